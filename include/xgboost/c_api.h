@@ -55,6 +55,18 @@ typedef void *BoosterHandle;  // NOLINT(*)
  * @since 3.2.0
  */
 typedef void *CategoriesHandle;  // NOLINT(*)
+/**
+ * @brief Handle to the single-row prediction session.
+ *
+ * @since 3.5.0
+ */
+typedef void *PredictionSessionHandle;  // NOLINT(*)
+/**
+ * @brief Handle to a prediction running in the background.
+ *
+ * @since 3.5.0
+ */
+typedef void *AsyncPredictionHandle;  // NOLINT(*)
 
 /**
  * @brief Return the version of the XGBoost library.
@@ -1332,6 +1344,158 @@ XGB_DLL int XGBoosterPredictFromCudaColumnar(BoosterHandle handle, char const *d
                                              bst_ulong const **out_shape, bst_ulong *out_dim,
                                              const float **out_result);
 
+/**
+ * @brief Create a session for predicting one dense row at a time with low latency.
+ *
+ *   The model views, the feature buffer, and the output transformation are prepared once by
+ *   this function. Subsequent calls to @ref XGPredictionSessionPredictRow don't parse any
+ *   configuration or allocate memory. The session references the trees in the booster, it
+ *   must be freed before the booster is freed or updated. A session is not thread-safe,
+ *   create one session for each thread instead.
+ *
+ * @since 3.5.0
+ *
+ * @param handle Booster handle
+ * @param config JSON encoded string storing parameters for the function. Following keys
+ *               are expected in the JSON document:
+ *               - "type": [0, 1]
+ *                 - 0: normal prediction
+ *                 - 1: output margin
+ *               - "missing": float
+ *               - "iteration_begin": int
+ *               - "iteration_end": int
+ * @param out    The created session.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGBoosterCreatePredictionSession(BoosterHandle handle, char const *config,
+                                             PredictionSessionHandle *out);
+/**
+ * @brief Get the input and output size of a prediction session.
+ *
+ * @since 3.5.0
+ *
+ * @param handle     Session handle
+ * @param n_features Number of features expected for each row.
+ * @param n_outputs  Number of output values for each row.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGPredictionSessionGetShape(PredictionSessionHandle handle, bst_ulong *n_features,
+                                        bst_ulong *n_outputs);
+/**
+ * @brief Predict a single dense row.
+ *
+ * @since 3.5.0
+ *
+ * @param handle Session handle
+ * @param row    Dense float32 row with the size of `n_features`.
+ * @param out    Output buffer with the size of `n_outputs`, owned by the caller.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGPredictionSessionPredictRow(PredictionSessionHandle handle, float const *row,
+                                          float *out);
+/**
+ * @brief Free a prediction session.
+ *
+ * @since 3.5.0
+ *
+ * @param handle Session handle
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGPredictionSessionFree(PredictionSessionHandle handle);
+
+/**
+ * @brief Queue a prediction from DMatrix on the background worker of the booster and
+ *        return immediately.
+ *
+ *   Queued predictions of a booster run one at a time in submission order. Use @ref
+ *   XGAsyncPredictionGetStatus to poll, or @ref XGAsyncPredictionWait to wait for the
+ *   result. The booster and the DMatrix must not be updated until the prediction is
+ *   finished, freeing the booster waits for all the queued predictions.
+ *
+ * @since 3.5.0
+ *
+ * @param handle Booster handle
+ * @param dmat   DMatrix handle
+ * @param config See @ref XGBoosterPredictFromDMatrix for more info. The `training` field
+ *               must be false.
+ * @param out    The created prediction handle.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGBoosterPredictFromDMatrixAsync(BoosterHandle handle, DMatrixHandle dmat,
+                                             char const *config, AsyncPredictionHandle *out);
+/**
+ * @brief Get the status of a queued prediction without blocking.
+ *
+ * @since 3.5.0
+ *
+ * @param handle     Prediction handle
+ * @param out_status One of:
+ *                   - 0: pending
+ *                   - 1: running
+ *                   - 2: done
+ *                   - 3: cancelled
+ *                   - 4: failed
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGAsyncPredictionGetStatus(AsyncPredictionHandle handle, int *out_status);
+/**
+ * @brief Wait for a queued prediction to finish.
+ *
+ * @since 3.5.0
+ *
+ * @param handle     Prediction handle
+ * @param timeout    Maximum time to wait in seconds, negative to wait without a limit.
+ * @param out_status Status after waiting, see @ref XGAsyncPredictionGetStatus .
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGAsyncPredictionWait(AsyncPredictionHandle handle, double timeout,
+                                  int *out_status);
+/**
+ * @brief Cancel a queued prediction if it hasn't started. A running prediction is not
+ *        interrupted.
+ *
+ * @since 3.5.0
+ *
+ * @param handle        Prediction handle
+ * @param out_cancelled 1 if the prediction is cancelled, 0 otherwise.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGAsyncPredictionCancel(AsyncPredictionHandle handle, int *out_cancelled);
+/**
+ * @brief Wait for a queued prediction and get the result. Fails if the prediction failed
+ *        or is cancelled, the error of the prediction is returned by @ref XGBGetLastError .
+ *
+ * @since 3.5.0
+ *
+ * @param handle     Prediction handle
+ * @param out_shape  See @ref XGBoosterPredictFromDMatrix for more info.
+ * @param out_dim    See @ref XGBoosterPredictFromDMatrix for more info.
+ * @param out_result Buffer storing the prediction, valid until the handle is freed.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGAsyncPredictionGetResult(AsyncPredictionHandle handle, bst_ulong const **out_shape,
+                                       bst_ulong *out_dim, float const **out_result);
+/**
+ * @brief Free a prediction handle. A pending prediction is cancelled, a running prediction
+ *        is finished in the background.
+ *
+ * @since 3.5.0
+ *
+ * @param handle Prediction handle
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGAsyncPredictionFree(AsyncPredictionHandle handle);
+
 /**@}*/  // End of Prediction
 
 /**
@@ -1378,6 +1542,91 @@ XGB_DLL int XGBoosterLoadModel(BoosterHandle handle, const char *fname);
  * @return 0 when success, -1 when failure happens
  */
 XGB_DLL int XGBoosterSaveModel(BoosterHandle handle, const char *fname);
+/**
+ * @brief Compile the model into a native shared library.
+ *
+ *   The trees are lowered into C source code and built with the system compiler. The
+ *   resulting library exports `void predict(float const* data, size_t n_rows, float* out)`
+ *   that accumulates the raw margin of a dense row-major batch into `out`. Once compiled,
+ *   inplace prediction with dense float32 data, NaN as missing value, and the full model is
+ *   dispatched to the library. A library compiled earlier can be loaded into a booster with
+ *   the same model by setting the `compiled_library` parameter to its path. The library
+ *   stores a fingerprint of the trees, and is not used once the model is changed by
+ *   training, loading or updating.
+ *
+ * @since 3.5.0
+ *
+ * @param handle handle
+ * @param config JSON encoded string storing parameters for the function.  Following
+ *               keys are expected in the JSON document:
+ *               - "path": str, required. Output path of the shared library. The generated
+ *                 source is written to the same path with a `.c` suffix.
+ *               - "compiler": str, optional. The C compiler, defaults to `cc`.
+ *               - "flags": str, optional. Compiler flags separated by white space, defaults
+ *                 to `-O2`. The compiler is executed without a shell.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGBoosterCompile(BoosterHandle handle, char const *config);
+/**
+ * @brief Create a reduced-precision copy of the model for inference.
+ *
+ *   Split thresholds and leaf values are stored in 16 bits, and tree weights are folded
+ *   into the leaves. Once compacted, batch and inplace prediction of the value on CPU use
+ *   the compact copy, other prediction types use the full model. A compact model saved
+ *   earlier can be loaded into a booster with the same model by setting the
+ *   `compact_model` parameter to its path. The compact copy stores a fingerprint of the
+ *   trees, and is not used once the model is changed by training or loading. Only
+ *   numerical splits and scalar leaves are supported.
+ *
+ * @since 3.5.0
+ *
+ * @param handle     handle
+ * @param config     JSON encoded string storing parameters for the function.  Following
+ *                   keys are expected in the JSON document:
+ *                   - "precision": str, optional. Encoding of the split thresholds, one of
+ *                     `fp16`, `bf16`, and `quantized`. The `quantized` encoding stores the
+ *                     index into the distinct thresholds of each feature and is exact.
+ *                     Leaf values are always stored as fp16. Defaults to `fp16`.
+ *                   - "path": str, optional. Output path of the compact model.
+ *
+ * @param out_report JSON encoded error report, with the maximum rounding error of the leaf
+ *                   values, the upper bound of the margin error, the maximum relative error
+ *                   of the thresholds, and the model size before and after compaction.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGBoosterCompact(BoosterHandle handle, char const *config, char const **out_report);
+/**
+ * @brief Simplify the trees of the model in place for inference.
+ *
+ *   Splits whose outcome is already decided by the splits on the same feature along the
+ *   path are removed, and sub-trees whose leaf values are within a tolerance of each
+ *   other are replaced by a single leaf. Trees with categorical splits and vector-leaf
+ *   trees are left unchanged. The model must be simplified before it's compiled or
+ *   compacted.
+ *
+ * @since 3.5.0
+ *
+ * @param handle     handle
+ * @param config     JSON encoded string storing parameters for the function.  Following
+ *                   keys are expected in the JSON document:
+ *                   - "tolerance": float, optional. Largest difference between the leaf
+ *                     values of a sub-tree that can be replaced by a leaf. The default 0
+ *                     keeps the prediction unchanged.
+ *                   - "fold_stumps": bool, optional. Fold trees with a single split on the
+ *                     same feature and threshold into the first of them. The folded trees
+ *                     are kept as a zero leaf. Predictions using a subset of the boosting
+ *                     rounds are changed by the folding. Defaults to false.
+ *
+ * @param out_report JSON encoded report, with the number of nodes before and after the
+ *                   pass, the number of removed splits, collapsed sub-trees and folded
+ *                   trees, and the upper bound of the change in the leaf values and the
+ *                   margin.
+ *
+ * @return 0 when success, -1 when failure happens
+ */
+XGB_DLL int XGBoosterSimplify(BoosterHandle handle, char const *config, char const **out_report);
 /**
  * @brief load model from in memory buffer
  *
@@ -15,6 +15,7 @@
 #include <xgboost/host_device_vector.h>
 #include <xgboost/model.h>
 
+#include <cstdint>  // for int32_t, uint8_t
 #include <functional>
 #include <memory>
 #include <set>
@@ -31,6 +32,11 @@ class CatContainer;
 struct Context;
 struct LearnerModelState;
 
+namespace predictor {
+class PredictionSession;
+class ContributionSink;
+}  // namespace predictor
+
 /*!
  * \brief interface of gradient boosting model.
  */
@@ -104,6 +110,74 @@ class GradientBooster : public Model, public Configurable {
                               bst_layer_t, bst_layer_t) const {
     LOG(FATAL) << "Inplace predict is not supported by the current booster.";
   }
+  /**
+   * @brief Compile the model into a native shared library and use it for inplace
+   *        prediction.
+   *
+   * @param config JSON encoded parameters, see @ref XGBoosterCompile .
+   */
+  virtual void Compile(Json const&) {
+    LOG(FATAL) << "Model compilation is not supported by the current booster.";
+  }
+  /**
+   * @brief Create a reduced-precision copy of the model and use it for value prediction.
+   *
+   * @param config     JSON encoded parameters, see @ref XGBoosterCompact .
+   * @param out_report Error introduced by the compaction.
+   */
+  virtual void Compact(Json const&, Json*) {
+    LOG(FATAL) << "Model compaction is not supported by the current booster.";
+  }
+  /**
+   * @brief Remove redundant splits and collapse near-constant sub-trees in place.
+   *
+   * @param config     JSON encoded parameters, see @ref XGBoosterSimplify .
+   * @param out_report Number of removed nodes and the change in the prediction.
+   */
+  virtual void Simplify(Json const&, Json*) {
+    LOG(FATAL) << "Model simplification is not supported by the current booster.";
+  }
+  /**
+   * @brief Create a session for predicting the margin of a single dense row.
+   *
+   * @param missing Missing value in the data.
+   * @param begin   Beginning of boosted tree layer used for prediction.
+   * @param end     End of booster layer. 0 means do not limit trees.
+   */
+  [[nodiscard]] virtual predictor::PredictionSession* CreatePredictionSession(
+      float /*missing*/, bst_layer_t /*begin*/, bst_layer_t /*end*/) const {
+    LOG(FATAL) << "Prediction session is not supported by the current booster.";
+    return nullptr;
+  }
+  /**
+   * @brief Predict which side of a margin threshold each row falls on, with early exit.
+   *
+   *   See @ref Predictor::PredictEarlyExit for details.
+   */
+  virtual void PredictEarlyExit(DMatrix* /*dmat*/, float /*threshold*/,
+                                HostDeviceVector<float>* /*out_preds*/,
+                                HostDeviceVector<bst_tree_t>* /*out_n_trees*/,
+                                bst_layer_t /*layer_begin*/, bst_layer_t /*layer_end*/) {
+    LOG(FATAL) << "Early exit prediction is not supported by the current booster.";
+  }
+  /**
+   * @brief Predict the cumulative margin at multiple layer boundaries in a single pass.
+   *
+   *   See @ref Learner::PredictStaged for details.
+   */
+  virtual void PredictStaged(DMatrix* /*dmat*/, common::Span<bst_layer_t const> /*stages*/,
+                             HostDeviceVector<float>* /*out_preds*/) {
+    LOG(FATAL) << "Staged prediction is not supported by the current booster.";
+  }
+  /**
+   * @brief Predict with a group of boosters on the same data, using the context of this
+   *        booster. See @ref Learner::PredictMulti for details.
+   */
+  virtual void PredictBatchMulti(DMatrix* /*dmat*/,
+                                 common::Span<GradientBooster const* const> /*boosters*/,
+                                 common::Span<HostDeviceVector<float>* const> /*out_preds*/) const {
+    LOG(FATAL) << "Multi-model prediction is not supported by the current booster.";
+  }
   /*!
    * \brief predict the leaf index of each tree, the output will be nsample * ntree vector
    *        this is only valid in gbtree predictor
@@ -115,6 +189,27 @@ class GradientBooster : public Model, public Configurable {
    */
   virtual void PredictLeaf(DMatrix* dmat, HostDeviceVector<bst_float>* out_preds,
                            bst_layer_t layer_begin, bst_layer_t layer_end, bool strict_shape) = 0;
+  /**
+   * @brief Predict the leaf index of each tree as packed integers.
+   *
+   *   See @ref Predictor::PredictLeafCompact for details.
+   */
+  virtual void PredictLeafCompact(DMatrix* /*dmat*/, HostDeviceVector<std::uint8_t>* /*out_leaf*/,
+                                  std::int32_t* /*out_bytes*/, bst_layer_t /*layer_begin*/,
+                                  bst_layer_t /*layer_end*/) {
+    LOG(FATAL) << "Compact leaf indices are not supported by the current booster.";
+  }
+  /**
+   * @brief Predict the leaf of each tree as a one-hot CSR matrix.
+   *
+   *   See @ref Predictor::PredictLeafOneHot for details.
+   */
+  virtual void PredictLeafOneHot(DMatrix* /*dmat*/, HostDeviceVector<bst_idx_t>* /*out_indptr*/,
+                                 HostDeviceVector<bst_feature_t>* /*out_indices*/,
+                                 bst_feature_t* /*out_n_columns*/, bst_layer_t /*layer_begin*/,
+                                 bst_layer_t /*layer_end*/) {
+    LOG(FATAL) << "One-hot leaf indices are not supported by the current booster.";
+  }
 
   /*!
    * \brief feature contributions to individual predictions; the output will be a vector
@@ -132,6 +227,29 @@ class GradientBooster : public Model, public Configurable {
   virtual void PredictInteractionContributions(DMatrix* dmat, HostDeviceVector<float>* out_contribs,
                                                bst_layer_t layer_begin, bst_layer_t layer_end,
                                                bool approximate) = 0;
+  /**
+   * @brief Feature contributions with only the largest values of each row, in CSR format.
+   *
+   *   See @ref Predictor::PredictContributionTopK for details.
+   */
+  virtual void PredictContributionTopK(DMatrix* /*dmat*/, bst_feature_t /*top_k*/,
+                                       HostDeviceVector<bst_idx_t>* /*out_indptr*/,
+                                       HostDeviceVector<bst_feature_t>* /*out_indices*/,
+                                       HostDeviceVector<float>* /*out_values*/,
+                                       bst_layer_t /*layer_begin*/, bst_layer_t /*layer_end*/) {
+    LOG(FATAL) << "Top-k feature contributions are not supported by the current booster.";
+  }
+  /**
+   * @brief Exact feature contributions written to a sink in blocks of rows.
+   *
+   *   See @ref Predictor::PredictContributionStream for details.
+   */
+  virtual void PredictContributionStream(DMatrix* /*dmat*/, bool /*interactions*/,
+                                         bst_idx_t /*block_rows*/,
+                                         predictor::ContributionSink* /*sink*/,
+                                         bst_layer_t /*layer_begin*/, bst_layer_t /*layer_end*/) {
+    LOG(FATAL) << "Streaming feature contributions is not supported by the current booster.";
+  }
 
   /**
    * @brief dump the model in the requested format
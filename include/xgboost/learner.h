@@ -37,6 +37,12 @@ template <typename T>
 class HostDeviceVector;
 class CatContainer;
 
+namespace predictor {
+class PredictionSession;
+class ContributionSink;
+class AsyncPrediction;
+}  // namespace predictor
+
 enum class PredictionType : std::uint8_t {  // NOLINT
   kValue = 0,
   kMargin = 1,
@@ -119,6 +125,149 @@ class Learner : public Model, public Configurable, public dmlc::Serializable {
                        bool pred_contribs = false, bool approx_contribs = false,
                        bool pred_interactions = false, bool strict_shape = false) = 0;
 
+  /**
+   * @brief Predict which side of a decision threshold each row falls on, with early exit.
+   *
+   *   For each row, the trees are evaluated in order until the partial margin plus the
+   *   precomputed bounds of the remaining trees can no longer cross the threshold. A row is
+   *   on the positive side if and only if its output is greater than the threshold. For
+   *   rows that exit early, the output is the bound of the full margin closest to the
+   *   threshold instead of the full margin. The decision is exact up to the floating-point
+   *   rounding of the margin. Only models with a single output are supported.
+   *
+   * @param data        Input data.
+   * @param threshold   Decision threshold on the raw margin, use the inverse link function
+   *                    of the objective to convert a probability threshold.
+   * @param out_preds   Output margin for each row.
+   * @param out_n_trees Number of trees evaluated for each row.
+   * @param layer_begin Beginning of boosted tree layer used for prediction.
+   * @param layer_end   End of booster layer. 0 means do not limit trees.
+   */
+  virtual void PredictEarlyExit(std::shared_ptr<DMatrix> data, float threshold,
+                                HostDeviceVector<float>* out_preds,
+                                HostDeviceVector<bst_tree_t>* out_n_trees,
+                                bst_layer_t layer_begin, bst_layer_t layer_end) = 0;
+  /**
+   * @brief Predict the raw margin at multiple boosting rounds in a single pass.
+   *
+   *   Equivalent to calling @ref Predict with the output margin and a layer range of
+   *   `[0, stages[i])` for each stage, but each tree is evaluated only once. Useful for
+   *   choosing the best iteration or plotting the learning curve on a validation dataset.
+   *
+   * @param data      Input data.
+   * @param stages    Strictly increasing layer end of each stage, in `[1, BoostedRounds()]`.
+   * @param out_preds Output margin with shape (n_stages, n_samples, n_groups).
+   */
+  virtual void PredictStaged(std::shared_ptr<DMatrix> data,
+                             common::Span<bst_layer_t const> stages,
+                             HostDeviceVector<float>* out_preds) = 0;
+  /**
+   * @brief Predict with multiple models on the same data, using all their trees.
+   *
+   *   Equivalent to calling @ref Predict on each learner, but the feature matrix is read
+   *   only once for all the models. Useful for scoring a batch with a group of models, like
+   *   champion and challenger models. The threads of this learner are used, which doesn't
+   *   need to be one of the `learners`. Only tree models are supported.
+   *
+   * @param data          Input data.
+   * @param learners      Learners to predict with.
+   * @param output_margin Whether to output the raw margin instead of the transformed value.
+   * @param out_preds     One output for each learner.
+   */
+  virtual void PredictMulti(std::shared_ptr<DMatrix> data, common::Span<Learner* const> learners,
+                            bool output_margin,
+                            common::Span<HostDeviceVector<float>* const> out_preds) = 0;
+  /**
+   * @brief Predict the leaf index of each tree with the smallest integer type.
+   *
+   *   The output is a row-major `(n_samples, n_trees)` matrix stored as raw bytes in native
+   *   byte order. Each index takes 1, 2, or 4 bytes depending on the size of the largest
+   *   tree.
+   *
+   * @param data        Input data.
+   * @param out_leaf    Raw bytes of the leaf indices.
+   * @param out_bytes   Number of bytes for each leaf index.
+   * @param layer_begin Beginning of boosted tree layer used for prediction.
+   * @param layer_end   End of booster layer. 0 means do not limit trees.
+   */
+  virtual void PredictLeafCompact(std::shared_ptr<DMatrix> data,
+                                  HostDeviceVector<std::uint8_t>* out_leaf,
+                                  std::int32_t* out_bytes, bst_layer_t layer_begin,
+                                  bst_layer_t layer_end) = 0;
+  /**
+   * @brief Predict the leaf of each tree as a one-hot CSR matrix.
+   *
+   *   Leaves of each tree are numbered in node order and offset by the number of leaves in
+   *   the previous trees. The result can be used as sparse features for a linear model
+   *   without expanding the leaf indices. All values are 1 and are not stored.
+   *
+   * @param data          Input data.
+   * @param out_indptr    Row pointer of the output.
+   * @param out_indices   Column index of each entry.
+   * @param out_n_columns Total number of leaves.
+   * @param layer_begin   Beginning of boosted tree layer used for prediction.
+   * @param layer_end     End of booster layer. 0 means do not limit trees.
+   */
+  virtual void PredictLeafOneHot(std::shared_ptr<DMatrix> data,
+                                 HostDeviceVector<bst_idx_t>* out_indptr,
+                                 HostDeviceVector<bst_feature_t>* out_indices,
+                                 bst_feature_t* out_n_columns, bst_layer_t layer_begin,
+                                 bst_layer_t layer_end) = 0;
+  /**
+   * @brief Predict the SHAP values, keeping only the largest contributions of each row.
+   *
+   *   The output is a CSR matrix with `n_samples * n_groups` rows, each row has at most
+   *   `top_k` non-zero contributions sorted by the absolute value in descending order. The
+   *   bias term is not included. Unlike the dense output from @ref Predict, the memory usage
+   *   is bounded by `top_k` instead of the number of features.
+   *
+   * @param data        Input data.
+   * @param top_k       Maximum number of contributions for each row.
+   * @param out_indptr  Row pointer of the output.
+   * @param out_indices Feature index of each contribution.
+   * @param out_values  Value of each contribution.
+   * @param layer_begin Beginning of boosted tree layer used for prediction.
+   * @param layer_end   End of booster layer. 0 means do not limit trees.
+   */
+  virtual void PredictContributionTopK(std::shared_ptr<DMatrix> data, bst_feature_t top_k,
+                                       HostDeviceVector<bst_idx_t>* out_indptr,
+                                       HostDeviceVector<bst_feature_t>* out_indices,
+                                       HostDeviceVector<float>* out_values,
+                                       bst_layer_t layer_begin, bst_layer_t layer_end) = 0;
+  /**
+   * @brief Predict the exact SHAP values or interaction values into a sink in blocks of
+   *        rows.
+   *
+   *   The concatenated output is the same as the dense output from @ref Predict, but only a
+   *   buffer for one block of rows is allocated. The sink reports the progress after each
+   *   block.
+   *
+   * @param data         Input data.
+   * @param interactions Output the interaction values instead of the SHAP values.
+   * @param block_rows   Number of rows in each block, 0 to choose automatically.
+   * @param sink         Destination of the contributions.
+   * @param layer_begin  Beginning of boosted tree layer used for prediction.
+   * @param layer_end    End of booster layer. 0 means do not limit trees.
+   */
+  virtual void PredictContributionStream(std::shared_ptr<DMatrix> data, bool interactions,
+                                         bst_idx_t block_rows, predictor::ContributionSink* sink,
+                                         bst_layer_t layer_begin, bst_layer_t layer_end) = 0;
+  /**
+   * @brief Queue a prediction on the background worker of the learner and return without
+   *        waiting for it.
+   *
+   *   The result is the same as @ref Predict without training. Queued predictions run one
+   *   at a time in submission order. The learner must not be updated while a prediction is
+   *   queued, and destroying the learner waits for all the queued predictions.
+   *
+   * @return State of the prediction for polling, waiting, or cancellation.
+   */
+  virtual std::shared_ptr<predictor::AsyncPrediction> PredictAsync(
+      std::shared_ptr<DMatrix> data, bool output_margin, bst_layer_t layer_begin,
+      bst_layer_t layer_end, bool pred_leaf = false, bool pred_contribs = false,
+      bool approx_contribs = false, bool pred_interactions = false,
+      bool strict_shape = false) = 0;
+
   /*!
    * \brief Inplace prediction.
    *
@@ -232,6 +381,40 @@ class Learner : public Model, public Configurable, public dmlc::Serializable {
    */
   virtual std::vector<std::string> DumpModel(const FeatureMap& fmap, bool with_stats,
                                              std::string format) = 0;
+  /**
+   * @brief Compile the model into a native shared library. Subsequent inplace prediction
+   *        calls are dispatched to the compiled library when possible.
+   *
+   * @param config JSON encoded parameters, see XGBoosterCompile for details.
+   */
+  virtual void Compile(Json const& config) = 0;
+  /**
+   * @brief Create a reduced-precision copy of the model. Subsequent batch and inplace
+   *        prediction of the value are dispatched to the compact model.
+   *
+   * @param config     JSON encoded parameters, see XGBoosterCompact for details.
+   * @param out_report Error introduced by the compaction.
+   */
+  virtual void Compact(Json const& config, Json* out_report) = 0;
+  /**
+   * @brief Remove redundant splits and collapse near-constant sub-trees of the model in
+   *        place.
+   *
+   * @param config     JSON encoded parameters, see XGBoosterSimplify for details.
+   * @param out_report Number of removed nodes and the change in the prediction.
+   */
+  virtual void Simplify(Json const& config, Json* out_report) = 0;
+  /**
+   * @brief Create a session for predicting single dense rows without per-call overhead.
+   *
+   * See InplacePredict for the parameters. Only `kValue` and `kMargin` are supported.
+   *
+   * @return A new session owned by the caller.
+   */
+  virtual predictor::PredictionSession* CreatePredictionSession(PredictionType type,
+                                                                float missing,
+                                                                bst_layer_t layer_begin,
+                                                                bst_layer_t layer_end) = 0;
 
   virtual XGBAPIThreadLocalEntry& GetThreadLocal() const = 0;
   /**
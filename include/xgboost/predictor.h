@@ -13,6 +13,7 @@
 #include <xgboost/linalg.h>
 #include <xgboost/span.h>
 
+#include <cstdint>     // for int32_t, uint8_t
 #include <functional>  // for function
 #include <memory>      // for shared_ptr
 #include <string>
@@ -23,6 +24,10 @@ namespace xgboost::gbm {
 struct GBTreeModel;
 }  // namespace xgboost::gbm
 
+namespace xgboost::predictor {
+class ContributionSink;
+}  // namespace xgboost::predictor
+
 namespace xgboost {
 class RegTree;
 /**
@@ -42,6 +47,12 @@ class Predictor {
 
   virtual ~Predictor() = default;
 
+  /**
+   * \brief Configure the predictor with booster parameters. Parameters not used by the
+   *        predictor are ignored.
+   */
+  virtual void Configure(Args const&) {}
+
   /**
    * \brief Initialize output prediction
    *
@@ -85,6 +96,60 @@ class Predictor {
                               float missing, HostDeviceVector<float>* out_preds,
                               bst_tree_t tree_begin = 0, bst_tree_t tree_end = 0) const = 0;
 
+  /**
+   * \brief Predict which side of a margin threshold each row falls on, with early exit.
+   *
+   *   The trees of a row are evaluated in order until the partial margin plus the bounds of
+   *   the remaining trees can no longer cross the threshold. Only single output models with
+   *   scalar leaves are supported.
+   *
+   * \param          dmat        Feature matrix.
+   * \param          threshold   Decision threshold on the raw margin.
+   * \param [in,out] out_preds   Initialized by @ref InitOutPredictions. For rows that exit
+   *                              early, the output is the bound of the full margin closest to
+   *                              the threshold, which is on the same side of the threshold as
+   *                              the full margin. Otherwise, it's the full margin.
+   * \param [out]    out_n_trees Number of trees evaluated for each row.
+   * \param          model       The model to predict from.
+   * \param          tree_begin  The tree begin index.
+   * \param          tree_end    The tree end index.
+   */
+  virtual void PredictEarlyExit(DMatrix* dmat, float threshold, HostDeviceVector<float>* out_preds,
+                                HostDeviceVector<bst_tree_t>* out_n_trees,
+                                gbm::GBTreeModel const& model, bst_tree_t tree_begin,
+                                bst_tree_t tree_end) const;
+
+  /**
+   * \brief Predict the cumulative margin at multiple tree boundaries in a single pass.
+   *
+   *   Each tree is evaluated once for each row, the partial margin is written out whenever
+   *   a stage boundary is reached.
+   *
+   * \param          dmat      Feature matrix.
+   * \param          stages    Strictly increasing tree end index of each stage.
+   * \param [in,out] out_preds Initialized by @ref InitOutPredictions. Resized to
+   *                            (n_stages, n_samples, n_groups), stage `i` contains the margin
+   *                            from the trees in `[0, stages[i])`.
+   * \param          model     The model to predict from.
+   */
+  virtual void PredictStaged(DMatrix* dmat, common::Span<bst_tree_t const> stages,
+                             HostDeviceVector<float>* out_preds,
+                             gbm::GBTreeModel const& model) const;
+
+  /**
+   * \brief Predict with multiple models on the same data using all their trees.
+   *
+   *   The default implementation calls @ref PredictBatch for each model. Predictors can
+   *   override it to read the feature matrix only once for all the models.
+   *
+   * \param          dmat      Feature matrix.
+   * \param          models    The models to predict from.
+   * \param [in,out] out_preds One output for each model, initialized by
+   *                            @ref InitOutPredictions with the corresponding model.
+   */
+  virtual void PredictBatchMulti(DMatrix* dmat, common::Span<gbm::GBTreeModel const* const> models,
+                                 common::Span<HostDeviceVector<float>* const> out_preds) const;
+
   /**
    * \brief predict the leaf index of each tree, the output will be nsample *
    * ntree vector this is only valid in gbtree predictor.
@@ -98,6 +163,38 @@ class Predictor {
   virtual void PredictLeaf(DMatrix* dmat, HostDeviceVector<float>* out_preds,
                            gbm::GBTreeModel const& model, bst_tree_t tree_end = 0) const = 0;
 
+  /**
+   * \brief Predict the leaf index of each tree as packed integers. The output has shape
+   *        `(n_samples, n_trees)` in native byte order, the integer width is the smallest
+   *        of 1, 2 and 4 bytes that can hold the node indices of all trees.
+   *
+   * \param          dmat      The input feature matrix.
+   * \param [out]    out_leaf  Raw bytes of the leaf indices.
+   * \param [out]    out_bytes Number of bytes for each leaf index.
+   * \param          model     Model to make predictions from.
+   * \param          tree_end  The tree end index.
+   */
+  virtual void PredictLeafCompact(DMatrix* dmat, HostDeviceVector<std::uint8_t>* out_leaf,
+                                  std::int32_t* out_bytes, gbm::GBTreeModel const& model,
+                                  bst_tree_t tree_end = 0) const;
+
+  /**
+   * \brief Predict the leaf of each tree as a one-hot CSR matrix. Leaves of each tree are
+   *        numbered in node order, starting after the leaves of the previous trees. Each
+   *        row has exactly one entry for each tree, and all values are 1.
+   *
+   * \param          dmat          The input feature matrix.
+   * \param [out]    out_indptr    Row pointer with length `n_samples + 1`.
+   * \param [out]    out_indices   Column of each entry, sorted within a row.
+   * \param [out]    out_n_columns Total number of leaves.
+   * \param          model         Model to make predictions from.
+   * \param          tree_end      The tree end index.
+   */
+  virtual void PredictLeafOneHot(DMatrix* dmat, HostDeviceVector<bst_idx_t>* out_indptr,
+                                 HostDeviceVector<bst_feature_t>* out_indices,
+                                 bst_feature_t* out_n_columns, gbm::GBTreeModel const& model,
+                                 bst_tree_t tree_end = 0) const;
+
   /**
    * \brief Add prediction contributions from known leaf ids. The leaf ids are encoded with
    *        tree::SamplePosition, where invalid rows are still decoded for prediction.
@@ -134,6 +231,43 @@ class Predictor {
                                                bst_tree_t tree_end = 0,
                                                bool approximate = false) const = 0;
 
+  /**
+   * \brief Feature contributions with only the `top_k` largest absolute values of each
+   *        row, in CSR format. The rows are (sample, group) pairs, arranged in that order.
+   *        Contributions of each row are sorted by their absolute values in descending
+   *        order, zero contributions and the bias term are excluded.
+   *
+   * \param          dmat        The input feature matrix.
+   * \param          top_k       Maximum number of contributions for each row.
+   * \param [out]    out_indptr  Row pointer with length `n_samples * n_groups + 1`.
+   * \param [out]    out_indices Feature index of each contribution.
+   * \param [out]    out_values  Value of each contribution.
+   * \param          model       Model to make predictions from.
+   * \param          tree_end    The tree end index.
+   */
+  virtual void PredictContributionTopK(DMatrix* dmat, bst_feature_t top_k,
+                                       HostDeviceVector<bst_idx_t>* out_indptr,
+                                       HostDeviceVector<bst_feature_t>* out_indices,
+                                       HostDeviceVector<float>* out_values,
+                                       gbm::GBTreeModel const& model,
+                                       bst_tree_t tree_end = 0) const;
+
+  /**
+   * \brief Exact feature contributions written to a sink in blocks of rows. Only a buffer
+   *        for one block is allocated, the output can be larger than the memory.
+   *
+   * \param dmat         The input feature matrix.
+   * \param interactions Output the interaction values instead of the SHAP values.
+   * \param block_rows   Number of rows in each block, 0 to choose automatically.
+   * \param sink         Destination of the contributions.
+   * \param model        Model to make predictions from.
+   * \param tree_end     The tree end index.
+   */
+  virtual void PredictContributionStream(DMatrix* dmat, bool interactions, bst_idx_t block_rows,
+                                         predictor::ContributionSink* sink,
+                                         gbm::GBTreeModel const& model,
+                                         bst_tree_t tree_end = 0) const;
+
   /**
    * \brief Creates a new Predictor*.
    *
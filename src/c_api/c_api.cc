@@ -4,6 +4,7 @@
 #include "xgboost/c_api.h"
 
 #include <algorithm>     // for copy, transform
+#include <chrono>        // for duration, milliseconds
 #include <cinttypes>     // for strtoimax
 #include <cmath>         // for nan
 #include <cstring>       // for strcmp
@@ -30,6 +31,8 @@
 #include "../data/proxy_dmatrix.h"       // for DMatrixProxy
 #include "../data/simple_dmatrix.h"      // for SimpleDMatrix
 #include "../encoder/types.h"            // for Overloaded
+#include "../predictor/async_prediction.h"    // for AsyncPrediction, AsyncStatus
+#include "../predictor/prediction_session.h"  // for PredictionSession
 #include "c_api_error.h"                 // for xgboost_CHECK_C_ARG_PTR, API_END, API_BEGIN
 #include "c_api_utils.h"                 // for RequiredArg, OptionalArg, GetMissing, CastDM...
 #include "dmlc/base.h"                   // for BeginPtr
@@ -1443,6 +1446,166 @@ XGB_DLL int XGBoosterPredictFromCSR(BoosterHandle handle, char const *indptr, ch
   API_END();
 }
 
+XGB_DLL int XGBoosterCreatePredictionSession(BoosterHandle handle, char const *config,
+                                             PredictionSessionHandle *out) {
+  API_BEGIN();
+  CHECK_HANDLE();
+  xgboost_CHECK_C_ARG_PTR(config);
+  xgboost_CHECK_C_ARG_PTR(out);
+  auto jconfig = Json::Load(StringView{config});
+  auto type = PredictionType(RequiredArg<Integer>(jconfig, "type", __func__));
+  float missing = GetMissing(jconfig);
+  auto *learner = static_cast<Learner *>(handle);
+  *out = learner->CreatePredictionSession(
+      type, missing, RequiredArg<Integer>(jconfig, "iteration_begin", __func__),
+      RequiredArg<Integer>(jconfig, "iteration_end", __func__));
+  API_END();
+}
+
+XGB_DLL int XGPredictionSessionGetShape(PredictionSessionHandle handle,
+                                        xgboost::bst_ulong *n_features,
+                                        xgboost::bst_ulong *n_outputs) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  xgboost_CHECK_C_ARG_PTR(n_features);
+  xgboost_CHECK_C_ARG_PTR(n_outputs);
+  auto const *session = static_cast<predictor::PredictionSession const *>(handle);
+  *n_features = session->NumFeatures();
+  *n_outputs = session->NumOutputs();
+  API_END();
+}
+
+XGB_DLL int XGPredictionSessionPredictRow(PredictionSessionHandle handle, float const *row,
+                                          float *out) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  xgboost_CHECK_C_ARG_PTR(row);
+  xgboost_CHECK_C_ARG_PTR(out);
+  static_cast<predictor::PredictionSession *>(handle)->PredictRow(row, out);
+  API_END();
+}
+
+XGB_DLL int XGPredictionSessionFree(PredictionSessionHandle handle) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  delete static_cast<predictor::PredictionSession *>(handle);
+  API_END();
+}
+
+namespace {
+struct AsyncPredictionEntry {
+  std::shared_ptr<predictor::AsyncPrediction> task;
+  // Used for calculating the output shape.
+  std::shared_ptr<DMatrix> p_m;
+  PredictionType type;
+  bool strict_shape;
+  bst_layer_t n_rounds;
+  bst_target_t n_groups;
+  std::vector<bst_ulong> shape;
+};
+}  // namespace
+
+XGB_DLL int XGBoosterPredictFromDMatrixAsync(BoosterHandle handle, DMatrixHandle dmat,
+                                             char const *c_json_config,
+                                             AsyncPredictionHandle *out) {
+  API_BEGIN();
+  CHECK_HANDLE();
+  if (dmat == nullptr) {
+    LOG(FATAL) << "DMatrix has not been initialized or has already been disposed.";
+  }
+  xgboost_CHECK_C_ARG_PTR(c_json_config);
+  xgboost_CHECK_C_ARG_PTR(out);
+  auto config = Json::Load(StringView{c_json_config});
+
+  auto *learner = static_cast<Learner *>(handle);
+  auto p_m = *static_cast<std::shared_ptr<DMatrix> *>(dmat);
+
+  auto type = PredictionType(RequiredArg<Integer>(config, "type", __func__));
+  auto iteration_begin = RequiredArg<Integer>(config, "iteration_begin", __func__);
+  auto iteration_end = RequiredArg<Integer>(config, "iteration_end", __func__);
+  CHECK(!OptionalArg<Boolean>(config, "training", false))
+      << "Prediction for training can not be queued.";
+  bool strict_shape = RequiredArg<Boolean>(config, "strict_shape", __func__);
+
+  bool approximate =
+      type == PredictionType::kApproxContribution || type == PredictionType::kApproxInteraction;
+  bool contribs =
+      type == PredictionType::kContribution || type == PredictionType::kApproxContribution;
+  bool interactions =
+      type == PredictionType::kInteraction || type == PredictionType::kApproxInteraction;
+  auto task = learner->PredictAsync(p_m, type == PredictionType::kMargin, iteration_begin,
+                                    iteration_end, type == PredictionType::kLeaf, contribs,
+                                    approximate, interactions, strict_shape);
+
+  auto n_rounds = iteration_end - iteration_begin;
+  n_rounds = n_rounds == 0 ? learner->BoostedRounds() : n_rounds;
+  *out = new AsyncPredictionEntry{std::move(task), std::move(p_m), type, strict_shape,
+                                  static_cast<bst_layer_t>(n_rounds), learner->Groups(), {}};
+  API_END();
+}
+
+XGB_DLL int XGAsyncPredictionGetStatus(AsyncPredictionHandle handle, int *out_status) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  xgboost_CHECK_C_ARG_PTR(out_status);
+  *out_status = static_cast<int>(static_cast<AsyncPredictionEntry *>(handle)->task->Status());
+  API_END();
+}
+
+XGB_DLL int XGAsyncPredictionWait(AsyncPredictionHandle handle, double timeout,
+                                  int *out_status) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  xgboost_CHECK_C_ARG_PTR(out_status);
+  auto const &task = static_cast<AsyncPredictionEntry *>(handle)->task;
+  predictor::AsyncStatus status;
+  if (timeout < 0) {
+    status = task->Wait();
+  } else {
+    status = task->WaitFor(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::duration<double>{timeout}));
+  }
+  *out_status = static_cast<int>(status);
+  API_END();
+}
+
+XGB_DLL int XGAsyncPredictionCancel(AsyncPredictionHandle handle, int *out_cancelled) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  xgboost_CHECK_C_ARG_PTR(out_cancelled);
+  *out_cancelled = static_cast<AsyncPredictionEntry *>(handle)->task->Cancel();
+  API_END();
+}
+
+XGB_DLL int XGAsyncPredictionGetResult(AsyncPredictionHandle handle,
+                                       xgboost::bst_ulong const **out_shape,
+                                       xgboost::bst_ulong *out_dim, float const **out_result) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  xgboost_CHECK_C_ARG_PTR(out_shape);
+  xgboost_CHECK_C_ARG_PTR(out_dim);
+  xgboost_CHECK_C_ARG_PTR(out_result);
+  auto *entry = static_cast<AsyncPredictionEntry *>(handle);
+  auto const &predictions = entry->task->Get();
+  *out_result = dmlc::BeginPtr(predictions.ConstHostVector());
+
+  auto const &info = entry->p_m->Info();
+  auto chunksize = info.num_row_ == 0 ? 0 : predictions.Size() / info.num_row_;
+  CalcPredictShape(entry->strict_shape, entry->type, info.num_row_, info.num_col_, chunksize,
+                   entry->n_groups, entry->n_rounds, &entry->shape, out_dim);
+  *out_shape = dmlc::BeginPtr(entry->shape);
+  API_END();
+}
+
+XGB_DLL int XGAsyncPredictionFree(AsyncPredictionHandle handle) {
+  API_BEGIN();
+  xgboost_CHECK_C_ARG_PTR(handle);
+  auto *entry = static_cast<AsyncPredictionEntry *>(handle);
+  entry->task->Cancel();
+  delete entry;
+  API_END();
+}
+
 #if !defined(XGBOOST_USE_CUDA)
 XGB_DLL int XGBoosterPredictFromCudaArray(BoosterHandle handle, char const *, char const *,
                                           DMatrixHandle, xgboost::bst_ulong const **,
@@ -1555,6 +1718,45 @@ XGB_DLL int XGBoosterSaveModel(BoosterHandle handle, const char *fname) {
   API_END();
 }
 
+XGB_DLL int XGBoosterCompile(BoosterHandle handle, char const *config) {
+  API_BEGIN();
+  CHECK_HANDLE();
+  xgboost_CHECK_C_ARG_PTR(config);
+  auto jconfig = Json::Load(StringView{config});
+  static_cast<Learner *>(handle)->Compile(jconfig);
+  API_END();
+}
+
+XGB_DLL int XGBoosterCompact(BoosterHandle handle, char const *config, char const **out_report) {
+  API_BEGIN();
+  CHECK_HANDLE();
+  xgboost_CHECK_C_ARG_PTR(config);
+  xgboost_CHECK_C_ARG_PTR(out_report);
+  auto jconfig = Json::Load(StringView{config});
+  auto *learner = static_cast<Learner *>(handle);
+  Json report;
+  learner->Compact(jconfig, &report);
+  auto &ret_str = learner->GetThreadLocal().ret_str;
+  Json::Dump(report, &ret_str);
+  *out_report = ret_str.c_str();
+  API_END();
+}
+
+XGB_DLL int XGBoosterSimplify(BoosterHandle handle, char const *config, char const **out_report) {
+  API_BEGIN();
+  CHECK_HANDLE();
+  xgboost_CHECK_C_ARG_PTR(config);
+  xgboost_CHECK_C_ARG_PTR(out_report);
+  auto jconfig = Json::Load(StringView{config});
+  auto *learner = static_cast<Learner *>(handle);
+  Json report;
+  learner->Simplify(jconfig, &report);
+  auto &ret_str = learner->GetThreadLocal().ret_str;
+  Json::Dump(report, &ret_str);
+  *out_report = ret_str.c_str();
+  API_END();
+}
+
 XGB_DLL int XGBoosterLoadModelFromBuffer(BoosterHandle handle, const void *buf,
                                          xgboost::bst_ulong len) {
   API_BEGIN();
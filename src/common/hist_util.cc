@@ -1,11 +1,13 @@
 /**
- * Copyright 2017-2025, XGBoost Contributors
+ * Copyright 2017-2026, XGBoost Contributors
  * \file hist_util.cc
  */
 #include "hist_util.h"
 
 #include <dmlc/timer.h>
 
+#include <cstring>      // for memcpy
+#include <type_traits>  // for is_same_v
 #include <vector>
 
 #include "../data/adapter.h"         // for SparsePageAdapterBatch
@@ -13,10 +15,15 @@
 #include "cache_manager.h"           // for CacheManager
 #include "io.h"                      // for AlignedResourceReadStream, AlignedFileWriteStream
 #include "quantile.h"
+#include "simd.h"             // for SimdIsa
 #include "xgboost/base.h"
 #include "xgboost/context.h"  // for Context
 #include "xgboost/data.h"     // for SparsePage, SortedCSCPage
 
+#if XGBOOST_SIMD_X86
+#include <immintrin.h>
+#endif  // XGBOOST_SIMD_X86
+
 #if defined(XGBOOST_MM_PREFETCH_PRESENT)
 #include <xmmintrin.h>
 #define PREFETCH_READ_T0(addr) _mm_prefetch(reinterpret_cast<const char *>(addr), _MM_HINT_T0)
@@ -120,6 +127,52 @@ void SubtractionHist(GHistRow dst, const GHistRow src1, const GHistRow src2, siz
   }
 }
 
+namespace {
+template <typename T>
+void IncrementQuantisedHist(Span<T> dst, Span<T const> add, std::size_t begin,
+                            std::size_t end) {
+  using ValueT = typename T::ValueT;
+  auto *pdst = reinterpret_cast<ValueT *>(dst.data());
+  auto const *padd = reinterpret_cast<ValueT const *>(add.data());
+
+  for (std::size_t i = 2 * begin; i < 2 * end; ++i) {
+    pdst[i] += padd[i];
+  }
+}
+}  // anonymous namespace
+
+void IncrementHist(Span<GradientPairInt32> dst, Span<GradientPairInt32 const> add,
+                   std::size_t begin, std::size_t end) {
+  IncrementQuantisedHist(dst, add, begin, end);
+}
+
+void IncrementHist(Span<GradientPairInt64> dst, Span<GradientPairInt64 const> add,
+                   std::size_t begin, std::size_t end) {
+  IncrementQuantisedHist(dst, add, begin, end);
+}
+
+void SubtractionHist(Span<GradientPairInt64> dst, Span<GradientPairInt64 const> src1,
+                     Span<GradientPairInt64 const> src2, std::size_t begin, std::size_t end) {
+  auto *pdst = reinterpret_cast<std::int64_t *>(dst.data());
+  auto const *psrc1 = reinterpret_cast<std::int64_t const *>(src1.data());
+  auto const *psrc2 = reinterpret_cast<std::int64_t const *>(src2.data());
+
+  for (std::size_t i = 2 * begin; i < 2 * end; ++i) {
+    pdst[i] = psrc1[i] - psrc2[i];
+  }
+}
+
+void SubtractionHist(Span<GradientPair> dst, Span<GradientPair const> src1,
+                     Span<GradientPair const> src2, std::size_t begin, std::size_t end) {
+  auto *pdst = reinterpret_cast<float *>(dst.data());
+  auto const *psrc1 = reinterpret_cast<float const *>(src1.data());
+  auto const *psrc2 = reinterpret_cast<float const *>(src2.data());
+
+  for (std::size_t i = 2 * begin; i < 2 * end; ++i) {
+    pdst[i] = psrc1[i] - psrc2[i];
+  }
+}
+
 struct Prefetch {
  public:
   static constexpr size_t kCacheLineSize = 64;
@@ -200,11 +253,13 @@ class GHistBuildingManager {
 // thread-local buffer that fits in cache. Returns false (fall through to the
 // direct-scatter loop) when the histogram fits in cache or per-leaf scatter
 // work does not amortize the per-block overhead.
-template <class BuildingManager>
-bool BuildSparseHistByBlocks(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-                             const GHistIndexMatrix &gmat, GHistRow hist) {
+template <class BuildingManager, typename GradientT, typename HistT>
+bool BuildSparseHistByBlocks(Span<GradientT const> gpair, Span<bst_idx_t const> row_indices,
+                             const GHistIndexMatrix &gmat, Span<HistT> hist) {
   constexpr bool kFirstPage = BuildingManager::kFirstPage;
   using BinIdxType = typename BuildingManager::BinIdxType;
+  using GradT = typename GradientT::ValueT;
+  using HistValueT = typename HistT::ValueT;
 
   constexpr size_t kColBlockSize = 32;
 
@@ -215,7 +270,7 @@ bool BuildSparseHistByBlocks(Span<GradientPair const> gpair, Span<bst_idx_t cons
   // Check 1: histogram size vs. per-thread cache budget. Detected once per
   // process via CacheManager (CPUID + sane defaults).
   static const CacheManager kCacheManager{};
-  const size_t hist_bytes = 2 * sizeof(double) * total_hist_bins;
+  const size_t hist_bytes = 2 * sizeof(HistValueT) * total_hist_bins;
   const double l3_per_thread =
       static_cast<double>(kCacheManager.L3Size()) / std::max(1, omp_get_max_threads());
   const double usable_cache = 0.8 * (kCacheManager.L2Size() + l3_per_thread);
@@ -249,7 +304,7 @@ bool BuildSparseHistByBlocks(Span<GradientPair const> gpair, Span<bst_idx_t cons
     max_block_bins = std::max(max_block_bins, bins);
   }
 
-  std::vector<double> tl_buf(max_block_bins * 2);
+  std::vector<HistValueT> tl_buf(max_block_bins * 2);
   std::vector<size_t> tl_row_starts(size);
   std::vector<size_t> tl_row_sizes(size);
   std::vector<uint32_t> tl_cursors(size, 0);
@@ -259,9 +314,9 @@ bool BuildSparseHistByBlocks(Span<GradientPair const> gpair, Span<bst_idx_t cons
     tl_row_sizes[i] = get_row_ptr(rid[i] + 1) - tl_row_starts[i];
   }
 
-  auto const *p_gpair = reinterpret_cast<const float *>(gpair.data());
+  auto const *p_gpair = reinterpret_cast<const GradT *>(gpair.data());
   const BinIdxType *gradient_index = gmat.index.data<BinIdxType>();
-  auto hist_data = reinterpret_cast<double *>(hist.data());
+  auto hist_data = reinterpret_cast<HistValueT *>(hist.data());
   const uint32_t two{2};
 
   for (size_t cid_begin = 0; cid_begin < n_features; cid_begin += kColBlockSize) {
@@ -270,14 +325,14 @@ bool BuildSparseHistByBlocks(Span<GradientPair const> gpair, Span<bst_idx_t cons
     const uint32_t bin_hi = cut_ptrs[cid_end];
     const size_t block_n_bins = bin_hi - bin_lo;
 
-    double *local_hist = tl_buf.data();
-    std::fill_n(local_hist, block_n_bins * 2, 0.0);
+    HistValueT *local_hist = tl_buf.data();
+    std::fill_n(local_hist, block_n_bins * 2, HistValueT{0});
 
     for (size_t i = 0; i < size; ++i) {
       const BinIdxType *gr_row = gradient_index + tl_row_starts[i];
       const size_t row_size = tl_row_sizes[i];
       const size_t idx_gh = two * rid[i];
-      const float pgh_t[] = {p_gpair[idx_gh], p_gpair[idx_gh + 1]};
+      const GradT pgh_t[] = {p_gpair[idx_gh], p_gpair[idx_gh + 1]};
 
       size_t j = tl_cursors[i];
       while (j < row_size && static_cast<uint32_t>(gr_row[j]) < bin_lo) ++j;
@@ -291,7 +346,7 @@ bool BuildSparseHistByBlocks(Span<GradientPair const> gpair, Span<bst_idx_t cons
       tl_cursors[i] = j;
     }
 
-    double *dst = hist_data + two * bin_lo;
+    HistValueT *dst = hist_data + two * bin_lo;
     for (size_t j = 0; j < block_n_bins * 2; ++j) {
       dst[j] += local_hist[j];
     }
@@ -299,22 +354,184 @@ bool BuildSparseHistByBlocks(Span<GradientPair const> gpair, Span<bst_idx_t cons
   return true;
 }
 
+#if XGBOOST_SIMD_X86
+/**
+ * @brief Explicit SIMD kernels for dense rows with compressed bin index.
+ *
+ *   The bins of different features in a row are disjoint, so the histogram entries of a
+ *   row can be updated with gather and scatter without conflict. Rows are processed in
+ *   the same order as the scalar kernel, the result is identical.
+ */
+template <bool do_prefetch, typename BinIdxType>
+XGBOOST_TARGET_AVX512 void DenseRowsHistAvx512(float const *p_gpair,
+                                               BinIdxType const *gradient_index,
+                                               std::uint32_t const *offsets,
+                                               Span<bst_idx_t const> row_indices,
+                                               bst_idx_t base_rowid, std::size_t n_features,
+                                               double *hist_data) {
+  // Interleave the entries for gradient and hessian: [2b_0, 2b_0 + 1, 2b_1, 2b_1 + 1, ...]
+  __m256i const dup = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+  __m256i const lane = _mm256_setr_epi32(0, 1, 0, 1, 0, 1, 0, 1);
+  std::size_t const n_vec = n_features - n_features % 4;
+  bst_idx_t const *rid = row_indices.data();
+
+  for (std::size_t i = 0; i < row_indices.size(); ++i) {
+    if (do_prefetch) {
+      auto rid_prefetch = rid[i + Prefetch::kPrefetchOffset];
+      PREFETCH_READ_T0(p_gpair + 2 * rid_prefetch);
+      auto icol_start_prefetch = (rid_prefetch - base_rowid) * n_features;
+      for (std::size_t j = icol_start_prefetch; j < icol_start_prefetch + n_features;
+           j += Prefetch::GetPrefetchStep<std::uint32_t>()) {
+        PREFETCH_READ_T0(gradient_index + j);
+      }
+    }
+    BinIdxType const *row = gradient_index + (rid[i] - base_rowid) * n_features;
+    double const g = p_gpair[2 * rid[i]];
+    double const h = p_gpair[2 * rid[i] + 1];
+    __m512d const gh = _mm512_setr_pd(g, h, g, h, g, h, g, h);
+
+    std::size_t j = 0;
+    for (; j < n_vec; j += 4) {
+      __m128i bins;
+      if constexpr (sizeof(BinIdxType) == 1) {
+        std::int32_t packed;
+        std::memcpy(&packed, row + j, sizeof(packed));
+        bins = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+      } else {
+        bins = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(row + j)));
+      }
+      bins = _mm_add_epi32(bins, _mm_loadu_si128(reinterpret_cast<__m128i const *>(offsets + j)));
+      __m256i idx = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(bins), dup);
+      idx = _mm256_add_epi32(_mm256_slli_epi32(idx, 1), lane);
+      __m512d v = _mm512_add_pd(_mm512_i32gather_pd(idx, hist_data, 8), gh);
+      _mm512_i32scatter_pd(hist_data, idx, v, 8);
+    }
+    for (; j < n_features; ++j) {
+      auto idx_bin = 2 * (static_cast<std::uint32_t>(row[j]) + offsets[j]);
+      hist_data[idx_bin] += g;
+      hist_data[idx_bin + 1] += h;
+    }
+  }
+}
+
+template <bool do_prefetch, typename BinIdxType>
+XGBOOST_TARGET_AVX2 void DenseRowsHistAvx2(float const *p_gpair, BinIdxType const *gradient_index,
+                                           std::uint32_t const *offsets,
+                                           Span<bst_idx_t const> row_indices,
+                                           bst_idx_t base_rowid, std::size_t n_features,
+                                           double *hist_data) {
+  // No scatter in AVX2, the bin index is computed with vectors and each entry is updated
+  // as a pair of gradient and hessian.
+  alignas(32) std::uint32_t idx[8];
+  std::size_t const n_vec = n_features - n_features % 8;
+  bst_idx_t const *rid = row_indices.data();
+
+  for (std::size_t i = 0; i < row_indices.size(); ++i) {
+    if (do_prefetch) {
+      auto rid_prefetch = rid[i + Prefetch::kPrefetchOffset];
+      PREFETCH_READ_T0(p_gpair + 2 * rid_prefetch);
+      auto icol_start_prefetch = (rid_prefetch - base_rowid) * n_features;
+      for (std::size_t j = icol_start_prefetch; j < icol_start_prefetch + n_features;
+           j += Prefetch::GetPrefetchStep<std::uint32_t>()) {
+        PREFETCH_READ_T0(gradient_index + j);
+      }
+    }
+    BinIdxType const *row = gradient_index + (rid[i] - base_rowid) * n_features;
+    double const g = p_gpair[2 * rid[i]];
+    double const h = p_gpair[2 * rid[i] + 1];
+    __m128d const gh = _mm_setr_pd(g, h);
+
+    std::size_t j = 0;
+    for (; j < n_vec; j += 8) {
+      __m256i bins;
+      if constexpr (sizeof(BinIdxType) == 1) {
+        bins = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(row + j)));
+      } else {
+        bins = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(row + j)));
+      }
+      bins = _mm256_add_epi32(
+          bins, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(offsets + j)));
+      _mm256_store_si256(reinterpret_cast<__m256i *>(idx), _mm256_slli_epi32(bins, 1));
+      for (std::size_t k = 0; k < 8; ++k) {
+        double *entry = hist_data + idx[k];
+        _mm_storeu_pd(entry, _mm_add_pd(_mm_loadu_pd(entry), gh));
+      }
+    }
+    for (; j < n_features; ++j) {
+      auto idx_bin = 2 * (static_cast<std::uint32_t>(row[j]) + offsets[j]);
+      hist_data[idx_bin] += g;
+      hist_data[idx_bin + 1] += h;
+    }
+  }
+}
+#endif  // XGBOOST_SIMD_X86
+
+/**
+ * @brief Build the histogram for dense rows with the SIMD kernels.
+ *
+ * @return Whether the histogram is built. False if the ISA or the bin type is not
+ *         supported, the caller should fall back to the scalar kernel.
+ */
 template <bool do_prefetch, class BuildingManager>
-void RowsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-                             const GHistIndexMatrix &gmat, GHistRow hist) {
+bool DenseRowsWiseBuildHistSimd(SimdIsa isa, Span<GradientPair const> gpair,
+                                Span<bst_idx_t const> row_indices, const GHistIndexMatrix &gmat,
+                                GHistRow hist) {
+  using BinIdxType = typename BuildingManager::BinIdxType;
+  if constexpr (BuildingManager::kAnyMissing || sizeof(BinIdxType) > 2) {
+    return false;
+  } else {
+#if XGBOOST_SIMD_X86
+    // 32-bit gather index for histogram entries.
+    if (isa == SimdIsa::kScalar || row_indices.empty() ||
+        gmat.cut.TotalBins() >= std::numeric_limits<std::int32_t>::max() / 2) {
+      return false;
+    }
+    auto base_rowid = BuildingManager::kFirstPage ? static_cast<bst_idx_t>(0) : gmat.base_rowid;
+    auto first = row_indices.front() - base_rowid;
+    std::size_t n_features = gmat.row_ptr[first + 1] - gmat.row_ptr[first];
+    auto const *p_gpair = reinterpret_cast<float const *>(gpair.data());
+    auto const *gradient_index = gmat.index.data<BinIdxType>();
+    std::uint32_t const *offsets = gmat.index.Offset();
+    CHECK(offsets);
+    auto *hist_data = reinterpret_cast<double *>(hist.data());
+    if (isa == SimdIsa::kAvx512) {
+      DenseRowsHistAvx512<do_prefetch>(p_gpair, gradient_index, offsets, row_indices,
+                                       base_rowid, n_features, hist_data);
+    } else {
+      DenseRowsHistAvx2<do_prefetch>(p_gpair, gradient_index, offsets, row_indices, base_rowid,
+                                     n_features, hist_data);
+    }
+    return true;
+#else
+    return false;
+#endif  // XGBOOST_SIMD_X86
+  }
+}
+
+template <bool do_prefetch, class BuildingManager, typename GradientT, typename HistT>
+void RowsWiseBuildHistKernel(Span<GradientT const> gpair, Span<bst_idx_t const> row_indices,
+                             const GHistIndexMatrix &gmat, Span<HistT> hist, SimdIsa isa) {
   constexpr bool kAnyMissing = BuildingManager::kAnyMissing;
   constexpr bool kFirstPage = BuildingManager::kFirstPage;
   using BinIdxType = typename BuildingManager::BinIdxType;
+  using GradT = typename GradientT::ValueT;
+  using HistValueT = typename HistT::ValueT;
 
   if constexpr (kAnyMissing) {
     if (BuildSparseHistByBlocks<BuildingManager>(gpair, row_indices, gmat, hist)) {
       return;
     }
+  } else if constexpr (std::is_same_v<GradientT, GradientPair> &&
+                       std::is_same_v<HistT, GradientPairPrecise>) {
+    if (DenseRowsWiseBuildHistSimd<do_prefetch, BuildingManager>(isa, gpair, row_indices, gmat,
+                                                                 hist)) {
+      return;
+    }
   }
 
   const size_t size = row_indices.size();
   bst_idx_t const *rid = row_indices.data();
-  auto const *p_gpair = reinterpret_cast<const float *>(gpair.data());
+  auto const *p_gpair = reinterpret_cast<const GradT *>(gpair.data());
   const BinIdxType *gradient_index = gmat.index.data<BinIdxType>();
 
   auto const &row_ptr = gmat.row_ptr.data();
@@ -337,7 +554,7 @@ void RowsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t cons
   CHECK_NE(row_indices.size(), 0);
   const size_t n_features =
       get_row_ptr(row_indices.data()[0] + 1) - get_row_ptr(row_indices.data()[0]);
-  auto hist_data = reinterpret_cast<double *>(hist.data());
+  auto hist_data = reinterpret_cast<HistValueT *>(hist.data());
   const uint32_t two{2};  // Each element from 'gpair' and 'hist' contains
                           // 2 FP values: gradient and hessian.
                           // So we need to multiply each row-index/bin-index by 2
@@ -367,7 +584,7 @@ void RowsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t cons
     const BinIdxType *gr_index_local = gradient_index + icol_start;
 
     // The trick with pgh_t buffer helps the compiler to generate faster binary.
-    const float pgh_t[] = {p_gpair[idx_gh], p_gpair[idx_gh + 1]};
+    const GradT pgh_t[] = {p_gpair[idx_gh], p_gpair[idx_gh + 1]};
     for (size_t j = 0; j < row_size; ++j) {
       const uint32_t idx_bin =
           two * (static_cast<uint32_t>(gr_index_local[j]) + (kAnyMissing ? 0 : offsets[j]));
@@ -378,15 +595,18 @@ void RowsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t cons
   }
 }
 
-template <class BuildingManager>
-void ColsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-                             const GHistIndexMatrix &gmat, GHistRow hist) {
+template <class BuildingManager, typename GradientT, typename HistT>
+void ColsWiseBuildHistKernel(Span<GradientT const> gpair, Span<bst_idx_t const> row_indices,
+                             const GHistIndexMatrix &gmat, Span<HistT> hist,
+                             bool spread_low_bins) {
   constexpr bool kAnyMissing = BuildingManager::kAnyMissing;
   constexpr bool kFirstPage = BuildingManager::kFirstPage;
   using BinIdxType = typename BuildingManager::BinIdxType;
+  using GradT = typename GradientT::ValueT;
+  using HistValueT = typename HistT::ValueT;
   const size_t size = row_indices.size();
   bst_idx_t const *rid = row_indices.data();
-  auto const *pgh = reinterpret_cast<const float *>(gpair.data());
+  auto const *pgh = reinterpret_cast<const GradT *>(gpair.data());
   const BinIdxType *gradient_index = gmat.index.data<BinIdxType>();
 
   auto const &row_ptr = gmat.row_ptr.data();
@@ -401,7 +621,7 @@ void ColsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t cons
 
   const size_t n_features = gmat.cut.Ptrs().size() - 1;
   const size_t n_columns = n_features;
-  auto hist_data = reinterpret_cast<double *>(hist.data());
+  auto hist_data = reinterpret_cast<HistValueT *>(hist.data());
   const uint32_t two{2};  // Each element from 'gpair' and 'hist' contains
                           // 2 FP values: gradient and hessian.
                           // So we need to multiply each row-index/bin-index by 2
@@ -414,24 +634,35 @@ void ColsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t cons
   auto const &cut_ptrs = gmat.cut.Ptrs();
   constexpr size_t kColBlockSize = 32;
 
+  // Features with few bins are hit by consecutive rows in the same entries, which
+  // serializes the updates on store-to-load forwarding. If `spread_low_bins` is set, blocks
+  // of such features spread the rows over multiple copies of the local buffer, merged
+  // before flushing. This changes the order of summation for floating point histograms.
+  constexpr size_t kLowBinsPerColumn = 16;
+  constexpr size_t kNumCopies = 4;
+  auto n_copies_for_block = [&](size_t n_bins, size_t n_cols) {
+    return spread_low_bins && n_bins <= kLowBinsPerColumn * n_cols ? kNumCopies : 1;
+  };
+
   // Pre-allocate thread-local buffer sized for the largest column block
-  size_t max_block_bins = 0;
+  size_t max_block_size = 0;
   for (size_t jj = 0; jj < n_columns; jj += kColBlockSize) {
     size_t jj_end = std::min(jj + kColBlockSize, n_columns);
     size_t bins = cut_ptrs[jj_end] - cut_ptrs[jj];
-    max_block_bins = std::max(max_block_bins, bins);
+    max_block_size = std::max(max_block_size, bins * n_copies_for_block(bins, jj_end - jj));
   }
 
-  std::vector<double> tl_cols_buf(max_block_bins * 2);
+  std::vector<HistValueT> tl_cols_buf(max_block_size * 2);
 
   for (size_t cid_begin = 0; cid_begin < n_columns; cid_begin += kColBlockSize) {
     const size_t cid_end = std::min(cid_begin + kColBlockSize, n_columns);
     const size_t chunk_bin_begin = cut_ptrs[cid_begin];
     const size_t chunk_bin_end = cut_ptrs[cid_end];
     const size_t chunk_n_bins = chunk_bin_end - chunk_bin_begin;
+    const size_t n_copies = n_copies_for_block(chunk_n_bins, cid_end - cid_begin);
 
-    double *local_hist = tl_cols_buf.data();
-    std::fill_n(local_hist, chunk_n_bins * 2, 0.0);
+    HistValueT *local_hist = tl_cols_buf.data();
+    std::fill_n(local_hist, chunk_n_bins * 2 * n_copies, HistValueT{0});
 
     for (size_t i = 0; i < size; ++i) {
       const size_t row_id = rid[i];
@@ -440,33 +671,42 @@ void ColsWiseBuildHistKernel(Span<GradientPair const> gpair, Span<bst_idx_t cons
       const size_t row_size = icol_end - icol_start;
 
       const size_t idx_gh = two * row_id;
-      const float pgh_t[] = {pgh[idx_gh], pgh[idx_gh + 1]};
+      const GradT pgh_t[] = {pgh[idx_gh], pgh[idx_gh + 1]};
       const BinIdxType *gr_index_local = gradient_index + icol_start;
+      HistValueT *row_hist = local_hist + (i % n_copies) * chunk_n_bins * 2;
 
       for (size_t cid = cid_begin; cid < cid_end; ++cid) {
         if (cid < row_size) {
           const uint32_t offset = kAnyMissing ? 0 : offsets[cid];
           const uint32_t global_bin = static_cast<uint32_t>(gr_index_local[cid]) + offset;
           const uint32_t local_bin = two * (global_bin - static_cast<uint32_t>(chunk_bin_begin));
-          *(local_hist + local_bin) += pgh_t[0];
-          *(local_hist + local_bin + 1) += pgh_t[1];
+          *(row_hist + local_bin) += pgh_t[0];
+          *(row_hist + local_bin + 1) += pgh_t[1];
         }
       }
     }
 
+    for (size_t c = 1; c < n_copies; ++c) {
+      HistValueT const *copy = local_hist + c * chunk_n_bins * 2;
+      for (size_t j = 0; j < chunk_n_bins * 2; ++j) {
+        local_hist[j] += copy[j];
+      }
+    }
+
     // Flush local buffer to full histogram
-    double *dst = hist_data + two * chunk_bin_begin;
+    HistValueT *dst = hist_data + two * chunk_bin_begin;
     for (size_t j = 0; j < chunk_n_bins * 2; ++j) {
       dst[j] += local_hist[j];
     }
   }
 }
 
-template <class BuildingManager>
-void BuildHistDispatch(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-                       const GHistIndexMatrix &gmat, GHistRow hist) {
+template <class BuildingManager, typename GradientT, typename HistT>
+void BuildHistDispatch(Span<GradientT const> gpair, Span<bst_idx_t const> row_indices,
+                       const GHistIndexMatrix &gmat, Span<HistT> hist, SimdIsa isa,
+                       bool spread_low_bins) {
   if (BuildingManager::kReadByColumn) {
-    ColsWiseBuildHistKernel<BuildingManager>(gpair, row_indices, gmat, hist);
+    ColsWiseBuildHistKernel<BuildingManager>(gpair, row_indices, gmat, hist, spread_low_bins);
   } else {
     if (row_indices.empty()) {
       return;
@@ -480,37 +720,111 @@ void BuildHistDispatch(Span<GradientPair const> gpair, Span<bst_idx_t const> row
 
     if (contiguousBlock) {
       // contiguous memory access, built-in HW prefetching is enough
-      RowsWiseBuildHistKernel<false, BuildingManager>(gpair, row_indices, gmat, hist);
+      RowsWiseBuildHistKernel<false, BuildingManager>(gpair, row_indices, gmat, hist, isa);
     } else {
       auto span1 = row_indices.subspan(0, row_indices.size() - no_prefetch_size);
       if (!span1.empty()) {
-        RowsWiseBuildHistKernel<true, BuildingManager>(gpair, span1, gmat, hist);
+        RowsWiseBuildHistKernel<true, BuildingManager>(gpair, span1, gmat, hist, isa);
       }
       // no prefetching to avoid loading extra memory
       auto span2 = row_indices.subspan(row_indices.size() - no_prefetch_size);
       if (!span2.empty()) {
-        RowsWiseBuildHistKernel<false, BuildingManager>(gpair, span2, gmat, hist);
+        RowsWiseBuildHistKernel<false, BuildingManager>(gpair, span2, gmat, hist, isa);
       }
     }
   }
 }
 
-template <bool any_missing>
-void BuildHist(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-               const GHistIndexMatrix &gmat, GHistRow hist, bool read_by_column) {
+template <bool any_missing, typename GradientT, typename HistT>
+void BuildHistImpl(Span<GradientT const> gpair, Span<bst_idx_t const> row_indices,
+                   const GHistIndexMatrix &gmat, Span<HistT> hist, bool read_by_column,
+                   SimdIsa isa, bool spread_low_bins) {
   bool first_page = gmat.base_rowid == 0;
   auto bin_type_size = gmat.index.GetBinTypeSize();
 
   GHistBuildingManager<any_missing>::DispatchAndExecute(
       {first_page, read_by_column, bin_type_size}, [&](auto t) {
         using BuildingManager = decltype(t);
-        BuildHistDispatch<BuildingManager>(gpair, row_indices, gmat, hist);
+        BuildHistDispatch<BuildingManager>(gpair, row_indices, gmat, hist, isa,
+                                           spread_low_bins);
       });
 }
 
+template <bool any_missing>
+void BuildHist(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix &gmat, GHistRow hist, bool read_by_column, SimdIsa isa,
+               bool spread_low_bins) {
+  BuildHistImpl<any_missing>(gpair, row_indices, gmat, hist, read_by_column, isa,
+                             spread_low_bins);
+}
+
+template <bool any_missing>
+void BuildHist(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix &gmat, Span<GradientPair> hist, bool read_by_column,
+               bool spread_low_bins) {
+  BuildHistImpl<any_missing>(gpair, row_indices, gmat, hist, read_by_column, SimdIsa::kScalar,
+                             spread_low_bins);
+}
+
+// The integer sum is exact, the column-wise kernel always spreads the low bin count features.
+template <bool any_missing>
+void BuildHist(Span<GradientPairInt16 const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix &gmat, Span<GradientPairInt32> hist, bool read_by_column) {
+  BuildHistImpl<any_missing>(gpair, row_indices, gmat, hist, read_by_column, SimdIsa::kScalar,
+                             true);
+}
+
+template <bool any_missing>
+void BuildHist(Span<GradientPairInt16 const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix &gmat, Span<GradientPairInt64> hist, bool read_by_column) {
+  BuildHistImpl<any_missing>(gpair, row_indices, gmat, hist, read_by_column, SimdIsa::kScalar,
+                             true);
+}
+
+template <bool any_missing>
+void BuildHist(Span<GradientPairInt32 const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix &gmat, Span<GradientPairInt64> hist, bool read_by_column) {
+  BuildHistImpl<any_missing>(gpair, row_indices, gmat, hist, read_by_column, SimdIsa::kScalar,
+                             true);
+}
+
+template void BuildHist<true>(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
+                              const GHistIndexMatrix &gmat, GHistRow hist, bool read_by_column,
+                              SimdIsa isa, bool spread_low_bins);
+
+template void BuildHist<false>(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
+                               const GHistIndexMatrix &gmat, GHistRow hist, bool read_by_column,
+                               SimdIsa isa, bool spread_low_bins);
+
 template void BuildHist<true>(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-                              const GHistIndexMatrix &gmat, GHistRow hist, bool read_by_column);
+                              const GHistIndexMatrix &gmat, Span<GradientPair> hist,
+                              bool read_by_column, bool spread_low_bins);
 
 template void BuildHist<false>(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-                               const GHistIndexMatrix &gmat, GHistRow hist, bool read_by_column);
+                               const GHistIndexMatrix &gmat, Span<GradientPair> hist,
+                               bool read_by_column, bool spread_low_bins);
+
+template void BuildHist<true>(Span<GradientPairInt16 const> gpair,
+                              Span<bst_idx_t const> row_indices, const GHistIndexMatrix &gmat,
+                              Span<GradientPairInt32> hist, bool read_by_column);
+
+template void BuildHist<false>(Span<GradientPairInt16 const> gpair,
+                               Span<bst_idx_t const> row_indices, const GHistIndexMatrix &gmat,
+                               Span<GradientPairInt32> hist, bool read_by_column);
+
+template void BuildHist<true>(Span<GradientPairInt16 const> gpair,
+                              Span<bst_idx_t const> row_indices, const GHistIndexMatrix &gmat,
+                              Span<GradientPairInt64> hist, bool read_by_column);
+
+template void BuildHist<false>(Span<GradientPairInt16 const> gpair,
+                               Span<bst_idx_t const> row_indices, const GHistIndexMatrix &gmat,
+                               Span<GradientPairInt64> hist, bool read_by_column);
+
+template void BuildHist<true>(Span<GradientPairInt32 const> gpair,
+                              Span<bst_idx_t const> row_indices, const GHistIndexMatrix &gmat,
+                              Span<GradientPairInt64> hist, bool read_by_column);
+
+template void BuildHist<false>(Span<GradientPairInt32 const> gpair,
+                               Span<bst_idx_t const> row_indices, const GHistIndexMatrix &gmat,
+                               Span<GradientPairInt64> hist, bool read_by_column);
 }  // namespace xgboost::common
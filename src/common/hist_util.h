@@ -12,11 +12,13 @@
 #include <cstdint>  // for uint32_t
 #include <limits>
 #include <map>
+#include <type_traits>  // for is_same_v
 #include <utility>
 #include <vector>
 
 #include "categorical.h"
 #include "quantile.h"
+#include "simd.h"  // for SimdIsa, DetectSimdIsa
 #include "threading_utils.h"
 #include "xgboost/base.h"  // for bst_feature_t, bst_bin_t
 #include "xgboost/data.h"
@@ -388,6 +390,14 @@ bst_bin_t XGBOOST_HOST_DEV_INLINE BinarySearchBin(std::size_t begin, std::size_t
 using GHistRow = Span<xgboost::GradientPairPrecise>;
 using ConstGHistRow = Span<xgboost::GradientPairPrecise const>;
 
+/** @brief Quantised gradient pair of a single sample. */
+using GradientPairInt16 = xgboost::detail::GradientPairInternal<std::int16_t>;
+/**
+ * @brief Histogram bin for quantised gradient, used when it can't overflow. Also the
+ *        quantised gradient of a sample when 16 bits are not enough.
+ */
+using GradientPairInt32 = xgboost::detail::GradientPairInternal<std::int32_t>;
+
 /*!
  * \brief Increment hist as dst += add in range [begin, end)
  */
@@ -404,17 +414,32 @@ void CopyHist(GHistRow dst, const GHistRow src, size_t begin, size_t end);
 void SubtractionHist(GHistRow dst, const GHistRow src1, const GHistRow src2, size_t begin,
                      size_t end);
 
+void IncrementHist(Span<GradientPairInt32> dst, Span<GradientPairInt32 const> add,
+                   std::size_t begin, std::size_t end);
+void IncrementHist(Span<GradientPairInt64> dst, Span<GradientPairInt64 const> add,
+                   std::size_t begin, std::size_t end);
+void SubtractionHist(Span<GradientPairInt64> dst, Span<GradientPairInt64 const> src1,
+                     Span<GradientPairInt64 const> src2, std::size_t begin, std::size_t end);
+/**
+ * @brief Subtraction for the single precision histogram cache.
+ */
+void SubtractionHist(Span<GradientPair> dst, Span<GradientPair const> src1,
+                     Span<GradientPair const> src2, std::size_t begin, std::size_t end);
+
 /*!
  * \brief histogram of gradient statistics for multiple nodes
  */
-class HistCollection {
+template <typename GradientSumT>
+class HistCollectionImpl {
  public:
+  using GHistRowT = Span<GradientSumT>;
+
   // access histogram for i-th node
-  GHistRow operator[](bst_uint nid) const {
+  GHistRowT operator[](bst_uint nid) const {
     constexpr uint32_t kMax = std::numeric_limits<uint32_t>::max();
     const size_t id = row_ptr_.at(nid);
     CHECK_NE(id, kMax);
-    GradientPairPrecise* ptr = const_cast<GradientPairPrecise*>(data_[id].data());
+    GradientSumT* ptr = const_cast<GradientSumT*>(data_[id].data());
     return {ptr, nbins_};
   }
 
@@ -456,7 +481,7 @@ class HistCollection {
   // allocate thread local memory i-th node
   void AllocateData(bst_uint nid) {
     if (data_[row_ptr_[nid]].size() == 0) {
-      data_[row_ptr_[nid]].resize(nbins_, {0, 0});
+      data_[row_ptr_[nid]].resize(nbins_, GradientSumT{});
     }
   }
 
@@ -465,18 +490,23 @@ class HistCollection {
   uint32_t nbins_ = 0;
   /*! \brief amount of active nodes in hist collection */
   uint32_t n_nodes_added_ = 0;
-  std::vector<std::vector<GradientPairPrecise>> data_;
+  std::vector<std::vector<GradientSumT>> data_;
 
   /*! \brief row_ptr_[nid] locates bin for histogram of node nid */
   std::vector<size_t> row_ptr_;
 };
 
+using HistCollection = HistCollectionImpl<GradientPairPrecise>;
+
 /*!
  * \brief Stores temporary histograms to compute them in parallel
  * Supports processing multiple tree-nodes for nested parallelism
  * Able to reduce histograms across threads in efficient way
  */
-class ParallelGHistBuilder {
+template <typename GradientSumT>
+class ParallelGHistBuilderImpl {
+  using GHistRowT = Span<GradientSumT>;
+
  public:
   void Init(size_t nbins) {
     if (nbins != nbins_) {
@@ -488,7 +518,7 @@ class ParallelGHistBuilder {
   // Add new elements if needed, mark all hists as unused
   // targeted_hists - already allocated hists which should contain final results after Reduce() call
   void Reset(size_t nthreads, size_t nodes, const BlockedSpace2d& space,
-             const std::vector<GHistRow>& targeted_hists) {
+             const std::vector<GHistRowT>& targeted_hists) {
     hist_buffer_.Init(nbins_);
     tid_nid_to_hist_.clear();
     threads_to_nids_map_.clear();
@@ -506,21 +536,35 @@ class ParallelGHistBuilder {
 
     hist_was_used_.resize(nthreads * nodes_);
     std::fill(hist_was_used_.begin(), hist_was_used_.end(), static_cast<int>(false));
+    // Buffers for stolen blocks only live until the next reset, otherwise they would
+    // accumulate towards one histogram for every pair of thread and node.
+    stolen_hists_.clear();
+    stolen_hists_.resize(nthreads * nodes_);
   }
 
   // Get specified hist, initialize hist by zeros if it wasn't used before
-  GHistRow GetInitializedHist(size_t tid, size_t nid) {
+  GHistRowT GetInitializedHist(size_t tid, size_t nid) {
     CHECK_LT(nid, nodes_);
     CHECK_LT(tid, nthreads_);
 
-    int idx = tid_nid_to_hist_.at({tid, nid});
-    if (idx >= 0) {
-      hist_buffer_.AllocateData(idx);
+    GHistRowT hist;
+    auto it = tid_nid_to_hist_.find({tid, nid});
+    if (it == tid_nid_to_hist_.cend()) {
+      // The block is stolen from another thread by ParallelFor2dStealing, allocate a
+      // buffer on first use. Only the thread `tid` accesses this buffer.
+      auto& buf = stolen_hists_[tid * nodes_ + nid];
+      buf.resize(nbins_);
+      hist = GHistRowT{buf.data(), buf.size()};
+    } else {
+      int idx = it->second;
+      if (idx >= 0) {
+        hist_buffer_.AllocateData(idx);
+      }
+      hist = idx == -1 ? targeted_hists_[nid] : hist_buffer_[idx];
     }
-    GHistRow hist = idx == -1 ? targeted_hists_[nid] : hist_buffer_[idx];
 
     if (!hist_was_used_[tid * nodes_ + nid]) {
-      std::fill_n(hist.data(), hist.size(), GradientPairPrecise{});
+      std::fill_n(hist.data(), hist.size(), GradientSumT{});
       hist_was_used_[tid * nodes_ + nid] = static_cast<int>(true);
     }
 
@@ -532,25 +576,53 @@ class ParallelGHistBuilder {
     CHECK_GT(end, begin);
     CHECK_LT(nid, nodes_);
 
-    GHistRow dst = targeted_hists_[nid];
+    GHistRowT dst = targeted_hists_[nid];
 
-    bool is_updated = false;
+    // The targeted hist is the buffer of the first thread assigned to the node. It holds
+    // garbage if that thread didn't process any block of the node, either because all the
+    // blocks are stolen, or in distributed mode where some tree nodes can be empty on local
+    // machines.
+    bool dst_is_used = false;
     for (size_t tid = 0; tid < nthreads_; ++tid) {
-      if (hist_was_used_[tid * nodes_ + nid]) {
-        is_updated = true;
-
-        int idx = tid_nid_to_hist_.at({tid, nid});
-        GHistRow src = idx == -1 ? targeted_hists_[nid] : hist_buffer_[idx];
+      auto it = tid_nid_to_hist_.find({tid, nid});
+      if (it != tid_nid_to_hist_.cend() && it->second == -1) {
+        dst_is_used = hist_was_used_[tid * nodes_ + nid];
+        break;
+      }
+    }
+    if (!dst_is_used) {
+      std::fill(dst.data() + begin, dst.data() + end, GradientSumT{});
+    }
 
-        if (dst.data() != src.data()) {
-          IncrementHist(dst, src, begin, end);
+    if constexpr (std::is_same_v<GradientSumT, GradientPair>) {
+      // Each thread accumulates a block of rows in single precision. The blocks are summed
+      // in double precision and each bin is rounded once.
+      std::vector<float const*> srcs;
+      for (size_t tid = 0; tid < nthreads_; ++tid) {
+        if (hist_was_used_[tid * nodes_ + nid]) {
+          auto src = this->ThreadHist(tid, nid);
+          if (dst.data() != src.data()) {
+            srcs.push_back(reinterpret_cast<float const*>(src.data()));
+          }
+        }
+      }
+      auto* pdst = reinterpret_cast<float*>(dst.data());
+      for (size_t i = 2 * begin; i < 2 * end; ++i) {
+        double sum = pdst[i];
+        for (auto const* src : srcs) {
+          sum += src[i];
+        }
+        pdst[i] = static_cast<float>(sum);
+      }
+    } else {
+      for (size_t tid = 0; tid < nthreads_; ++tid) {
+        if (hist_was_used_[tid * nodes_ + nid]) {
+          auto src = this->ThreadHist(tid, nid);
+          if (dst.data() != src.data()) {
+            IncrementHist(dst, src, begin, end);
+          }
         }
       }
-    }
-    if (!is_updated) {
-      // In distributed mode - some tree nodes can be empty on local machines,
-      // So we need just set local hist by zeros in this case
-      std::fill(dst.data() + begin, dst.data() + end, GradientPairPrecise{});
     }
   }
 
@@ -601,8 +673,26 @@ class ParallelGHistBuilder {
   }
 
   [[nodiscard]] bst_bin_t TotalBins() const { return nbins_; }
+  /** @brief Number of bins allocated for stolen blocks, used for testing. */
+  [[nodiscard]] std::size_t StolenBins() const {
+    std::size_t n = 0;
+    for (auto const& buf : stolen_hists_) {
+      n += buf.size();
+    }
+    return n;
+  }
 
  private:
+  // Get the hist of a thread without initialization.
+  [[nodiscard]] Span<GradientSumT const> ThreadHist(size_t tid, size_t nid) const {
+    auto it = tid_nid_to_hist_.find({tid, nid});
+    if (it == tid_nid_to_hist_.cend()) {
+      auto const& buf = stolen_hists_[tid * nodes_ + nid];
+      return {buf.data(), buf.size()};
+    }
+    return it->second == -1 ? targeted_hists_[nid] : hist_buffer_[it->second];
+  }
+
   void MatchNodeNidPairToHist() {
     size_t hist_allocated_additionally = 0;
 
@@ -628,7 +718,7 @@ class ParallelGHistBuilder {
   /*! \brief number of nodes which will be processed in parallel  */
   size_t nodes_ = 0;
   /*! \brief Buffer for additional histograms for Parallel processing  */
-  HistCollection hist_buffer_;
+  HistCollectionImpl<GradientSumT> hist_buffer_;
   /*!
    * \brief Marks which hists were used, it means that they should be merged.
    * Contains only {true or false} values
@@ -639,18 +729,59 @@ class ParallelGHistBuilder {
   /*! \brief Buffer for additional histograms for Parallel processing  */
   std::vector<bool> threads_to_nids_map_;
   /*! \brief Contains histograms for final results  */
-  std::vector<GHistRow> targeted_hists_;
+  std::vector<GHistRowT> targeted_hists_;
   /*!
    * \brief map pair {tid, nid} to index of allocated histogram from hist_buffer_ and targeted_hists_,
    * -1 is reserved for targeted_hists_
    */
   std::map<std::pair<size_t, size_t>, int> tid_nid_to_hist_;
+  /*!
+   * \brief Lazily allocated hists for {tid, nid} pairs that are not in tid_nid_to_hist_,
+   * indexed by tid * nodes_ + nid.
+   */
+  std::vector<std::vector<GradientSumT>> stolen_hists_;
 };
 
-// construct a histogram via histogram aggregation
+using ParallelGHistBuilder = ParallelGHistBuilderImpl<GradientPairPrecise>;
+
+/**
+ * @brief Construct a histogram via histogram aggregation.
+ *
+ * @param isa             Instruction set for the dense row-wise kernel, mostly used for testing
+ *                        and benchmarking. Other cases use the scalar kernel.
+ * @param spread_low_bins Whether the column-wise kernel spreads rows over multiple local
+ *                        buffers for features with few bins. The result is not bitwise
+ *                        identical to the row-wise kernel due to the order of summation.
+ */
 template <bool any_missing>
 void BuildHist(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
-               const GHistIndexMatrix& gmat, GHistRow hist, bool read_by_column);
+               const GHistIndexMatrix& gmat, GHistRow hist, bool read_by_column,
+               SimdIsa isa = DetectSimdIsa(), bool spread_low_bins = false);
+
+/**
+ * @brief Construct a single precision histogram. Rows are summed in float, partial
+ *        histograms of different blocks should be combined in double precision.
+ */
+template <bool any_missing>
+void BuildHist(Span<GradientPair const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix& gmat, Span<GradientPair> hist, bool read_by_column,
+               bool spread_low_bins = false);
+
+/**
+ * @brief Construct a histogram with quantised gradient. The sum of each bin is exact, the
+ *        caller is responsible for choosing a bin type that doesn't overflow.
+ */
+template <bool any_missing>
+void BuildHist(Span<GradientPairInt16 const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix& gmat, Span<GradientPairInt32> hist, bool read_by_column);
+
+template <bool any_missing>
+void BuildHist(Span<GradientPairInt16 const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix& gmat, Span<GradientPairInt64> hist, bool read_by_column);
+
+template <bool any_missing>
+void BuildHist(Span<GradientPairInt32 const> gpair, Span<bst_idx_t const> row_indices,
+               const GHistIndexMatrix& gmat, Span<GradientPairInt64> hist, bool read_by_column);
 }  // namespace common
 }  // namespace xgboost
 #endif  // XGBOOST_COMMON_HIST_UTIL_H_
@@ -6,6 +6,7 @@
 #if defined(__linux__)
 
 #include <linux/mempolicy.h>  // for MPOL_BIND
+#include <sched.h>            // for sched_getaffinity, sched_setaffinity, CPU_SET
 #include <sys/syscall.h>      // for SYS_get_mempolicy
 #include <unistd.h>           // for syscall
 
@@ -211,6 +212,43 @@ void GetNumaHasCpuNodes(std::vector<std::int32_t> *p_nodes) {
 #endif  // defined(__linux__)
 }
 
+void GetThreadAffinity(std::vector<std::int32_t> *p_cpus) {
+  p_cpus->clear();
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  // pid 0 is the calling thread.
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+    return;
+  }
+  for (std::int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &mask)) {
+      p_cpus->push_back(cpu);
+    }
+  }
+#endif  // defined(__linux__)
+}
+
+[[nodiscard]] bool SetThreadAffinity(std::vector<std::int32_t> const &cpus) {
+#if defined(__linux__)
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (auto cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &mask);
+  }
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif  // defined(__linux__)
+}
+
 [[nodiscard]] bool GetCpuNuma(unsigned int* cpu, unsigned int* numa) {
 #ifdef SYS_getcpu
   return syscall(SYS_getcpu, cpu, numa, NULL) == 0;
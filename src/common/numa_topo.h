@@ -67,6 +67,22 @@ void GetNumaHasCpuNodes(std::vector<std::int32_t> *p_nodes);
  */
 [[nodiscard]] bool GetCpuNuma(unsigned int* cpu, unsigned int* numa);
 
+/**
+ * @brief Get the list of CPUs that the calling thread is allowed to run on.
+ *
+ *   Linux-Only. The list is empty if the call fails.
+ */
+void GetThreadAffinity(std::vector<std::int32_t> *p_cpus);
+
+/**
+ * @brief Restrict the calling thread to a list of CPUs.
+ *
+ *   Linux-Only.
+ *
+ * @return false if the call fails.
+ */
+[[nodiscard]] bool SetThreadAffinity(std::vector<std::int32_t> const &cpus);
+
 /**
  * @brief Is it physically possible to access the wrong memory?
  */
@@ -0,0 +1,26 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "simd.h"
+
+namespace xgboost::common {
+namespace {
+SimdIsa DetectSimdIsaImpl() {
+#if XGBOOST_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdIsa::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdIsa::kAvx2;
+  }
+#endif  // XGBOOST_SIMD_X86
+  return SimdIsa::kScalar;
+}
+}  // namespace
+
+[[nodiscard]] SimdIsa DetectSimdIsa() {
+  static SimdIsa const isa = DetectSimdIsaImpl();
+  return isa;
+}
+}  // namespace xgboost::common
@@ -0,0 +1,33 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Runtime dispatch for explicit SIMD kernels.
+ */
+#pragma once
+
+#include <cstdint>  // for int32_t
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define XGBOOST_SIMD_X86 1
+#define XGBOOST_TARGET_AVX2 __attribute__((target("avx2")))
+#define XGBOOST_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define XGBOOST_SIMD_X86 0
+#endif  // defined(__GNUC__) && defined(__x86_64__)
+
+namespace xgboost::common {
+/** @brief Instruction sets with specialized kernels, ordered by vector width. */
+enum class SimdIsa : std::int32_t {
+  kScalar = 0,
+  kAvx2 = 1,
+  kAvx512 = 2,
+};
+
+/**
+ * @brief Get the widest instruction set supported by the running CPU.
+ *
+ *   Only x86-64 with GCC-compatible compilers is detected, the result is @ref
+ *   SimdIsa::kScalar otherwise. The detection runs once and is cached.
+ */
+[[nodiscard]] SimdIsa DetectSimdIsa();
+}  // namespace xgboost::common
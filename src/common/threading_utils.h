@@ -11,6 +11,7 @@
 #include <cstddef>      // for size_t
 #include <cstdint>      // for int32_t
 #include <cstdlib>      // for malloc, free
+#include <mutex>        // for mutex, lock_guard
 #include <new>          // for bad_alloc
 #include <thread>       // for thread
 #include <type_traits>  // for is_signed, conditional_t, is_integral_v, invoke_result_t
@@ -158,6 +159,106 @@ void ParallelFor2d(const BlockedSpace2d& space, std::int32_t n_threads, Func&& f
   exc.Rethrow();
 }
 
+namespace detail {
+/**
+ * @brief The remaining blocks of a thread in @ref ParallelFor2dStealing .
+ *
+ *   The owner takes blocks from the front, thieves take the back half. Aligned to the cache
+ *   line to avoid false sharing between threads.
+ */
+struct alignas(64) StealingRange {
+  std::mutex mu;
+  std::size_t begin{0};
+  std::size_t end{0};
+
+  bool Pop(std::size_t* out) {
+    std::lock_guard guard{mu};
+    if (begin == end) {
+      return false;
+    }
+    *out = begin++;
+    return true;
+  }
+  // Move the back half of the remaining blocks into [begin, end), return false if empty.
+  bool Split(std::size_t* begin_out, std::size_t* end_out) {
+    std::lock_guard guard{mu};
+    if (begin == end) {
+      return false;
+    }
+    auto mid = end - DivRoundUp(end - begin, 2);
+    *begin_out = mid;
+    *end_out = end;
+    end = mid;
+    return true;
+  }
+  void Assign(std::size_t new_begin, std::size_t new_end) {
+    std::lock_guard guard{mu};
+    begin = new_begin;
+    end = new_end;
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Same as @ref ParallelFor2d , but threads that have finished their blocks steal the
+ *        remaining blocks from other threads.
+ *
+ *   Each thread starts with the same contiguous range of blocks as ParallelFor2d. Once the
+ *   range is exhausted, the thread takes the back half of the remaining blocks from the
+ *   next thread that still has work. The stolen range is split again if other threads run
+ *   out of work, so the size of a steal adapts to the work left. Blocks of skewed tree nodes
+ *   are thus balanced between threads while the static assignment is kept when the work is
+ *   even.
+ *
+ *   Each block is processed exactly once, but not necessarily by the thread it's assigned
+ *   to. Per-thread buffers used by the function must handle blocks from any node, see
+ *   @ref ParallelGHistBuilderImpl .
+ */
+template <typename Func>
+void ParallelFor2dStealing(BlockedSpace2d const& space, std::int32_t n_threads, Func&& func) {
+  static_assert(std::is_void_v<std::invoke_result_t<Func, std::size_t, Range1d>>);
+  std::size_t n_blocks_in_space = space.Size();
+  CHECK_GE(n_threads, 1);
+
+  std::size_t n_workers = n_threads;
+  std::vector<detail::StealingRange> ranges(n_workers);
+  std::size_t chunk_size = DivRoundUp(n_blocks_in_space, n_workers);
+  for (std::size_t tid = 0; tid < n_workers; ++tid) {
+    std::size_t begin = std::min(chunk_size * tid, n_blocks_in_space);
+    ranges[tid].begin = begin;
+    ranges[tid].end = std::min(begin + chunk_size, n_blocks_in_space);
+  }
+
+  dmlc::OMPException exc;
+#pragma omp parallel num_threads(n_threads)
+  {
+    exc.Run([&]() {
+      std::size_t tid = omp_get_thread_num();
+      auto& own = ranges[tid];
+      std::size_t i = 0;
+      while (true) {
+        while (own.Pop(&i)) {
+          func(space.GetFirstDimension(i), space.GetRange(i));
+        }
+        // Blocks are only moved between threads, never added. The remaining blocks of a
+        // thread that is still running are processed by itself if all steals fail.
+        bool stolen = false;
+        for (std::size_t k = 1; k < n_workers && !stolen; ++k) {
+          std::size_t begin = 0, end = 0;
+          stolen = ranges[(tid + k) % n_workers].Split(&begin, &end);
+          if (stolen) {
+            own.Assign(begin, end);
+          }
+        }
+        if (!stolen) {
+          break;
+        }
+      }
+    });
+  }
+  exc.Rethrow();
+}
+
 /**
  * OpenMP schedule
  */
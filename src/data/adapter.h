@@ -207,6 +207,7 @@ class ArrayAdapter : public detail::SingleBatchDataIter<ArrayAdapterBatch> {
   [[nodiscard]] ArrayAdapterBatch const& Value() const override { return batch_; }
   [[nodiscard]] std::size_t NumRows() const { return array_interface_.Shape<0>(); }
   [[nodiscard]] std::size_t NumColumns() const { return array_interface_.Shape<1>(); }
+  [[nodiscard]] ArrayInterface<2> const& Array() const { return array_interface_; }
 
  private:
   ArrayAdapterBatch batch_;
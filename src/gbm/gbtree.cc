@@ -10,10 +10,11 @@
 #include <dmlc/omp.h>
 #include <dmlc/parameter.h>
 
-#include <algorithm>  // for equal, any_of
+#include <algorithm>  // for equal, any_of, find_if
 #include <cstdint>    // for uint32_t
 #include <memory>
 #include <string>
+#include <tuple>  // for ignore
 #include <utility>
 #include <vector>
 
@@ -23,6 +24,11 @@
 #include "../common/threading_utils.h"
 #include "../common/timer.h"
 #include "../data/proxy_dmatrix.h"  // for DMatrixProxy, HostAdapterDispatch
+#include "../predictor/compact_forest.h"      // for CompactForest, CompactPredictor
+#include "../predictor/compiled_predictor.h"  // for CompiledModel, CompiledPredictor
+#include "../predictor/interpretability/shap.h"  // for ParseShapAlgorithm
+#include "../predictor/prediction_session.h"  // for PredictionSession
+#include "../predictor/simplify_forest.h"     // for SimplifyModel
 #include "gbtree_model.h"
 #include "xgboost/base.h"
 #include "xgboost/data.h"
@@ -70,6 +76,24 @@ std::string MapTreeMethodToUpdaters(Context const* ctx, TreeMethod tree_method)
   return "";
 }
 
+/** @brief Map the `predictor` parameter to the name of a registered CPU predictor. */
+std::string MapPredictorToCPUPredictor(std::string const& predictor) {
+  if (predictor == "quickscorer") {
+    return "cpu_quickscorer_predictor";
+  }
+  if (predictor == "quantized") {
+    return "cpu_quantized_predictor";
+  }
+  if (predictor == "numa") {
+    return "cpu_numa_predictor";
+  }
+  // `cpu_predictor` and `gpu_predictor` are from models saved before the `device` parameter
+  // was introduced.
+  CHECK(predictor == "auto" || predictor == "cpu_predictor" || predictor == "gpu_predictor")
+      << "Unknown predictor: `" << predictor << "`.";
+  return "cpu_predictor";
+}
+
 bool UpdatersMatched(std::vector<std::string> updater_seq,
                      std::vector<std::unique_ptr<TreeUpdater>> const& updaters) {
   if (updater_seq.size() != updaters.size()) {
@@ -108,6 +132,34 @@ std::set<std::string> GBTree::Configure(Args const& cfg) {
     this->tparam_.updater_seq = MapTreeMethodToUpdaters(ctx_, tparam_.tree_method);
   }
 
+  // Validate the predictor.
+  MapPredictorToCPUPredictor(tparam_.predictor);
+  std::ignore = interpretability::ParseShapAlgorithm(tparam_.shap_algorithm);
+  // Load the compiled model. The library is bound to the current process and is not part
+  // of the booster configuration.
+  auto it = std::find_if(cfg.cbegin(), cfg.cend(),
+                         [](auto const& arg) { return arg.first == "compiled_library"; });
+  if (it != cfg.cend()) {
+    if (it->second.empty()) {
+      compiled_.reset();
+    } else if (!compiled_ || compiled_->Path() != it->second) {
+      compiled_ = std::make_shared<predictor::CompiledModel>(it->second);
+    }
+    used.insert(it->first);
+  }
+  // Same for the compact model.
+  it = std::find_if(cfg.cbegin(), cfg.cend(),
+                    [](auto const& arg) { return arg.first == "compact_model"; });
+  if (it != cfg.cend()) {
+    if (it->second.empty()) {
+      compact_.reset();
+    } else if (compact_path_ != it->second) {
+      compact_ = predictor::LoadCompactModel(it->second);
+    }
+    compact_path_ = it->second;
+    used.insert(it->first);
+  }
+
   auto up_names = common::Split(tparam_.updater_seq, ',');
   if (!UpdatersMatched(up_names, updaters_)) {
     updaters_.clear();
@@ -126,6 +178,7 @@ std::set<std::string> GBTree::Configure(Args const& cfg) {
 
 void GBTreeModel::InitTreesToUpdate() {
   if (trees_to_update.empty()) {
+    this->InvalidateCache();
     for (auto& tree : trees) {
       trees_to_update.push_back(std::move(tree));
     }
@@ -182,6 +235,10 @@ void GPUDartPredictInc(common::Span<float>, common::Span<float>, float, size_t,
 
 void GBTree::DoBoost(std::shared_ptr<DMatrix> p_fmat, GradientContainer* in_gpair,
                      ObjFunction const*) {
+  // The compiled library and the compact model are for the trees before this iteration.
+  compiled_.reset();
+  compact_.reset();
+  compact_path_.clear();
   auto predt = prediction_cache_.Cache(p_fmat, ctx_->Device());
   if (model_.learner_model_state->IsVectorLeaf()) {
     CHECK(tparam_.tree_method == TreeMethod::kHist || tparam_.tree_method == TreeMethod::kAuto)
@@ -451,6 +508,9 @@ void GBTree::LoadModel(Json const& in) {
   CHECK(name == "gbtree" || name == "dart");
   auto const& model = name == "dart" ? in["gbtree"] : in;
   model_.LoadModel(model["model"]);
+  compiled_.reset();
+  compact_.reset();
+  compact_path_.clear();
   auto const& obj = get<Object const>(name == "dart" ? in : model);
   // Compatibility for older models that stored DART weights beside the tree model.
   auto it = obj.find("weight_drop");
@@ -614,10 +674,14 @@ void GBTree::Slice(bst_layer_t begin, bst_layer_t end, bst_layer_t step, Gradien
   std::partial_sum(out_indptr.cbegin(), out_indptr.cend(), out_indptr.begin());
   CHECK_EQ(out_model.iteration_indptr.front(), 0);
 
+  out_model.InvalidateCache();
   out_model.param.num_trees = out_model.trees.size();
   out_model.param.num_parallel_tree = model_.param.num_parallel_tree;
   out_model.Cats()->Copy(this->ctx_, *this->model_.Cats());
 
+  p_gbtree->compiled_.reset();
+  p_gbtree->compact_.reset();
+  p_gbtree->compact_path_.clear();
   p_gbtree->dparam_ = this->dparam_;
   p_gbtree->idx_drop_.clear();
   p_gbtree->model_.weight_drop.clear();
@@ -696,6 +760,58 @@ void GBTree::PredictBatch(std::shared_ptr<DMatrix> p_fmat, HostDeviceVector<floa
   out_preds->Copy(cache->predictions);
 }
 
+void GBTree::PredictEarlyExit(DMatrix* p_fmat, float threshold,
+                              HostDeviceVector<float>* out_preds,
+                              HostDeviceVector<bst_tree_t>* out_n_trees, bst_layer_t layer_begin,
+                              bst_layer_t layer_end) {
+  auto [tree_begin, tree_end] = detail::LayerToTree(model_, layer_begin, layer_end);
+  CHECK_LE(tree_end, model_.trees.size()) << "Invalid number of trees.";
+  // Early exit is a row-wise traversal, only available with the CPU predictor.
+  auto predictor = this->CreateCPUPredictor(false);
+  predictor->InitOutPredictions(p_fmat->Info(), out_preds, model_);
+  predictor->PredictEarlyExit(p_fmat, threshold, out_preds, out_n_trees, model_, tree_begin,
+                              tree_end);
+}
+
+void GBTree::PredictStaged(DMatrix* p_fmat, common::Span<bst_layer_t const> stages,
+                           HostDeviceVector<float>* out_preds) {
+  CHECK(!stages.empty()) << "Empty stages for staged prediction.";
+  auto n_layers = model_.BoostedRounds();
+  std::vector<bst_tree_t> tree_stages(stages.size());
+  for (std::size_t i = 0; i < stages.size(); ++i) {
+    CHECK(stages[i] > 0 && stages[i] <= n_layers)
+        << "Invalid stage: " << stages[i] << ", expecting a value in [1, " << n_layers << "].";
+    CHECK(i == 0 || stages[i] > stages[i - 1]) << "Stages must be strictly increasing.";
+    tree_stages[i] = detail::LayerToTree(model_, 0, stages[i]).second;
+  }
+  // Staged prediction is a single pass over the trees, only available with the CPU
+  // predictor.
+  auto predictor = this->CreateCPUPredictor(false);
+  predictor->InitOutPredictions(p_fmat->Info(), out_preds, model_);
+  predictor->PredictStaged(p_fmat, common::Span<bst_tree_t const>{tree_stages}, out_preds,
+                           model_);
+}
+
+void GBTree::PredictBatchMulti(DMatrix* p_fmat, common::Span<GradientBooster const* const> boosters,
+                               common::Span<HostDeviceVector<float>* const> out_preds) const {
+  CHECK_EQ(boosters.size(), out_preds.size());
+  CHECK(ctx_->IsCPU()) << "Multi-model prediction is only supported on CPU.";
+  std::vector<GBTreeModel const*> models;
+  for (auto const* booster : boosters) {
+    auto const* gbtree = dynamic_cast<GBTree const*>(booster);
+    CHECK(gbtree) << "Multi-model prediction only supports tree boosters.";
+    models.push_back(&gbtree->model_);
+  }
+  // The compiled and compact models of each booster are not used, the predictor shares
+  // the feature matrix between the tree traversals of all the models.
+  auto predictor = this->CreateCPUPredictor(false);
+  for (std::size_t i = 0; i < models.size(); ++i) {
+    predictor->InitOutPredictions(p_fmat->Info(), out_preds[i], *models[i]);
+  }
+  predictor->PredictBatchMulti(p_fmat, common::Span<GBTreeModel const* const>{models},
+                               out_preds);
+}
+
 void GBTree::InplacePredict(std::shared_ptr<DMatrix> p_m, float missing,
                             HostDeviceVector<float>* out_preds, bst_layer_t layer_begin,
                             bst_layer_t layer_end) const {
@@ -724,13 +840,58 @@ void GBTree::InplacePredict(std::shared_ptr<DMatrix> p_m, float missing,
   }
 }
 
+[[nodiscard]] predictor::PredictionSession* GBTree::CreatePredictionSession(
+    float missing, bst_layer_t layer_begin, bst_layer_t layer_end) const {
+  CHECK(ctx_->IsCPU()) << "Prediction session is only supported on CPU.";
+  auto [tree_begin, tree_end] = detail::LayerToTree(model_, layer_begin, layer_end);
+  CHECK_LE(tree_end, model_.trees.size()) << "Invalid number of trees.";
+  return new predictor::PredictionSession{model_, missing, tree_begin, tree_end};
+}
+
+void GBTree::Compile(Json const& config) {
+  auto path = predictor::CompileModel(this->model_, config);
+  compiled_ = std::make_shared<predictor::CompiledModel>(path);
+  CHECK(compiled_->Matches(this->model_));
+}
+
+void GBTree::Compact(Json const& config, Json* out_report) {
+  compact_ = predictor::CompactModel(this->model_, config);
+  compact_path_.clear();
+  *out_report = compact_->Report();
+}
+
+void GBTree::Simplify(Json const& config, Json* out_report) {
+  CHECK(!compiled_ && !compact_)
+      << "The model must be simplified before it's compiled or compacted.";
+  *out_report = predictor::SimplifyModel(&this->model_, config);
+  // Cached predictions are accumulated from the old trees.
+  for (auto const& kv : prediction_cache_.Container()) {
+    kv.second.value->Reset();
+  }
+}
+
+[[nodiscard]] std::unique_ptr<Predictor> GBTree::CreateCPUPredictor(bool is_training) const {
+  std::unique_ptr<Predictor> predictor{
+      Predictor::Create(MapPredictorToCPUPredictor(tparam_.predictor), ctx_)};
+  predictor->Configure(Args{{"shap_algorithm", tparam_.shap_algorithm}});
+  if (compiled_) {
+    predictor.reset(new predictor::CompiledPredictor{ctx_, compiled_, std::move(predictor)});
+  }
+  // Keep the full precision for the prediction cache during training.
+  if (compact_ && !is_training) {
+    predictor.reset(new predictor::CompactPredictor{ctx_, compact_, std::move(predictor)});
+  }
+  return predictor;
+}
+
 [[nodiscard]] std::unique_ptr<Predictor> GBTree::CreatePredictor(
     bool is_training, HostDeviceVector<float> const* out_pred, DMatrix* f_dmat) const {
+  auto cpu_predictor = [&] { return this->CreateCPUPredictor(is_training); };
   // Data comes from SparsePageDMatrix. Since we are loading data in pages, no need to
   // prevent data copy.
   if (f_dmat && !f_dmat->SingleColBlock()) {
     if (ctx_->IsCPU()) {
-      return std::unique_ptr<Predictor>{Predictor::Create("cpu_predictor", ctx_)};
+      return cpu_predictor();
     } else if (ctx_->IsCUDA()) {
       common::AssertGPUSupport();
       return std::unique_ptr<Predictor>{Predictor::Create("gpu_predictor", ctx_)};
@@ -766,11 +927,11 @@ void GBTree::InplacePredict(std::shared_ptr<DMatrix> p_m, float missing,
       // FIXME(trivialfis): Implement a better method for testing whether data
       // is on device after DMatrix refactoring is done.
       !on_device && is_training) {
-    return std::unique_ptr<Predictor>{Predictor::Create("cpu_predictor", ctx_)};
+    return cpu_predictor();
   }
 
   if (ctx_->IsCPU()) {
-    return std::unique_ptr<Predictor>{Predictor::Create("cpu_predictor", ctx_)};
+    return cpu_predictor();
   } else if (ctx_->IsCUDA()) {
     common::AssertGPUSupport();
     return std::unique_ptr<Predictor>{Predictor::Create("gpu_predictor", ctx_)};
@@ -781,7 +942,7 @@ void GBTree::InplacePredict(std::shared_ptr<DMatrix> p_m, float missing,
 #endif  // defined(XGBOOST_USE_SYCL)
   }
 
-  return std::unique_ptr<Predictor>{Predictor::Create("cpu_predictor", ctx_)};
+  return cpu_predictor();
 }
 
 // register the objective functions
@@ -54,6 +54,11 @@ DECLARE_FIELD_ENUM_CLASS(xgboost::TreeMethod);
 DECLARE_FIELD_ENUM_CLASS(xgboost::TreeProcessType);
 DECLARE_FIELD_ENUM_CLASS(xgboost::DartSampleType);
 
+namespace xgboost::predictor {
+class CompiledModel;
+class CompactForest;
+}  // namespace xgboost::predictor
+
 namespace xgboost::gbm {
 /*! \brief training parameters */
 struct GBTreeTrainParam : public XGBoostParameter<GBTreeTrainParam> {
@@ -63,6 +68,10 @@ struct GBTreeTrainParam : public XGBoostParameter<GBTreeTrainParam> {
   TreeProcessType process_type;
   // tree construction method
   TreeMethod tree_method;
+  /*! \brief inference algorithm used by the CPU predictor */
+  std::string predictor;
+  /*! \brief algorithm for the exact SHAP values on CPU */
+  std::string shap_algorithm;
   // declare parameters
   DMLC_DECLARE_PARAMETER(GBTreeTrainParam) {
     DMLC_DECLARE_FIELD(updater_seq).describe("Tree updater sequence.").set_default("");
@@ -81,6 +90,19 @@ struct GBTreeTrainParam : public XGBoostParameter<GBTreeTrainParam> {
         .add_enum("exact", TreeMethod::kExact)
         .add_enum("hist", TreeMethod::kHist)
         .describe("Choice of tree construction method.");
+    DMLC_DECLARE_FIELD(predictor)
+        .set_default("auto")
+        .describe(
+            "Inference algorithm for the CPU predictor, one of `auto`, `quickscorer`, "
+            "`quantized`, and `numa`. Models that are not supported by the selected algorithm "
+            "use the default tree traversal. `numa` keeps a copy of the model on each NUMA "
+            "node for batch prediction.");
+    DMLC_DECLARE_FIELD(shap_algorithm)
+        .set_default("quadrature")
+        .describe(
+            "Algorithm for the exact SHAP values on CPU, one of `quadrature` and `linear`. "
+            "`linear` is Linear TreeSHAP, which chooses the quadrature size from the depth of "
+            "each tree and is exact for deep trees.");
   }
 };
 
@@ -244,6 +266,14 @@ class GBTree : public GradientBooster {
                       HostDeviceVector<float>* out_preds, bst_layer_t layer_begin,
                       bst_layer_t layer_end) const override;
 
+  void Compile(Json const& config) override;
+
+  void Compact(Json const& config, Json* out_report) override;
+  void Simplify(Json const& config, Json* out_report) override;
+
+  [[nodiscard]] predictor::PredictionSession* CreatePredictionSession(
+      float missing, bst_layer_t layer_begin, bst_layer_t layer_end) const override;
+
   void FeatureScore(std::string const& importance_type, common::Span<int32_t const> trees,
                     std::vector<bst_feature_t>* features,
                     std::vector<float>* scores) const override {
@@ -337,6 +367,38 @@ class GBTree : public GradientBooster {
     predictor->PredictLeaf(p_fmat, out_preds, model_, tree_end);
   }
 
+  void PredictLeafCompact(DMatrix* p_fmat, HostDeviceVector<std::uint8_t>* out_leaf,
+                          std::int32_t* out_bytes, bst_layer_t layer_begin,
+                          bst_layer_t layer_end) override {
+    auto [tree_begin, tree_end] = detail::LayerToTree(model_, layer_begin, layer_end);
+    CHECK_EQ(tree_begin, 0) << "Predict leaf supports only iteration end: [0, "
+                               "n_iteration), use model slicing instead.";
+    auto predictor = this->CreatePredictor(false);
+    predictor->PredictLeafCompact(p_fmat, out_leaf, out_bytes, model_, tree_end);
+  }
+
+  void PredictLeafOneHot(DMatrix* p_fmat, HostDeviceVector<bst_idx_t>* out_indptr,
+                         HostDeviceVector<bst_feature_t>* out_indices,
+                         bst_feature_t* out_n_columns, bst_layer_t layer_begin,
+                         bst_layer_t layer_end) override {
+    auto [tree_begin, tree_end] = detail::LayerToTree(model_, layer_begin, layer_end);
+    CHECK_EQ(tree_begin, 0) << "Predict leaf supports only iteration end: [0, "
+                               "n_iteration), use model slicing instead.";
+    auto predictor = this->CreatePredictor(false);
+    predictor->PredictLeafOneHot(p_fmat, out_indptr, out_indices, out_n_columns, model_,
+                                 tree_end);
+  }
+
+  void PredictEarlyExit(DMatrix* p_fmat, float threshold, HostDeviceVector<float>* out_preds,
+                        HostDeviceVector<bst_tree_t>* out_n_trees, bst_layer_t layer_begin,
+                        bst_layer_t layer_end) override;
+
+  void PredictStaged(DMatrix* p_fmat, common::Span<bst_layer_t const> stages,
+                     HostDeviceVector<float>* out_preds) override;
+
+  void PredictBatchMulti(DMatrix* p_fmat, common::Span<GradientBooster const* const> boosters,
+                         common::Span<HostDeviceVector<float>* const> out_preds) const override;
+
   void PredictContribution(DMatrix* p_fmat, HostDeviceVector<float>* out_contribs,
                            bst_layer_t layer_begin, bst_layer_t layer_end,
                            bool approximate) override {
@@ -357,6 +419,30 @@ class GBTree : public GradientBooster {
     predictor->PredictInteractionContributions(p_fmat, out_contribs, model_, tree_end, approximate);
   }
 
+  void PredictContributionTopK(DMatrix* p_fmat, bst_feature_t top_k,
+                               HostDeviceVector<bst_idx_t>* out_indptr,
+                               HostDeviceVector<bst_feature_t>* out_indices,
+                               HostDeviceVector<float>* out_values, bst_layer_t layer_begin,
+                               bst_layer_t layer_end) override {
+    auto [tree_begin, tree_end] = detail::LayerToTree(model_, layer_begin, layer_end);
+    CHECK_EQ(tree_begin, 0) << "Predict contribution supports only iteration end: [0, "
+                               "n_iteration), using model slicing instead.";
+    auto predictor = this->CreatePredictor(false);
+    predictor->PredictContributionTopK(p_fmat, top_k, out_indptr, out_indices, out_values, model_,
+                                       tree_end);
+  }
+
+  void PredictContributionStream(DMatrix* p_fmat, bool interactions, bst_idx_t block_rows,
+                                 predictor::ContributionSink* sink, bst_layer_t layer_begin,
+                                 bst_layer_t layer_end) override {
+    auto [tree_begin, tree_end] = detail::LayerToTree(model_, layer_begin, layer_end);
+    CHECK_EQ(tree_begin, 0) << "Predict contribution supports only iteration end: [0, "
+                               "n_iteration), using model slicing instead.";
+    auto predictor = this->CreatePredictor(false);
+    predictor->PredictContributionStream(p_fmat, interactions, block_rows, sink, model_,
+                                         tree_end);
+  }
+
   [[nodiscard]] std::vector<std::string> DumpModel(const FeatureMap& fmap, bool with_stats,
                                                    std::string format) const override {
     return model_.DumpModel(fmap, with_stats, this->ctx_->Threads(), format);
@@ -375,6 +461,11 @@ class GBTree : public GradientBooster {
   [[nodiscard]] std::unique_ptr<Predictor> CreatePredictor(
       bool is_training, HostDeviceVector<float> const* out_pred = nullptr,
       DMatrix* f_dmat = nullptr) const;
+  /**
+   * @brief The configured CPU predictor, wrapped by the compiled and compact models when
+   *        they are loaded.
+   */
+  [[nodiscard]] std::unique_ptr<Predictor> CreateCPUPredictor(bool is_training) const;
 
   // commit new trees all at once
   virtual void CommitModel(TreesOneIter&& new_trees);
@@ -391,6 +482,11 @@ class GBTree : public GradientBooster {
   std::vector<std::unique_ptr<TreeUpdater>> updaters_;
   // indexes of dropped trees
   std::vector<size_t> idx_drop_;
+  // Shared library loaded from the `compiled_library` parameter, not serialized.
+  std::shared_ptr<predictor::CompiledModel const> compiled_;
+  // Compact model from the `compact_model` parameter or `Compact`, not serialized.
+  std::shared_ptr<predictor::CompactForest const> compact_;
+  std::string compact_path_;
   mutable PredictionContainer prediction_cache_;
   common::Monitor monitor_;
 };
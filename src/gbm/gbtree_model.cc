@@ -3,12 +3,17 @@
  */
 #include "gbtree_model.h"
 
-#include <algorithm>  // for transform, max_element
-#include <cstddef>    // for size_t
-#include <numeric>    // for partial_sum
-#include <utility>    // for move, pair
+#include <algorithm>    // for transform, max_element
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t, uint8_t
+#include <cstring>      // for memcpy
+#include <mutex>        // for lock_guard
+#include <numeric>      // for partial_sum
+#include <type_traits>  // for is_trivially_copyable_v
+#include <utility>      // for move, pair
 
 #include "../common/threading_utils.h"  // for ParallelFor
+#include "../tree/tree_view.h"          // for ScalarTreeView, MultiTargetTreeView
 #include "xgboost/context.h"            // for Context
 #include "xgboost/json.h"               // for Json, get, Integer, Array, FromJson, ToJson, Json...
 #include "xgboost/learner.h"            // for LearnerModelState
@@ -17,6 +22,52 @@
 
 namespace xgboost::gbm {
 namespace {
+// 64-bit FNV-1a hash for the model fingerprint.
+class ModelHash {
+  std::uint64_t h_{0xcbf29ce484222325ULL};
+
+ public:
+  template <typename T>
+  void Update(T const& v) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    std::uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &v, sizeof(T));
+    for (auto b : bytes) {
+      h_ = (h_ ^ b) * 0x100000001b3ULL;
+    }
+  }
+  [[nodiscard]] std::uint64_t Digest() const { return h_; }
+};
+
+template <typename TreeView>
+void HashTree(TreeView const& tree, ModelHash* p_hash) {
+  auto& hash = *p_hash;
+  hash.Update(tree.Size());
+  for (bst_node_t nidx = 0; nidx < tree.Size(); ++nidx) {
+    if (tree.IsLeaf(nidx)) {
+      if constexpr (tree::IsScalarTree<TreeView>()) {
+        hash.Update(tree.LeafValue(nidx));
+      } else {
+        auto leaf = tree.LeafValue(nidx);
+        for (std::size_t t = 0; t < leaf.Size(); ++t) {
+          hash.Update(leaf(t));
+        }
+      }
+      continue;
+    }
+    hash.Update(tree.SplitIndex(nidx));
+    hash.Update(tree.SplitCond(nidx));
+    hash.Update(tree.DefaultLeft(nidx));
+    hash.Update(tree.LeftChild(nidx));
+    hash.Update(tree.RightChild(nidx));
+    if (tree.HasCategoricalSplit() && tree.SplitType(nidx) == FeatureType::kCategorical) {
+      for (auto c : tree.NodeCats(nidx)) {
+        hash.Update(c);
+      }
+    }
+  }
+}
+
 // For creating the tree indptr from old models.
 void MakeIndptr(GBTreeModel* out_model) {
   auto const& tree_info = out_model->tree_info.ConstHostVector();
@@ -87,9 +138,38 @@ void GBTreeModel::SaveModel(Json* p_out) const {
   this->Cats()->Save(&out["cats"]);
 }
 
+std::uint64_t GBTreeModel::Fingerprint() const {
+  std::lock_guard guard{this->Mutex()};
+  if (!trees_hash_) {
+    ModelHash hash;
+    hash.Update(this->learner_model_state->num_feature);
+    hash.Update(this->learner_model_state->OutputLength());
+    hash.Update(this->trees.size());
+    auto const& tree_info = this->tree_info.ConstHostVector();
+    for (std::size_t i = 0; i < this->trees.size(); ++i) {
+      hash.Update(tree_info[i]);
+      auto const& tree = *this->trees[i];
+      if (tree.IsMultiTarget()) {
+        HashTree(tree.HostMtView(), &hash);
+      } else {
+        HashTree(tree.HostScView(), &hash);
+      }
+    }
+    trees_hash_ = hash.Digest();
+  }
+  // Tree weights can be changed without touching the trees, like in DART.
+  ModelHash hash;
+  hash.Update(*trees_hash_);
+  for (auto w : this->weight_drop) {
+    hash.Update(w);
+  }
+  return hash.Digest();
+}
+
 void GBTreeModel::LoadModel(Json const& in) {
   FromJson(in["gbtree_model_param"], &param);
 
+  this->InvalidateCache();
   trees.clear();
   trees_to_update.clear();
 
@@ -165,6 +245,7 @@ bst_tree_t GBTreeModel::CommitModel(TreesOneIter&& new_trees) {
 }
 
 void GBTreeModel::CommitModelGroup(TreesOneGroup&& new_trees, bst_target_t group_idx) {
+  this->InvalidateCache();
   auto& h_tree_info = this->tree_info.HostVector();
   for (auto& new_tree : new_trees) {
     trees.push_back(std::move(new_tree));
@@ -8,8 +8,10 @@
 
 #include <dmlc/parameter.h>
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -24,6 +26,15 @@ namespace xgboost {
 
 class Json;
 
+namespace interpretability {
+class ShapModelCache;
+}  // namespace interpretability
+
+namespace predictor {
+class NumaReplicatedModel;
+struct ForestLayoutCache;
+}  // namespace predictor
+
 namespace gbm {
 /**
  * @brief Container for all trees built (not update) for one group.
@@ -135,6 +146,39 @@ struct GBTreeModel : public Model {
    */
   common::Span<bst_target_t const> TreeGroups(DeviceOrd device) const;
   [[nodiscard]] std::mutex& Mutex() const { return tree_view_mu_; }
+  /**
+   * @brief Model data for SHAP that is shared between calls, guarded by @ref Mutex . The
+   *        cache is dropped whenever the trees are changed.
+   */
+  [[nodiscard]] std::shared_ptr<interpretability::ShapModelCache>& ShapCache() const {
+    return shap_cache_;
+  }
+  /**
+   * @brief Copies of the trees for each NUMA node, guarded by @ref Mutex . Dropped along
+   *        with the SHAP cache.
+   */
+  [[nodiscard]] std::shared_ptr<predictor::NumaReplicatedModel const>& NumaCache() const {
+    return numa_cache_;
+  }
+  /**
+   * @brief Alternative layouts of the forest built by the CPU predictor, guarded by @ref
+   *        Mutex . Dropped along with the SHAP cache.
+   */
+  [[nodiscard]] std::shared_ptr<predictor::ForestLayoutCache>& LayoutCache() const {
+    return layout_cache_;
+  }
+  /**
+   * @brief A hash of the trees and the tree weights. Used to check whether a model
+   *        converted from this one, like a compiled library, is still up to date. The
+   *        hash of the trees is cached until the trees are changed.
+   */
+  [[nodiscard]] std::uint64_t Fingerprint() const;
+  void InvalidateCache() {
+    shap_cache_.reset();
+    numa_cache_.reset();
+    layout_cache_.reset();
+    trees_hash_.reset();
+  }
 
  private:
   /**
@@ -142,6 +186,10 @@ struct GBTreeModel : public Model {
    */
   std::shared_ptr<CatContainer> cats_{std::make_shared<CatContainer>()};
   mutable std::mutex tree_view_mu_;
+  mutable std::shared_ptr<interpretability::ShapModelCache> shap_cache_;
+  mutable std::shared_ptr<predictor::NumaReplicatedModel const> numa_cache_;
+  mutable std::shared_ptr<predictor::ForestLayoutCache> layout_cache_;
+  mutable std::optional<std::uint64_t> trees_hash_;
   Context const* ctx_;
 };
 }  // namespace gbm
@@ -40,6 +40,7 @@
 #include "common/param_array.h"           // for ParamArray
 #include "common/timer.h"                 // for Monitor
 #include "common/version.h"               // for Version
+#include "predictor/async_prediction.h"   // for AsyncPredictor, AsyncPrediction
 #include "xgboost/base.h"                 // for Args, GradientPair, bst_feature_t
 #include "xgboost/context.h"              // for Context
 #include "xgboost/data.h"                 // for DMatrix, MetaInfo
@@ -955,6 +956,8 @@ class LearnerImpl : public LearnerIO {
  public:
   explicit LearnerImpl(std::vector<std::shared_ptr<DMatrix>> cache) : LearnerIO{cache} {}
   ~LearnerImpl() override {
+    // Finish the queued predictions before anything is released.
+    async_.reset();
     auto local_map = LearnerAPIThreadLocalStore::Get();
     if (local_map->find(this) != local_map->cend()) {
       local_map->erase(this);
@@ -969,6 +972,48 @@ class LearnerImpl : public LearnerIO {
     return gbm_->DumpModel(fmap, with_stats, format);
   }
 
+  void Compile(Json const& config) override {
+    this->Configure();
+    this->CheckModelInitialized();
+
+    gbm_->Compile(config);
+  }
+
+  void Compact(Json const& config, Json* out_report) override {
+    this->Configure();
+    this->CheckModelInitialized();
+
+    gbm_->Compact(config, out_report);
+  }
+
+  void Simplify(Json const& config, Json* out_report) override {
+    this->Configure();
+    this->CheckModelInitialized();
+
+    gbm_->Simplify(config, out_report);
+  }
+
+  predictor::PredictionSession* CreatePredictionSession(PredictionType type, float missing,
+                                                        bst_layer_t layer_begin,
+                                                        bst_layer_t layer_end) override {
+    this->Configure();
+    this->CheckModelInitialized();
+    CHECK(type == PredictionType::kValue || type == PredictionType::kMargin)
+        << "Prediction session only supports the `value` and the `margin` prediction types.";
+
+    std::unique_ptr<predictor::PredictionSession> session{
+        gbm_->CreatePredictionSession(missing, layer_begin, layer_end)};
+    if (type == PredictionType::kValue) {
+      // Use a copy of the objective that runs in the single-threaded context of the session.
+      Json objective_fn{Object{}};
+      obj_->SaveConfig(&objective_fn);
+      std::unique_ptr<ObjFunction> obj{ObjFunction::Create(tparam_.objective, session->Ctx())};
+      obj->LoadConfig(objective_fn);
+      session->SetTransform(std::move(obj));
+    }
+    return session.release();
+  }
+
   Learner* Slice(bst_layer_t begin, bst_layer_t end, bst_layer_t step,
                  bool* out_of_bound) override {
     this->Configure();
@@ -1155,6 +1200,111 @@ class LearnerImpl : public LearnerIO {
     }
   }
 
+  void PredictEarlyExit(std::shared_ptr<DMatrix> data, float threshold,
+                        HostDeviceVector<float>* out_preds,
+                        HostDeviceVector<bst_tree_t>* out_n_trees, bst_layer_t layer_begin,
+                        bst_layer_t layer_end) override {
+    this->Configure();
+    this->CheckModelInitialized();
+    this->ValidateDMatrix(data.get(), false);
+    gbm_->PredictEarlyExit(data.get(), threshold, out_preds, out_n_trees, layer_begin, layer_end);
+  }
+
+  void PredictStaged(std::shared_ptr<DMatrix> data, common::Span<bst_layer_t const> stages,
+                     HostDeviceVector<float>* out_preds) override {
+    this->Configure();
+    this->CheckModelInitialized();
+    this->ValidateDMatrix(data.get(), false);
+    gbm_->PredictStaged(data.get(), stages, out_preds);
+  }
+
+  void PredictMulti(std::shared_ptr<DMatrix> data, common::Span<Learner* const> learners,
+                    bool output_margin,
+                    common::Span<HostDeviceVector<float>* const> out_preds) override {
+    CHECK_EQ(learners.size(), out_preds.size());
+    this->Configure();
+    std::vector<LearnerImpl*> impls;
+    std::vector<GradientBooster const*> boosters;
+    for (auto* learner : learners) {
+      auto* impl = dynamic_cast<LearnerImpl*>(learner);
+      CHECK(impl);
+      impl->Configure();
+      impl->CheckModelInitialized();
+      impl->ValidateDMatrix(data.get(), false);
+      impls.push_back(impl);
+      boosters.push_back(impl->gbm_.get());
+    }
+    gbm_->PredictBatchMulti(data.get(), common::Span<GradientBooster const* const>{boosters},
+                            out_preds);
+    if (!output_margin) {
+      for (std::size_t i = 0; i < impls.size(); ++i) {
+        impls[i]->obj_->PredTransform(out_preds[i]);
+      }
+    }
+  }
+
+  void PredictLeafCompact(std::shared_ptr<DMatrix> data, HostDeviceVector<std::uint8_t>* out_leaf,
+                          std::int32_t* out_bytes, bst_layer_t layer_begin,
+                          bst_layer_t layer_end) override {
+    this->Configure();
+    this->CheckModelInitialized();
+    this->ValidateDMatrix(data.get(), false);
+    gbm_->PredictLeafCompact(data.get(), out_leaf, out_bytes, layer_begin, layer_end);
+  }
+
+  void PredictLeafOneHot(std::shared_ptr<DMatrix> data, HostDeviceVector<bst_idx_t>* out_indptr,
+                         HostDeviceVector<bst_feature_t>* out_indices,
+                         bst_feature_t* out_n_columns, bst_layer_t layer_begin,
+                         bst_layer_t layer_end) override {
+    this->Configure();
+    this->CheckModelInitialized();
+    this->ValidateDMatrix(data.get(), false);
+    gbm_->PredictLeafOneHot(data.get(), out_indptr, out_indices, out_n_columns, layer_begin,
+                            layer_end);
+  }
+
+  void PredictContributionTopK(std::shared_ptr<DMatrix> data, bst_feature_t top_k,
+                               HostDeviceVector<bst_idx_t>* out_indptr,
+                               HostDeviceVector<bst_feature_t>* out_indices,
+                               HostDeviceVector<float>* out_values, bst_layer_t layer_begin,
+                               bst_layer_t layer_end) override {
+    this->Configure();
+    this->CheckModelInitialized();
+    this->ValidateDMatrix(data.get(), false);
+    gbm_->PredictContributionTopK(data.get(), top_k, out_indptr, out_indices, out_values,
+                                  layer_begin, layer_end);
+  }
+
+  void PredictContributionStream(std::shared_ptr<DMatrix> data, bool interactions,
+                                 bst_idx_t block_rows, predictor::ContributionSink* sink,
+                                 bst_layer_t layer_begin, bst_layer_t layer_end) override {
+    this->Configure();
+    this->CheckModelInitialized();
+    this->ValidateDMatrix(data.get(), false);
+    gbm_->PredictContributionStream(data.get(), interactions, block_rows, sink, layer_begin,
+                                    layer_end);
+  }
+
+  std::shared_ptr<predictor::AsyncPrediction> PredictAsync(
+      std::shared_ptr<DMatrix> data, bool output_margin, bst_layer_t layer_begin,
+      bst_layer_t layer_end, bool pred_leaf, bool pred_contribs, bool approx_contribs,
+      bool pred_interactions, bool strict_shape) override {
+    // Report invalid parameters to the caller instead of the worker.
+    this->Configure();
+    this->CheckModelInitialized();
+    this->ValidateDMatrix(data.get(), false);
+    {
+      std::lock_guard<std::mutex> guard{async_lock_};
+      if (!async_) {
+        async_ = std::make_unique<predictor::AsyncPredictor>();
+      }
+    }
+    return async_->Submit([=](HostDeviceVector<float>* out_preds) {
+      this->Predict(data, output_margin, out_preds, layer_begin, layer_end, false, pred_leaf,
+                    pred_contribs, approx_contribs, pred_interactions, strict_shape);
+    });
+  }
+
   int32_t BoostedRounds() const override {
     if (!this->gbm_) {
       return 0;
@@ -1252,6 +1402,9 @@ class LearnerImpl : public LearnerIO {
   static int32_t constexpr kRandSeedMagic = 127;
   // gradient pairs
   GradientContainer gpair_;
+  // Worker for PredictAsync, created on the first call.
+  std::mutex async_lock_;
+  std::unique_ptr<predictor::AsyncPredictor> async_;
 };
 
 constexpr int32_t LearnerImpl::kRandSeedMagic;
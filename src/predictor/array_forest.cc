@@ -0,0 +1,158 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "array_forest.h"
+
+#include <algorithm>  // for fill_n
+#include <limits>     // for numeric_limits
+
+#include "../common/simd.h"             // for DetectSimdIsa
+#include "../common/threading_utils.h"  // for ParallelFor
+#include "array_tree_layout.h"          // for ArrayTreeNodes, TraverseArrayTree
+#include "xgboost/logging.h"            // for CHECK_EQ, CHECK
+
+namespace xgboost::predictor {
+namespace {
+/**
+ * @brief Copy the sub-tree rooted at `nidx` into the complete layout.
+ *
+ * @param level Level of the node.
+ * @param pos   Position of the node inside its level.
+ */
+void Flatten(tree::ScalarTreeView const& tree, bst_node_t nidx, std::int32_t level,
+             bst_node_t pos, std::int32_t depth, bst_feature_t* split_index, float* split_cond,
+             std::uint8_t* default_left, float* leaf_value) {
+  if (tree.IsLeaf(nidx)) {
+    // The padding nodes below always go right, which ends at the right most position of
+    // the sub-tree on the last level.
+    auto last = ((pos + 1) << (depth - level)) - 1;
+    leaf_value[last] = tree.LeafValue(nidx);
+    return;
+  }
+  auto node = (1 << level) - 1 + pos;
+  split_index[node] = tree.SplitIndex(nidx);
+  split_cond[node] = tree.SplitCond(nidx);
+  default_left[node] = tree.DefaultLeft(nidx);
+  Flatten(tree, tree.LeftChild(nidx), level + 1, 2 * pos, depth, split_index, split_cond,
+          default_left, leaf_value);
+  Flatten(tree, tree.RightChild(nidx), level + 1, 2 * pos + 1, depth, split_index, split_cond,
+          default_left, leaf_value);
+}
+
+template <bool any_missing, std::int32_t kDepth>
+void TraverseRows(detail::ArrayTreeNodes const& nodes, common::Span<RegTree::FVec> fvec_tloc,
+                  std::size_t begin, bst_node_t* out_pos) {
+  for (std::size_t i = begin; i < fvec_tloc.size(); ++i) {
+    auto const& feat = fvec_tloc[i];
+    bst_node_t pos = 0;
+    // The trip count is known at compile time, the loop is fully unrolled.
+    for (std::int32_t level = 0; level < kDepth; ++level) {
+      auto node = (1 << level) - 1 + pos;
+      auto split = nodes.split_index[node];
+      bool go_left;
+      if constexpr (any_missing) {
+        go_left = feat.IsMissing(split) ? nodes.default_left[node] != 0
+                                        : feat.GetFvalue(split) < nodes.split_cond[node];
+      } else {
+        go_left = feat.GetFvalue(split) < nodes.split_cond[node];
+      }
+      pos = 2 * pos + !go_left;
+    }
+    out_pos[i] = pos;
+  }
+}
+
+// Dispatch the runtime depth to the specialization of the traversal.
+template <bool any_missing, std::int32_t kDepth = 0>
+void DispatchDepth(detail::ArrayTreeNodes const& nodes, common::Span<RegTree::FVec> fvec_tloc,
+                   std::size_t begin, bst_node_t* out_pos) {
+  if constexpr (kDepth == ArrayForest::kMaxDepth) {
+    TraverseRows<any_missing, kDepth>(nodes, fvec_tloc, begin, out_pos);
+  } else {
+    if (nodes.n_levels == kDepth) {
+      TraverseRows<any_missing, kDepth>(nodes, fvec_tloc, begin, out_pos);
+    } else {
+      DispatchDepth<any_missing, kDepth + 1>(nodes, fvec_tloc, begin, out_pos);
+    }
+  }
+}
+}  // namespace
+
+[[nodiscard]] bool ArrayForest::IsSupported(tree::ScalarTreeView const& tree, bst_node_t depth) {
+  if (depth > kMaxDepth || tree.HasCategoricalSplit()) {
+    return false;
+  }
+  bool valid = true;
+  tree.WalkTree([&](bst_node_t nidx) {
+    if (!tree.IsLeaf(nidx) && tree.RightChild(nidx) == RegTree::kInvalidNodeId) {
+      valid = false;
+    }
+    return valid;
+  });
+  return valid;
+}
+
+ArrayForest::ArrayForest(common::Span<tree::ScalarTreeView const* const> trees,
+                         common::Span<std::int32_t const> depth, std::int32_t n_threads) {
+  CHECK_EQ(trees.size(), depth.size());
+  auto n_trees = trees.size();
+  split_ptr_.resize(n_trees + 1, 0);
+  leaf_ptr_.resize(n_trees + 1, 0);
+  depth_.resize(n_trees, -1);
+  for (std::size_t i = 0; i < n_trees; ++i) {
+    std::size_t n_leaves = 0;
+    if (trees[i]) {
+      CHECK_LE(depth[i], kMaxDepth);
+      depth_[i] = depth[i];
+      n_leaves = std::size_t{1} << depth[i];
+    }
+    split_ptr_[i + 1] = split_ptr_[i] + (n_leaves == 0 ? 0 : n_leaves - 1);
+    leaf_ptr_[i + 1] = leaf_ptr_[i] + n_leaves;
+  }
+
+  // Padding nodes have a NaN threshold, the comparison is always false.
+  split_index_.resize(split_ptr_.back(), 0);
+  split_cond_.resize(split_ptr_.back(), std::numeric_limits<float>::quiet_NaN());
+  default_left_.resize(split_ptr_.back() + sizeof(std::int32_t) - 1, 0);
+  leaf_value_.resize(leaf_ptr_.back(), 0.0f);
+  common::ParallelFor(n_trees, n_threads, [&](auto i) {
+    if (!trees[i]) {
+      return;
+    }
+    Flatten(*trees[i], RegTree::kRoot, 0, 0, depth_[i], split_index_.data() + split_ptr_[i],
+            split_cond_.data() + split_ptr_[i], default_left_.data() + split_ptr_[i],
+            leaf_value_.data() + leaf_ptr_[i]);
+  });
+}
+
+[[nodiscard]] std::size_t ArrayForest::MemCostBytes() const {
+  return split_index_.size() * sizeof(bst_feature_t) + split_cond_.size() * sizeof(float) +
+         default_left_.size() + leaf_value_.size() * sizeof(float) +
+         (split_ptr_.size() + leaf_ptr_.size()) * sizeof(std::size_t) +
+         depth_.size() * sizeof(std::int32_t);
+}
+
+void ArrayForest::Traverse(bst_tree_t tree_idx, common::Span<RegTree::FVec> fvec_tloc,
+                           bool any_missing, bst_node_t* out_pos) const {
+  CHECK(this->IsFlat(tree_idx));
+  auto offset = split_ptr_[tree_idx];
+  detail::ArrayTreeNodes nodes{split_index_.data() + offset, split_cond_.data() + offset,
+                               any_missing ? default_left_.data() + offset : nullptr,
+                               depth_[tree_idx]};
+  std::size_t n_simd_rows = 0;
+  if (nodes.n_levels > 0) {
+    // The SIMD kernels start from the current position.
+    std::fill_n(out_pos, fvec_tloc.size(), 0);
+    auto isa = common::DetectSimdIsa();
+    n_simd_rows = any_missing ? detail::TraverseArrayTree<true>(nodes, fvec_tloc,
+                                                                fvec_tloc.size(), out_pos, isa)
+                              : detail::TraverseArrayTree<false>(nodes, fvec_tloc,
+                                                                 fvec_tloc.size(), out_pos, isa);
+  }
+  if (any_missing) {
+    DispatchDepth<true>(nodes, fvec_tloc, n_simd_rows, out_pos);
+  } else {
+    DispatchDepth<false>(nodes, fvec_tloc, n_simd_rows, out_pos);
+  }
+}
+}  // namespace xgboost::predictor
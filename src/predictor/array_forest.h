@@ -0,0 +1,85 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Complete binary array layout for all levels of a forest.
+ */
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t, uint8_t
+#include <vector>   // for vector
+
+#include "../tree/tree_view.h"   // for ScalarTreeView
+#include "xgboost/base.h"        // for bst_feature_t, bst_node_t, bst_tree_t
+#include "xgboost/span.h"        // for Span
+#include "xgboost/tree_model.h"  // for RegTree
+
+namespace xgboost::predictor {
+/**
+ * @brief Trees flattened into complete binary trees in breadth-first order.
+ *
+ *   The @ref ArrayTreeLayout unrolls only the top levels of a tree, and it's rebuilt for
+ *   each block of rows. This class flattens all levels of a tree once. Leaves above the
+ *   last level are padded with split nodes that always go right, so each row takes
+ *   exactly `depth` steps and ends at a position on the last level. The leaf values are
+ *   inlined into an array indexed by that position.
+ *
+ *   Only scalar trees with numerical splits and depth up to @ref kMaxDepth can be
+ *   flattened. The other trees are marked as not flattened and should use the
+ *   node-by-node traversal.
+ */
+class ArrayForest {
+ public:
+  /** @brief The padded size grows exponentially, 12 levels take about 52KB. */
+  constexpr static bst_node_t kMaxDepth = 12;
+
+ private:
+  // Offset of each tree in the split arrays and in the leaf array.
+  std::vector<std::size_t> split_ptr_;
+  std::vector<std::size_t> leaf_ptr_;
+  // Depth of each tree, -1 if the tree is not flattened.
+  std::vector<std::int32_t> depth_;
+
+  std::vector<bst_feature_t> split_index_;
+  std::vector<float> split_cond_;
+  // Padded for the 32-bit gathers of the SIMD kernels.
+  std::vector<std::uint8_t> default_left_;
+  std::vector<float> leaf_value_;
+
+ public:
+  /**
+   * @brief Whether the tree can be flattened.
+   *
+   * @param tree  The tree.
+   * @param depth Maximum depth of the tree.
+   */
+  [[nodiscard]] static bool IsSupported(tree::ScalarTreeView const& tree, bst_node_t depth);
+  /**
+   * @param trees     Pointers to the trees to flatten, nullptr for trees that should be
+   *                  skipped. All non-null trees must pass the @ref IsSupported check.
+   * @param depth     Maximum depth of each tree.
+   * @param n_threads Number of threads used for filling the arrays.
+   */
+  ArrayForest(common::Span<tree::ScalarTreeView const* const> trees,
+              common::Span<std::int32_t const> depth, std::int32_t n_threads);
+
+  [[nodiscard]] bool IsFlat(bst_tree_t tree_idx) const { return depth_[tree_idx] >= 0; }
+  [[nodiscard]] std::int32_t Depth(bst_tree_t tree_idx) const { return depth_[tree_idx]; }
+  /** @brief Memory used by the forest in bytes. */
+  [[nodiscard]] std::size_t MemCostBytes() const;
+  /**
+   * @brief Traverse a flattened tree for a block of rows.
+   *
+   * @param tree_idx    Index of the tree.
+   * @param fvec_tloc   Feature vectors of the rows.
+   * @param any_missing Whether any of the rows has missing values.
+   * @param out_pos     Position of each row on the last level.
+   */
+  void Traverse(bst_tree_t tree_idx, common::Span<RegTree::FVec> fvec_tloc, bool any_missing,
+                bst_node_t* out_pos) const;
+  /** @brief Leaf value for a position returned by @ref Traverse . */
+  [[nodiscard]] float LeafValue(bst_tree_t tree_idx, bst_node_t pos) const {
+    return leaf_value_[leaf_ptr_[tree_idx] + pos];
+  }
+};
+}  // namespace xgboost::predictor
@@ -7,13 +7,162 @@
 #define XGBOOST_PREDICTOR_ARRAY_TREE_LAYOUT_H_
 
 #include <array>
+#include <cstdint>  // for int32_t, int64_t, uintptr_t, uint8_t
 #include <limits>
-#include <type_traits>  // for conditional_t
+#include <type_traits>  // for conditional_t, integral_constant
 
 #include "../common/categorical.h"            // for IsCat
+#include "../common/simd.h"                   // for SimdIsa, DetectSimdIsa
 #include "xgboost/tree_model.h"               // for RegTree
 
+#if XGBOOST_SIMD_X86
+#include <immintrin.h>
+#endif  // XGBOOST_SIMD_X86
+
 namespace xgboost::predictor {
+namespace detail {
+/**
+ * @brief Raw pointers to the numerical split nodes of an @ref ArrayTreeLayout .
+ */
+struct ArrayTreeNodes {
+  bst_feature_t const* split_index;
+  float const* split_cond;
+  // Padded for 32-bit gathers, nullptr if there's no missing value.
+  std::uint8_t const* default_left;
+  std::int32_t n_levels;
+};
+
+#if XGBOOST_SIMD_X86
+/**
+ * @brief Get the byte offsets of the feature vectors relative to the first one. Used to
+ *        gather feature values from rows in different allocations.
+ */
+template <std::size_t kLanes>
+void RowOffsets(float const* const* rows, std::int64_t* out) {
+  auto base = reinterpret_cast<std::uintptr_t>(rows[0]);
+  for (std::size_t i = 0; i < kLanes; ++i) {
+    out[i] = static_cast<std::int64_t>(reinterpret_cast<std::uintptr_t>(rows[i]) - base);
+  }
+}
+
+/**
+ * @brief Traverse the array tree for 8 rows in lockstep.
+ */
+template <bool any_missing>
+XGBOOST_TARGET_AVX2 void TraverseLanesAvx2(ArrayTreeNodes const& nodes, float const* const* rows,
+                                           bst_node_t* p_nidx) {
+  constexpr std::size_t kLanes = 8;
+  alignas(32) std::int64_t offsets[kLanes];
+  RowOffsets<kLanes>(rows, offsets);
+  __m256i const row_lo = _mm256_load_si256(reinterpret_cast<__m256i const*>(offsets));
+  __m256i const row_hi = _mm256_load_si256(reinterpret_cast<__m256i const*>(offsets + 4));
+  __m256i const one = _mm256_set1_epi32(1);
+
+  __m256i nidx = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p_nidx));
+  for (std::int32_t depth = 0; depth < nodes.n_levels; ++depth) {
+    __m256i node = _mm256_add_epi32(nidx, _mm256_set1_epi32((1 << depth) - 1));
+    __m256i split =
+        _mm256_i32gather_epi32(reinterpret_cast<int const*>(nodes.split_index), node, 4);
+    __m256 cond = _mm256_i32gather_ps(nodes.split_cond, node, 4);
+    // Gather the feature values with 64-bit byte offsets.
+    __m256i fidx_lo = _mm256_slli_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(split)), 2);
+    __m256i fidx_hi =
+        _mm256_slli_epi64(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(split, 1)), 2);
+    __m128 fvalue_lo = _mm256_i64gather_ps(rows[0], _mm256_add_epi64(row_lo, fidx_lo), 1);
+    __m128 fvalue_hi = _mm256_i64gather_ps(rows[0], _mm256_add_epi64(row_hi, fidx_hi), 1);
+    __m256 fvalue = _mm256_set_m128(fvalue_hi, fvalue_lo);
+    // Comparison with NaN is always false, padding nodes always go right.
+    __m256 go_left = _mm256_cmp_ps(fvalue, cond, _CMP_LT_OQ);
+    if constexpr (any_missing) {
+      __m256 is_missing = _mm256_cmp_ps(fvalue, fvalue, _CMP_UNORD_Q);
+      __m256i dft = _mm256_and_si256(
+          _mm256_i32gather_epi32(reinterpret_cast<int const*>(nodes.default_left), node, 1),
+          _mm256_set1_epi32(0xFF));
+      __m256 dft_left = _mm256_castsi256_ps(_mm256_cmpgt_epi32(dft, _mm256_setzero_si256()));
+      go_left = _mm256_blendv_ps(go_left, dft_left, is_missing);
+    }
+    // nidx = 2 * nidx + !go_left, where go_left is -1 for true.
+    nidx = _mm256_add_epi32(_mm256_add_epi32(nidx, nidx),
+                            _mm256_add_epi32(one, _mm256_castps_si256(go_left)));
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_nidx), nidx);
+}
+
+/**
+ * @brief Traverse the array tree for 16 rows in lockstep.
+ */
+template <bool any_missing>
+XGBOOST_TARGET_AVX512 void TraverseLanesAvx512(ArrayTreeNodes const& nodes,
+                                               float const* const* rows, bst_node_t* p_nidx) {
+  constexpr std::size_t kLanes = 16;
+  alignas(64) std::int64_t offsets[kLanes];
+  RowOffsets<kLanes>(rows, offsets);
+  __m512i const row_lo = _mm512_load_si512(offsets);
+  __m512i const row_hi = _mm512_load_si512(offsets + 8);
+  __m512i const one = _mm512_set1_epi32(1);
+
+  __m512i nidx = _mm512_loadu_si512(p_nidx);
+  for (std::int32_t depth = 0; depth < nodes.n_levels; ++depth) {
+    __m512i node = _mm512_add_epi32(nidx, _mm512_set1_epi32((1 << depth) - 1));
+    __m512i split = _mm512_i32gather_epi32(node, nodes.split_index, 4);
+    __m512 cond = _mm512_i32gather_ps(node, nodes.split_cond, 4);
+    __m512i fidx_lo = _mm512_slli_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(split)), 2);
+    __m512i fidx_hi =
+        _mm512_slli_epi64(_mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(split, 1)), 2);
+    __m256 fvalue_lo = _mm512_i64gather_ps(_mm512_add_epi64(row_lo, fidx_lo), rows[0], 1);
+    __m256 fvalue_hi = _mm512_i64gather_ps(_mm512_add_epi64(row_hi, fidx_hi), rows[0], 1);
+    __m512 fvalue = _mm512_castpd_ps(_mm512_insertf64x4(
+        _mm512_castps_pd(_mm512_castps256_ps512(fvalue_lo)), _mm256_castps_pd(fvalue_hi), 1));
+    __mmask16 go_left = _mm512_cmp_ps_mask(fvalue, cond, _CMP_LT_OQ);
+    if constexpr (any_missing) {
+      __mmask16 is_missing = _mm512_cmp_ps_mask(fvalue, fvalue, _CMP_UNORD_Q);
+      __m512i dft = _mm512_i32gather_epi32(node, nodes.default_left, 1);
+      __mmask16 dft_left = _mm512_test_epi32_mask(dft, _mm512_set1_epi32(0xFF));
+      go_left = (go_left & ~is_missing) | (dft_left & is_missing);
+    }
+    // nidx = 2 * nidx + 1 - go_left
+    nidx = _mm512_add_epi32(_mm512_add_epi32(nidx, nidx), one);
+    nidx = _mm512_mask_sub_epi32(nidx, go_left, nidx, one);
+  }
+  _mm512_storeu_si512(p_nidx, nidx);
+}
+#endif  // XGBOOST_SIMD_X86
+
+/**
+ * @brief Traverse the array tree with SIMD kernels, multiple rows at a time.
+ *
+ * @return The number of leading rows processed, the rest should be processed by the
+ *         scalar loop.
+ */
+template <bool any_missing>
+std::size_t TraverseArrayTree(ArrayTreeNodes const& nodes, common::Span<RegTree::FVec> fvec_tloc,
+                              std::size_t const block_size, bst_node_t* p_nidx,
+                              common::SimdIsa isa) {
+#if XGBOOST_SIMD_X86
+  auto launch = [&](auto lanes, auto kernel) {
+    constexpr std::size_t kLanes = decltype(lanes)::value;
+    std::size_t n_full = block_size / kLanes * kLanes;
+    std::array<float const*, kLanes> rows;
+    for (std::size_t beg = 0; beg < n_full; beg += kLanes) {
+      for (std::size_t i = 0; i < kLanes; ++i) {
+        rows[i] = fvec_tloc[beg + i].Data().data();
+      }
+      kernel(nodes, rows.data(), p_nidx + beg);
+    }
+    return n_full;
+  };
+  switch (isa) {
+    case common::SimdIsa::kAvx512:
+      return launch(std::integral_constant<std::size_t, 16>{}, TraverseLanesAvx512<any_missing>);
+    case common::SimdIsa::kAvx2:
+      return launch(std::integral_constant<std::size_t, 8>{}, TraverseLanesAvx2<any_missing>);
+    default:
+      break;
+  }
+#endif  // XGBOOST_SIMD_X86
+  return 0;
+}
+}  // namespace detail
 
 /**
  * @brief The class holds the array-based representation of the top levels of a single tree.
@@ -30,10 +179,14 @@ class ArrayTreeLayout {
   /* Number of nodes in the array based representation of the top levels of the tree
    */
   constexpr static size_t kNodesCount = (1u << kNumDeepLevels) - 1;
+  /* The SIMD kernels load the default direction with 32-bit gathers.
+   */
+  constexpr static size_t kGatherPadding = sizeof(std::int32_t) - 1;
 
   struct Empty {};
   using DefaultLeftType =
-      typename std::conditional_t<any_missing, std::array<uint8_t, kNodesCount>, Empty>;
+      typename std::conditional_t<any_missing,
+                                  std::array<uint8_t, kNodesCount + kGatherPadding>, Empty>;
   using IsCatType =
       typename std::conditional_t<has_categorical, std::array<uint8_t, kNodesCount>, Empty>;
   using CatSegmentType =
@@ -140,6 +293,7 @@ class ArrayTreeLayout {
   static_assert(kNumDeepLevels <= kMaxNumDeepLevels);
 
   ArrayTreeLayout(TreeView const& tree, RegTree::CategoricalSplitMatrix const &cats) {
+    if constexpr (any_missing) default_left_.fill(0);
     Populate(tree, cats);
   }
 
@@ -172,13 +326,23 @@ class ArrayTreeLayout {
    * @param p_nidx Pointer to the vector of node indexes in the original tree with size
    *               equals to the block size. (One node per sample). The value corresponds
    *               to the level next after kNumDeepLevels
+   * @param isa    Instruction set for the multi-row kernels. Categorical splits are always
+   *               processed by the scalar loop.
    */
   void Process(common::Span<RegTree::FVec> fvec_tloc, std::size_t const block_size,
-               bst_node_t* p_nidx) {
+               bst_node_t* p_nidx, common::SimdIsa isa = common::DetectSimdIsa()) {
+    std::size_t n_simd_rows = 0;
+    if constexpr (!has_categorical) {
+      detail::ArrayTreeNodes nodes{split_index_.data(), split_cond_.data(), nullptr,
+                                   kNumDeepLevels};
+      if constexpr (any_missing) nodes.default_left = default_left_.data();
+      n_simd_rows =
+          detail::TraverseArrayTree<any_missing>(nodes, fvec_tloc, block_size, p_nidx, isa);
+    }
     for (int depth = 0; depth < kNumDeepLevels; ++depth) {
       std::size_t first_node = (1u << depth) - 1;
 
-      for (std::size_t i = 0; i < block_size; ++i) {
+      for (std::size_t i = n_simd_rows; i < block_size; ++i) {
         bst_node_t idx = p_nidx[i];
 
         const auto& feat = fvec_tloc[i];
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "async_prediction.h"
+
+#include <exception>  // for exception
+#include <tuple>      // for ignore
+#include <utility>    // for move
+
+#include "xgboost/global_config.h"  // for GlobalConfigThreadLocalStore
+#include "xgboost/logging.h"        // for LOG
+#include "xgboost/string_view.h"    // for StringView
+
+namespace xgboost::predictor {
+namespace {
+bool IsFinished(AsyncStatus status) {
+  return status != AsyncStatus::kPending && status != AsyncStatus::kRunning;
+}
+}  // namespace
+
+void AsyncPrediction::SetStatus(AsyncStatus status) {
+  {
+    std::lock_guard guard{mu_};
+    status_ = status;
+  }
+  cv_.notify_all();
+}
+
+AsyncStatus AsyncPrediction::Status() const {
+  std::lock_guard guard{mu_};
+  return status_;
+}
+
+bool AsyncPrediction::Cancel() {
+  {
+    std::lock_guard guard{mu_};
+    if (status_ != AsyncStatus::kPending) {
+      return status_ == AsyncStatus::kCancelled;
+    }
+    status_ = AsyncStatus::kCancelled;
+  }
+  cv_.notify_all();
+  return true;
+}
+
+AsyncStatus AsyncPrediction::Wait() const {
+  std::unique_lock lock{mu_};
+  cv_.wait(lock, [this] { return IsFinished(status_); });
+  return status_;
+}
+
+AsyncStatus AsyncPrediction::WaitFor(std::chrono::milliseconds timeout) const {
+  std::unique_lock lock{mu_};
+  cv_.wait_for(lock, timeout, [this] { return IsFinished(status_); });
+  return status_;
+}
+
+HostDeviceVector<float> const& AsyncPrediction::Get() const {
+  auto status = this->Wait();
+  if (status == AsyncStatus::kCancelled) {
+    LOG(FATAL) << "The prediction is cancelled.";
+  }
+  if (status == AsyncStatus::kFailed) {
+    LOG(FATAL) << "The prediction failed: " << error_;
+  }
+  return predt_;
+}
+
+bool AsyncPrediction::Start() {
+  std::lock_guard guard{mu_};
+  if (status_ == AsyncStatus::kCancelled) {
+    return false;
+  }
+  status_ = AsyncStatus::kRunning;
+  return true;
+}
+
+void AsyncPrediction::Finish() { this->SetStatus(AsyncStatus::kDone); }
+
+void AsyncPrediction::Fail(std::string msg) {
+  {
+    std::lock_guard guard{mu_};
+    error_ = std::move(msg);
+    status_ = AsyncStatus::kFailed;
+  }
+  cv_.notify_all();
+}
+
+AsyncPredictor::AsyncPredictor() : pool_{StringView{"predict"}, 1, [] {}} {}
+
+std::shared_ptr<AsyncPrediction> AsyncPredictor::Submit(PredictFn fn) {
+  auto state = std::make_shared<AsyncPrediction>();
+  // The future is not used, the state is shared with the caller instead.
+  std::ignore = pool_.Submit(
+      [state, fn = std::move(fn), config = *GlobalConfigThreadLocalStore::Get()] {
+        if (!state->Start()) {
+          return;
+        }
+        *GlobalConfigThreadLocalStore::Get() = config;
+        // Exceptions must not escape the worker thread.
+        try {
+          fn(state->Output());
+          state->Finish();
+        } catch (std::exception const& e) {
+          state->Fail(e.what());
+        }
+      });
+  return state;
+}
+}  // namespace xgboost::predictor
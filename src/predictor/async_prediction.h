@@ -0,0 +1,91 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Prediction running in the background of a booster.
+ */
+#pragma once
+
+#include <chrono>              // for milliseconds
+#include <condition_variable>  // for condition_variable
+#include <cstdint>             // for int32_t
+#include <functional>          // for function
+#include <memory>              // for shared_ptr
+#include <mutex>               // for mutex
+#include <string>              // for string
+
+#include "../common/threadpool.h"        // for ThreadPool
+#include "xgboost/host_device_vector.h"  // for HostDeviceVector
+
+namespace xgboost::predictor {
+enum class AsyncStatus : std::int32_t {
+  kPending = 0,
+  kRunning = 1,
+  kDone = 2,
+  kCancelled = 3,
+  kFailed = 4,
+};
+
+/**
+ * @brief State of a prediction queued with @ref AsyncPredictor::Submit .
+ *
+ *   The state is shared by the caller and the worker, the caller can release it at any
+ *   time. All methods are thread-safe.
+ */
+class AsyncPrediction {
+  mutable std::mutex mu_;
+  mutable std::condition_variable cv_;
+  AsyncStatus status_{AsyncStatus::kPending};
+  std::string error_;
+  HostDeviceVector<float> predt_;
+
+  void SetStatus(AsyncStatus status);
+
+ public:
+  [[nodiscard]] AsyncStatus Status() const;
+  /**
+   * @brief Cancel the prediction if it hasn't started. A running prediction can't be
+   *        interrupted.
+   *
+   * @return Whether the prediction is cancelled.
+   */
+  bool Cancel();
+  /** @brief Block until the prediction is finished, failed, or cancelled. */
+  AsyncStatus Wait() const;
+  /** @brief Same as @ref Wait , but returns the current status after the timeout. */
+  AsyncStatus WaitFor(std::chrono::milliseconds timeout) const;
+  /**
+   * @brief Block until the prediction is finished and return the result. Throws if the
+   *        prediction failed or was cancelled.
+   */
+  [[nodiscard]] HostDeviceVector<float> const& Get() const;
+
+  /** @brief Called by the worker, returns false if the prediction is cancelled. */
+  [[nodiscard]] bool Start();
+  void Finish();
+  void Fail(std::string msg);
+  [[nodiscard]] HostDeviceVector<float>* Output() { return &predt_; }
+};
+
+/**
+ * @brief Background worker of a booster for running predictions without blocking the
+ *        caller.
+ *
+ *   Predictions run one at a time in submission order, each uses the threads configured
+ *   for the booster. Destroying the worker waits for all the queued predictions.
+ */
+class AsyncPredictor {
+  common::ThreadPool pool_;
+
+ public:
+  using PredictFn = std::function<void(HostDeviceVector<float>*)>;
+
+  AsyncPredictor();
+  /**
+   * @brief Queue a prediction. The global configuration of the calling thread is used by
+   *        the worker.
+   *
+   * @param fn Function writing the prediction into its argument.
+   */
+  [[nodiscard]] std::shared_ptr<AsyncPrediction> Submit(PredictFn fn);
+};
+}  // namespace xgboost::predictor
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "block_tiling.h"
+
+#include <algorithm>  // for max, clamp
+
+#include "../common/cache_manager.h"  // for CacheManager
+#include "../common/common.h"         // for DivRoundUp
+
+namespace xgboost::predictor {
+[[nodiscard]] BlockTiling ChooseBlockTiling(std::int64_t l2_size, std::int64_t l3_size,
+                                            std::int32_t n_threads, std::size_t model_bytes,
+                                            bst_tree_t n_trees, bst_feature_t n_features,
+                                            bst_idx_t n_samples, std::size_t block_rows) {
+  // Upper bound of the tile size, in number of row blocks.
+  constexpr std::size_t kMaxBlocksPerTile = 16;
+
+  BlockTiling untiled{block_rows, std::max(n_trees, static_cast<bst_tree_t>(1))};
+  if (n_trees <= 1 || block_rows <= 1) {
+    return untiled;
+  }
+  // Same budget as the histogram building: L2 plus the share of L3 for each thread, minus
+  // some headroom for the output and the stack.
+  auto l3_per_thread = static_cast<double>(l3_size) / std::max(n_threads, 1);
+  auto budget = static_cast<std::size_t>(0.8 * (static_cast<double>(l2_size) + l3_per_thread));
+  if (model_bytes <= budget / 2) {
+    return untiled;
+  }
+
+  // Half of the budget for the feature vectors.
+  std::size_t row_bytes = std::max(n_features, static_cast<bst_feature_t>(1)) * sizeof(float);
+  std::size_t n_blocks = budget / 2 / (row_bytes * block_rows);
+  // Keep at least one tile for each thread.
+  std::size_t rows_per_thread = common::DivRoundUp(n_samples, std::max(n_threads, 1));
+  std::size_t max_blocks = common::DivRoundUp(rows_per_thread, block_rows);
+  max_blocks = std::clamp(max_blocks, std::size_t{1}, kMaxBlocksPerTile);
+  n_blocks = std::clamp(n_blocks, std::size_t{1}, max_blocks);
+  auto tile_rows = n_blocks * block_rows;
+
+  // The remaining budget for the trees.
+  auto tile_bytes = tile_rows * row_bytes;
+  auto tree_budget = budget > tile_bytes ? budget - tile_bytes : 0;
+  auto tree_bytes = std::max(model_bytes / static_cast<std::size_t>(n_trees), std::size_t{1});
+  auto chunk_trees = static_cast<bst_tree_t>(
+      std::clamp(tree_budget / tree_bytes, std::size_t{1}, static_cast<std::size_t>(n_trees)));
+  return {tile_rows, chunk_trees};
+}
+
+[[nodiscard]] BlockTiling ChooseBlockTiling(common::CacheManager const& cache,
+                                            std::int32_t n_threads, std::size_t model_bytes,
+                                            bst_tree_t n_trees, bst_feature_t n_features,
+                                            bst_idx_t n_samples, std::size_t block_rows) {
+  return ChooseBlockTiling(cache.L2Size(), cache.L3Size(), n_threads, model_bytes, n_trees,
+                           n_features, n_samples, block_rows);
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Choose the row and tree tiling of the CPU block kernel from the cache sizes.
+ */
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t, int64_t
+
+#include "xgboost/base.h"  // for bst_feature_t, bst_idx_t, bst_tree_t
+
+namespace xgboost::common {
+class CacheManager;
+}  // namespace xgboost::common
+
+namespace xgboost::predictor {
+/**
+ * @brief Tiling for the block-based traversal.
+ *
+ *   The feature vectors of `tile_rows` rows are filled at once. Trees are then evaluated in
+ *   chunks of `chunk_trees`, each chunk running over all the row blocks of the tile before
+ *   moving to the next chunk. The accumulation order for each row is the same as running all
+ *   the trees at once, only the loop nest is changed.
+ */
+struct BlockTiling {
+  // Number of rows in a tile, a multiple of the row block size.
+  std::size_t tile_rows;
+  // Number of trees in a chunk.
+  bst_tree_t chunk_trees;
+};
+
+/**
+ * @brief Choose the tiling with the model size and the per-thread cache budget.
+ *
+ *   When the model fits in half of the cache budget, it stays resident while the trees run
+ *   over a single row block, and the returned tiling is the untiled loop. Otherwise, half
+ *   of the budget is given to the feature vectors of a tile and the remaining to a chunk of
+ *   trees, so that neither is evicted while the tile is being processed.
+ *
+ * @param l2_size     Size of the L2 cache in bytes.
+ * @param l3_size     Size of the shared L3 cache in bytes, 0 if there's none.
+ * @param n_threads   Number of threads sharing the L3 cache.
+ * @param model_bytes Estimated memory footprint of the trees.
+ * @param n_trees     Number of trees.
+ * @param n_features  Number of features, determines the size of a feature vector.
+ * @param n_samples   Number of rows in the batch, tiles are capped to keep all threads busy.
+ * @param block_rows  Size of the row block used by the traversal.
+ */
+[[nodiscard]] BlockTiling ChooseBlockTiling(std::int64_t l2_size, std::int64_t l3_size,
+                                            std::int32_t n_threads, std::size_t model_bytes,
+                                            bst_tree_t n_trees, bst_feature_t n_features,
+                                            bst_idx_t n_samples, std::size_t block_rows);
+
+/** @brief Overload that uses the detected cache sizes. */
+[[nodiscard]] BlockTiling ChooseBlockTiling(common::CacheManager const& cache,
+                                            std::int32_t n_threads, std::size_t model_bytes,
+                                            bst_tree_t n_trees, bst_feature_t n_features,
+                                            bst_idx_t n_samples, std::size_t block_rows);
+}  // namespace xgboost::predictor
@@ -0,0 +1,462 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "compact_forest.h"
+
+#include <dmlc/io.h>  // for Stream
+
+#include <algorithm>  // for sort, unique, lower_bound, max
+#include <cmath>      // for isnan, nearbyint, abs
+#include <cstring>    // for memcpy
+#include <limits>     // for numeric_limits
+#include <queue>      // for queue
+
+#include "../common/error_msg.h"        // for InplacePredictProxy
+#include "../common/json_utils.h"       // for OptionalArg
+#include "../common/threading_utils.h"  // for ParallelFor1d
+#include "../data/gradient_index.h"     // for GHistIndexMatrix
+#include "../data/proxy_dmatrix.h"      // for DMatrixProxy, DispatchAny
+#include "../gbm/gbtree_model.h"        // for GBTreeModel
+#include "data_accessor.h"              // for SparsePageView, GHistIndexMatrixView, AdapterView
+#include "utils.h"                      // for CheckProxyDMatrix
+#include "xgboost/data.h"               // for DMatrix, SparsePage
+#include "xgboost/learner.h"            // for LearnerModelState
+#include "xgboost/logging.h"            // for CHECK, LOG
+
+namespace xgboost::predictor {
+namespace {
+// Largest finite fp16 value.
+constexpr float kHalfMax = 65504.0f;
+
+std::uint32_t FloatBits(float v) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(v));
+  return bits;
+}
+
+float BitsToFloat(std::uint32_t bits) {
+  float v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+// Convert to IEEE half precision, rounding to the nearest even.
+std::uint16_t FloatToHalf(float v) {
+  std::uint16_t sign = (FloatBits(v) >> 16) & 0x8000;
+  float a = std::abs(v);
+  if (std::isnan(a)) {
+    return sign | 0x7e00;
+  }
+  // Values greater than or equal to 65520 round to infinity.
+  if (a >= 65520.0f) {
+    return sign | 0x7c00;
+  }
+  // Subnormal, in units of the smallest subnormal 2^-24.
+  if (a < 0x1p-14f) {
+    return sign | static_cast<std::uint16_t>(std::nearbyint(a * 0x1p24f));
+  }
+  auto bits = FloatBits(a);
+  bits += 0xfff + ((bits >> 13) & 1);
+  return sign | static_cast<std::uint16_t>((bits - ((127 - 15) << 23)) >> 13);
+}
+
+float HalfToFloat(std::uint16_t h) {
+  std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000) << 16;
+  std::uint32_t em = h & 0x7fff;
+  if (em >= 0x7c00) {
+    // Infinity and NaN.
+    return BitsToFloat(sign | 0x7f800000 | ((em & 0x3ff) << 13));
+  }
+  // Re-bias the exponent by multiplying with 2^112, also handles the subnormals.
+  return BitsToFloat(sign | FloatBits(BitsToFloat(em << 13) * 0x1p112f));
+}
+
+std::uint16_t FloatToBf16(float v) {
+  auto bits = FloatBits(v);
+  if (std::isnan(v)) {
+    return static_cast<std::uint16_t>((bits >> 16) | 0x40);
+  }
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return static_cast<std::uint16_t>(bits >> 16);
+}
+
+float Bf16ToFloat(std::uint16_t v) { return BitsToFloat(static_cast<std::uint32_t>(v) << 16); }
+
+constexpr char const* kMagic = "xgboost-compact-forest";
+constexpr std::int32_t kFormatVersion = 1;
+}  // namespace
+
+[[nodiscard]] CompactPrecision ParseCompactPrecision(std::string const& name) {
+  if (name == "fp16") {
+    return CompactPrecision::kFp16;
+  } else if (name == "bf16") {
+    return CompactPrecision::kBf16;
+  } else if (name == "quantized") {
+    return CompactPrecision::kQuantized;
+  }
+  LOG(FATAL) << "Unknown precision for the compact model: `" << name
+             << "`, expecting one of `fp16`, `bf16`, and `quantized`.";
+  return CompactPrecision::kFp16;
+}
+
+[[nodiscard]] bool CompactForest::IsSupported(tree::ScalarTreeView const& tree,
+                                              bst_feature_t n_features) {
+  if (tree.HasCategoricalSplit() || n_features >= (1U << 15)) {
+    return false;
+  }
+  bool valid = true;
+  tree.WalkTree([&](bst_node_t nidx) {
+    if (!tree.IsLeaf(nidx) && tree.RightChild(nidx) == RegTree::kInvalidNodeId) {
+      valid = false;
+    }
+    return valid;
+  });
+  return valid;
+}
+
+[[nodiscard]] std::unique_ptr<CompactForest> CompactForest::Create(
+    common::Span<tree::ScalarTreeView const> trees, common::Span<bst_target_t const> tree_groups,
+    bst_feature_t n_features, bst_target_t n_groups, common::OptionalWeights tree_weights,
+    CompactPrecision precision) {
+  CHECK_EQ(trees.size(), tree_groups.size());
+  std::unique_ptr<CompactForest> forest{new CompactForest{}};
+  forest->precision_ = precision;
+  forest->n_features_ = n_features;
+  forest->n_groups_ = n_groups;
+  forest->tree_groups_.assign(tree_groups.cbegin(), tree_groups.cend());
+
+  if (precision == CompactPrecision::kQuantized) {
+    // Collect the distinct thresholds of each feature.
+    std::vector<std::vector<float>> thresholds(n_features);
+    for (auto const& tree : trees) {
+      tree.WalkTree([&](bst_node_t nidx) {
+        if (!tree.IsLeaf(nidx)) {
+          CHECK_LT(tree.SplitIndex(nidx), n_features);
+          thresholds[tree.SplitIndex(nidx)].push_back(tree.SplitCond(nidx));
+        }
+        return true;
+      });
+    }
+    forest->cut_ptr_.resize(n_features + 1, 0);
+    for (bst_feature_t fidx = 0; fidx < n_features; ++fidx) {
+      auto& cuts = thresholds[fidx];
+      std::sort(cuts.begin(), cuts.end());
+      cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+      if (cuts.size() > std::numeric_limits<std::uint16_t>::max()) {
+        return nullptr;
+      }
+      forest->cut_values_.insert(forest->cut_values_.end(), cuts.cbegin(), cuts.cend());
+      forest->cut_ptr_[fidx + 1] = forest->cut_values_.size();
+    }
+  }
+
+  double max_leaf_error = 0.0, max_threshold_error = 0.0;
+  std::vector<double> margin_error(n_groups, 0.0);
+  std::int64_t n_rounded_thresholds = 0;
+  std::size_t full_bytes = 0;
+
+  forest->tree_ptr_.push_back(0);
+  for (std::size_t tree_idx = 0; tree_idx < trees.size(); ++tree_idx) {
+    auto const& tree = trees[tree_idx];
+    auto weight = tree_weights[tree_idx];
+    auto tree_beg = forest->nodes_.size();
+    double tree_leaf_error = 0.0;
+    full_bytes += static_cast<std::size_t>(tree.Size()) * sizeof(RegTree::Node);
+    // (node index in the tree, node index in the forest)
+    std::queue<std::pair<bst_node_t, std::size_t>> queue;
+    forest->nodes_.emplace_back();
+    queue.emplace(RegTree::kRoot, tree_beg);
+    while (!queue.empty()) {
+      auto [nidx, new_nidx] = queue.front();
+      queue.pop();
+      if (tree.IsLeaf(nidx)) {
+        float value = tree.LeafValue(nidx) * weight;
+        if (std::abs(value) > kHalfMax) {
+          return nullptr;
+        }
+        auto encoded = FloatToHalf(value);
+        tree_leaf_error = std::max(
+            tree_leaf_error, std::abs(static_cast<double>(HalfToFloat(encoded)) - value));
+        forest->nodes_[new_nidx] = Node{RegTree::kInvalidNodeId, 0, encoded};
+        continue;
+      }
+
+      auto fidx = tree.SplitIndex(nidx);
+      auto cond = tree.SplitCond(nidx);
+      std::uint16_t encoded = 0;
+      float decoded = cond;
+      switch (precision) {
+        case CompactPrecision::kFp16: {
+          // Larger thresholds would be rounded to infinity.
+          if (std::abs(cond) > kHalfMax) {
+            return nullptr;
+          }
+          encoded = FloatToHalf(cond);
+          decoded = HalfToFloat(encoded);
+          break;
+        }
+        case CompactPrecision::kBf16: {
+          encoded = FloatToBf16(cond);
+          decoded = Bf16ToFloat(encoded);
+          break;
+        }
+        case CompactPrecision::kQuantized: {
+          auto beg = forest->cut_values_.cbegin() + forest->cut_ptr_[fidx];
+          auto end = forest->cut_values_.cbegin() + forest->cut_ptr_[fidx + 1];
+          encoded = static_cast<std::uint16_t>(std::lower_bound(beg, end, cond) - beg);
+          break;
+        }
+      }
+      if (decoded != cond) {
+        ++n_rounded_thresholds;
+        auto error = std::abs(static_cast<double>(decoded) - cond) /
+                     std::max(std::abs(static_cast<double>(cond)),
+                              static_cast<double>(std::numeric_limits<float>::min()));
+        max_threshold_error = std::max(max_threshold_error, error);
+      }
+
+      auto left = forest->nodes_.size();
+      auto sindex = static_cast<std::uint16_t>(
+          fidx | (static_cast<std::uint32_t>(tree.DefaultLeft(nidx)) << 15));
+      forest->nodes_[new_nidx] = Node{static_cast<std::int32_t>(left - tree_beg), sindex, encoded};
+      forest->nodes_.resize(left + 2);
+      queue.emplace(tree.LeftChild(nidx), left);
+      queue.emplace(tree.RightChild(nidx), left + 1);
+    }
+    forest->tree_ptr_.push_back(forest->nodes_.size());
+    max_leaf_error = std::max(max_leaf_error, tree_leaf_error);
+    margin_error[tree_groups[tree_idx]] += tree_leaf_error;
+  }
+
+  auto& report = forest->report_;
+  report["max_leaf_error"] = Number{max_leaf_error};
+  report["max_margin_error"] =
+      Number{margin_error.empty() ? 0.0 : *std::max_element(margin_error.cbegin(),
+                                                            margin_error.cend())};
+  report["max_threshold_error"] = Number{max_threshold_error};
+  report["n_rounded_thresholds"] = Integer{n_rounded_thresholds};
+  report["n_nodes"] = Integer{static_cast<Integer::Int>(forest->nodes_.size())};
+  report["bytes"] = Integer{static_cast<Integer::Int>(forest->MemCostBytes())};
+  report["full_bytes"] = Integer{static_cast<Integer::Int>(full_bytes)};
+  return forest;
+}
+
+[[nodiscard]] std::unique_ptr<CompactForest> CompactForest::Create(gbm::GBTreeModel const& model,
+                                                                   CompactPrecision precision) {
+  auto n_features = model.learner_model_state->num_feature;
+  std::vector<tree::ScalarTreeView> trees;
+  for (auto const& p_tree : model.trees) {
+    CHECK(!p_tree->IsMultiTarget()) << "Compact model doesn't support vector-leaf trees.";
+    trees.emplace_back(p_tree.get());
+    CHECK(IsSupported(trees.back(), n_features))
+        << "Compact model only supports numerical splits with less than 32768 features.";
+  }
+  auto const* weights = model.TreeWeights();
+  auto tree_weights = weights == nullptr
+                          ? common::OptionalWeights{1.0f}
+                          : common::OptionalWeights{common::Span<float const>{*weights}};
+  auto forest = Create(common::Span{trees}, model.TreeGroups(DeviceOrd::CPU()), n_features,
+                       model.learner_model_state->OutputLength(), tree_weights, precision);
+  CHECK(forest) << "The model can't be compacted. Leaf values must be representable by fp16, "
+                   "split thresholds must be within the fp16 range for the fp16 precision, "
+                   "and each feature can have at most 65535 distinct split thresholds for the "
+                   "quantized precision.";
+  forest->fingerprint_ = model.Fingerprint();
+  return forest;
+}
+
+void CompactForest::Save(dmlc::Stream* fo) const {
+  fo->Write(std::string{kMagic});
+  fo->Write(kFormatVersion);
+  fo->Write(static_cast<std::int32_t>(precision_));
+  fo->Write(fingerprint_);
+  fo->Write(n_features_);
+  fo->Write(n_groups_);
+  fo->Write(nodes_);
+  fo->Write(tree_ptr_);
+  fo->Write(tree_groups_);
+  fo->Write(cut_ptr_);
+  fo->Write(cut_values_);
+  std::string report;
+  Json::Dump(report_, &report);
+  fo->Write(report);
+}
+
+[[nodiscard]] std::unique_ptr<CompactForest> CompactForest::Load(dmlc::Stream* fi) {
+  std::unique_ptr<CompactForest> forest{new CompactForest{}};
+  std::string magic;
+  CHECK(fi->Read(&magic) && magic == std::string{kMagic})
+      << "Invalid compact model.";
+  std::int32_t version{0}, precision{0};
+  CHECK(fi->Read(&version));
+  CHECK_EQ(version, kFormatVersion) << "Unsupported version of the compact model.";
+  CHECK(fi->Read(&precision));
+  CHECK(precision >= static_cast<std::int32_t>(CompactPrecision::kFp16) &&
+        precision <= static_cast<std::int32_t>(CompactPrecision::kQuantized));
+  forest->precision_ = static_cast<CompactPrecision>(precision);
+  std::string report;
+  CHECK(fi->Read(&forest->fingerprint_) && fi->Read(&forest->n_features_) &&
+        fi->Read(&forest->n_groups_) && fi->Read(&forest->nodes_) &&
+        fi->Read(&forest->tree_ptr_) && fi->Read(&forest->tree_groups_) &&
+        fi->Read(&forest->cut_ptr_) && fi->Read(&forest->cut_values_) && fi->Read(&report))
+      << "Invalid compact model.";
+  CHECK_EQ(forest->tree_ptr_.size(), forest->tree_groups_.size() + 1);
+  forest->report_ = Json::Load(StringView{report});
+  return forest;
+}
+
+[[nodiscard]] std::size_t CompactForest::MemCostBytes() const {
+  return nodes_.size() * sizeof(Node) + tree_ptr_.size() * sizeof(std::size_t) +
+         tree_groups_.size() * sizeof(bst_target_t) + cut_ptr_.size() * sizeof(std::size_t) +
+         cut_values_.size() * sizeof(float);
+}
+
+[[nodiscard]] bool CompactForest::Matches(gbm::GBTreeModel const& model) const {
+  return static_cast<bst_tree_t>(model.trees.size()) == this->NumTrees() &&
+         model.learner_model_state->num_feature == this->n_features_ &&
+         model.learner_model_state->OutputLength() == this->n_groups_ &&
+         model.Fingerprint() == this->fingerprint_;
+}
+
+template <CompactPrecision precision>
+void CompactForest::PredictImpl(common::Span<RegTree::FVec const> feats, bst_tree_t tree_begin,
+                                bst_tree_t tree_end, linalg::MatrixView<float> out) const {
+  auto decode = [&](Node const& node) {
+    if constexpr (precision == CompactPrecision::kFp16) {
+      return HalfToFloat(node.value);
+    } else if constexpr (precision == CompactPrecision::kBf16) {
+      return Bf16ToFloat(node.value);
+    } else {
+      return this->cut_values_[this->cut_ptr_[node.SplitIndex()] + node.value];
+    }
+  };
+  for (bst_tree_t tree_idx = tree_begin; tree_idx < tree_end; ++tree_idx) {
+    auto const* nodes = nodes_.data() + tree_ptr_[tree_idx];
+    auto gidx = tree_groups_[tree_idx];
+    for (std::size_t i = 0; i < feats.size(); ++i) {
+      auto const& row = feats[i];
+      bst_node_t nidx = 0;
+      while (!nodes[nidx].IsLeaf()) {
+        auto const& node = nodes[nidx];
+        auto fidx = node.SplitIndex();
+        bool go_left =
+            row.IsMissing(fidx) ? node.DefaultLeft() : row.GetFvalue(fidx) < decode(node);
+        nidx = node.left + !go_left;
+      }
+      out(i, gidx) += HalfToFloat(nodes[nidx].value);
+    }
+  }
+}
+
+void CompactForest::Predict(common::Span<RegTree::FVec const> feats, bst_tree_t tree_begin,
+                            bst_tree_t tree_end, linalg::MatrixView<float> out) const {
+  CHECK_LE(tree_end, this->NumTrees());
+  CHECK_EQ(out.Shape(0), feats.size());
+  switch (precision_) {
+    case CompactPrecision::kFp16:
+      this->PredictImpl<CompactPrecision::kFp16>(feats, tree_begin, tree_end, out);
+      break;
+    case CompactPrecision::kBf16:
+      this->PredictImpl<CompactPrecision::kBf16>(feats, tree_begin, tree_end, out);
+      break;
+    case CompactPrecision::kQuantized:
+      this->PredictImpl<CompactPrecision::kQuantized>(feats, tree_begin, tree_end, out);
+      break;
+  }
+}
+
+[[nodiscard]] std::shared_ptr<CompactForest const> CompactModel(gbm::GBTreeModel const& model,
+                                                                Json const& config) {
+  std::string precision = OptionalArg<String>(config, "precision", std::string{"fp16"});
+  std::string path = OptionalArg<String>(config, "path", std::string{});
+  std::shared_ptr<CompactForest const> forest{
+      CompactForest::Create(model, ParseCompactPrecision(precision))};
+  if (!path.empty()) {
+    std::unique_ptr<dmlc::Stream> fo{dmlc::Stream::Create(path.c_str(), "w")};
+    forest->Save(fo.get());
+  }
+  return forest;
+}
+
+[[nodiscard]] std::shared_ptr<CompactForest const> LoadCompactModel(std::string const& path) {
+  CHECK(!path.empty()) << "Empty path for the compact model.";
+  std::unique_ptr<dmlc::Stream> fi{dmlc::Stream::Create(path.c_str(), "r")};
+  return CompactForest::Load(fi.get());
+}
+
+namespace {
+template <typename DataView>
+void PredictByCompactForest(DataView const& batch, CompactForest const& forest,
+                            bst_tree_t tree_begin, bst_tree_t tree_end, std::int32_t n_threads,
+                            linalg::MatrixView<float> out_predt) {
+  constexpr std::size_t kBlockOfRowsSize = 64;
+  std::vector<RegTree::FVec> feat_vecs(n_threads * kBlockOfRowsSize);
+  common::ParallelFor1d<kBlockOfRowsSize>(batch.Size(), n_threads, [&](auto&& block) {
+    auto fvec_tloc = common::Span{feat_vecs}.subspan(omp_get_thread_num() * kBlockOfRowsSize,
+                                                     block.Size());
+    batch.FVecFill(block, forest.NumFeatures(), fvec_tloc);
+    auto ridx = block.begin() + batch.base_rowid;
+    forest.Predict(fvec_tloc, tree_begin, tree_end,
+                   out_predt.Slice(linalg::Range(ridx, ridx + block.Size()), linalg::All()));
+    batch.FVecDrop(fvec_tloc);
+  });
+}
+}  // namespace
+
+void CompactPredictor::PredictBatch(DMatrix* dmat, HostDeviceVector<float>* out_preds,
+                                    gbm::GBTreeModel const& model, bst_tree_t tree_begin,
+                                    bst_tree_t tree_end,
+                                    std::vector<float> const* tree_weights_override) const {
+  if (tree_end == 0) {
+    tree_end = model.trees.size();
+  }
+  if (tree_weights_override != nullptr || !forest_->Matches(model)) {
+    fallback_->PredictBatch(dmat, out_preds, model, tree_begin, tree_end, tree_weights_override);
+    return;
+  }
+  auto n_threads = this->ctx_->Threads();
+  auto out_predt = linalg::MakeTensorView(this->ctx_, out_preds->HostVector(),
+                                          dmat->Info().num_row_, forest_->NumGroups());
+  if (!dmat->PageExists<SparsePage>()) {
+    auto ft = dmat->Info().feature_types.ConstHostVector();
+    for (auto const& page : dmat->GetBatches<GHistIndexMatrix>(this->ctx_, {})) {
+      PredictByCompactForest(GHistIndexMatrixView{page, NoOpAccessor{}, ft}, *forest_, tree_begin,
+                             tree_end, n_threads, out_predt);
+    }
+  } else {
+    for (auto const& page : dmat->GetBatches<SparsePage>()) {
+      PredictByCompactForest(SparsePageView{page.GetView(), page.base_rowid, NoOpAccessor{}},
+                             *forest_, tree_begin, tree_end, n_threads, out_predt);
+    }
+  }
+}
+
+[[nodiscard]] bool CompactPredictor::InplacePredict(std::shared_ptr<DMatrix> p_m,
+                                                    gbm::GBTreeModel const& model, float missing,
+                                                    HostDeviceVector<float>* out_preds,
+                                                    bst_tree_t tree_begin,
+                                                    bst_tree_t tree_end) const {
+  auto proxy = dynamic_cast<data::DMatrixProxy*>(p_m.get());
+  CHECK(proxy) << error::InplacePredictProxy();
+  if (tree_end == 0) {
+    tree_end = model.trees.size();
+  }
+  if (!forest_->Matches(model)) {
+    return fallback_->InplacePredict(p_m, model, missing, out_preds, tree_begin, tree_end);
+  }
+
+  this->InitOutPredictions(p_m->Info(), out_preds, model);
+  auto& h_predt = out_preds->HostVector();
+  auto dispatch = [&](auto x) {
+    CheckProxyDMatrix(x, proxy, model.learner_model_state);
+    auto view = AdapterView{x.get(), missing, NoOpAccessor{}};
+    auto out_predt =
+        linalg::MakeTensorView(this->ctx_, h_predt, view.Size(), forest_->NumGroups());
+    PredictByCompactForest(view, *forest_, tree_begin, tree_end, this->ctx_->Threads(),
+                           out_predt);
+  };
+  bool type_error = false;
+  data::cpu_impl::DispatchAny<false>(proxy, dispatch, &type_error);
+  return !type_error;
+}
+}  // namespace xgboost::predictor
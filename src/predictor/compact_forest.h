@@ -0,0 +1,261 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Reduced-precision inference-only representation of tree models.
+ */
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int8_t, int32_t, uint16_t, uint64_t
+#include <memory>   // for shared_ptr, unique_ptr
+#include <string>   // for string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include "../common/optional_weight.h"   // for OptionalWeights
+#include "../tree/tree_view.h"           // for ScalarTreeView
+#include "xgboost/base.h"                // for bst_feature_t, bst_tree_t, bst_target_t
+#include "xgboost/host_device_vector.h"  // for HostDeviceVector
+#include "xgboost/json.h"                // for Json
+#include "xgboost/linalg.h"              // for MatrixView
+#include "xgboost/predictor.h"           // for Predictor
+#include "xgboost/span.h"                // for Span
+#include "xgboost/tree_model.h"          // for RegTree
+
+namespace dmlc {
+class Stream;
+}  // namespace dmlc
+
+namespace xgboost::gbm {
+struct GBTreeModel;
+}  // namespace xgboost::gbm
+
+namespace xgboost::predictor {
+/** @brief Encoding of the split thresholds. */
+enum class CompactPrecision : std::int8_t {
+  kFp16 = 0,
+  kBf16 = 1,
+  // Index into the sorted distinct thresholds of the feature, exact.
+  kQuantized = 2,
+};
+
+[[nodiscard]] CompactPrecision ParseCompactPrecision(std::string const& name);
+
+/**
+ * @brief A forest with 8-byte nodes for inference.
+ *
+ *   Each node stores the index of the left child, a 16-bit feature index with the default
+ *   direction in the highest bit, and a 16-bit value. The value is the fp16 leaf value for
+ *   leaves, and the encoded split threshold for split nodes. Trees are laid out in
+ *   breadth-first order with siblings next to each other, and tree weights are folded into
+ *   the leaf values.
+ *
+ *   Only numerical splits for scalar-leaf trees with less than 32768 features are
+ *   supported. Leaf values, and the split thresholds for the fp16 precision, must be within
+ *   the fp16 range. Rounding the thresholds can change the decision of a split for values close
+ *   to the threshold, see @ref Report for the error introduced by the compaction.
+ */
+class CompactForest {
+ public:
+  struct Node {
+    // Index of the left child inside the tree, the right child is `left + 1`.
+    std::int32_t left;
+    // Feature index, the highest bit is set when missing values go left.
+    std::uint16_t sindex;
+    // Encoded split threshold, or the fp16 leaf value.
+    std::uint16_t value;
+
+    [[nodiscard]] bool IsLeaf() const { return left == RegTree::kInvalidNodeId; }
+    [[nodiscard]] bst_feature_t SplitIndex() const { return sindex & ((1U << 15) - 1U); }
+    [[nodiscard]] bool DefaultLeft() const { return (sindex >> 15) != 0; }
+  };
+  static_assert(sizeof(Node) == 8);
+
+ private:
+  CompactPrecision precision_{CompactPrecision::kFp16};
+  // Fingerprint of the model that the forest is created from.
+  std::uint64_t fingerprint_{0};
+  bst_feature_t n_features_{0};
+  bst_target_t n_groups_{0};
+  std::vector<Node> nodes_;
+  std::vector<std::size_t> tree_ptr_;
+  std::vector<bst_target_t> tree_groups_;
+  // Sorted distinct thresholds for each feature in CSR format, only for the quantized
+  // precision.
+  std::vector<std::size_t> cut_ptr_;
+  std::vector<float> cut_values_;
+
+  // Error statistics collected during compaction.
+  Json report_{Object{}};
+
+  template <CompactPrecision precision>
+  void PredictImpl(common::Span<RegTree::FVec const> feats, bst_tree_t tree_begin,
+                   bst_tree_t tree_end, linalg::MatrixView<float> out) const;
+
+  CompactForest() = default;
+
+ public:
+  [[nodiscard]] static bool IsSupported(tree::ScalarTreeView const& tree,
+                                        bst_feature_t n_features);
+  /**
+   * @brief Compact a forest, returns nullptr if the model can't be represented.
+   *
+   * @param trees        Scalar trees, all of them must pass the @ref IsSupported check.
+   * @param tree_groups  Output group for each tree.
+   * @param n_features   Number of features in the model.
+   * @param n_groups     Number of output groups.
+   * @param tree_weights Tree weights, folded into the leaf values.
+   * @param precision    Encoding of the split thresholds.
+   */
+  [[nodiscard]] static std::unique_ptr<CompactForest> Create(
+      common::Span<tree::ScalarTreeView const> trees,
+      common::Span<bst_target_t const> tree_groups, bst_feature_t n_features,
+      bst_target_t n_groups, common::OptionalWeights tree_weights, CompactPrecision precision);
+  /** @brief Compact a GBTree model, raises an error if the model can't be represented. */
+  [[nodiscard]] static std::unique_ptr<CompactForest> Create(gbm::GBTreeModel const& model,
+                                                             CompactPrecision precision);
+
+  void Save(dmlc::Stream* fo) const;
+  [[nodiscard]] static std::unique_ptr<CompactForest> Load(dmlc::Stream* fi);
+
+  [[nodiscard]] CompactPrecision Precision() const { return precision_; }
+  [[nodiscard]] bst_tree_t NumTrees() const { return tree_groups_.size(); }
+  [[nodiscard]] bst_feature_t NumFeatures() const { return n_features_; }
+  [[nodiscard]] bst_target_t NumGroups() const { return n_groups_; }
+  [[nodiscard]] std::size_t NumNodes() const { return nodes_.size(); }
+  /** @brief Memory used by the forest in bytes. */
+  [[nodiscard]] std::size_t MemCostBytes() const;
+  /**
+   * @brief Error introduced by the compaction, with the following keys:
+   *
+   *   - "max_leaf_error": Maximum absolute rounding error of the weighted leaf values.
+   *   - "max_margin_error": Upper bound of the margin error caused by the leaf rounding,
+   *     the sum of the maximum leaf error of each tree.
+   *   - "max_threshold_error": Maximum relative rounding error of the split thresholds.
+   *   - "n_rounded_thresholds": Number of split thresholds that are not exactly
+   *     representable.
+   *   - "n_nodes", "bytes", "full_bytes": Size of the compact and the original model.
+   */
+  [[nodiscard]] Json const& Report() const { return report_; }
+  /**
+   * @brief Whether the forest can be used for predicting with the model. The forest stores
+   *        the @ref gbm::GBTreeModel::Fingerprint of the model that it's created from.
+   */
+  [[nodiscard]] bool Matches(gbm::GBTreeModel const& model) const;
+  /**
+   * @brief Accumulate the prediction of trees in `[tree_begin, tree_end)`.
+   *
+   * @param feats Feature vectors of the rows.
+   * @param out   Output with shape (n_rows, n_groups), incremented by the leaf values.
+   */
+  void Predict(common::Span<RegTree::FVec const> feats, bst_tree_t tree_begin,
+               bst_tree_t tree_end, linalg::MatrixView<float> out) const;
+};
+
+/**
+ * @brief Compact the model and optionally save it to a file.
+ *
+ * @param config JSON object with the following keys:
+ *               - "precision": One of "fp16", "bf16", and "quantized", defaults to "fp16".
+ *               - "path": Output path, optional.
+ */
+[[nodiscard]] std::shared_ptr<CompactForest const> CompactModel(gbm::GBTreeModel const& model,
+                                                                Json const& config);
+/** @brief Load a compact model saved by @ref CompactModel . */
+[[nodiscard]] std::shared_ptr<CompactForest const> LoadCompactModel(std::string const& path);
+
+/**
+ * @brief Predictor that runs value prediction with a compact forest.
+ *
+ *   Batch and inplace prediction for the model that the forest is created from are handled
+ *   by the compact forest, everything else is forwarded to the wrapped predictor.
+ */
+class CompactPredictor : public Predictor {
+  std::shared_ptr<CompactForest const> forest_;
+  std::unique_ptr<Predictor> fallback_;
+
+ public:
+  CompactPredictor(Context const* ctx, std::shared_ptr<CompactForest const> forest,
+                   std::unique_ptr<Predictor> fallback)
+      : Predictor{ctx}, forest_{std::move(forest)}, fallback_{std::move(fallback)} {}
+
+  void PredictBatch(DMatrix* dmat, HostDeviceVector<float>* out_preds,
+                    gbm::GBTreeModel const& model, bst_tree_t tree_begin, bst_tree_t tree_end = 0,
+                    std::vector<float> const* tree_weights_override = nullptr) const override;
+
+  [[nodiscard]] bool InplacePredict(std::shared_ptr<DMatrix> p_m, gbm::GBTreeModel const& model,
+                                    float missing, HostDeviceVector<float>* out_preds,
+                                    bst_tree_t tree_begin, bst_tree_t tree_end) const override;
+
+  void PredictEarlyExit(DMatrix* dmat, float threshold, HostDeviceVector<float>* out_preds,
+                        HostDeviceVector<bst_tree_t>* out_n_trees, gbm::GBTreeModel const& model,
+                        bst_tree_t tree_begin, bst_tree_t tree_end) const override {
+    fallback_->PredictEarlyExit(dmat, threshold, out_preds, out_n_trees, model, tree_begin,
+                                tree_end);
+  }
+
+  void PredictStaged(DMatrix* dmat, common::Span<bst_tree_t const> stages,
+                     HostDeviceVector<float>* out_preds,
+                     gbm::GBTreeModel const& model) const override {
+    fallback_->PredictStaged(dmat, stages, out_preds, model);
+  }
+
+  void PredictBatchMulti(DMatrix* dmat, common::Span<gbm::GBTreeModel const* const> models,
+                         common::Span<HostDeviceVector<float>* const> out_preds) const override {
+    fallback_->PredictBatchMulti(dmat, models, out_preds);
+  }
+
+  void PredictLeaf(DMatrix* dmat, HostDeviceVector<float>* out_preds,
+                   gbm::GBTreeModel const& model, bst_tree_t tree_end = 0) const override {
+    fallback_->PredictLeaf(dmat, out_preds, model, tree_end);
+  }
+
+  void PredictLeafCompact(DMatrix* dmat, HostDeviceVector<std::uint8_t>* out_leaf,
+                          std::int32_t* out_bytes, gbm::GBTreeModel const& model,
+                          bst_tree_t tree_end = 0) const override {
+    fallback_->PredictLeafCompact(dmat, out_leaf, out_bytes, model, tree_end);
+  }
+
+  void PredictLeafOneHot(DMatrix* dmat, HostDeviceVector<bst_idx_t>* out_indptr,
+                         HostDeviceVector<bst_feature_t>* out_indices,
+                         bst_feature_t* out_n_columns, gbm::GBTreeModel const& model,
+                         bst_tree_t tree_end = 0) const override {
+    fallback_->PredictLeafOneHot(dmat, out_indptr, out_indices, out_n_columns, model, tree_end);
+  }
+
+  void PredictFromLeafIds(common::Span<HostDeviceVector<bst_node_t> const> leaf_ids,
+                          common::Span<RegTree const*> trees,
+                          linalg::MatrixView<float> out_preds) const override {
+    fallback_->PredictFromLeafIds(leaf_ids, trees, out_preds);
+  }
+
+  void PredictContribution(DMatrix* dmat, HostDeviceVector<float>* out_contribs,
+                           gbm::GBTreeModel const& model, bst_tree_t tree_end = 0,
+                           bool approximate = false, int condition = 0,
+                           unsigned condition_feature = 0) const override {
+    fallback_->PredictContribution(dmat, out_contribs, model, tree_end, approximate, condition,
+                                   condition_feature);
+  }
+
+  void PredictInteractionContributions(DMatrix* dmat, HostDeviceVector<float>* out_contribs,
+                                       gbm::GBTreeModel const& model, bst_tree_t tree_end = 0,
+                                       bool approximate = false) const override {
+    fallback_->PredictInteractionContributions(dmat, out_contribs, model, tree_end, approximate);
+  }
+
+  void PredictContributionTopK(DMatrix* dmat, bst_feature_t top_k,
+                               HostDeviceVector<bst_idx_t>* out_indptr,
+                               HostDeviceVector<bst_feature_t>* out_indices,
+                               HostDeviceVector<float>* out_values, gbm::GBTreeModel const& model,
+                               bst_tree_t tree_end = 0) const override {
+    fallback_->PredictContributionTopK(dmat, top_k, out_indptr, out_indices, out_values, model,
+                                       tree_end);
+  }
+
+  void PredictContributionStream(DMatrix* dmat, bool interactions, bst_idx_t block_rows,
+                                 ContributionSink* sink, gbm::GBTreeModel const& model,
+                                 bst_tree_t tree_end = 0) const override {
+    fallback_->PredictContributionStream(dmat, interactions, block_rows, sink, model, tree_end);
+  }
+};
+}  // namespace xgboost::predictor
@@ -0,0 +1,301 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "compiled_predictor.h"
+
+#if !defined(_WIN32)
+#include <dlfcn.h>     // for dlclose, dlsym, dlopen, dlerror
+#include <spawn.h>     // for posix_spawnp, posix_spawn_file_actions_t
+#include <sys/wait.h>  // for waitpid, WIFEXITED, WEXITSTATUS
+#include <unistd.h>    // for pipe, read, close, STDOUT_FILENO, STDERR_FILENO
+#endif                 // !defined(_WIN32)
+
+#include <algorithm>     // for min
+#include <any>           // for any_cast
+#include <cerrno>        // for errno, EINTR
+#include <cmath>         // for isinf, isnan
+#include <cstdint>       // for int32_t
+#include <fstream>       // for ofstream
+#include <ios>           // for hexfloat
+#include <sstream>       // for stringstream
+#include <string>        // for string
+#include <system_error>  // for error_code, system_category
+#include <typeinfo>      // for typeid
+#include <utility>       // for move, pair
+#include <vector>        // for vector
+
+#include "../common/common.h"           // for DivRoundUp
+#include "../common/error_msg.h"        // for InplacePredictProxy, SystemError
+#include "../common/json_utils.h"       // for RequiredArg, OptionalArg
+#include "../common/optional_weight.h"  // for OptionalWeights
+#include "../common/threading_utils.h"  // for ParallelFor
+#include "../data/adapter.h"            // for ArrayAdapter
+#include "../data/proxy_dmatrix.h"      // for DMatrixProxy
+#include "../gbm/gbtree_model.h"        // for GBTreeModel
+#include "../tree/tree_view.h"          // for ScalarTreeView
+#include "xgboost/logging.h"            // for CHECK, LOG
+#include "xgboost/string_view.h"        // for StringView
+
+#if !defined(_WIN32)
+extern char** environ;  // NOLINT
+#endif                  // !defined(_WIN32)
+
+namespace xgboost::predictor {
+namespace {
+/**
+ * @brief Run a command without going through the shell.
+ *
+ * @return The exit status of the command and its combined stdout and stderr.
+ */
+std::pair<std::int32_t, std::string> RunCommand(std::vector<std::string> const& args) {
+#if !defined(_WIN32)
+  CHECK(!args.empty());
+  std::vector<char*> argv;
+  for (auto const& arg : args) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  int fds[2];
+  CHECK_EQ(pipe(fds), 0) << "Failed to create a pipe: " << error::SystemError().message();
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addclose(&actions, fds[0]);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDERR_FILENO);
+  posix_spawn_file_actions_addclose(&actions, fds[1]);
+  pid_t pid;
+  auto rc = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  close(fds[1]);
+  if (rc != 0) {
+    close(fds[0]);
+    LOG(FATAL) << "Failed to run `" << args[0]
+               << "`: " << std::error_code{rc, std::system_category()}.message();
+  }
+
+  std::string output;
+  char buf[4096];
+  while (true) {
+    auto n = read(fds[0], buf, sizeof(buf));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    output.append(buf, n);
+  }
+  close(fds[0]);
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0) {
+    CHECK_EQ(errno, EINTR) << "Failed to wait for `" << args[0]
+                           << "`: " << error::SystemError().message();
+  }
+  return {WIFEXITED(status) ? WEXITSTATUS(status) : -1, std::move(output)};
+#else
+  LOG(FATAL) << "Compiling models is not supported on Windows.";
+  return {};
+#endif  // !defined(_WIN32)
+}
+
+// Exact representation of a float in C source.
+std::string FloatLiteral(float v) {
+  if (std::isinf(v)) {
+    return v > 0 ? "INFINITY" : "-INFINITY";
+  }
+  CHECK(!std::isnan(v)) << "Invalid value in the tree model.";
+  std::stringstream ss;
+  ss << std::hexfloat << static_cast<double>(v) << "f";
+  return ss.str();
+}
+
+void GenerateNode(tree::ScalarTreeView const& tree, bst_node_t nidx, float weight,
+                  std::int32_t depth, std::ostream* p_out) {
+  auto& out = *p_out;
+  std::string indent(depth * 2, ' ');
+  if (tree.IsLeaf(nidx)) {
+    out << indent << "return " << FloatLiteral(tree.LeafValue(nidx) * weight) << ";\n";
+    return;
+  }
+  auto fidx = tree.SplitIndex(nidx);
+  auto cond = FloatLiteral(tree.SplitCond(nidx));
+  // Same as the tree traversal, missing values go right unless it's the default left.
+  out << indent << "if (";
+  if (tree.DefaultLeft(nidx)) {
+    out << "isnan(x[" << fidx << "]) || ";
+  }
+  out << "x[" << fidx << "] < " << cond << ") {\n";
+  GenerateNode(tree, tree.LeftChild(nidx), weight, depth + 1, p_out);
+  out << indent << "} else {\n";
+  GenerateNode(tree, tree.RightChild(nidx), weight, depth + 1, p_out);
+  out << indent << "}\n";
+}
+}  // namespace
+
+void GenerateModelSource(gbm::GBTreeModel const& model, std::ostream* p_out) {
+  auto& out = *p_out;
+  auto n_features = model.learner_model_state->num_feature;
+  auto n_targets = model.learner_model_state->OutputLength();
+  auto n_trees = static_cast<bst_tree_t>(model.trees.size());
+  auto const& tree_groups = model.tree_info.ConstHostVector();
+  auto const* tree_weights = model.TreeWeights();
+  auto weights = tree_weights == nullptr
+                     ? common::OptionalWeights{1.0f}
+                     : common::OptionalWeights{common::Span<float const>{*tree_weights}};
+  CHECK_NE(n_features, 0) << "The model is not trained.";
+
+  out << "/* Generated by XGBoost. */\n"
+      << "#include <math.h>\n"
+      << "#include <stddef.h>\n\n";
+  for (bst_tree_t tree_idx = 0; tree_idx < n_trees; ++tree_idx) {
+    auto const* p_tree = model.trees[tree_idx].get();
+    CHECK(!p_tree->IsMultiTarget()) << "Compiling multi-target trees is not supported.";
+    auto tree = tree::ScalarTreeView{p_tree};
+    CHECK(!tree.HasCategoricalSplit()) << "Compiling categorical splits is not supported.";
+    out << "static float tree_" << tree_idx << "(float const* x) {\n";
+    GenerateNode(tree, RegTree::kRoot, weights[tree_idx], 1, p_out);
+    out << "}\n\n";
+  }
+
+  out << "unsigned xgboost_num_feature(void) { return " << n_features << "; }\n"
+      << "unsigned xgboost_num_target(void) { return " << n_targets << "; }\n"
+      << "unsigned xgboost_num_tree(void) { return " << n_trees << "; }\n"
+      << "unsigned long long xgboost_model_fingerprint(void) { return " << model.Fingerprint()
+      << "ULL; }\n\n";
+
+  out << "void predict(float const* data, size_t n_rows, float* out) {\n"
+      << "  for (size_t i = 0; i < n_rows; ++i) {\n"
+      << "    float const* x = data + i * " << n_features << ";\n"
+      << "    float* y = out + i * " << n_targets << ";\n";
+  for (bst_tree_t tree_idx = 0; tree_idx < n_trees; ++tree_idx) {
+    out << "    y[" << tree_groups[tree_idx] << "] += tree_" << tree_idx << "(x);\n";
+  }
+  out << "  }\n"
+      << "}\n";
+}
+
+[[nodiscard]] std::string CompileModel(gbm::GBTreeModel const& model, Json const& config) {
+  std::string path = RequiredArg<String>(config, "path", __func__);
+  std::string compiler = OptionalArg<String>(config, "compiler", std::string{"cc"});
+  std::string flags = OptionalArg<String>(config, "flags", std::string{"-O2"});
+
+  auto src = path + ".c";
+  {
+    std::ofstream fout{src};
+    CHECK(fout) << "Failed to open `" << src << "` for writing.";
+    GenerateModelSource(model, &fout);
+    CHECK(fout) << "Failed to write the model source to `" << src << "`.";
+  }
+
+  // Flags are split by white space, they are passed to the compiler as they are.
+  std::vector<std::string> args{compiler};
+  std::stringstream ss{flags};
+  for (std::string flag; ss >> flag;) {
+    args.push_back(flag);
+  }
+  for (auto arg : {"-shared", "-fPIC", "-o"}) {
+    args.emplace_back(arg);
+  }
+  args.push_back(path);
+  args.push_back(src);
+
+  std::stringstream cmd;
+  for (auto const& arg : args) {
+    cmd << " `" << arg << "`";
+  }
+  LOG(INFO) << "Compiling model:" << cmd.str();
+  auto [rc, output] = RunCommand(args);
+  CHECK_EQ(rc, 0) << "Failed to compile the model with:" << cmd.str() << "\n" << output;
+  return path;
+}
+
+CompiledModel::CompiledModel(std::string path) : path_{std::move(path)} {
+  CHECK(!path_.empty()) << "Empty path for the compiled model.";
+#if !defined(_WIN32)
+  std::string msg{"Failed to load the compiled model from path: `" + path_ + "`. Error:\n  "};
+  handle_ = dlopen(path_.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!handle_) {
+    LOG(FATAL) << msg << dlerror();
+  }
+
+  auto safe_load = [&](auto t, StringView name) {
+    auto ptr = reinterpret_cast<decltype(t)>(dlsym(handle_, name.c_str()));
+    if (!ptr) {
+      LOG(FATAL) << "Failed to load symbol `" << name << "` from " << path_ << ". Error:\n  "
+                 << dlerror();
+    }
+    return ptr;
+  };
+  using MetaFn = unsigned (*)();
+  predict_ = safe_load(predict_, "predict");
+  n_features_ = safe_load(MetaFn{nullptr}, "xgboost_num_feature")();
+  n_targets_ = safe_load(MetaFn{nullptr}, "xgboost_num_target")();
+  n_trees_ = safe_load(MetaFn{nullptr}, "xgboost_num_tree")();
+  using FingerprintFn = unsigned long long (*)();  // NOLINT
+  fingerprint_ = safe_load(FingerprintFn{nullptr}, "xgboost_model_fingerprint")();
+  CHECK_NE(n_targets_, 0) << "Invalid compiled model: `" << path_ << "`.";
+#else
+  LOG(FATAL) << "Loading compiled models is not supported on Windows.";
+#endif  // !defined(_WIN32)
+}
+
+CompiledModel::~CompiledModel() {
+#if !defined(_WIN32)
+  if (handle_) {
+    dlclose(handle_);
+  }
+#endif  // !defined(_WIN32)
+}
+
+[[nodiscard]] bool CompiledModel::Matches(gbm::GBTreeModel const& model) const {
+  return static_cast<bst_tree_t>(model.trees.size()) == this->n_trees_ &&
+         model.learner_model_state->num_feature == this->n_features_ &&
+         model.learner_model_state->OutputLength() == this->n_targets_ &&
+         model.Fingerprint() == this->fingerprint_;
+}
+
+[[nodiscard]] bool CompiledPredictor::InplacePredict(std::shared_ptr<DMatrix> p_m,
+                                                     gbm::GBTreeModel const& model, float missing,
+                                                     HostDeviceVector<float>* out_preds,
+                                                     bst_tree_t tree_begin,
+                                                     bst_tree_t tree_end) const {
+  auto proxy = dynamic_cast<data::DMatrixProxy*>(p_m.get());
+  CHECK(proxy) << error::InplacePredictProxy();
+  if (tree_end == 0) {
+    tree_end = model.trees.size();
+  }
+  // The compiled code treats NaN as missing, and takes a dense row-major float32 matrix.
+  bool full_model = tree_begin == 0 && tree_end == static_cast<bst_tree_t>(model.trees.size());
+  auto const& any_adapter = proxy->Adapter();
+  auto p_adapter = any_adapter.type() == typeid(std::shared_ptr<data::ArrayAdapter>)
+                       ? std::any_cast<std::shared_ptr<data::ArrayAdapter>>(any_adapter)
+                       : nullptr;
+  if (!full_model || !std::isnan(missing) || !p_adapter || !compiled_->Matches(model)) {
+    return fallback_->InplacePredict(p_m, model, missing, out_preds, tree_begin, tree_end);
+  }
+  auto const& array = p_adapter->Array();
+  if (array.type != data::ArrayInterfaceHandler::kF4 || !array.is_contiguous ||
+      array.Shape<1>() != compiled_->NumFeatures()) {
+    return fallback_->InplacePredict(p_m, model, missing, out_preds, tree_begin, tree_end);
+  }
+
+  this->InitOutPredictions(p_m->Info(), out_preds, model);
+  auto h_predt = out_preds->HostSpan();
+  auto const* data = static_cast<float const*>(array.data);
+  auto n_rows = array.Shape<0>();
+  std::size_t n_features = compiled_->NumFeatures();
+  std::size_t n_targets = compiled_->NumTargets();
+  CHECK_EQ(h_predt.size(), n_rows * n_targets);
+
+  std::size_t constexpr kBlockOfRows = 64;
+  auto n_blocks = common::DivRoundUp(n_rows, kBlockOfRows);
+  common::ParallelFor(n_blocks, this->ctx_->Threads(), [&](auto block_idx) {
+    auto begin = block_idx * kBlockOfRows;
+    auto n = std::min(n_rows - begin, kBlockOfRows);
+    compiled_->Predict(data + begin * n_features, n, h_predt.data() + begin * n_targets);
+  });
+  return true;
+}
+}  // namespace xgboost::predictor
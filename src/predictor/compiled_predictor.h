@@ -0,0 +1,198 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Ahead-of-time compilation of tree models into native shared libraries.
+ */
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t, uint8_t, uint64_t
+#include <memory>   // for shared_ptr, unique_ptr
+#include <ostream>  // for ostream
+#include <string>   // for string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include "xgboost/base.h"                // for bst_feature_t, bst_tree_t, bst_target_t
+#include "xgboost/host_device_vector.h"  // for HostDeviceVector
+#include "xgboost/json.h"                // for Json
+#include "xgboost/linalg.h"              // for MatrixView
+#include "xgboost/predictor.h"           // for Predictor
+#include "xgboost/span.h"                // for Span
+
+namespace xgboost::gbm {
+struct GBTreeModel;
+}  // namespace xgboost::gbm
+
+namespace xgboost::predictor {
+/**
+ * @brief Generate C source code for a tree model.
+ *
+ *   Each tree is lowered into a function with nested if/else blocks, and tree weights are
+ *   folded into the leaf values. The generated library exports the following ABI:
+ *
+ *   - `void predict(float const* data, size_t n_rows, float* out)`: Accumulate the margin of
+ *     a dense row-major batch into `out`, which has shape (n_rows, n_targets). Missing
+ *     values are represented by NaN.
+ *   - `xgboost_num_feature`, `xgboost_num_target`, and `xgboost_num_tree`: Model metadata
+ *     used for validating the library.
+ *   - `xgboost_model_fingerprint`: The @ref gbm::GBTreeModel::Fingerprint of the model, the
+ *     library is not used once the trees are changed.
+ *
+ *   Only numerical splits with scalar leaves are supported.
+ */
+void GenerateModelSource(gbm::GBTreeModel const& model, std::ostream* out);
+
+/**
+ * @brief Generate the source code and build it into a shared library with the system
+ *        compiler.
+ *
+ * @param config JSON object with the following keys:
+ *               - "path": Output path of the shared library, required.
+ *               - "compiler": The C compiler, defaults to `cc`.
+ *               - "flags": Compiler flags separated by white space, defaults to `-O2`.
+ *
+ *   The compiler is executed directly without a shell, and the compiler output is included
+ *   in the error if the compilation fails.
+ *
+ * @return The path of the shared library.
+ */
+[[nodiscard]] std::string CompileModel(gbm::GBTreeModel const& model, Json const& config);
+
+/**
+ * @brief A shared library produced by @ref CompileModel .
+ */
+class CompiledModel {
+ public:
+  using PredictFn = void (*)(float const*, std::size_t, float*);
+
+ private:
+  std::string path_;
+  void* handle_{nullptr};
+  PredictFn predict_{nullptr};
+  bst_feature_t n_features_{0};
+  bst_target_t n_targets_{0};
+  bst_tree_t n_trees_{0};
+  std::uint64_t fingerprint_{0};
+
+ public:
+  explicit CompiledModel(std::string path);
+  ~CompiledModel();
+
+  CompiledModel(CompiledModel const& that) = delete;
+  CompiledModel& operator=(CompiledModel const& that) = delete;
+
+  [[nodiscard]] std::string const& Path() const { return path_; }
+  [[nodiscard]] bst_feature_t NumFeatures() const { return n_features_; }
+  [[nodiscard]] bst_target_t NumTargets() const { return n_targets_; }
+  [[nodiscard]] bst_tree_t NumTrees() const { return n_trees_; }
+  /**
+   * @brief Whether the compiled code can be used for predicting with the full model. Both
+   *        the shape and the fingerprint of the model must match.
+   */
+  [[nodiscard]] bool Matches(gbm::GBTreeModel const& model) const;
+  /**
+   * @brief Accumulate the prediction of a dense batch into `out`.
+   */
+  void Predict(float const* data, std::size_t n_rows, float* out) const {
+    this->predict_(data, n_rows, out);
+  }
+};
+
+/**
+ * @brief Predictor that dispatches inplace prediction to a compiled model.
+ *
+ *   Dense float32 inputs predicted with the full model are handled by the compiled
+ *   library, everything else is forwarded to the wrapped predictor.
+ */
+class CompiledPredictor : public Predictor {
+  std::shared_ptr<CompiledModel const> compiled_;
+  std::unique_ptr<Predictor> fallback_;
+
+ public:
+  CompiledPredictor(Context const* ctx, std::shared_ptr<CompiledModel const> compiled,
+                    std::unique_ptr<Predictor> fallback)
+      : Predictor{ctx}, compiled_{std::move(compiled)}, fallback_{std::move(fallback)} {}
+
+  void PredictBatch(DMatrix* dmat, HostDeviceVector<float>* out_preds,
+                    gbm::GBTreeModel const& model, bst_tree_t tree_begin, bst_tree_t tree_end = 0,
+                    std::vector<float> const* tree_weights_override = nullptr) const override {
+    fallback_->PredictBatch(dmat, out_preds, model, tree_begin, tree_end, tree_weights_override);
+  }
+
+  [[nodiscard]] bool InplacePredict(std::shared_ptr<DMatrix> p_m, gbm::GBTreeModel const& model,
+                                    float missing, HostDeviceVector<float>* out_preds,
+                                    bst_tree_t tree_begin, bst_tree_t tree_end) const override;
+
+  void PredictEarlyExit(DMatrix* dmat, float threshold, HostDeviceVector<float>* out_preds,
+                        HostDeviceVector<bst_tree_t>* out_n_trees, gbm::GBTreeModel const& model,
+                        bst_tree_t tree_begin, bst_tree_t tree_end) const override {
+    fallback_->PredictEarlyExit(dmat, threshold, out_preds, out_n_trees, model, tree_begin,
+                                tree_end);
+  }
+
+  void PredictStaged(DMatrix* dmat, common::Span<bst_tree_t const> stages,
+                     HostDeviceVector<float>* out_preds,
+                     gbm::GBTreeModel const& model) const override {
+    fallback_->PredictStaged(dmat, stages, out_preds, model);
+  }
+
+  void PredictBatchMulti(DMatrix* dmat, common::Span<gbm::GBTreeModel const* const> models,
+                         common::Span<HostDeviceVector<float>* const> out_preds) const override {
+    fallback_->PredictBatchMulti(dmat, models, out_preds);
+  }
+
+  void PredictLeaf(DMatrix* dmat, HostDeviceVector<float>* out_preds,
+                   gbm::GBTreeModel const& model, bst_tree_t tree_end = 0) const override {
+    fallback_->PredictLeaf(dmat, out_preds, model, tree_end);
+  }
+
+  void PredictLeafCompact(DMatrix* dmat, HostDeviceVector<std::uint8_t>* out_leaf,
+                          std::int32_t* out_bytes, gbm::GBTreeModel const& model,
+                          bst_tree_t tree_end = 0) const override {
+    fallback_->PredictLeafCompact(dmat, out_leaf, out_bytes, model, tree_end);
+  }
+
+  void PredictLeafOneHot(DMatrix* dmat, HostDeviceVector<bst_idx_t>* out_indptr,
+                         HostDeviceVector<bst_feature_t>* out_indices,
+                         bst_feature_t* out_n_columns, gbm::GBTreeModel const& model,
+                         bst_tree_t tree_end = 0) const override {
+    fallback_->PredictLeafOneHot(dmat, out_indptr, out_indices, out_n_columns, model, tree_end);
+  }
+
+  void PredictFromLeafIds(common::Span<HostDeviceVector<bst_node_t> const> leaf_ids,
+                          common::Span<RegTree const*> trees,
+                          linalg::MatrixView<float> out_preds) const override {
+    fallback_->PredictFromLeafIds(leaf_ids, trees, out_preds);
+  }
+
+  void PredictContribution(DMatrix* dmat, HostDeviceVector<float>* out_contribs,
+                           gbm::GBTreeModel const& model, bst_tree_t tree_end = 0,
+                           bool approximate = false, int condition = 0,
+                           unsigned condition_feature = 0) const override {
+    fallback_->PredictContribution(dmat, out_contribs, model, tree_end, approximate, condition,
+                                   condition_feature);
+  }
+
+  void PredictInteractionContributions(DMatrix* dmat, HostDeviceVector<float>* out_contribs,
+                                       gbm::GBTreeModel const& model, bst_tree_t tree_end = 0,
+                                       bool approximate = false) const override {
+    fallback_->PredictInteractionContributions(dmat, out_contribs, model, tree_end, approximate);
+  }
+
+  void PredictContributionTopK(DMatrix* dmat, bst_feature_t top_k,
+                               HostDeviceVector<bst_idx_t>* out_indptr,
+                               HostDeviceVector<bst_feature_t>* out_indices,
+                               HostDeviceVector<float>* out_values, gbm::GBTreeModel const& model,
+                               bst_tree_t tree_end = 0) const override {
+    fallback_->PredictContributionTopK(dmat, top_k, out_indptr, out_indices, out_values, model,
+                                       tree_end);
+  }
+
+  void PredictContributionStream(DMatrix* dmat, bool interactions, bst_idx_t block_rows,
+                                 ContributionSink* sink, gbm::GBTreeModel const& model,
+                                 bst_tree_t tree_end = 0) const override {
+    fallback_->PredictContributionStream(dmat, interactions, block_rows, sink, model, tree_end);
+  }
+};
+}  // namespace xgboost::predictor
@@ -0,0 +1,31 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "contribution_sink.h"
+
+#include <algorithm>  // for copy
+
+#include "dmlc/io.h"          // for Stream
+#include "xgboost/logging.h"  // for CHECK
+
+namespace xgboost::predictor {
+void MemoryContributionSink::Begin(std::size_t n_values) {
+  CHECK_GE(out_.size(), n_values) << "The output buffer is too small for the contributions.";
+  n_written_ = 0;
+}
+
+void MemoryContributionSink::Write(common::Span<float const> values) {
+  CHECK_LE(n_written_ + values.size(), out_.size());
+  std::copy(values.cbegin(), values.cend(), out_.data() + n_written_);
+  n_written_ += values.size();
+}
+
+FileContributionSink::FileContributionSink(std::string const& path)
+    : fo_{dmlc::Stream::Create(path.c_str(), "w")} {}
+
+FileContributionSink::~FileContributionSink() = default;
+
+void FileContributionSink::Write(common::Span<float const> values) {
+  fo_->Write(values.data(), values.size_bytes());
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Destinations for feature contributions streamed in blocks of rows.
+ */
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <functional>  // for function
+#include <memory>      // for unique_ptr
+#include <string>      // for string
+#include <utility>     // for move
+
+#include "xgboost/base.h"  // for bst_idx_t
+#include "xgboost/span.h"  // for Span
+
+namespace dmlc {
+class Stream;
+}  // namespace dmlc
+
+namespace xgboost::predictor {
+/**
+ * @brief Destination of feature contributions produced in blocks of rows.
+ *
+ *   Blocks are written in row order. Concatenating them gives the same layout as the dense
+ *   output of @ref Predictor::PredictContribution or
+ *   @ref Predictor::PredictInteractionContributions .
+ */
+class ContributionSink {
+ public:
+  /** @brief Called with the number of finished rows and the total number of rows. */
+  using ProgressFn = std::function<void(bst_idx_t n_rows_done, bst_idx_t n_rows)>;
+
+ private:
+  ProgressFn progress_;
+
+ public:
+  virtual ~ContributionSink() = default;
+  /**
+   * @brief Called once before the first block.
+   *
+   * @param n_values Total number of values that are going to be written.
+   */
+  virtual void Begin(std::size_t /*n_values*/) {}
+  /** @brief Write the next block of values. */
+  virtual void Write(common::Span<float const> values) = 0;
+
+  void SetProgress(ProgressFn fn) { progress_ = std::move(fn); }
+  /** @brief Called after each block is written. */
+  void Progress(bst_idx_t n_rows_done, bst_idx_t n_rows) const {
+    if (progress_) {
+      progress_(n_rows_done, n_rows);
+    }
+  }
+};
+
+/**
+ * @brief Write into a caller-owned buffer, like a shared memory mapping of the output file.
+ */
+class MemoryContributionSink : public ContributionSink {
+  common::Span<float> out_;
+  std::size_t n_written_{0};
+
+ public:
+  explicit MemoryContributionSink(common::Span<float> out) : out_{out} {}
+
+  void Begin(std::size_t n_values) override;
+  void Write(common::Span<float const> values) override;
+  [[nodiscard]] std::size_t Size() const { return n_written_; }
+};
+
+/**
+ * @brief Write the raw float values to a file, or any URI supported by `dmlc::Stream`.
+ */
+class FileContributionSink : public ContributionSink {
+  std::unique_ptr<dmlc::Stream> fo_;
+
+ public:
+  explicit FileContributionSink(std::string const& path);
+  ~FileContributionSink() override;
+
+  void Write(common::Span<float const> values) override;
+};
+}  // namespace xgboost::predictor
@@ -1,16 +1,23 @@
 /**
  * Copyright 2017-2026, XGBoost Contributors
  */
-#include <algorithm>  // for max, fill, min
+#include <algorithm>  // for max, fill, min, any_of, fill_n
+#include <array>      // for array
+#include <atomic>     // for atomic
 #include <cassert>    // for assert
 #include <cstddef>    // for size_t
-#include <cstdint>    // for uint32_t, int32_t, uint64_t
+#include <cmath>      // for nextafter
+#include <cstdint>    // for uint32_t, int32_t, uint64_t, int64_t
+#include <limits>     // for numeric_limits
 #include <memory>     // for unique_ptr, shared_ptr
+#include <mutex>      // for lock_guard
+#include <string>     // for stoll
 #include <vector>     // for vector
 
 #include "../collective/allreduce.h"         // for Allreduce
 #include "../collective/communicator-inl.h"  // for IsDistributed
 #include "../common/bitfield.h"              // for RBitField8
+#include "../common/cache_manager.h"         // for CacheManager
 #include "../common/column_matrix.h"         // for ColumnMatrix
 #include "../common/error_msg.h"             // for InplacePredictProxy
 #include "../common/math.h"                  // for CheckNAN
@@ -22,12 +29,18 @@
 #include "../data/proxy_dmatrix.h"           // for DMatrixProxy
 #include "../gbm/gbtree_model.h"             // for GBTreeModel, GBTreeModelParam
 #include "../tree/sample_position.h"         // for SamplePosition
+#include "array_forest.h"                    // for ArrayForest
 #include "array_tree_layout.h"               // for ProcessArrayTree
+#include "block_tiling.h"                    // for ChooseBlockTiling
 #include "data_accessor.h"                   // for GHistIndexMatrixView, SparsePageView
 #include "dmlc/registry.h"                   // for DMLC_REGISTRY_FILE_TAG
+#include "forest_cache.h"                    // for ForestLayoutCache, CachedLayout
 #include "gbtree_view.h"                     // for GBTreeModelView
 #include "interpretability/shap.h"  // for ShapValues, ApproxFeatureImportance, ShapInteractionValues
+#include "numa_model.h"             // for NumaReplicatedModel, PartitionByNuma
 #include "predict_fn.h"             // for GetNextNode, GetNextNodeMulti
+#include "quantized_forest.h"       // for QuantizedForest
+#include "quick_scorer.h"           // for QuickScorerForest
 #include "utils.h"                  // for CheckProxyDMatrix
 #include "xgboost/base.h"           // for bst_float, bst_node_t, bst_omp_uint, bst_fe...
 #include "xgboost/context.h"        // for Context
@@ -154,24 +167,36 @@ void PredValueByOneTree(tree::MultiTargetTreeView const &tree, std::size_t const
 }  // namespace multi
 
 namespace {
+/**
+ * @brief Run a chunk of trees `[chunk_begin, chunk_end)` over a block of rows.
+ */
 template <bool use_array_tree_layout, bool any_missing>
 void PredictBlockByAllTrees(HostModel const &model, std::size_t const predict_offset,
                             common::Span<RegTree::FVec> fvec_tloc, std::size_t const block_size,
                             linalg::MatrixView<float> out_predt, const std::vector<int> &tree_depth,
-                            common::OptionalWeights tree_weights) {
+                            common::OptionalWeights tree_weights, bst_tree_t chunk_begin,
+                            bst_tree_t chunk_end, ArrayForest const *flat) {
   std::vector<bst_node_t> nidx;
   if constexpr (use_array_tree_layout) {
     nidx.resize(block_size, 0);
   }
   auto trees = model.Trees();
-  for (bst_tree_t tree_id = 0, n_trees = model.Trees().size(); tree_id < n_trees; ++tree_id) {
+  for (bst_tree_t tree_id = chunk_begin; tree_id < chunk_end; ++tree_id) {
     bst_node_t depth = use_array_tree_layout ? tree_depth[tree_id] : 0;
     auto weight = tree_weights[tree_id];
     std::visit(
         enc::Overloaded{[&](tree::ScalarTreeView const &tree) {
                           bool has_categorical = tree.HasCategoricalSplit();
                           auto const gid = model.tree_groups[tree_id];
-                          if (has_categorical) {
+                          if (use_array_tree_layout && flat && flat->IsFlat(tree_id)) {
+                            flat->Traverse(tree_id, fvec_tloc.first(block_size), any_missing,
+                                           nidx.data());
+                            for (std::size_t i = 0; i < block_size; ++i) {
+                              out_predt(predict_offset + i, gid) +=
+                                  flat->LeafValue(tree_id, nidx[i]) * weight;
+                              nidx[i] = 0;
+                            }
+                          } else if (has_categorical) {
                             scalar::PredValueByOneTree<true, any_missing, use_array_tree_layout>(
                                 tree, predict_offset, fvec_tloc, block_size, out_predt, nidx.data(),
                                 depth, gid, weight);
@@ -201,7 +226,9 @@ void PredictBlockByAllTrees(HostModel const &model, std::size_t const predict_of
 void DispatchArrayLayout(HostModel const &model, std::size_t const predict_offset,
                          common::Span<RegTree::FVec> fvec_tloc, std::size_t const block_size,
                          linalg::MatrixView<float> out_predt, const std::vector<int> &tree_depth,
-                         bool any_missing, common::OptionalWeights tree_weights) {
+                         bool any_missing, common::OptionalWeights tree_weights,
+                         bst_tree_t chunk_begin, bst_tree_t chunk_end,
+                         ArrayForest const *flat = nullptr) {
   auto n_trees = model.tree_end - model.tree_begin;
   CHECK_EQ(n_trees, model.Trees().size());
   /*
@@ -223,14 +250,55 @@ void DispatchArrayLayout(HostModel const &model, std::size_t const predict_offse
     }
     if (any_missing) {
       PredictBlockByAllTrees<true, true>(model, predict_offset, fvec_tloc, block_size, out_predt,
-                                         tree_depth, tree_weights);
+                                         tree_depth, tree_weights, chunk_begin, chunk_end, flat);
     } else {
       PredictBlockByAllTrees<true, false>(model, predict_offset, fvec_tloc, block_size, out_predt,
-                                          tree_depth, tree_weights);
+                                          tree_depth, tree_weights, chunk_begin, chunk_end, flat);
     }
   } else {
     PredictBlockByAllTrees<false, true>(model, predict_offset, fvec_tloc, block_size, out_predt,
-                                        tree_depth, tree_weights);
+                                        tree_depth, tree_weights, chunk_begin, chunk_end, nullptr);
+  }
+}
+
+/**
+ * @brief Find the leaf of each row in a block for one tree. The top levels of the tree are
+ *        traversed with the array layout when there's more than one row.
+ */
+template <typename TreeView>
+void LeafByOneTree(TreeView const &tree, common::Span<RegTree::FVec> fvec_tloc,
+                   std::size_t const block_size, bst_node_t depth, bool any_missing,
+                   bst_node_t *p_nidx) {
+  std::fill_n(p_nidx, block_size, RegTree::kRoot);
+  bool has_categorical = tree.HasCategoricalSplit();
+  if (block_size > 1) {
+    // Recheck if the current block has missing values.
+    any_missing = any_missing && std::any_of(fvec_tloc.cbegin(), fvec_tloc.cbegin() + block_size,
+                                             [](auto const &feat) { return feat.HasMissing(); });
+    if (has_categorical) {
+      if (any_missing) {
+        ProcessArrayTree<true, true>(tree, fvec_tloc, block_size, p_nidx, depth);
+      } else {
+        ProcessArrayTree<true, false>(tree, fvec_tloc, block_size, p_nidx, depth);
+      }
+    } else {
+      if (any_missing) {
+        ProcessArrayTree<false, true>(tree, fvec_tloc, block_size, p_nidx, depth);
+      } else {
+        ProcessArrayTree<false, false>(tree, fvec_tloc, block_size, p_nidx, depth);
+      }
+    }
+  }
+  auto const &cats = tree.GetCategoriesMatrix();
+  for (std::size_t i = 0; i < block_size; ++i) {
+    auto const &feat = fvec_tloc[i];
+    if (has_categorical) {
+      p_nidx[i] = feat.HasMissing() ? GetLeafIndex<true, true>(tree, feat, cats, p_nidx[i])
+                                    : GetLeafIndex<false, true>(tree, feat, cats, p_nidx[i]);
+    } else {
+      p_nidx[i] = feat.HasMissing() ? GetLeafIndex<true, false>(tree, feat, cats, p_nidx[i])
+                                    : GetLeafIndex<false, false>(tree, feat, cats, p_nidx[i]);
+    }
   }
 }
 
@@ -363,18 +431,30 @@ template <std::size_t kBlockOfRowsSize>
 class ThreadTmp {
  private:
   std::vector<RegTree::FVec> feat_vecs_;
+  std::int32_t n_threads_;
+  std::size_t rows_per_thread_{kBlockOfRowsSize};
 
  public:
   /**
    * @param blocked Whether block-based parallelism is used.
    */
-  explicit ThreadTmp(std::int32_t n_threads) {
+  explicit ThreadTmp(std::int32_t n_threads) : n_threads_{n_threads} {
     std::size_t n = n_threads * kBlockOfRowsSize;
     std::size_t prev_thread_temp_size = feat_vecs_.size();
     if (prev_thread_temp_size < n) {
       feat_vecs_.resize(n, RegTree::FVec{});
     }
   }
+  /**
+   * @brief Grow the buffer of each thread to hold at least `n_rows` rows. Must be called
+   *        outside of the parallel region.
+   */
+  void Reserve(std::size_t n_rows) {
+    if (n_rows > rows_per_thread_) {
+      rows_per_thread_ = n_rows;
+      feat_vecs_.resize(n_threads_ * rows_per_thread_, RegTree::FVec{});
+    }
+  }
   /**
    * @brief Get a thread local buffer.
    *
@@ -382,17 +462,77 @@ class ThreadTmp {
    */
   common::Span<RegTree::FVec> ThreadBuffer(std::size_t n) {
     std::int32_t thread_idx = omp_get_thread_num();
-    auto const fvec_offset = thread_idx * kBlockOfRowsSize;
+    auto const fvec_offset = thread_idx * rows_per_thread_;
     auto fvec_tloc = common::Span{feat_vecs_}.subspan(fvec_offset, n);
     return fvec_tloc;
   }
 };
 
+/**
+ * @brief Estimate the memory footprint of the trees used by the traversal.
+ */
+[[nodiscard]] std::size_t ModelBytes(HostModel const &model) {
+  std::size_t n_bytes = 0;
+  for (auto const &tree : model.Trees()) {
+    n_bytes += std::visit(
+        enc::Overloaded{[](tree::ScalarTreeView const &sc_tree) {
+                          return static_cast<std::size_t>(sc_tree.Size()) * sizeof(RegTree::Node);
+                        },
+                        [](tree::MultiTargetTreeView const &mt_tree) {
+                          // Children, parent, split index, default left, split condition, and
+                          // the leaf weights.
+                          std::size_t node_bytes =
+                              sizeof(bst_node_t) * 3 + sizeof(bst_feature_t) +
+                              sizeof(std::uint8_t) + sizeof(float) * (1 + mt_tree.NumTargets());
+                          return static_cast<std::size_t>(mt_tree.Size()) * node_bytes;
+                        }},
+        tree);
+  }
+  return n_bytes;
+}
+
+/**
+ * @brief Flatten the trees that are worth the padding, returns nullptr if none of them is.
+ *
+ *   The flattened forest is created once for a batch, while the array layout of the top
+ *   levels is created for each block. A tree is flattened when the batch has at least as
+ *   many rows as the padded size, and the padding is at most a few times the tree size.
+ */
+std::unique_ptr<ArrayForest> MakeArrayForest(HostModel const &model,
+                                             std::vector<int> const &tree_depth,
+                                             bst_idx_t n_samples, std::int32_t n_threads) {
+  // Maximum ratio between the padded size and the number of nodes.
+  constexpr std::size_t kMaxPadding = 16;
+  auto trees = model.Trees();
+  std::vector<tree::ScalarTreeView const *> flat(trees.size(), nullptr);
+  bool any_flat = false;
+  for (std::size_t i = 0; i < trees.size(); ++i) {
+    auto const *sc_tree = std::get_if<tree::ScalarTreeView>(&trees[i]);
+    if (sc_tree == nullptr || tree_depth[i] > ArrayForest::kMaxDepth) {
+      continue;
+    }
+    auto n_padded = std::size_t{1} << (tree_depth[i] + 1);
+    if (n_padded > n_samples || n_padded > kMaxPadding * sc_tree->Size() ||
+        !ArrayForest::IsSupported(*sc_tree, tree_depth[i])) {
+      continue;
+    }
+    flat[i] = sc_tree;
+    any_flat = true;
+  }
+  if (!any_flat) {
+    return nullptr;
+  }
+  return std::make_unique<ArrayForest>(common::Span{flat}, common::Span{tree_depth}, n_threads);
+}
+
+/**
+ * @param cache_size Cache size used to choose the tiling, 0 to use the detected cache sizes.
+ */
 template <std::size_t kBlockOfRowsSize, typename DataView>
 void PredictBatchByBlockKernel(DataView const &batch, HostModel const &model,
                                ThreadTmp<kBlockOfRowsSize> *p_fvec, std::int32_t n_threads,
                                bool any_missing, linalg::TensorView<float, 2> out_predt,
-                               common::OptionalWeights tree_weights) {
+                               common::OptionalWeights tree_weights, std::int64_t cache_size) {
   auto &fvec = *p_fvec;
   // Parallel over local batches
   auto const n_samples = batch.Size();
@@ -415,18 +555,209 @@ void PredictBatchByBlockKernel(DataView const &batch, HostModel const &model,
       });
     }
   }
-  common::ParallelFor1d<kBlockOfRowsSize>(n_samples, n_threads, [&](auto &&block) {
+  std::unique_ptr<ArrayForest> flat;
+  if (!tree_depth.empty()) {
+    flat = MakeArrayForest(model, tree_depth, n_samples, n_threads);
+  }
+  /* Tile the rows and the trees to keep both the feature vectors and the trees in cache
+   * for large models. See ChooseBlockTiling for details. Tiling is a no-op for batches
+   * that fit in a single block.
+   */
+  bst_tree_t n_trees = model.Trees().size();
+  BlockTiling tiling{kBlockOfRowsSize, std::max(n_trees, static_cast<bst_tree_t>(1))};
+  if (kBlockOfRowsSize > 1 && n_samples > kBlockOfRowsSize) {
+    static const common::CacheManager kCacheManager{};
+    // A specified cache size replaces both the L2 and the shared L3.
+    auto l2_size = cache_size > 0 ? cache_size : kCacheManager.L2Size();
+    auto l3_size = cache_size > 0 ? 0 : kCacheManager.L3Size();
+    tiling = ChooseBlockTiling(l2_size, l3_size, n_threads, ModelBytes(model), n_trees,
+                               n_features, n_samples, kBlockOfRowsSize);
+    fvec.Reserve(tiling.tile_rows);
+  }
+  auto const tile_rows = tiling.tile_rows;
+  common::ParallelFor(common::DivRoundUp(n_samples, tile_rows), n_threads, [&](auto tile_idx) {
+    std::size_t const tile_beg = tile_idx * tile_rows;
+    auto const tile_size = std::min(static_cast<std::size_t>(n_samples - tile_beg), tile_rows);
+    auto fvec_tloc = fvec.ThreadBuffer(tile_size);
+
+    batch.FVecFill(common::Range1d{tile_beg, tile_beg + tile_size}, n_features, fvec_tloc);
+    for (bst_tree_t chunk_beg = 0; chunk_beg < n_trees; chunk_beg += tiling.chunk_trees) {
+      auto chunk_end = std::min(chunk_beg + tiling.chunk_trees, n_trees);
+      for (std::size_t block_beg = 0; block_beg < tile_size; block_beg += kBlockOfRowsSize) {
+        auto block_size = std::min(tile_size - block_beg, kBlockOfRowsSize);
+        DispatchArrayLayout(model, tile_beg + block_beg + batch.base_rowid,
+                            fvec_tloc.subspan(block_beg, block_size), block_size, out_predt,
+                            tree_depth, any_missing, tree_weights, chunk_beg, chunk_end,
+                            flat.get());
+      }
+    }
+    batch.FVecDrop(fvec_tloc);
+  });
+}
+
+/**
+ * @brief Run the traversal with a copy of the model on each NUMA node.
+ *
+ *   The rows of the batch are split between the nodes, and the blocks of each node are
+ *   processed by the threads pinned to the node with the local copy of the trees.
+ */
+template <std::size_t kBlockOfRowsSize, typename DataView>
+void PredictBatchByNuma(DataView const &batch, NumaReplicatedModel const &replicas,
+                        std::vector<HostModel> const &h_models,
+                        ThreadTmp<kBlockOfRowsSize> *p_fvec, std::int32_t n_threads,
+                        bool any_missing, linalg::TensorView<float, 2> out_predt,
+                        common::OptionalWeights tree_weights) {
+  auto &fvec = *p_fvec;
+  auto const n_samples = batch.Size();
+  auto const &h_model = h_models.front();
+  bst_tree_t n_trees = h_model.Trees().size();
+  std::vector<int> tree_depth;
+  if constexpr (kBlockOfRowsSize > 1) {
+    tree_depth.resize(n_trees);
+    common::ParallelFor(n_trees, n_threads, [&](auto i) {
+      std::visit([&](auto &&tree) { tree_depth[i] = tree.MaxDepth(); }, h_model.Trees()[i]);
+    });
+  }
+
+  auto partition = PartitionByNuma(replicas.Nodes(), n_threads, n_samples);
+  auto n_nodes = replicas.NumNodes();
+  // Blocks of each node are claimed by the threads of the node.
+  std::vector<std::atomic<std::size_t>> next_block(n_nodes);
+  for (auto &v : next_block) {
+    v.store(0);
+  }
+  common::ParallelFor(n_threads, n_threads, common::Sched::Static(), [&](std::int32_t tidx) {
+    auto node = partition.thread_node[tidx];
+    ScopedThreadAffinity pin{replicas.Nodes()[node].cpus};
+    auto const &local_model = h_models[node];
+    auto node_beg = partition.row_ptr[node];
+    auto node_end = partition.row_ptr[node + 1];
+    while (true) {
+      auto block_beg = node_beg + next_block[node].fetch_add(1) * kBlockOfRowsSize;
+      if (block_beg >= node_end) {
+        break;
+      }
+      auto block_size =
+          std::min(static_cast<std::size_t>(node_end - block_beg), kBlockOfRowsSize);
+      auto fvec_tloc = fvec.ThreadBuffer(block_size);
+      batch.FVecFill(common::Range1d{block_beg, block_beg + block_size}, local_model.n_features,
+                     fvec_tloc);
+      DispatchArrayLayout(local_model, block_beg + batch.base_rowid, fvec_tloc, block_size,
+                          out_predt, tree_depth, any_missing, tree_weights, 0, n_trees);
+      batch.FVecDrop(fvec_tloc);
+    }
+  });
+}
+
+/**
+ * @brief Create the QuickScorer representation of the model, returns nullptr if any of
+ *        the trees is not supported.
+ */
+std::shared_ptr<QuickScorerForest const> MakeQuickScorer(HostModel const &model,
+                                                         common::OptionalWeights tree_weights) {
+  std::vector<tree::ScalarTreeView> trees;
+  for (auto const &tree : model.Trees()) {
+    auto const *sc_tree = std::get_if<tree::ScalarTreeView>(&tree);
+    if (sc_tree == nullptr || !QuickScorerForest::IsSupported(*sc_tree)) {
+      return nullptr;
+    }
+    trees.push_back(*sc_tree);
+  }
+  return std::make_shared<QuickScorerForest const>(common::Span{trees}, model.tree_groups,
+                                                   model.n_features, tree_weights);
+}
+
+/**
+ * @brief Get a layout of the forest from the cache on the model. The layout is built with
+ *        `make` if the cached one is for a different range of trees or tree weights.
+ */
+template <typename Forest, typename MakeFn>
+std::shared_ptr<Forest const> GetCachedLayout(gbm::GBTreeModel const &model,
+                                              CachedLayout<Forest> ForestLayoutCache::*layout,
+                                              bst_tree_t tree_begin, bst_tree_t tree_end,
+                                              common::OptionalWeights tree_weights,
+                                              MakeFn &&make) {
+  std::lock_guard guard{model.Mutex()};
+  auto &p_cache = model.LayoutCache();
+  if (!p_cache) {
+    p_cache = std::make_shared<ForestLayoutCache>();
+  }
+  auto &entry = (*p_cache).*layout;
+  if (!entry.Matches(tree_begin, tree_end, tree_weights)) {
+    entry.Reset(tree_begin, tree_end, tree_weights, make());
+  }
+  return entry.forest;
+}
+
+template <std::size_t kBlockOfRowsSize, typename DataView>
+void PredictBatchByQuickScorer(DataView const &batch, QuickScorerForest const &forest,
+                               bst_feature_t n_features, ThreadTmp<kBlockOfRowsSize> *p_fvec,
+                               std::int32_t n_threads, linalg::TensorView<float, 2> out_predt) {
+  auto &fvec = *p_fvec;
+  auto n_words = forest.WorkspaceSize();
+  std::vector<QuickScorerForest::WordT> workspace(n_words * n_threads);
+  common::ParallelFor1d<kBlockOfRowsSize>(batch.Size(), n_threads, [&](auto &&block) {
     auto fvec_tloc = fvec.ThreadBuffer(block.Size());
+    auto ws_tloc = common::Span{workspace}.subspan(omp_get_thread_num() * n_words, n_words);
 
     batch.FVecFill(block, n_features, fvec_tloc);
-    DispatchArrayLayout(model, block.begin() + batch.base_rowid, fvec_tloc, block.Size(), out_predt,
-                        tree_depth, any_missing, tree_weights);
+    for (std::size_t i = 0; i < block.Size(); ++i) {
+      auto ridx = block.begin() + batch.base_rowid + i;
+      forest.PredictRow(fvec_tloc[i], ws_tloc, out_predt.Slice(ridx, linalg::All()));
+    }
     batch.FVecDrop(fvec_tloc);
   });
 }
 
+/**
+ * @brief Create the quantized representation of the model, returns nullptr if any of the
+ *        trees is not supported.
+ */
+std::shared_ptr<QuantizedForest const> MakeQuantizedForest(HostModel const &model,
+                                                           common::OptionalWeights tree_weights) {
+  std::vector<tree::ScalarTreeView> trees;
+  for (auto const &tree : model.Trees()) {
+    auto const *sc_tree = std::get_if<tree::ScalarTreeView>(&tree);
+    if (sc_tree == nullptr || !QuantizedForest::IsSupported(*sc_tree)) {
+      return nullptr;
+    }
+    trees.push_back(*sc_tree);
+  }
+  return QuantizedForest::Create(common::Span{trees}, model.tree_groups, model.n_features,
+                                 tree_weights);
+}
+
+template <std::size_t kBlockOfRowsSize, typename DataView>
+void PredictBatchByQuantizedForest(DataView const &batch, QuantizedForest const &forest,
+                                   bst_feature_t n_features, ThreadTmp<kBlockOfRowsSize> *p_fvec,
+                                   std::int32_t n_threads, linalg::TensorView<float, 2> out_predt) {
+  auto &fvec = *p_fvec;
+  auto n_bytes = forest.RowBytes() * kBlockOfRowsSize;
+  std::vector<std::uint8_t> bins(n_bytes * n_threads);
+  common::ParallelFor1d<kBlockOfRowsSize>(batch.Size(), n_threads, [&](auto &&block) {
+    auto fvec_tloc = fvec.ThreadBuffer(block.Size());
+    auto bins_tloc = common::Span{bins}.subspan(omp_get_thread_num() * n_bytes,
+                                                forest.RowBytes() * block.Size());
+
+    batch.FVecFill(block, n_features, fvec_tloc);
+    forest.BinRows(fvec_tloc, bins_tloc);
+    batch.FVecDrop(fvec_tloc);
+
+    auto ridx = block.begin() + batch.base_rowid;
+    forest.Predict(bins_tloc,
+                   out_predt.Slice(linalg::Range(ridx, ridx + block.Size()), linalg::All()));
+  });
+}
 }  // anonymous namespace
 
+/** @brief Inference algorithm used by the CPU predictor. */
+enum class CPUAlgorithm : std::int8_t {
+  kTraversal = 0,
+  kQuickScorer = 1,
+  kQuantized = 2,
+  kNuma = 3,
+};
+
 class CPUPredictor : public Predictor {
  protected:
   void PredictDMatrix(DMatrix *p_fmat, std::vector<float> *out_preds, gbm::GBTreeModel const &model,
@@ -442,19 +773,75 @@ class CPUPredictor : public Predictor {
     bool any_missing = !(p_fmat->IsDense());
     auto const h_model =
         HostModel{DeviceOrd::CPU(), model, false, tree_begin, tree_end, CopyViews{}};
+    std::shared_ptr<QuickScorerForest const> forest;
+    if (algo_ == CPUAlgorithm::kQuickScorer) {
+      forest = GetCachedLayout(model, &ForestLayoutCache::quick_scorer, tree_begin, tree_end,
+                               tree_weights,
+                               [&] { return MakeQuickScorer(h_model, tree_weights); });
+    }
+    std::shared_ptr<QuantizedForest const> q_forest;
+    if (algo_ == CPUAlgorithm::kQuantized) {
+      q_forest = GetCachedLayout(model, &ForestLayoutCache::quantized, tree_begin, tree_end,
+                                 tree_weights,
+                                 [&] { return MakeQuantizedForest(h_model, tree_weights); });
+    }
+    // Each node needs at least one thread.
+    auto replicas = algo_ == CPUAlgorithm::kNuma ? GetNumaReplicas(model) : nullptr;
+    if (replicas && static_cast<std::size_t>(n_threads) < replicas->NumNodes()) {
+      replicas.reset();
+    }
+    std::vector<HostModel> h_replicas;
+    if (replicas) {
+      h_replicas.reserve(replicas->NumNodes());
+      for (std::size_t k = 0; k < replicas->NumNodes(); ++k) {
+        h_replicas.emplace_back(DeviceOrd::CPU(), replicas->Replica(k), false, tree_begin,
+                                tree_end, CopyViews{});
+      }
+    }
 
     LaunchPredict(this->ctx_, p_fmat, model, [&](auto &&policy) {
       using Policy = common::GetValueT<decltype(policy)>;
       ThreadTmp<Policy::kBlockOfRowsSize> feat_vecs{n_threads};
       policy.ForEachBatch([&](auto &&batch) {
-        PredictBatchByBlockKernel<Policy::kBlockOfRowsSize>(batch, h_model, &feat_vecs, n_threads,
-                                                            any_missing, out_predt, tree_weights);
+        if (replicas) {
+          PredictBatchByNuma<Policy::kBlockOfRowsSize>(batch, *replicas, h_replicas, &feat_vecs,
+                                                       n_threads, any_missing, out_predt,
+                                                       tree_weights);
+        } else if (forest) {
+          PredictBatchByQuickScorer<Policy::kBlockOfRowsSize>(
+              batch, *forest, h_model.n_features, &feat_vecs, n_threads, out_predt);
+        } else if (q_forest) {
+          PredictBatchByQuantizedForest<Policy::kBlockOfRowsSize>(
+              batch, *q_forest, h_model.n_features, &feat_vecs, n_threads, out_predt);
+        } else {
+          PredictBatchByBlockKernel<Policy::kBlockOfRowsSize>(batch, h_model, &feat_vecs,
+                                                              n_threads, any_missing, out_predt,
+                                                              tree_weights, tiling_cache_size_);
+        }
       });
     });
   }
 
+  // Models not supported by the selected algorithm use the tree traversal.
+  CPUAlgorithm algo_{CPUAlgorithm::kTraversal};
+  interpretability::ShapAlgorithm shap_algo_{interpretability::ShapAlgorithm::kQuadrature};
+  // Cache size in bytes for choosing the block tiling, 0 to detect. Only set by tests.
+  std::int64_t tiling_cache_size_{0};
+
  public:
-  explicit CPUPredictor(Context const *ctx) : Predictor::Predictor{ctx} {}
+  explicit CPUPredictor(Context const *ctx, CPUAlgorithm algo = CPUAlgorithm::kTraversal)
+      : Predictor::Predictor{ctx}, algo_{algo} {}
+
+  void Configure(Args const &cfg) override {
+    for (auto const &[key, value] : cfg) {
+      if (key == "shap_algorithm") {
+        shap_algo_ = interpretability::ParseShapAlgorithm(value);
+      } else if (key == "tiling_cache_size") {
+        tiling_cache_size_ = std::stoll(value);
+        CHECK_GE(tiling_cache_size_, 0) << "Invalid cache size for the block tiling.";
+      }
+    }
+  }
 
   void PredictBatch(DMatrix *dmat, HostDeviceVector<float> *out_preds,
                     gbm::GBTreeModel const &model, bst_tree_t tree_begin, bst_tree_t tree_end = 0,
@@ -497,11 +884,31 @@ class CPUPredictor : public Predictor {
                                            : common::OptionalWeights{common::Span<float const>{
                                                  tree_weights->data() + tree_begin,
                                                  static_cast<std::size_t>(tree_end - tree_begin)}};
+    std::shared_ptr<QuickScorerForest const> forest;
+    if (algo_ == CPUAlgorithm::kQuickScorer) {
+      forest = GetCachedLayout(model, &ForestLayoutCache::quick_scorer, tree_begin, tree_end,
+                               weights, [&] { return MakeQuickScorer(h_model, weights); });
+    }
+    std::shared_ptr<QuantizedForest const> q_forest;
+    if (algo_ == CPUAlgorithm::kQuantized) {
+      q_forest = GetCachedLayout(model, &ForestLayoutCache::quantized, tree_begin, tree_end,
+                                 weights, [&] { return MakeQuantizedForest(h_model, weights); });
+    }
 
     auto kernel = [&](auto &&view) {
       auto out_predt = linalg::MakeTensorView(ctx_, predictions, view.Size(), n_groups);
-      PredictBatchByBlockKernel<BlockPolicy::kBlockOfRowsSize>(view, h_model, &feat_vecs, n_threads,
-                                                               any_missing, out_predt, weights);
+      if (forest) {
+        PredictBatchByQuickScorer<BlockPolicy::kBlockOfRowsSize>(
+            view, *forest, h_model.n_features, &feat_vecs, n_threads, out_predt);
+      } else if (q_forest) {
+        PredictBatchByQuantizedForest<BlockPolicy::kBlockOfRowsSize>(
+            view, *q_forest, h_model.n_features, &feat_vecs, n_threads, out_predt);
+      } else {
+        PredictBatchByBlockKernel<BlockPolicy::kBlockOfRowsSize>(view, h_model, &feat_vecs,
+                                                                 n_threads, any_missing,
+                                                                 out_predt, weights,
+                                                                 tiling_cache_size_);
+      }
     };
     auto dispatch = [&](auto x) {
       using AdapterT = typename decltype(x)::element_type;
@@ -532,34 +939,245 @@ class CPUPredictor : public Predictor {
     return !type_error;
   }
 
-  void PredictLeaf(DMatrix *p_fmat, HostDeviceVector<float> *out_preds,
-                   gbm::GBTreeModel const &model, bst_tree_t ntree_limit) const override {
+  void PredictEarlyExit(DMatrix *p_fmat, float threshold, HostDeviceVector<float> *out_preds,
+                        HostDeviceVector<bst_tree_t> *out_n_trees, gbm::GBTreeModel const &model,
+                        bst_tree_t tree_begin, bst_tree_t tree_end) const override {
+    CHECK(!model.learner_model_state->IsVectorLeaf())
+        << "Early exit prediction" << MTNotImplemented();
+    CHECK_EQ(model.learner_model_state->OutputLength(), 1)
+        << "Early exit prediction only supports models with a single output.";
+    if (tree_end == 0) {
+      tree_end = model.trees.size();
+    }
     auto const n_threads = this->ctx_->Threads();
-    // number of valid trees
-    ntree_limit = GetTreeLimit(model.trees, ntree_limit);
-    const MetaInfo &info = p_fmat->Info();
-    std::vector<float> &preds = out_preds->HostVector();
-    preds.resize(info.num_row_ * ntree_limit);
+    auto const &info = p_fmat->Info();
+    auto &h_preds = out_preds->HostVector();
+    CHECK_EQ(h_preds.size(), info.num_row_);
+    out_n_trees->Resize(info.num_row_);
+    auto &h_n_trees = out_n_trees->HostVector();
 
-    auto n_features = model.learner_model_state->num_feature;
-    ThreadTmp<1> feat_vecs{n_threads};
+    auto const h_model =
+        HostModel{DeviceOrd::CPU(), model, false, tree_begin, tree_end, CopyViews{}};
+    auto const *tree_weights = model.TreeWeights();
+    auto weights = tree_weights == nullptr ? common::OptionalWeights{1.0f}
+                                           : common::OptionalWeights{common::Span<float const>{
+                                                 tree_weights->data() + tree_begin,
+                                                 static_cast<std::size_t>(tree_end - tree_begin)}};
+    // Bounds of the margin from the remaining trees.
+    std::vector<double> lower, upper;
+    h_model.MarginBounds(weights, &lower, &upper);
 
-    auto const h_model = HostModel{DeviceOrd::CPU(), model, false, 0, ntree_limit, CopyViews{}};
+    bst_tree_t n_trees = h_model.Trees().size();
+    ThreadTmp<1> feat_vecs{n_threads};
     LaunchPredict(this->ctx_, p_fmat, model, [&](auto &&policy) {
       policy.ForEachBatch([&](auto &&batch) {
         common::ParallelFor1d<1>(batch.Size(), n_threads, [&](auto &&block) {
           auto ridx = static_cast<bst_idx_t>(batch.base_rowid + block.begin());
           auto fvec_tloc = feat_vecs.ThreadBuffer(block.Size());
+          batch.FVecFill(block, h_model.n_features, fvec_tloc);
+          auto const &feats = fvec_tloc.front();
+
+          float margin = h_preds[ridx];
+          bst_tree_t tree_idx = 0;
+          for (; tree_idx < n_trees; ++tree_idx) {
+            if (margin + lower[tree_idx] > threshold) {
+              // Don't let the rounding put the bound on the threshold.
+              margin = std::max(static_cast<float>(margin + lower[tree_idx]),
+                                std::nextafter(threshold, std::numeric_limits<float>::max()));
+              break;
+            }
+            if (margin + upper[tree_idx] <= threshold) {
+              margin += upper[tree_idx];
+              break;
+            }
+            auto const &sc_tree = std::get<tree::ScalarTreeView>(h_model.Trees()[tree_idx]);
+            auto const &cats = sc_tree.GetCategoriesMatrix();
+            auto leaf_value = sc_tree.HasCategoricalSplit()
+                                  ? scalar::PredValueByOneTree<true>(feats, sc_tree, cats, 0)
+                                  : scalar::PredValueByOneTree<false>(feats, sc_tree, cats, 0);
+            margin += leaf_value * weights[tree_idx];
+          }
+          h_preds[ridx] = margin;
+          h_n_trees[ridx] = tree_idx;
+          batch.FVecDrop(fvec_tloc);
+        });
+      });
+    });
+  }
+
+  void PredictStaged(DMatrix *p_fmat, common::Span<bst_tree_t const> stages,
+                     HostDeviceVector<float> *out_preds,
+                     gbm::GBTreeModel const &model) const override {
+    CHECK(!stages.empty());
+    auto const n_threads = this->ctx_->Threads();
+    bst_idx_t n_groups = model.learner_model_state->OutputLength();
+    bst_idx_t n_samples = p_fmat->Info().num_row_;
+    auto n_stages = stages.size();
+    auto &h_preds = out_preds->HostVector();
+    CHECK_EQ(h_preds.size(), n_samples * n_groups);
+    // Each stage starts from the output of the previous stage, the first one starts from
+    // the base margin.
+    std::vector<float> base_margin{h_preds};
+    h_preds.resize(n_stages * n_samples * n_groups);
+    auto h_base = linalg::MakeTensorView(ctx_, base_margin, n_samples, n_groups);
+    auto out_predt = linalg::MakeTensorView(ctx_, h_preds, n_stages, n_samples, n_groups);
+
+    bst_tree_t tree_end = stages.back();
+    auto const h_model = HostModel{DeviceOrd::CPU(), model, false, 0, tree_end, CopyViews{}};
+    auto const *tree_weights = model.TreeWeights();
+    auto weights = tree_weights == nullptr
+                       ? common::OptionalWeights{1.0f}
+                       : common::OptionalWeights{common::Span<float const>{
+                             tree_weights->data(), static_cast<std::size_t>(tree_end)}};
+    bool any_missing = !(p_fmat->IsDense());
+
+    LaunchPredict(this->ctx_, p_fmat, model, [&](auto &&policy) {
+      using Policy = common::GetValueT<decltype(policy)>;
+      constexpr std::size_t kBlockOfRowsSize = Policy::kBlockOfRowsSize;
+      std::vector<int> tree_depth;
+      if constexpr (kBlockOfRowsSize > 1) {
+        tree_depth.resize(tree_end);
+        common::ParallelFor(tree_end, n_threads, [&](auto i) {
+          std::visit([&](auto &&tree) { tree_depth[i] = tree.MaxDepth(); }, h_model.Trees()[i]);
+        });
+      }
+      ThreadTmp<kBlockOfRowsSize> feat_vecs{n_threads};
+      policy.ForEachBatch([&](auto &&batch) {
+        common::ParallelFor1d<kBlockOfRowsSize>(batch.Size(), n_threads, [&](auto &&block) {
+          auto ridx = block.begin() + batch.base_rowid;
+          auto fvec_tloc = feat_vecs.ThreadBuffer(block.Size());
+          batch.FVecFill(block, h_model.n_features, fvec_tloc);
+          // Fill the feature vectors once, then walk through the stages with the trees
+          // between the boundaries.
+          bst_tree_t stage_begin = 0;
+          for (std::size_t s = 0; s < n_stages; ++s) {
+            auto stage_predt = out_predt.Slice(s, linalg::All(), linalg::All());
+            for (std::size_t i = ridx; i < ridx + block.Size(); ++i) {
+              for (bst_idx_t gidx = 0; gidx < n_groups; ++gidx) {
+                stage_predt(i, gidx) = s == 0 ? h_base(i, gidx) : out_predt(s - 1, i, gidx);
+              }
+            }
+            DispatchArrayLayout(h_model, ridx, fvec_tloc, block.Size(), stage_predt, tree_depth,
+                                any_missing, weights, stage_begin, stages[s]);
+            stage_begin = stages[s];
+          }
+          batch.FVecDrop(fvec_tloc);
+        });
+      });
+    });
+  }
+
+  void PredictBatchMulti(DMatrix *p_fmat, common::Span<gbm::GBTreeModel const *const> models,
+                         common::Span<HostDeviceVector<float> *const> out_preds) const override {
+    CHECK_EQ(models.size(), out_preds.size());
+    if (models.empty()) {
+      return;
+    }
+    auto const n_threads = this->ctx_->Threads();
+    bst_idx_t n_samples = p_fmat->Info().num_row_;
+    bool any_missing = !(p_fmat->IsDense());
+
+    // The feature vectors are sized for the widest model.
+    bst_feature_t n_features = 0;
+    std::vector<std::unique_ptr<HostModel const>> h_models;
+    std::vector<common::OptionalWeights> weights;
+    std::vector<linalg::MatrixView<float>> out_predts;
+    for (std::size_t i = 0; i < models.size(); ++i) {
+      auto const &model = *models[i];
+      // The categories of the data are re-encoded for each model in the tree traversal,
+      // which can't be shared.
+      CHECK(!model.Cats()->HasCategorical() || !p_fmat->Cats()->NeedRecode())
+          << "Multi-model prediction doesn't support re-coding categorical features.";
+      bst_tree_t n_trees = model.trees.size();
+      h_models.emplace_back(
+          std::make_unique<HostModel>(DeviceOrd::CPU(), model, false, 0, n_trees, CopyViews{}));
+      n_features = std::max(n_features, h_models.back()->n_features);
+      auto const *tree_weights = model.TreeWeights();
+      weights.push_back(tree_weights == nullptr
+                            ? common::OptionalWeights{1.0f}
+                            : common::OptionalWeights{common::Span<float const>{*tree_weights}});
+      bst_idx_t n_groups = model.learner_model_state->OutputLength();
+      CHECK_EQ(out_preds[i]->Size(), n_samples * n_groups);
+      out_predts.push_back(
+          linalg::MakeTensorView(ctx_, out_preds[i]->HostVector(), n_samples, n_groups));
+    }
+
+    auto dispatch = [&](auto &&policy) {
+      using Policy = common::GetValueT<decltype(policy)>;
+      constexpr std::size_t kBlockOfRowsSize = Policy::kBlockOfRowsSize;
+      std::vector<std::vector<int>> tree_depth(h_models.size());
+      if constexpr (kBlockOfRowsSize > 1) {
+        for (std::size_t i = 0; i < h_models.size(); ++i) {
+          auto const &h_model = *h_models[i];
+          tree_depth[i].resize(h_model.Trees().size());
+          common::ParallelFor(h_model.Trees().size(), n_threads, [&](auto j) {
+            std::visit([&](auto &&tree) { tree_depth[i][j] = tree.MaxDepth(); },
+                       h_model.Trees()[j]);
+          });
+        }
+      }
+      ThreadTmp<kBlockOfRowsSize> feat_vecs{n_threads};
+      policy.ForEachBatch([&](auto &&batch) {
+        common::ParallelFor1d<kBlockOfRowsSize>(batch.Size(), n_threads, [&](auto &&block) {
+          auto ridx = block.begin() + batch.base_rowid;
+          auto fvec_tloc = feat_vecs.ThreadBuffer(block.Size());
+          // Fill the feature vectors once for all the models.
           batch.FVecFill(block, n_features, fvec_tloc);
+          for (std::size_t i = 0; i < h_models.size(); ++i) {
+            auto const &h_model = *h_models[i];
+            bst_tree_t n_trees = h_model.Trees().size();
+            DispatchArrayLayout(h_model, ridx, fvec_tloc, block.Size(), out_predts[i],
+                                tree_depth[i], any_missing, weights[i], 0, n_trees);
+          }
+          batch.FVecDrop(fvec_tloc);
+        });
+      });
+    };
+    // No re-coding, checked above.
+    LaunchPredict(this->ctx_, p_fmat, *models.front(), dispatch,
+                  [](DMatrix const *) { return false; });
+  }
 
-          for (bst_tree_t j = 0; j < ntree_limit; ++j) {
-            bst_node_t nidx = std::visit(
+ private:
+  /**
+   * @brief Find the leaf of each row for the trees in `[0, tree_end)`. Blocks of rows are
+   *        processed in parallel, with one tree at a time for each block.
+   *
+   * @param fn Called with the row index, the tree index, and the leaf node index.
+   */
+  template <typename Fn>
+  void ForEachLeaf(DMatrix *p_fmat, gbm::GBTreeModel const &model, bst_tree_t tree_end,
+                   Fn &&fn) const {
+    auto const n_threads = this->ctx_->Threads();
+    auto const h_model = HostModel{DeviceOrd::CPU(), model, false, 0, tree_end, CopyViews{}};
+    bool any_missing = !(p_fmat->IsDense());
+
+    LaunchPredict(this->ctx_, p_fmat, model, [&](auto &&policy) {
+      using Policy = common::GetValueT<decltype(policy)>;
+      constexpr std::size_t kBlockOfRowsSize = Policy::kBlockOfRowsSize;
+      std::vector<int> tree_depth(tree_end, 0);
+      if constexpr (kBlockOfRowsSize > 1) {
+        common::ParallelFor(tree_end, n_threads, [&](auto i) {
+          std::visit([&](auto &&tree) { tree_depth[i] = tree.MaxDepth(); }, h_model.Trees()[i]);
+        });
+      }
+      ThreadTmp<kBlockOfRowsSize> feat_vecs{n_threads};
+      policy.ForEachBatch([&](auto &&batch) {
+        common::ParallelFor1d<kBlockOfRowsSize>(batch.Size(), n_threads, [&](auto &&block) {
+          auto ridx = static_cast<bst_idx_t>(batch.base_rowid + block.begin());
+          auto fvec_tloc = feat_vecs.ThreadBuffer(block.Size());
+          batch.FVecFill(block, h_model.n_features, fvec_tloc);
+          std::array<bst_node_t, kBlockOfRowsSize> nidx;
+          for (bst_tree_t tree_id = 0; tree_id < tree_end; ++tree_id) {
+            std::visit(
                 [&](auto &&tree) {
-                  return GetLeafIndex<true, true>(tree, fvec_tloc.front(),
-                                                  tree.GetCategoriesMatrix(), RegTree::kRoot);
+                  LeafByOneTree(tree, fvec_tloc, block.Size(), tree_depth[tree_id], any_missing,
+                                nidx.data());
                 },
-                h_model.Trees()[j]);
-            preds[ridx * ntree_limit + j] = static_cast<float>(nidx);
+                h_model.Trees()[tree_id]);
+            for (std::size_t i = 0; i < block.Size(); ++i) {
+              fn(ridx + i, tree_id, nidx[i]);
+            }
           }
           batch.FVecDrop(fvec_tloc);
         });
@@ -567,6 +1185,105 @@ class CPUPredictor : public Predictor {
     });
   }
 
+ public:
+  void PredictLeaf(DMatrix *p_fmat, HostDeviceVector<float> *out_preds,
+                   gbm::GBTreeModel const &model, bst_tree_t ntree_limit) const override {
+    // number of valid trees
+    ntree_limit = GetTreeLimit(model.trees, ntree_limit);
+    const MetaInfo &info = p_fmat->Info();
+    std::vector<float> &preds = out_preds->HostVector();
+    preds.resize(info.num_row_ * ntree_limit);
+    this->ForEachLeaf(p_fmat, model, ntree_limit,
+                      [&](bst_idx_t ridx, bst_tree_t tree_id, bst_node_t nidx) {
+                        preds[ridx * ntree_limit + tree_id] = static_cast<float>(nidx);
+                      });
+  }
+
+  void PredictLeafCompact(DMatrix *p_fmat, HostDeviceVector<std::uint8_t> *out_leaf,
+                          std::int32_t *out_bytes, gbm::GBTreeModel const &model,
+                          bst_tree_t ntree_limit) const override {
+    ntree_limit = GetTreeLimit(model.trees, ntree_limit);
+    bst_node_t max_nodes = 0;
+    for (bst_tree_t i = 0; i < ntree_limit; ++i) {
+      max_nodes = std::max(max_nodes, model.trees[i]->Size());
+    }
+    // The largest node index is `max_nodes - 1`.
+    std::int32_t n_bytes = sizeof(std::uint32_t);
+    if (max_nodes <= std::numeric_limits<std::uint8_t>::max() + 1) {
+      n_bytes = sizeof(std::uint8_t);
+    } else if (max_nodes <= std::numeric_limits<std::uint16_t>::max() + 1) {
+      n_bytes = sizeof(std::uint16_t);
+    }
+    *out_bytes = n_bytes;
+
+    auto const &info = p_fmat->Info();
+    auto &h_leaf = out_leaf->HostVector();
+    h_leaf.resize(info.num_row_ * ntree_limit * n_bytes);
+    auto write = [&](auto t) {
+      using T = decltype(t);
+      auto *p_out = reinterpret_cast<T *>(h_leaf.data());
+      this->ForEachLeaf(p_fmat, model, ntree_limit,
+                        [&](bst_idx_t ridx, bst_tree_t tree_id, bst_node_t nidx) {
+                          p_out[ridx * ntree_limit + tree_id] = static_cast<T>(nidx);
+                        });
+    };
+    switch (n_bytes) {
+      case sizeof(std::uint8_t):
+        write(std::uint8_t{});
+        break;
+      case sizeof(std::uint16_t):
+        write(std::uint16_t{});
+        break;
+      default:
+        write(std::uint32_t{});
+        break;
+    }
+  }
+
+  void PredictLeafOneHot(DMatrix *p_fmat, HostDeviceVector<bst_idx_t> *out_indptr,
+                         HostDeviceVector<bst_feature_t> *out_indices,
+                         bst_feature_t *out_n_columns, gbm::GBTreeModel const &model,
+                         bst_tree_t ntree_limit) const override {
+    ntree_limit = GetTreeLimit(model.trees, ntree_limit);
+    // Number the leaves of each tree, the columns of a tree start after the previous trees.
+    std::vector<std::vector<bst_feature_t>> leaf_columns(ntree_limit);
+    bst_idx_t n_columns = 0;
+    for (bst_tree_t i = 0; i < ntree_limit; ++i) {
+      auto const &tree = *model.trees[i];
+      auto &columns = leaf_columns[i];
+      columns.resize(tree.Size(), 0);
+      auto number = [&](auto const &view, auto is_deleted) {
+        for (bst_node_t nidx = 0; nidx < view.Size(); ++nidx) {
+          if (view.IsLeaf(nidx) && !is_deleted(view, nidx)) {
+            CHECK_LT(n_columns, std::numeric_limits<bst_feature_t>::max())
+                << "Too many leaves for the one-hot encoding.";
+            columns[nidx] = static_cast<bst_feature_t>(n_columns++);
+          }
+        }
+      };
+      if (tree.IsMultiTarget()) {
+        number(tree.HostMtView(), [](auto const &, bst_node_t) { return false; });
+      } else {
+        number(tree.HostScView(),
+               [](auto const &view, bst_node_t nidx) { return view.IsDeleted(nidx); });
+      }
+    }
+    *out_n_columns = static_cast<bst_feature_t>(n_columns);
+
+    auto const &info = p_fmat->Info();
+    auto &h_indptr = out_indptr->HostVector();
+    h_indptr.resize(info.num_row_ + 1);
+    for (std::size_t i = 0; i < h_indptr.size(); ++i) {
+      h_indptr[i] = i * ntree_limit;
+    }
+    auto &h_indices = out_indices->HostVector();
+    h_indices.resize(info.num_row_ * ntree_limit);
+    this->ForEachLeaf(p_fmat, model, ntree_limit,
+                      [&](bst_idx_t ridx, bst_tree_t tree_id, bst_node_t nidx) {
+                        h_indices[ridx * ntree_limit + tree_id] = leaf_columns[tree_id][nidx];
+                      });
+  }
+
   void PredictFromLeafIds(common::Span<HostDeviceVector<bst_node_t> const> leaf_ids,
                           common::Span<RegTree const *> trees,
                           linalg::MatrixView<float> out_preds) const override {
@@ -608,6 +1325,12 @@ class CPUPredictor : public Predictor {
     if (approximate) {
       interpretability::ApproxFeatureImportance(this->ctx_, p_fmat, out_contribs, model,
                                                 ntree_limit, tree_weights);
+    } else if (shap_algo_ == interpretability::ShapAlgorithm::kLinear) {
+      CHECK_EQ(condition, 0) << "Linear TreeSHAP doesn't support conditioned attributions.";
+      CHECK_EQ(condition_feature, 0U)
+          << "Linear TreeSHAP doesn't support conditioned attributions.";
+      interpretability::cpu_impl::LinearTreeShapValues(this->ctx_, p_fmat, out_contribs, model,
+                                                       ntree_limit, tree_weights);
     } else {
       interpretability::ShapValues(this->ctx_, p_fmat, out_contribs, model, ntree_limit,
                                    tree_weights, condition, condition_feature);
@@ -621,9 +1344,43 @@ class CPUPredictor : public Predictor {
     interpretability::ShapInteractionValues(this->ctx_, p_fmat, out_contribs, model, ntree_limit,
                                             tree_weights, approximate);
   }
+
+  void PredictContributionTopK(DMatrix *p_fmat, bst_feature_t top_k,
+                               HostDeviceVector<bst_idx_t> *out_indptr,
+                               HostDeviceVector<bst_feature_t> *out_indices,
+                               HostDeviceVector<float> *out_values, gbm::GBTreeModel const &model,
+                               bst_tree_t ntree_limit) const override {
+    interpretability::cpu_impl::ShapValuesTopK(this->ctx_, p_fmat, model, ntree_limit,
+                                               model.TreeWeights(), top_k, out_indptr,
+                                               out_indices, out_values);
+  }
+
+  void PredictContributionStream(DMatrix *p_fmat, bool interactions, bst_idx_t block_rows,
+                                 predictor::ContributionSink *sink, gbm::GBTreeModel const &model,
+                                 bst_tree_t ntree_limit) const override {
+    interpretability::cpu_impl::ShapValuesStream(this->ctx_, p_fmat, model, ntree_limit,
+                                                 model.TreeWeights(), interactions, block_rows,
+                                                 sink);
+  }
 };
 
 XGBOOST_REGISTER_PREDICTOR(CPUPredictor, "cpu_predictor")
     .describe("Make predictions using CPU.")
     .set_body([](Context const *ctx) { return new CPUPredictor(ctx); });
+
+XGBOOST_REGISTER_PREDICTOR(CPUQuickScorerPredictor, "cpu_quickscorer_predictor")
+    .describe("Make predictions using CPU with the bitvector-based QuickScorer algorithm.")
+    .set_body([](Context const *ctx) {
+      return new CPUPredictor(ctx, CPUAlgorithm::kQuickScorer);
+    });
+
+XGBOOST_REGISTER_PREDICTOR(CPUQuantizedPredictor, "cpu_quantized_predictor")
+    .describe("Make predictions using CPU on feature bins derived from the split thresholds.")
+    .set_body([](Context const *ctx) {
+      return new CPUPredictor(ctx, CPUAlgorithm::kQuantized);
+    });
+
+XGBOOST_REGISTER_PREDICTOR(CPUNumaPredictor, "cpu_numa_predictor")
+    .describe("Make predictions using CPU with a copy of the model on each NUMA node.")
+    .set_body([](Context const *ctx) { return new CPUPredictor(ctx, CPUAlgorithm::kNuma); });
 }  // namespace xgboost::predictor
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Alternative forest layouts of the CPU predictor that are kept between calls.
+ */
+#pragma once
+
+#include <algorithm>  // for equal
+#include <memory>     // for shared_ptr
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "../common/optional_weight.h"  // for OptionalWeights
+#include "xgboost/base.h"               // for bst_tree_t
+
+namespace xgboost::predictor {
+class QuickScorerForest;
+class QuantizedForest;
+
+/**
+ * @brief A forest layout built for a range of trees with their weights.
+ */
+template <typename Forest>
+struct CachedLayout {
+  bool valid{false};
+  bst_tree_t tree_begin{0};
+  bst_tree_t tree_end{0};
+  std::vector<float> weights;
+  float dft_weight{1.0f};
+  // nullptr if the trees are not supported by the layout.
+  std::shared_ptr<Forest const> forest;
+
+  [[nodiscard]] bool Matches(bst_tree_t beg, bst_tree_t end,
+                             common::OptionalWeights tree_weights) const {
+    return valid && tree_begin == beg && tree_end == end && dft_weight == tree_weights.dft &&
+           std::equal(weights.cbegin(), weights.cend(), tree_weights.weights.cbegin(),
+                      tree_weights.weights.cend());
+  }
+  void Reset(bst_tree_t beg, bst_tree_t end, common::OptionalWeights tree_weights,
+             std::shared_ptr<Forest const> new_forest) {
+    valid = true;
+    tree_begin = beg;
+    tree_end = end;
+    weights.assign(tree_weights.weights.cbegin(), tree_weights.weights.cend());
+    dft_weight = tree_weights.dft;
+    forest = std::move(new_forest);
+  }
+};
+
+/**
+ * @brief Layouts of the model used by the CPU predictor. Only the layout of the most recent
+ *        tree range is kept. The cache is stored on the tree model and dropped whenever the
+ *        trees are changed.
+ */
+struct ForestLayoutCache {
+  CachedLayout<QuickScorerForest> quick_scorer;
+  CachedLayout<QuantizedForest> quantized;
+};
+}  // namespace xgboost::predictor
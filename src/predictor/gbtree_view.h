@@ -3,12 +3,16 @@
  */
 #pragma once
 
-#include <mutex>    // for mutex, lock_guard
-#include <utility>  // for move
-#include <vector>   // for vector
+#include <algorithm>  // for max, min, swap
+#include <limits>     // for numeric_limits
+#include <mutex>      // for mutex, lock_guard
+#include <utility>    // for move
+#include <variant>    // for get_if
+#include <vector>     // for vector
 
-#include "../gbm/gbtree_model.h"  // for GBTreeModel
-#include "../tree/tree_view.h"    // for MultiTargetTreeView, ScalarTreeView
+#include "../common/optional_weight.h"  // for OptionalWeights
+#include "../gbm/gbtree_model.h"        // for GBTreeModel
+#include "../tree/tree_view.h"          // for MultiTargetTreeView, ScalarTreeView
 #include "xgboost/base.h"         // for bst_tree_t, bst_target_t
 #include "xgboost/context.h"      // for DeviceOrd
 #include "xgboost/span.h"         // for Span
@@ -72,6 +76,41 @@ class GBTreeModelView {
   [[nodiscard]] common::Span<TreeViewVar const> Trees() const {
     return {trees_.data(), trees_.size()};
   }
+  /**
+   * @brief Bounds of the margin contributed by the remaining trees.
+   *
+   *   `(*p_lower)[i]` and `(*p_upper)[i]` are the suffix sums of the minimum and the maximum
+   *   weighted leaf value from the i^th tree to the last tree, both with a size of
+   *   `n_trees + 1`. Only available for host views of scalar trees.
+   */
+  void MarginBounds(common::OptionalWeights tree_weights, std::vector<double>* p_lower,
+                    std::vector<double>* p_upper) const {
+    auto n_trees = this->trees_.size();
+    p_lower->assign(n_trees + 1, 0.0);
+    p_upper->assign(n_trees + 1, 0.0);
+    for (std::size_t i = n_trees; i-- > 0;) {
+      auto const* sc_tree = std::get_if<tree::ScalarTreeView>(&this->trees_[i]);
+      CHECK(sc_tree) << "Margin bounds are not supported for vector-leaf trees.";
+      double lower = std::numeric_limits<double>::max();
+      double upper = std::numeric_limits<double>::lowest();
+      sc_tree->WalkTree([&](bst_node_t nidx) {
+        if (sc_tree->IsLeaf(nidx)) {
+          double value = sc_tree->LeafValue(nidx);
+          lower = std::min(lower, value);
+          upper = std::max(upper, value);
+        }
+        return true;
+      });
+      double weight = tree_weights[i];
+      lower *= weight;
+      upper *= weight;
+      if (lower > upper) {
+        std::swap(lower, upper);
+      }
+      (*p_lower)[i] = (*p_lower)[i + 1] + lower;
+      (*p_upper)[i] = (*p_upper)[i + 1] + upper;
+    }
+  }
 
   GBTreeModelView() = delete;
   GBTreeModelView(GBTreeModelView const&) = delete;
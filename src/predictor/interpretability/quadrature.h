@@ -102,6 +102,38 @@ inline QuadratureRule const& GetQuadratureRule() {
   return kRule;
 }
 
+/** @brief Gauss-Legendre rule on [0, 1], exact for polynomials with degree up to 2n - 1. */
+struct GaussLegendreRule {
+  std::vector<double> nodes;
+  std::vector<double> weights;
+
+  [[nodiscard]] std::size_t Size() const { return nodes.size(); }
+};
+
+inline GaussLegendreRule MakeGaussLegendreRule(std::size_t n) {
+  CHECK_GT(n, 0);
+  constexpr double kConvergenceEps = 1e-15;
+  GaussLegendreRule rule;
+  rule.nodes.resize(n);
+  rule.weights.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    double x = std::cos(kPi * (static_cast<double>(i) + 0.75) / (static_cast<double>(n) + 0.5));
+    for (std::size_t iter = 0; iter < 64; ++iter) {
+      auto pn = LegendrePolynomial(n, x);
+      auto dx = pn / LegendreDerivative(n, x, pn);
+      x -= dx;
+      if (std::abs(dx) < kConvergenceEps) {
+        break;
+      }
+    }
+    auto dpn = LegendreDerivative(n, x, LegendrePolynomial(n, x));
+    // Map from [-1, 1] to [0, 1].
+    rule.nodes[i] = 0.5 * (x + 1.0);
+    rule.weights[i] = 1.0 / ((1.0 - x * x) * dpn * dpn);
+  }
+  return rule;
+}
+
 template <typename Tree, typename LeafValueFn>
 double FillRootMeanValue(Tree const& tree, bst_node_t nidx, LeafValueFn const& leaf_value) {
   if (tree.IsLeaf(nidx)) {
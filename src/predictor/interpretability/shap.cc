@@ -3,17 +3,26 @@
  */
 #include "shap.h"
 
-#include <algorithm>    // for copy, fill
+#include <algorithm>    // for copy, copy_n, equal, fill, fill_n, min, push_heap, sort_heap
 #include <array>        // for array
 #include <atomic>       // for atomic
 #include <cmath>        // for abs
+#include <cstdint>      // for int32_t
+#include <map>          // for map
+#include <memory>       // for shared_ptr, make_shared
+#include <mutex>        // for mutex, lock_guard
+#include <string>       // for string
 #include <type_traits>  // for remove_const_t
+#include <utility>      // for pair
 #include <variant>      // for variant
 #include <vector>       // for vector
 
+#include "../../common/common.h"           // for DivRoundUp
+#include "../../common/simd.h"             // for SimdIsa, DetectSimdIsa
 #include "../../common/threading_utils.h"  // for ParallelFor
 #include "../../gbm/gbtree_model.h"        // for GBTreeModel
 #include "../../tree/tree_view.h"          // for MultiTargetTreeView, ScalarTreeView
+#include "../contribution_sink.h"           // for ContributionSink
 #include "../data_accessor.h"              // for GHistIndexMatrixView
 #include "../predict_fn.h"                 // for GetTreeLimit
 #include "dmlc/omp.h"                      // for omp_get_thread_num
@@ -23,6 +32,10 @@
 #include "xgboost/span.h"        // for Span
 #include "xgboost/tree_model.h"  // for MTNotImplemented
 
+#if XGBOOST_SIMD_X86
+#include <immintrin.h>
+#endif  // XGBOOST_SIMD_X86
+
 namespace xgboost::interpretability {
 namespace {
 using TreeView = std::variant<tree::ScalarTreeView, tree::MultiTargetTreeView>;
@@ -225,13 +238,6 @@ struct QuadraturePathView {
   }
 };
 
-struct EmptyQuadraturePathState {
-  void Reset() const {}
-  void Push(bst_feature_t, float) const {}
-  void Pop(bst_feature_t) const {}
-  [[nodiscard]] auto View() const { return QuadraturePathView{{}}; }
-};
-
 struct LiveQuadraturePathState {
   std::vector<QuadraturePathElement> *path;
 
@@ -248,29 +254,9 @@ struct LiveQuadraturePathState {
   }
 };
 
-// Current additive SHAP formulation. It consumes the weighted subtree return and writes one
-// feature contribution per return edge.
-struct AdditiveContributionFormulation {
-  EmptyQuadraturePathState path_state;
-  ContributionVectorView<float> phi;
-
-  explicit AdditiveContributionFormulation(ContributionVectorView<float> phi) : phi{phi} {}
-
-  void ResetPath() const { path_state.Reset(); }
-  void PushPathSplit(bst_feature_t split_index, float p_child) const {
-    path_state.Push(split_index, p_child);
-  }
-  void PopPathSplit(bst_feature_t split_index) const { path_state.Pop(split_index); }
-
-  void HandleReturn(QuadratureRule const &rule, bst_feature_t split_index,
-                    QuadratureBuffer const &h_vals, float p_enter, float p_exit) const {
-    phi[split_index] += ExtractQuadratureDelta(rule, h_vals, p_enter, p_exit);
-  }
-};
-
 // First path-local interaction formulation built on top of the quadrature traversal. It keeps the
-// traversal and weighted subtree return shared with additive SHAP, and only changes how return
-// edges are written into the dense interaction sink.
+// traversal and weighted subtree return of additive SHAP, and only changes how return edges are
+// written into the dense interaction sink.
 struct InteractionContributionFormulation {
   LiveQuadraturePathState path_state;
   ContributionVectorView<float> phi_diag;
@@ -423,6 +409,328 @@ struct QuadratureTreeShapRunner {
   }
 };
 
+/**
+ * @brief Linear TreeSHAP for one row and one tree.
+ *
+ *   The leaves are summarized by polynomials in t, the product of (1 + t * (q_j - 1)) over
+ *   the features on the path, where q_j is the path probability ratio of feature j. The SHAP
+ *   value of a split is the integral over [0, 1] of the polynomials summed over its
+ *   sub-tree, with the factor of its own feature replaced by (q - 1). Polynomials are
+ *   stored as their values on a Gauss-Legendre rule, the product and the division by a
+ *   factor are then element-wise. The degree is bounded by the depth of the tree, the rule
+ *   is chosen to be exact for that degree instead of using a fixed number of points. Each
+ *   node costs O(depth), and the summation of the leaves is shared by all the splits above
+ *   them.
+ */
+template <typename Tree>
+struct LinearTreeShapRunner {
+  Tree const &tree;
+  bst_target_t target_idx;
+  RegTree::FVec const &feat;
+  detail::GaussLegendreRule const &rule;
+  // Path probability ratio of each feature, kQuadratureTreeShapUnseen if it's not on the path.
+  std::vector<float> *path_prob;
+  // Two polynomials for each level: the product along the path and the sub-tree sum.
+  double *arena;
+  // SHAP values of the tree, with size n_features.
+  double *phi;
+
+  [[nodiscard]] double *PathProduct(std::int32_t level) const {
+    return arena + 2 * level * rule.Size();
+  }
+  [[nodiscard]] double *SubtreeSum(std::int32_t level) const {
+    return arena + (2 * level + 1) * rule.Size();
+  }
+
+  void VisitChild(bst_node_t split_node, bst_node_t child_node, float child_weight,
+                  bool satisfies, std::int32_t level, double w_prod) {
+    auto split_index = tree.SplitIndex(split_node);
+    auto p_old = (*path_prob)[split_index];
+    auto seen = p_old != kQuadratureTreeShapUnseen;
+    float p_e = satisfies ? (seen ? p_old : 1.0f) / child_weight : 0.0f;
+    // Replace the factor of the previous split on the same feature.
+    double alpha_e = p_e - 1.0, alpha_old = seen ? p_old - 1.0 : 0.0;
+
+    auto n_points = rule.Size();
+    auto const *c = this->PathProduct(level);
+    auto *c_child = this->PathProduct(level + 1);
+    for (std::size_t k = 0; k < n_points; ++k) {
+      auto t = rule.nodes[k];
+      c_child[k] = c[k] * (1.0 + alpha_e * t) / (1.0 + alpha_old * t);
+    }
+
+    (*path_prob)[split_index] = p_e;
+    this->RunNode(child_node, level + 1, w_prod * child_weight);
+    (*path_prob)[split_index] = p_old;
+
+    // The previous split has already added the sub-tree with its own factor, subtract it.
+    auto const *h_child = this->SubtreeSum(level + 1);
+    auto *h = this->SubtreeSum(level);
+    double acc = 0.0;
+    for (std::size_t k = 0; k < n_points; ++k) {
+      auto t = rule.nodes[k];
+      acc += h_child[k] * (alpha_e / (1.0 + alpha_e * t) - alpha_old / (1.0 + alpha_old * t));
+      h[k] += h_child[k];
+    }
+    phi[split_index] += acc;
+  }
+
+  void RunNode(bst_node_t nidx, std::int32_t level, double w_prod) {
+    auto n_points = rule.Size();
+    auto *h = this->SubtreeSum(level);
+    if (tree.IsLeaf(nidx)) {
+      auto const *c = this->PathProduct(level);
+      auto leaf_scale = w_prod * LeafValue(tree, nidx, target_idx);
+      for (std::size_t k = 0; k < n_points; ++k) {
+        h[k] = c[k] * leaf_scale * rule.weights[k];
+      }
+      return;
+    }
+    std::fill_n(h, n_points, 0.0);
+
+    auto left = tree.LeftChild(nidx);
+    auto right = tree.RightChild(nidx);
+    auto parent_cover = tree.SumHess(nidx);
+    CHECK_GE(parent_cover, 0.0f);
+    CHECK_GE(tree.SumHess(left), 0.0f);
+    CHECK_GE(tree.SumHess(right), 0.0f);
+    auto split_index = tree.SplitIndex(nidx);
+    auto next = predictor::GetNextNode<true, true>(tree, nidx, feat.GetFvalue(split_index),
+                                                   feat.IsMissing(split_index),
+                                                   tree.GetCategoriesMatrix());
+    this->VisitChild(nidx, left, detail::BranchWeight(tree.SumHess(left), parent_cover),
+                     next == left, level, w_prod);
+    this->VisitChild(nidx, right, detail::BranchWeight(tree.SumHess(right), parent_cover),
+                     next == right, level, w_prod);
+  }
+
+  void Run() {
+    if (tree.IsLeaf(RegTree::kRoot)) {
+      return;
+    }
+    std::fill_n(this->PathProduct(0), rule.Size(), 1.0);
+    this->RunNode(RegTree::kRoot, 0, 1.0);
+  }
+};
+
+// Number of rows evaluated together by the additive block kernel, one AVX register of floats.
+constexpr std::size_t kShapBlockRows = 8;
+
+// Quadrature buffers for a block of rows, laid out as [point][row] so that each quadrature
+// point is a contiguous vector over the rows.
+using QuadratureBlock = std::array<float, kQuadratureTreeShapPoints * kShapBlockRows>;
+using BlockRowValues = std::array<float, kShapBlockRows>;
+
+// out = c * (1 + alpha_enter * x) / (1 + alpha_exit * x) for each quadrature point x.
+void ScaleQuadratureBlock(QuadratureRule const &rule, BlockRowValues const &alpha_enter,
+                          BlockRowValues const &alpha_exit, QuadratureBlock const &c_vals,
+                          QuadratureBlock *out) {
+  for (std::size_t i = 0; i < kQuadratureTreeShapPoints; ++i) {
+    for (std::size_t r = 0; r < kShapBlockRows; ++r) {
+      auto k = i * kShapBlockRows + r;
+      (*out)[k] = c_vals[k] * (1.0f + alpha_enter[r] * rule.nodes[i]) /
+                  (1.0f + alpha_exit[r] * rule.nodes[i]);
+    }
+  }
+}
+
+// Block version of the `ExtractQuadratureDelta`, a zero alpha contributes nothing.
+void ExtractQuadratureDeltaBlock(QuadratureRule const &rule, QuadratureBlock const &h_vals,
+                                 BlockRowValues const &alpha_enter,
+                                 BlockRowValues const &alpha_exit, BlockRowValues *out) {
+  out->fill(0.0f);
+  for (std::size_t i = 0; i < kQuadratureTreeShapPoints; ++i) {
+    for (std::size_t r = 0; r < kShapBlockRows; ++r) {
+      (*out)[r] += alpha_enter[r] * h_vals[i * kShapBlockRows + r] /
+                   (1.0f + alpha_enter[r] * rule.nodes[i]);
+    }
+  }
+  for (std::size_t i = 0; i < kQuadratureTreeShapPoints; ++i) {
+    for (std::size_t r = 0; r < kShapBlockRows; ++r) {
+      (*out)[r] -= alpha_exit[r] * h_vals[i * kShapBlockRows + r] /
+                   (1.0f + alpha_exit[r] * rule.nodes[i]);
+    }
+  }
+}
+
+#if XGBOOST_SIMD_X86
+static_assert(kShapBlockRows == 8);
+
+XGBOOST_TARGET_AVX2 void ScaleQuadratureBlockAvx2(QuadratureRule const &rule,
+                                                  BlockRowValues const &alpha_enter,
+                                                  BlockRowValues const &alpha_exit,
+                                                  QuadratureBlock const &c_vals,
+                                                  QuadratureBlock *out) {
+  __m256 const one = _mm256_set1_ps(1.0f);
+  __m256 const a_enter = _mm256_loadu_ps(alpha_enter.data());
+  __m256 const a_exit = _mm256_loadu_ps(alpha_exit.data());
+  for (std::size_t i = 0; i < kQuadratureTreeShapPoints; ++i) {
+    __m256 const x = _mm256_set1_ps(rule.nodes[i]);
+    __m256 c = _mm256_loadu_ps(c_vals.data() + i * kShapBlockRows);
+    c = _mm256_mul_ps(c, _mm256_add_ps(one, _mm256_mul_ps(a_enter, x)));
+    c = _mm256_div_ps(c, _mm256_add_ps(one, _mm256_mul_ps(a_exit, x)));
+    _mm256_storeu_ps(out->data() + i * kShapBlockRows, c);
+  }
+}
+
+XGBOOST_TARGET_AVX2 void ExtractQuadratureDeltaBlockAvx2(QuadratureRule const &rule,
+                                                         QuadratureBlock const &h_vals,
+                                                         BlockRowValues const &alpha_enter,
+                                                         BlockRowValues const &alpha_exit,
+                                                         BlockRowValues *out) {
+  __m256 const one = _mm256_set1_ps(1.0f);
+  __m256 const a_enter = _mm256_loadu_ps(alpha_enter.data());
+  __m256 const a_exit = _mm256_loadu_ps(alpha_exit.data());
+  __m256 acc = _mm256_setzero_ps();
+  for (std::size_t i = 0; i < kQuadratureTreeShapPoints; ++i) {
+    __m256 const x = _mm256_set1_ps(rule.nodes[i]);
+    __m256 const h = _mm256_loadu_ps(h_vals.data() + i * kShapBlockRows);
+    acc = _mm256_add_ps(acc, _mm256_div_ps(_mm256_mul_ps(a_enter, h),
+                                           _mm256_add_ps(one, _mm256_mul_ps(a_enter, x))));
+  }
+  for (std::size_t i = 0; i < kQuadratureTreeShapPoints; ++i) {
+    __m256 const x = _mm256_set1_ps(rule.nodes[i]);
+    __m256 const h = _mm256_loadu_ps(h_vals.data() + i * kShapBlockRows);
+    acc = _mm256_sub_ps(acc, _mm256_div_ps(_mm256_mul_ps(a_exit, h),
+                                           _mm256_add_ps(one, _mm256_mul_ps(a_exit, x))));
+  }
+  _mm256_storeu_ps(out->data(), acc);
+}
+#endif  // XGBOOST_SIMD_X86
+
+// Additive QuadratureTreeSHAP for a block of rows. The traversal visits every node of the tree
+// regardless of the row, only the path probabilities depend on the feature values. Hence a
+// block of rows can share the walk, with the per-row states updated in lockstep.
+template <typename Tree>
+struct QuadratureTreeShapBlockRunner {
+  using RowMask = std::array<bool, kShapBlockRows>;
+
+  Tree const &tree;
+  bst_target_t target_idx;
+  // Feature vectors of the rows in this block, at most `kShapBlockRows`.
+  common::Span<RegTree::FVec const> feats;
+  QuadratureRule const &rule;
+  // Path probabilities laid out as [feature][row].
+  std::vector<float> *path_prob;
+  // Output contributions laid out as [row][column].
+  float *phi;
+  std::size_t ncolumns;
+  bool use_avx2;
+
+  void Scale(BlockRowValues const &alpha_enter, BlockRowValues const &alpha_exit,
+             QuadratureBlock const &c_vals, QuadratureBlock *out) const {
+#if XGBOOST_SIMD_X86
+    if (use_avx2) {
+      ScaleQuadratureBlockAvx2(rule, alpha_enter, alpha_exit, c_vals, out);
+      return;
+    }
+#endif  // XGBOOST_SIMD_X86
+    ScaleQuadratureBlock(rule, alpha_enter, alpha_exit, c_vals, out);
+  }
+
+  void ExtractDelta(QuadratureBlock const &h_vals, BlockRowValues const &alpha_enter,
+                    BlockRowValues const &alpha_exit, BlockRowValues *out) const {
+#if XGBOOST_SIMD_X86
+    if (use_avx2) {
+      ExtractQuadratureDeltaBlockAvx2(rule, h_vals, alpha_enter, alpha_exit, out);
+      return;
+    }
+#endif  // XGBOOST_SIMD_X86
+    ExtractQuadratureDeltaBlock(rule, h_vals, alpha_enter, alpha_exit, out);
+  }
+
+  void EvaluateGoesLeft(bst_node_t nidx, RowMask *goes_left) const {
+    auto split_index = tree.SplitIndex(nidx);
+    auto const &cats = tree.GetCategoriesMatrix();
+    auto left = tree.LeftChild(nidx);
+    goes_left->fill(false);
+    for (std::size_t r = 0; r < feats.size(); ++r) {
+      auto const &feat = feats[r];
+      auto next = predictor::GetNextNode<true, true>(tree, nidx, feat.GetFvalue(split_index),
+                                                     feat.IsMissing(split_index), cats);
+      (*goes_left)[r] = next == left;
+    }
+  }
+
+  [[nodiscard]] float ChildWeight(bst_node_t parent, bst_node_t child) const {
+    auto parent_cover = tree.SumHess(parent);
+    CHECK_GE(parent_cover, 0.0f);
+    CHECK_GE(tree.SumHess(child), 0.0f);
+    return detail::BranchWeight(tree.SumHess(child), parent_cover);
+  }
+
+  void VisitChild(bst_node_t split_node, bst_node_t child_node, float child_weight,
+                  RowMask const &satisfies, QuadratureBlock const &c_vals, float w_prod,
+                  QuadratureBlock *out_h) {
+    auto split_index = tree.SplitIndex(split_node);
+    auto p_prob = path_prob->data() + static_cast<std::size_t>(split_index) * kShapBlockRows;
+
+    BlockRowValues p_old, alpha_enter, alpha_exit;
+    for (std::size_t r = 0; r < kShapBlockRows; ++r) {
+      p_old[r] = p_prob[r];
+      auto p_exit = p_old[r] == kQuadratureTreeShapUnseen ? 1.0f : p_old[r];
+      auto p_e = satisfies[r] ? p_exit / child_weight : 0.0f;
+      alpha_enter[r] = p_e - 1.0f;
+      alpha_exit[r] = p_exit - 1.0f;
+      p_prob[r] = p_e;
+    }
+
+    QuadratureBlock c_child;
+    this->Scale(alpha_enter, alpha_exit, c_vals, &c_child);
+    this->RunNode(child_node, c_child, w_prod * child_weight, out_h);
+    BlockRowValues delta;
+    this->ExtractDelta(*out_h, alpha_enter, alpha_exit, &delta);
+
+    for (std::size_t r = 0; r < feats.size(); ++r) {
+      phi[r * ncolumns + split_index] += delta[r];
+    }
+    std::copy(p_old.cbegin(), p_old.cend(), p_prob);
+  }
+
+  void RunNode(bst_node_t nidx, QuadratureBlock const &c_vals, float w_prod,
+               QuadratureBlock *out_h) {
+    if (tree.IsLeaf(nidx)) {
+      auto const leaf_scale = w_prod * LeafValue(tree, nidx, target_idx);
+      for (std::size_t i = 0; i < kQuadratureTreeShapPoints; ++i) {
+        for (std::size_t r = 0; r < kShapBlockRows; ++r) {
+          auto k = i * kShapBlockRows + r;
+          (*out_h)[k] = c_vals[k] * leaf_scale * rule.weights[i];
+        }
+      }
+      return;
+    }
+
+    auto left = tree.LeftChild(nidx);
+    auto right = tree.RightChild(nidx);
+    auto left_weight = this->ChildWeight(nidx, left);
+    auto right_weight = this->ChildWeight(nidx, right);
+    RowMask goes_left, goes_right;
+    this->EvaluateGoesLeft(nidx, &goes_left);
+    for (std::size_t r = 0; r < kShapBlockRows; ++r) {
+      goes_right[r] = !goes_left[r];
+    }
+
+    QuadratureBlock right_h;
+    this->VisitChild(nidx, left, left_weight, goes_left, c_vals, w_prod, out_h);
+    this->VisitChild(nidx, right, right_weight, goes_right, c_vals, w_prod, &right_h);
+    for (std::size_t k = 0; k < out_h->size(); ++k) {
+      (*out_h)[k] += right_h[k];
+    }
+  }
+
+  void Run() {
+    CHECK_LE(feats.size(), kShapBlockRows);
+    if (tree.IsLeaf(RegTree::kRoot)) {
+      return;
+    }
+
+    QuadratureBlock c_init;
+    c_init.fill(1.0f);
+    QuadratureBlock h_vals;
+    this->RunNode(RegTree::kRoot, c_init, 1.0f, &h_vals);
+  }
+};
+
 struct QuadratureTreeShapModelData {
   struct TreeEntry {
     bst_tree_t tree_idx;
@@ -496,6 +804,73 @@ QuadratureTreeShapModelData MakeQuadratureTreeShapModelData(
   return out;
 }
 
+}  // namespace
+
+/**
+ * @brief Cache for the QuadratureTreeSHAP model data of a tree model, keyed by the tree
+ *        range. It's owned by the model and dropped when the trees are changed. The tree
+ *        weights are checked for each lookup as DART can modify them without changing
+ *        the trees.
+ */
+class ShapModelCache {
+  struct Entry {
+    std::vector<float> weights;
+    bool has_weights{false};
+    std::shared_ptr<QuadratureTreeShapModelData const> data;
+  };
+  // Bound the number of cached tree ranges.
+  static constexpr std::size_t kMaxEntries = 8;
+
+  std::mutex mu_;
+  std::map<bst_tree_t, Entry> entries_;
+
+ public:
+  [[nodiscard]] std::shared_ptr<QuadratureTreeShapModelData const> Get(
+      gbm::GBTreeModel const &model, bst_tree_t tree_end, std::vector<float> const *tree_weights) {
+    auto same_weights = [&](Entry const &entry) {
+      if (tree_weights == nullptr) {
+        return !entry.has_weights;
+      }
+      return entry.has_weights &&
+             std::equal(entry.weights.cbegin(), entry.weights.cend(), tree_weights->cbegin(),
+                        tree_weights->cbegin() + tree_end);
+    };
+
+    std::lock_guard guard{mu_};
+    auto it = entries_.find(tree_end);
+    if (it != entries_.cend() && same_weights(it->second)) {
+      return it->second.data;
+    }
+    if (it == entries_.cend() && entries_.size() >= kMaxEntries) {
+      entries_.clear();
+    }
+    auto &entry = entries_[tree_end];
+    entry.has_weights = tree_weights != nullptr;
+    entry.weights.clear();
+    if (tree_weights != nullptr) {
+      entry.weights.assign(tree_weights->cbegin(), tree_weights->cbegin() + tree_end);
+    }
+    entry.data = std::make_shared<QuadratureTreeShapModelData const>(
+        MakeQuadratureTreeShapModelData(model, tree_end, tree_weights));
+    return entry.data;
+  }
+};
+
+namespace {
+std::shared_ptr<QuadratureTreeShapModelData const> GetQuadratureTreeShapModelData(
+    gbm::GBTreeModel const &model, bst_tree_t tree_end, std::vector<float> const *tree_weights) {
+  std::shared_ptr<ShapModelCache> cache;
+  {
+    std::lock_guard guard{model.Mutex()};
+    auto &p_cache = model.ShapCache();
+    if (!p_cache) {
+      p_cache = std::make_shared<ShapModelCache>();
+    }
+    cache = p_cache;
+  }
+  return cache->Get(model, tree_end, tree_weights);
+}
+
 template <typename EncAccessor, typename Fn>
 void DispatchByBatchView(Context const *ctx, DMatrix *p_fmat, EncAccessor acc, Fn &&fn) {
   using AccT = std::decay_t<EncAccessor>;
@@ -523,38 +898,34 @@ void LaunchShap(Context const *ctx, DMatrix *p_fmat, gbm::GBTreeModel const &mod
     DispatchByBatchView(ctx, p_fmat, NoOpAccessor{}, fn);
   }
 }
-}  // namespace
 
-namespace cpu_impl {
-void QuadratureTreeShapValues(Context const *ctx, DMatrix *p_fmat,
-                              HostDeviceVector<float> *out_contribs, gbm::GBTreeModel const &model,
-                              bst_tree_t tree_end, std::vector<float> const *tree_weights,
-                              std::size_t quadrature_points);
-void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
-                                         HostDeviceVector<float> *out_contribs,
-                                         gbm::GBTreeModel const &model, bst_tree_t tree_end,
-                                         std::vector<float> const *tree_weights,
-                                         std::size_t quadrature_points);
-
-void ShapValues(Context const *ctx, DMatrix *p_fmat, HostDeviceVector<float> *out_contribs,
-                gbm::GBTreeModel const &model, bst_tree_t tree_end,
-                std::vector<float> const *tree_weights, int condition, unsigned condition_feature) {
-  CHECK_EQ(condition, 0) << "CPU exact SHAP uses fixed 8-point QuadratureTreeSHAP and does not "
-                            "support conditioned exact attributions.";
-  CHECK_EQ(condition_feature, 0U)
-      << "CPU exact SHAP uses fixed 8-point QuadratureTreeSHAP and does "
-         "not support conditioned exact attributions.";
-  QuadratureTreeShapValues(ctx, p_fmat, out_contribs, model, tree_end, tree_weights,
-                           kQuadratureTreeShapPoints);
+// Split a batch into chunks of rows, `done` is called after each chunk.
+template <typename View, typename Fn, typename Done>
+void ForEachChunk(View const &view, bst_idx_t chunk_rows, Fn &&fn, Done &&done) {
+  auto n_rows = static_cast<bst_idx_t>(view.Size());
+  auto chunk = chunk_rows == 0 ? n_rows : chunk_rows;
+  for (bst_idx_t chunk_begin = 0; chunk_begin < n_rows; chunk_begin += chunk) {
+    auto chunk_size = std::min(chunk, n_rows - chunk_begin);
+    fn(view, chunk_begin, chunk_size);
+    done(view.base_rowid + chunk_begin, chunk_size);
+  }
 }
 
-void QuadratureTreeShapValues(Context const *ctx, DMatrix *p_fmat,
-                              HostDeviceVector<float> *out_contribs, gbm::GBTreeModel const &model,
+/**
+ * @brief Run the additive QuadratureTreeSHAP in blocks of rows.
+ *
+ * @param chunk_rows Number of rows processed before calling `done`, 0 for the entire batch.
+ * @param isa        Instruction set for the block kernels.
+ * @param fn         Called with the thread index, the row index, the output group, and the
+ *                   contributions of the row with the bias in the last column. The
+ *                   contributions are only valid during the call.
+ * @param done       Called with the first row index and the number of rows once a chunk of
+ *                   rows is finished, in row order.
+ */
+template <typename Fn, typename Done>
+void QuadratureTreeShapBlocks(Context const *ctx, DMatrix *p_fmat, gbm::GBTreeModel const &model,
                               bst_tree_t tree_end, std::vector<float> const *tree_weights,
-                              std::size_t quadrature_points) {
-  CHECK_EQ(quadrature_points, kQuadratureTreeShapPoints)
-      << "CPU QuadratureTreeSHAP currently uses a fixed quadrature size of "
-      << kQuadratureTreeShapPoints << ".";
+                              bst_idx_t chunk_rows, common::SimdIsa isa, Fn &&fn, Done &&done) {
   MetaInfo const &info = p_fmat->Info();
   tree_end = predictor::GetTreeLimit(model.trees, tree_end);
   CHECK_GE(tree_end, 0);
@@ -563,76 +934,105 @@ void QuadratureTreeShapValues(Context const *ctx, DMatrix *p_fmat,
   auto const n_groups = model.learner_model_state->num_output_group;
   auto const n_features = model.learner_model_state->num_feature;
   size_t const ncolumns = model.learner_model_state->num_feature + 1;
-  std::vector<bst_float> &contribs = out_contribs->HostVector();
-  contribs.resize(info.num_row_ * ncolumns * model.learner_model_state->num_output_group);
-  std::fill(contribs.begin(), contribs.end(), 0.0f);
   CHECK_NE(n_groups, 0);
   auto const &rule = detail::GetQuadratureRule();
   auto const base_score = model.learner_model_state->BaseScore(DeviceOrd::CPU());
-  auto model_data = MakeQuadratureTreeShapModelData(model, tree_end, tree_weights);
-  std::vector<RegTree::FVec> feats_tloc(n_threads);
-  std::vector<std::vector<float>> contribs_tloc(n_threads, std::vector<float>(ncolumns));
+  auto p_model_data = GetQuadratureTreeShapModelData(model, tree_end, tree_weights);
+  auto const &model_data = *p_model_data;
+  CHECK(isa <= common::DetectSimdIsa()) << "The instruction set is not supported by the CPU.";
+  auto const use_avx2 = isa >= common::SimdIsa::kAvx2;
+  std::vector<std::vector<RegTree::FVec>> feats_tloc(n_threads,
+                                                     std::vector<RegTree::FVec>(kShapBlockRows));
+  std::vector<std::vector<float>> contribs_tloc(
+      n_threads, std::vector<float>(kShapBlockRows * ncolumns));
+  std::vector<std::vector<float>> acc_tloc(n_threads,
+                                           std::vector<float>(kShapBlockRows * ncolumns));
   std::vector<std::vector<float>> path_prob_tloc(
-      n_threads, std::vector<float>(n_features, kQuadratureTreeShapUnseen));
+      n_threads, std::vector<float>(n_features * kShapBlockRows, kQuadratureTreeShapUnseen));
 
   auto device = ctx->Device().IsSycl() ? DeviceOrd::CPU() : ctx->Device();
   auto base_margin = info.base_margin_.View(device);
 
-  auto process_view = [&](auto &&view) {
-    common::ParallelFor(view.Size(), n_threads, [&](auto i) {
+  auto process_chunk = [&](auto const &view, bst_idx_t chunk_begin, bst_idx_t chunk_size) {
+    auto n_blocks = common::DivRoundUp(chunk_size, kShapBlockRows);
+    common::ParallelFor(n_blocks, n_threads, [&](auto block_id) {
       auto tid = omp_get_thread_num();
-      auto &feats = feats_tloc[tid];
-      if (feats.Size() == 0) {
-        feats.Init(model.learner_model_state->num_feature);
+      auto batch_offset = chunk_begin + block_id * kShapBlockRows;
+      auto block_size =
+          std::min<std::size_t>(kShapBlockRows, chunk_begin + chunk_size - batch_offset);
+      auto &block_feats = feats_tloc[tid];
+      for (std::size_t r = 0; r < block_size; ++r) {
+        auto &feats = block_feats[r];
+        if (feats.Size() == 0) {
+          feats.Init(model.learner_model_state->num_feature);
+        }
+        auto n_valid = view.DoFill(batch_offset + r, feats.Data().data());
+        feats.HasMissing(n_valid != feats.Size());
       }
-      auto &this_tree_contribs = contribs_tloc[tid];
+      auto feats = common::Span<RegTree::FVec const>{block_feats}.subspan(0, block_size);
+      auto &block_contribs = contribs_tloc[tid];
       auto &path_prob = path_prob_tloc[tid];
-      auto row_idx = view.base_rowid + i;
-      auto n_valid = view.DoFill(i, feats.Data().data());
-      feats.HasMissing(n_valid != feats.Size());
+      auto &block_acc = acc_tloc[tid];
       for (bst_target_t gid = 0; gid < n_groups; ++gid) {
-        float *p_contribs = &contribs[(row_idx * n_groups + gid) * ncolumns];
+        std::fill(block_acc.begin(), block_acc.end(), 0.0f);
         for (auto entry_idx : model_data.entries_by_group[gid]) {
           auto const &entry = model_data.entries[entry_idx];
-          std::fill(this_tree_contribs.begin(), this_tree_contribs.end(), 0.0f);
-          auto formulation = AdditiveContributionFormulation{{this_tree_contribs.data(), ncolumns}};
+          std::fill(block_contribs.begin(), block_contribs.end(), 0.0f);
           std::visit(
               [&](auto const &tree) {
-                auto runner = QuadratureTreeShapRunner<std::decay_t<decltype(tree)>,
-                                                       AdditiveContributionFormulation>{
-                    tree, entry.target_idx, feats, rule, &path_prob, formulation};
+                auto runner = QuadratureTreeShapBlockRunner<std::decay_t<decltype(tree)>>{
+                    tree,       entry.target_idx,      feats,    rule,
+                    &path_prob, block_contribs.data(), ncolumns, use_avx2};
                 runner.Run();
               },
               model_data.trees[entry.tree_idx]);
           auto const weight = entry.weight;
-          for (size_t ci = 0; ci + 1 < ncolumns; ++ci) {
-            p_contribs[ci] += this_tree_contribs[ci] * weight;
+          for (std::size_t r = 0; r < block_size; ++r) {
+            float *p_contribs = &block_acc[r * ncolumns];
+            float const *p_tree_contribs = &block_contribs[r * ncolumns];
+            for (size_t ci = 0; ci + 1 < ncolumns; ++ci) {
+              p_contribs[ci] += p_tree_contribs[ci] * weight;
+            }
           }
         }
-        p_contribs[ncolumns - 1] += model_data.group_root_mean_sums[gid];
-        if (base_margin.Size() != 0) {
-          CHECK_EQ(base_margin.Shape(1), n_groups);
-          p_contribs[ncolumns - 1] += base_margin(row_idx, gid);
-        } else {
-          p_contribs[ncolumns - 1] += base_score(gid);
+        for (std::size_t r = 0; r < block_size; ++r) {
+          auto row_idx = view.base_rowid + batch_offset + r;
+          float *p_contribs = &block_acc[r * ncolumns];
+          p_contribs[ncolumns - 1] += model_data.group_root_mean_sums[gid];
+          if (base_margin.Size() != 0) {
+            CHECK_EQ(base_margin.Shape(1), n_groups);
+            p_contribs[ncolumns - 1] += base_margin(row_idx, gid);
+          } else {
+            p_contribs[ncolumns - 1] += base_score(gid);
+          }
+          fn(tid, row_idx, gid, common::Span<float const>{p_contribs, ncolumns});
         }
       }
-      feats.Drop();
+      for (std::size_t r = 0; r < block_size; ++r) {
+        block_feats[r].Drop();
+      }
     });
   };
+  auto process_view = [&](auto &&view) {
+    ForEachChunk(view, chunk_rows, process_chunk, done);
+  };
 
   LaunchShap(ctx, p_fmat, model, process_view);
 }
-
-void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
-                                         HostDeviceVector<float> *out_contribs,
-                                         gbm::GBTreeModel const &model, bst_tree_t tree_end,
-                                         std::vector<float> const *tree_weights,
-                                         std::size_t quadrature_points) {
-  CHECK_EQ(quadrature_points, kQuadratureTreeShapPoints)
-      << "CPU QuadratureTreeSHAP currently uses a fixed quadrature size of "
-      << kQuadratureTreeShapPoints << ".";
-
+/**
+ * @brief Run the QuadratureTreeSHAP interaction values one row at a time.
+ *
+ * @param chunk_rows Number of rows processed before calling `done`, 0 for the entire batch.
+ * @param out_row    Returns the zero-initialized output of a row, with shape (n_groups,
+ *                   n_features + 1, n_features + 1).
+ * @param done       Called with the first row index and the number of rows once a chunk of
+ *                   rows is finished, in row order.
+ */
+template <typename OutRow, typename Done>
+void QuadratureTreeShapInteractionRows(Context const *ctx, DMatrix *p_fmat,
+                                       gbm::GBTreeModel const &model, bst_tree_t tree_end,
+                                       std::vector<float> const *tree_weights,
+                                       bst_idx_t chunk_rows, OutRow &&out_row, Done &&done) {
   MetaInfo const &info = p_fmat->Info();
   tree_end = predictor::GetTreeLimit(model.trees, tree_end);
   CHECK_GE(tree_end, 0);
@@ -642,16 +1042,12 @@ void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
   auto const n_groups = model.learner_model_state->num_output_group;
   auto const n_features = model.learner_model_state->num_feature;
   auto const ncolumns = n_features + 1;
-  auto const row_chunk = n_groups * ncolumns * ncolumns;
   auto const matrix_chunk = ncolumns * ncolumns;
 
-  std::vector<bst_float> &contribs = out_contribs->HostVector();
-  contribs.resize(info.num_row_ * row_chunk);
-  std::fill(contribs.begin(), contribs.end(), 0.0f);
-
   auto const &rule = detail::GetQuadratureRule();
   auto const base_score = model.learner_model_state->BaseScore(DeviceOrd::CPU());
-  auto model_data = MakeQuadratureTreeShapModelData(model, tree_end, tree_weights);
+  auto p_model_data = GetQuadratureTreeShapModelData(model, tree_end, tree_weights);
+  auto const &model_data = *p_model_data;
   std::vector<RegTree::FVec> feats_tloc(n_threads);
   std::vector<std::vector<QuadraturePathElement>> path_tloc(n_threads);
   std::vector<std::vector<float>> path_prob_tloc(
@@ -661,8 +1057,9 @@ void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
   auto device = ctx->Device().IsSycl() ? DeviceOrd::CPU() : ctx->Device();
   auto base_margin = info.base_margin_.View(device);
 
-  auto process_view = [&](auto &&view) {
-    common::ParallelFor(view.Size(), n_threads, [&](auto i) {
+  auto process_chunk = [&](auto const &view, bst_idx_t chunk_begin, bst_idx_t chunk_size) {
+    common::ParallelFor(chunk_size, n_threads, [&](auto j) {
+      auto i = chunk_begin + j;
       auto tid = omp_get_thread_num();
       auto &feats = feats_tloc[tid];
       if (feats.Size() == 0) {
@@ -676,8 +1073,8 @@ void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
       feats.HasMissing(n_valid != feats.Size());
 
       for (bst_target_t gid = 0; gid < n_groups; ++gid) {
-        auto const offset = (row_idx * n_groups + gid) * matrix_chunk;
-        auto matrix = DenseInteractionMatrixView<bst_float>{contribs.data() + offset, ncolumns};
+        auto matrix =
+            DenseInteractionMatrixView<bst_float>{out_row(row_idx) + gid * matrix_chunk, ncolumns};
         std::fill(diag.begin(), diag.end(), 0.0f);
 
         for (auto entry_idx : model_data.entries_by_group[gid]) {
@@ -728,9 +1125,305 @@ void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
       feats.Drop();
     });
   };
+  auto process_view = [&](auto &&view) {
+    ForEachChunk(view, chunk_rows, process_chunk, done);
+  };
 
   LaunchShap(ctx, p_fmat, model, process_view);
 }
+}  // namespace
+
+[[nodiscard]] ShapAlgorithm ParseShapAlgorithm(std::string const &name) {
+  if (name == "quadrature") {
+    return ShapAlgorithm::kQuadrature;
+  }
+  if (name == "linear") {
+    return ShapAlgorithm::kLinear;
+  }
+  LOG(FATAL) << "Unknown SHAP algorithm: `" << name << "`.";
+  return ShapAlgorithm::kQuadrature;
+}
+
+namespace cpu_impl {
+void QuadratureTreeShapValues(Context const *ctx, DMatrix *p_fmat,
+                              HostDeviceVector<float> *out_contribs, gbm::GBTreeModel const &model,
+                              bst_tree_t tree_end, std::vector<float> const *tree_weights,
+                              std::size_t quadrature_points, common::SimdIsa isa);
+void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
+                                         HostDeviceVector<float> *out_contribs,
+                                         gbm::GBTreeModel const &model, bst_tree_t tree_end,
+                                         std::vector<float> const *tree_weights,
+                                         std::size_t quadrature_points);
+
+void ShapValues(Context const *ctx, DMatrix *p_fmat, HostDeviceVector<float> *out_contribs,
+                gbm::GBTreeModel const &model, bst_tree_t tree_end,
+                std::vector<float> const *tree_weights, int condition, unsigned condition_feature,
+                common::SimdIsa isa) {
+  CHECK_EQ(condition, 0) << "CPU exact SHAP uses fixed 8-point QuadratureTreeSHAP and does not "
+                            "support conditioned exact attributions.";
+  CHECK_EQ(condition_feature, 0U)
+      << "CPU exact SHAP uses fixed 8-point QuadratureTreeSHAP and does "
+         "not support conditioned exact attributions.";
+  QuadratureTreeShapValues(ctx, p_fmat, out_contribs, model, tree_end, tree_weights,
+                           kQuadratureTreeShapPoints, isa);
+}
+
+void QuadratureTreeShapValues(Context const *ctx, DMatrix *p_fmat,
+                              HostDeviceVector<float> *out_contribs, gbm::GBTreeModel const &model,
+                              bst_tree_t tree_end, std::vector<float> const *tree_weights,
+                              std::size_t quadrature_points, common::SimdIsa isa) {
+  CHECK_EQ(quadrature_points, kQuadratureTreeShapPoints)
+      << "CPU QuadratureTreeSHAP currently uses a fixed quadrature size of "
+      << kQuadratureTreeShapPoints << ".";
+  MetaInfo const &info = p_fmat->Info();
+  auto const n_groups = model.learner_model_state->num_output_group;
+  size_t const ncolumns = model.learner_model_state->num_feature + 1;
+  std::vector<bst_float> &contribs = out_contribs->HostVector();
+  contribs.resize(info.num_row_ * ncolumns * n_groups);
+  QuadratureTreeShapBlocks(
+      ctx, p_fmat, model, tree_end, tree_weights, 0, isa,
+      [&](std::int32_t, bst_idx_t row_idx, bst_target_t gid,
+          common::Span<float const> row_contribs) {
+        std::copy(row_contribs.cbegin(), row_contribs.cend(),
+                  contribs.begin() + (row_idx * n_groups + gid) * ncolumns);
+      },
+      [](bst_idx_t, bst_idx_t) {});
+}
+
+void LinearTreeShapValues(Context const *ctx, DMatrix *p_fmat,
+                          HostDeviceVector<float> *out_contribs, gbm::GBTreeModel const &model,
+                          bst_tree_t tree_end, std::vector<float> const *tree_weights) {
+  MetaInfo const &info = p_fmat->Info();
+  tree_end = predictor::GetTreeLimit(model.trees, tree_end);
+  CHECK_GE(tree_end, 0);
+  ValidateTreeWeights(tree_weights, tree_end);
+  auto const n_threads = ctx->Threads();
+  auto const n_groups = model.learner_model_state->num_output_group;
+  auto const n_features = model.learner_model_state->num_feature;
+  std::size_t const ncolumns = n_features + 1;
+  CHECK_NE(n_groups, 0);
+  auto const base_score = model.learner_model_state->BaseScore(DeviceOrd::CPU());
+  auto p_model_data = GetQuadratureTreeShapModelData(model, tree_end, tree_weights);
+  auto const &model_data = *p_model_data;
+
+  // A path with d distinct features leads to polynomials with degree less than d, which
+  // needs (d + 1) / 2 points.
+  std::map<std::size_t, detail::GaussLegendreRule> rules;
+  std::vector<detail::GaussLegendreRule const *> tree_rules(tree_end);
+  bst_node_t max_depth = 0;
+  for (bst_tree_t i = 0; i < tree_end; ++i) {
+    auto depth = model.trees[i]->MaxDepth();
+    max_depth = std::max(max_depth, depth);
+    auto n_points = std::max<std::size_t>((depth + 1) / 2, 1);
+    auto it = rules.find(n_points);
+    if (it == rules.cend()) {
+      it = rules.emplace(n_points, detail::MakeGaussLegendreRule(n_points)).first;
+    }
+    tree_rules[i] = &it->second;
+  }
+  auto max_points = std::max<std::size_t>((max_depth + 1) / 2, 1);
+
+  std::vector<bst_float> &contribs = out_contribs->HostVector();
+  contribs.resize(info.num_row_ * ncolumns * n_groups);
+  std::fill(contribs.begin(), contribs.end(), 0.0f);
+  std::vector<RegTree::FVec> feats_tloc(n_threads);
+  std::vector<std::vector<float>> path_prob_tloc(
+      n_threads, std::vector<float>(n_features, kQuadratureTreeShapUnseen));
+  std::vector<std::vector<double>> arena_tloc(
+      n_threads, std::vector<double>(2 * (max_depth + 1) * max_points));
+  std::vector<std::vector<double>> phi_tloc(n_threads, std::vector<double>(n_features));
+
+  auto device = ctx->Device().IsSycl() ? DeviceOrd::CPU() : ctx->Device();
+  auto base_margin = info.base_margin_.View(device);
+
+  auto process_view = [&](auto &&view) {
+    common::ParallelFor(view.Size(), n_threads, [&](auto i) {
+      auto tid = omp_get_thread_num();
+      auto &feats = feats_tloc[tid];
+      if (feats.Size() == 0) {
+        feats.Init(n_features);
+      }
+      auto &phi = phi_tloc[tid];
+      auto row_idx = view.base_rowid + i;
+      auto n_valid = view.DoFill(i, feats.Data().data());
+      feats.HasMissing(n_valid != feats.Size());
+      for (bst_target_t gid = 0; gid < n_groups; ++gid) {
+        float *p_contribs = &contribs[(row_idx * n_groups + gid) * ncolumns];
+        for (auto entry_idx : model_data.entries_by_group[gid]) {
+          auto const &entry = model_data.entries[entry_idx];
+          std::fill(phi.begin(), phi.end(), 0.0);
+          std::visit(
+              [&](auto const &tree) {
+                auto runner = LinearTreeShapRunner<std::decay_t<decltype(tree)>>{
+                    tree,
+                    entry.target_idx,
+                    feats,
+                    *tree_rules[entry.tree_idx],
+                    &path_prob_tloc[tid],
+                    arena_tloc[tid].data(),
+                    phi.data()};
+                runner.Run();
+              },
+              model_data.trees[entry.tree_idx]);
+          for (bst_feature_t f = 0; f < n_features; ++f) {
+            p_contribs[f] += static_cast<float>(phi[f] * entry.weight);
+          }
+        }
+        p_contribs[ncolumns - 1] += model_data.group_root_mean_sums[gid];
+        if (base_margin.Size() != 0) {
+          CHECK_EQ(base_margin.Shape(1), n_groups);
+          p_contribs[ncolumns - 1] += base_margin(row_idx, gid);
+        } else {
+          p_contribs[ncolumns - 1] += base_score(gid);
+        }
+      }
+      feats.Drop();
+    });
+  };
+
+  LaunchShap(ctx, p_fmat, model, process_view);
+}
+
+void ShapValuesTopK(Context const *ctx, DMatrix *p_fmat, gbm::GBTreeModel const &model,
+                    bst_tree_t tree_end, std::vector<float> const *tree_weights,
+                    bst_feature_t top_k, HostDeviceVector<bst_idx_t> *out_indptr,
+                    HostDeviceVector<bst_feature_t> *out_indices,
+                    HostDeviceVector<float> *out_values) {
+  CHECK_GT(top_k, 0) << "The number of top contributions must be positive.";
+  MetaInfo const &info = p_fmat->Info();
+  auto const n_groups = model.learner_model_state->num_output_group;
+  auto const n_features = model.learner_model_state->num_feature;
+  auto const k = std::min<std::size_t>(top_k, n_features);
+  auto const n_out_rows = info.num_row_ * n_groups;
+
+  auto &indptr = out_indptr->HostVector();
+  auto &indices = out_indices->HostVector();
+  auto &values = out_values->HostVector();
+  indptr.assign(n_out_rows + 1, 0);
+  // Each output row has at most `k` slots, compacted after the SHAP kernel.
+  indices.resize(n_out_rows * k);
+  values.resize(n_out_rows * k);
+
+  using Contrib = std::pair<float, bst_feature_t>;
+  // Larger magnitude first, ties are broken by the feature index.
+  auto more_important = [](Contrib const &l, Contrib const &r) {
+    auto l_abs = std::abs(l.first), r_abs = std::abs(r.first);
+    return l_abs > r_abs || (l_abs == r_abs && l.second < r.second);
+  };
+  std::vector<std::vector<Contrib>> heap_tloc(ctx->Threads());
+  QuadratureTreeShapBlocks(
+      ctx, p_fmat, model, tree_end, tree_weights, 0, common::DetectSimdIsa(),
+      [&](std::int32_t tid, bst_idx_t row_idx, bst_target_t gid,
+          common::Span<float const> row_contribs) {
+        // Bounded heap with the least important contribution at the front.
+        auto &heap = heap_tloc[tid];
+        heap.clear();
+        for (bst_feature_t fidx = 0; fidx < n_features; ++fidx) {
+          Contrib c{row_contribs[fidx], fidx};
+          if (c.first == 0.0f) {
+            continue;
+          }
+          if (heap.size() < k) {
+            heap.push_back(c);
+            std::push_heap(heap.begin(), heap.end(), more_important);
+          } else if (more_important(c, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), more_important);
+            heap.back() = c;
+            std::push_heap(heap.begin(), heap.end(), more_important);
+          }
+        }
+        std::sort_heap(heap.begin(), heap.end(), more_important);
+
+        auto out_ridx = row_idx * n_groups + gid;
+        for (std::size_t i = 0; i < heap.size(); ++i) {
+          values[out_ridx * k + i] = heap[i].first;
+          indices[out_ridx * k + i] = heap[i].second;
+        }
+        indptr[out_ridx + 1] = heap.size();
+      },
+      [](bst_idx_t, bst_idx_t) {});
+
+  // Move the entries to the front, rows are written in parallel into fixed slots.
+  for (std::size_t i = 0; i < n_out_rows; ++i) {
+    auto n = indptr[i + 1];
+    indptr[i + 1] = indptr[i] + n;
+    std::copy_n(values.cbegin() + i * k, n, values.begin() + indptr[i]);
+    std::copy_n(indices.cbegin() + i * k, n, indices.begin() + indptr[i]);
+  }
+  values.resize(indptr.back());
+  indices.resize(indptr.back());
+}
+
+void QuadratureTreeShapInteractionValues(Context const *ctx, DMatrix *p_fmat,
+                                         HostDeviceVector<float> *out_contribs,
+                                         gbm::GBTreeModel const &model, bst_tree_t tree_end,
+                                         std::vector<float> const *tree_weights,
+                                         std::size_t quadrature_points) {
+  CHECK_EQ(quadrature_points, kQuadratureTreeShapPoints)
+      << "CPU QuadratureTreeSHAP currently uses a fixed quadrature size of "
+      << kQuadratureTreeShapPoints << ".";
+
+  MetaInfo const &info = p_fmat->Info();
+  auto const n_groups = model.learner_model_state->num_output_group;
+  auto const ncolumns = model.learner_model_state->num_feature + 1;
+  auto const row_chunk = n_groups * ncolumns * ncolumns;
+
+  std::vector<bst_float> &contribs = out_contribs->HostVector();
+  contribs.resize(info.num_row_ * row_chunk);
+  std::fill(contribs.begin(), contribs.end(), 0.0f);
+  QuadratureTreeShapInteractionRows(
+      ctx, p_fmat, model, tree_end, tree_weights, 0,
+      [&](bst_idx_t row_idx) { return contribs.data() + row_idx * row_chunk; },
+      [](bst_idx_t, bst_idx_t) {});
+}
+
+void ShapValuesStream(Context const *ctx, DMatrix *p_fmat, gbm::GBTreeModel const &model,
+                      bst_tree_t tree_end, std::vector<float> const *tree_weights,
+                      bool interactions, bst_idx_t block_rows,
+                      predictor::ContributionSink *sink) {
+  CHECK(sink);
+  MetaInfo const &info = p_fmat->Info();
+  auto const n_rows = info.num_row_;
+  auto const n_groups = model.learner_model_state->num_output_group;
+  std::size_t const ncolumns = model.learner_model_state->num_feature + 1;
+  auto const row_size = n_groups * ncolumns * (interactions ? ncolumns : 1);
+  if (block_rows == 0) {
+    // Default to a buffer of about 64MB.
+    std::size_t constexpr kBlockBytes = static_cast<std::size_t>(64) << 20;
+    block_rows = std::max(kBlockBytes / (row_size * sizeof(float)), std::size_t{1});
+    // Full blocks for the additive kernel.
+    block_rows = common::DivRoundUp(block_rows, kShapBlockRows) * kShapBlockRows;
+  }
+
+  std::vector<float> buffer(std::min(block_rows, n_rows) * row_size, 0.0f);
+  sink->Begin(n_rows * row_size);
+  bst_idx_t chunk_begin = 0;
+  auto done = [&](bst_idx_t begin, bst_idx_t n) {
+    CHECK_EQ(begin, chunk_begin);
+    auto n_values = n * row_size;
+    sink->Write(common::Span<float const>{buffer.data(), n_values});
+    chunk_begin = begin + n;
+    sink->Progress(chunk_begin, n_rows);
+    std::fill_n(buffer.begin(), n_values, 0.0f);
+  };
+
+  if (interactions) {
+    QuadratureTreeShapInteractionRows(
+        ctx, p_fmat, model, tree_end, tree_weights, block_rows,
+        [&](bst_idx_t row_idx) { return buffer.data() + (row_idx - chunk_begin) * row_size; },
+        done);
+  } else {
+    QuadratureTreeShapBlocks(
+        ctx, p_fmat, model, tree_end, tree_weights, block_rows, common::DetectSimdIsa(),
+        [&](std::int32_t, bst_idx_t row_idx, bst_target_t gid,
+            common::Span<float const> row_contribs) {
+          auto offset = ((row_idx - chunk_begin) * n_groups + gid) * ncolumns;
+          std::copy(row_contribs.cbegin(), row_contribs.cend(), buffer.begin() + offset);
+        },
+        done);
+  }
+  CHECK_EQ(chunk_begin, n_rows);
+}
 
 void ApproxFeatureImportance(Context const *ctx, DMatrix *p_fmat,
                              HostDeviceVector<float> *out_contribs, gbm::GBTreeModel const &model,
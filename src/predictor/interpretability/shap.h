@@ -3,8 +3,11 @@
  */
 #pragma once
 
-#include <vector>  // for vector
+#include <cstdint>  // for int8_t
+#include <string>   // for string
+#include <vector>   // for vector
 
+#include "../../common/simd.h"           // for SimdIsa, DetectSimdIsa
 #include "xgboost/context.h"             // for Context
 #include "xgboost/data.h"                // for DMatrix, MetaInfo
 #include "xgboost/host_device_vector.h"  // for HostDeviceVector
@@ -13,11 +16,28 @@ namespace xgboost::gbm {
 struct GBTreeModel;
 }  // namespace xgboost::gbm
 
+namespace xgboost::predictor {
+class ContributionSink;
+}  // namespace xgboost::predictor
+
 namespace xgboost::interpretability {
+/** @brief Algorithm for the exact SHAP values on CPU. */
+enum class ShapAlgorithm : std::int8_t {
+  kQuadrature = 0,
+  kLinear = 1,
+};
+
+/** @brief Parse the `shap_algorithm` parameter, either `quadrature` or `linear`. */
+[[nodiscard]] ShapAlgorithm ParseShapAlgorithm(std::string const& name);
+
 namespace cpu_impl {
+/**
+ * @param isa Instruction set for the additive block kernel, must be supported by the CPU.
+ */
 void ShapValues(Context const* ctx, DMatrix* p_fmat, HostDeviceVector<float>* out_contribs,
                 gbm::GBTreeModel const& model, bst_tree_t tree_end,
-                std::vector<float> const* tree_weights, int condition, unsigned condition_feature);
+                std::vector<float> const* tree_weights, int condition, unsigned condition_feature,
+                common::SimdIsa isa = common::DetectSimdIsa());
 
 void ApproxFeatureImportance(Context const* ctx, DMatrix* p_fmat,
                              HostDeviceVector<float>* out_contribs, gbm::GBTreeModel const& model,
@@ -27,6 +47,42 @@ void ShapInteractionValues(Context const* ctx, DMatrix* p_fmat,
                            HostDeviceVector<float>* out_contribs, gbm::GBTreeModel const& model,
                            bst_tree_t tree_end, std::vector<float> const* tree_weights,
                            bool approximate);
+
+/**
+ * @brief Exact SHAP values with Linear TreeSHAP. The output has the same layout as
+ *        @ref ShapValues . The number of quadrature points is chosen from the depth of
+ *        each tree, the result is exact for trees of any depth.
+ */
+void LinearTreeShapValues(Context const* ctx, DMatrix* p_fmat,
+                          HostDeviceVector<float>* out_contribs, gbm::GBTreeModel const& model,
+                          bst_tree_t tree_end, std::vector<float> const* tree_weights);
+
+/**
+ * @brief SHAP values with only the largest contributions of each row, in CSR format.
+ *
+ *   Output rows are the (sample, group) pairs in the same order as @ref ShapValues. Each row
+ *   has at most `top_k` non-zero feature contributions sorted by their absolute value in
+ *   descending order, the bias term is not included. The dense contribution matrix is never
+ *   materialized.
+ */
+void ShapValuesTopK(Context const* ctx, DMatrix* p_fmat, gbm::GBTreeModel const& model,
+                    bst_tree_t tree_end, std::vector<float> const* tree_weights,
+                    bst_feature_t top_k, HostDeviceVector<bst_idx_t>* out_indptr,
+                    HostDeviceVector<bst_feature_t>* out_indices,
+                    HostDeviceVector<float>* out_values);
+
+/**
+ * @brief Exact SHAP values or interaction values, written to the sink in blocks of rows
+ *        instead of a single output buffer.
+ *
+ * @param block_rows Number of rows in each block, the last block can be smaller. 0 to choose
+ *                   a block size with about 64MB of output. Multiples of 8 rows avoid
+ *                   partially filled row blocks in the additive kernel.
+ */
+void ShapValuesStream(Context const* ctx, DMatrix* p_fmat, gbm::GBTreeModel const& model,
+                      bst_tree_t tree_end, std::vector<float> const* tree_weights,
+                      bool interactions, bst_idx_t block_rows,
+                      predictor::ContributionSink* sink);
 }  // namespace cpu_impl
 
 #if defined(XGBOOST_USE_CUDA)
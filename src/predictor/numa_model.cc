@@ -0,0 +1,128 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "numa_model.h"
+
+#include <algorithm>  // for sort, set_intersection
+#include <iterator>   // for back_inserter
+#include <mutex>      // for lock_guard
+#include <utility>    // for move
+
+#include "../common/numa_topo.h"        // for GetNumaHasCpuNodes, SetThreadAffinity
+#include "../common/threading_utils.h"  // for ParallelFor
+#include "../gbm/gbtree_model.h"        // for GBTreeModel
+#include "xgboost/logging.h"            // for CHECK_GE, LOG
+
+namespace xgboost::predictor {
+namespace {
+[[nodiscard]] std::vector<NumaNode> DiscoverNumaNodes() {
+  std::vector<std::int32_t> node_ids;
+  common::GetNumaHasCpuNodes(&node_ids);
+  std::vector<std::int32_t> allowed;
+  common::GetThreadAffinity(&allowed);
+  std::sort(allowed.begin(), allowed.end());
+
+  std::vector<NumaNode> nodes;
+  for (auto node_id : node_ids) {
+    std::vector<std::int32_t> cpus;
+    common::GetNumaNodeCpus(node_id, &cpus);
+    std::sort(cpus.begin(), cpus.end());
+    NumaNode node{node_id, {}};
+    std::set_intersection(cpus.cbegin(), cpus.cend(), allowed.cbegin(), allowed.cend(),
+                          std::back_inserter(node.cpus));
+    if (!node.cpus.empty()) {
+      nodes.push_back(std::move(node));
+    }
+  }
+  return nodes;
+}
+}  // namespace
+
+[[nodiscard]] std::vector<NumaNode> const& NumaTopology() {
+  static std::vector<NumaNode> const kNodes = DiscoverNumaNodes();
+  return kNodes;
+}
+
+ScopedThreadAffinity::ScopedThreadAffinity(std::vector<std::int32_t> const& cpus) {
+  common::GetThreadAffinity(&prev_);
+  pinned_ = !prev_.empty() && common::SetThreadAffinity(cpus);
+}
+
+ScopedThreadAffinity::~ScopedThreadAffinity() {
+  if (pinned_) {
+    auto restored = common::SetThreadAffinity(prev_);
+    if (!restored) {
+      LOG(WARNING) << "Failed to restore the thread affinity.";
+    }
+  }
+}
+
+[[nodiscard]] NumaPartition PartitionByNuma(common::Span<NumaNode const> nodes,
+                                            std::int32_t n_threads, bst_idx_t n_rows) {
+  auto n_nodes = nodes.size();
+  CHECK_GE(static_cast<std::size_t>(n_threads), n_nodes);
+  NumaPartition partition;
+  std::vector<std::int32_t> n_node_threads(n_nodes, 0);
+  // Give each thread to the node with the least threads relative to its number of CPUs.
+  for (std::int32_t t = 0; t < n_threads; ++t) {
+    std::size_t best = 0;
+    for (std::size_t k = 1; k < n_nodes; ++k) {
+      // n_node_threads[k] / cpus[k] < n_node_threads[best] / cpus[best]
+      if (static_cast<std::size_t>(n_node_threads[k]) * nodes[best].cpus.size() <
+          static_cast<std::size_t>(n_node_threads[best]) * nodes[k].cpus.size()) {
+        best = k;
+      }
+    }
+    n_node_threads[best]++;
+    partition.thread_node.push_back(static_cast<std::int32_t>(best));
+  }
+
+  partition.row_ptr.resize(n_nodes + 1, 0);
+  std::int32_t n_assigned = 0;
+  for (std::size_t k = 0; k < n_nodes; ++k) {
+    n_assigned += n_node_threads[k];
+    partition.row_ptr[k + 1] = n_rows * n_assigned / n_threads;
+  }
+  return partition;
+}
+
+NumaReplicatedModel::NumaReplicatedModel(gbm::GBTreeModel const& model,
+                                         std::vector<NumaNode> nodes)
+    : nodes_{std::move(nodes)} {
+  // Read the host data before the parallel region.
+  auto const& h_tree_info = model.tree_info.ConstHostVector();
+  auto n_nodes = static_cast<std::int32_t>(nodes_.size());
+  replicas_.resize(n_nodes);
+  // One thread for each node, the copy is first touched by a thread running on the node.
+  common::ParallelFor(n_nodes, n_nodes, common::Sched::Static(), [&](auto k) {
+    ScopedThreadAffinity pin{nodes_[k].cpus};
+    auto replica = std::make_unique<gbm::GBTreeModel>(model.learner_model_state, model.Ctx());
+    replica->param = model.param;
+    replica->trees.reserve(model.trees.size());
+    for (auto const& p_tree : model.trees) {
+      replica->trees.emplace_back(p_tree->Copy());
+    }
+    replica->tree_info.HostVector() = h_tree_info;
+    replica->iteration_indptr = model.iteration_indptr;
+    replica->weight_drop = model.weight_drop;
+    replica->Cats(model.CatsShared());
+    replicas_[k] = std::move(replica);
+  });
+}
+
+NumaReplicatedModel::~NumaReplicatedModel() = default;
+
+[[nodiscard]] std::shared_ptr<NumaReplicatedModel const> GetNumaReplicas(
+    gbm::GBTreeModel const& model) {
+  auto const& nodes = NumaTopology();
+  if (nodes.size() < 2) {
+    return nullptr;
+  }
+  std::lock_guard guard{model.Mutex()};
+  auto& p_cache = model.NumaCache();
+  if (!p_cache) {
+    p_cache = std::make_shared<NumaReplicatedModel>(model, nodes);
+  }
+  return p_cache;
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief NUMA-aware replication of tree models for batch prediction.
+ */
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t
+#include <memory>   // for shared_ptr, unique_ptr
+#include <vector>   // for vector
+
+#include "xgboost/base.h"  // for bst_idx_t
+#include "xgboost/span.h"  // for Span
+
+namespace xgboost::gbm {
+struct GBTreeModel;
+}  // namespace xgboost::gbm
+
+namespace xgboost::predictor {
+/** @brief CPUs of a NUMA node that the current process is allowed to run on. */
+struct NumaNode {
+  std::int32_t node_id;
+  std::vector<std::int32_t> cpus;
+};
+
+/**
+ * @brief Discover the NUMA nodes with at least one usable CPU. The result is computed once
+ *        and cached. It's empty if the topology is not available.
+ */
+[[nodiscard]] std::vector<NumaNode> const& NumaTopology();
+
+/**
+ * @brief Restrict the calling thread to the given CPUs, the previous affinity is restored
+ *        on destruction. Nothing is changed if the affinity is not supported.
+ */
+class ScopedThreadAffinity {
+  std::vector<std::int32_t> prev_;
+  bool pinned_{false};
+
+ public:
+  explicit ScopedThreadAffinity(std::vector<std::int32_t> const& cpus);
+  ~ScopedThreadAffinity();
+
+  ScopedThreadAffinity(ScopedThreadAffinity const&) = delete;
+  ScopedThreadAffinity& operator=(ScopedThreadAffinity const&) = delete;
+};
+
+/** @brief Assignment of threads and rows to NUMA nodes. */
+struct NumaPartition {
+  // Node index for each thread.
+  std::vector<std::int32_t> thread_node;
+  // Row range of each node, with size n_nodes + 1.
+  std::vector<bst_idx_t> row_ptr;
+};
+
+/**
+ * @brief Distribute the threads to the nodes in proportion to their number of CPUs, then
+ *        split the rows in proportion to the number of threads. Each node gets at least
+ *        one thread, `n_threads` must not be less than the number of nodes.
+ */
+[[nodiscard]] NumaPartition PartitionByNuma(common::Span<NumaNode const> nodes,
+                                            std::int32_t n_threads, bst_idx_t n_rows);
+
+/**
+ * @brief One copy of the trees for each NUMA node.
+ *
+ *   Each copy is created by a thread running on the node. With the default first-touch
+ *   policy, the pages of the copy are allocated in the memory of that node. Threads
+ *   running on the node can then traverse the trees without going through the
+ *   interconnect.
+ */
+class NumaReplicatedModel {
+  std::vector<NumaNode> nodes_;
+  std::vector<std::unique_ptr<gbm::GBTreeModel>> replicas_;
+
+ public:
+  NumaReplicatedModel(gbm::GBTreeModel const& model, std::vector<NumaNode> nodes);
+  ~NumaReplicatedModel();
+
+  [[nodiscard]] std::size_t NumNodes() const { return nodes_.size(); }
+  [[nodiscard]] common::Span<NumaNode const> Nodes() const { return nodes_; }
+  [[nodiscard]] gbm::GBTreeModel const& Replica(std::size_t node) const {
+    return *replicas_[node];
+  }
+};
+
+/**
+ * @brief Get the replicas cached on the model, they are created on the first call.
+ *
+ * @return nullptr if there's less than two NUMA nodes.
+ */
+[[nodiscard]] std::shared_ptr<NumaReplicatedModel const> GetNumaReplicas(
+    gbm::GBTreeModel const& model);
+}  // namespace xgboost::predictor
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "prediction_session.h"
+
+#include <algorithm>  // for copy, copy_n
+#include <cmath>      // for isnan
+#include <limits>     // for numeric_limits
+#include <utility>    // for move
+#include <variant>    // for visit, get_if, get
+
+#include "../gbm/gbtree_model.h"  // for GBTreeModel
+#include "predict_fn.h"           // for GetNextNode
+#include "xgboost/learner.h"      // for LearnerModelState
+#include "xgboost/logging.h"      // for CHECK_EQ
+#include "xgboost/span.h"         // for Span
+
+namespace xgboost::predictor {
+namespace {
+template <bool has_missing, bool has_categorical, typename TreeView>
+bst_node_t GetLeafIndex(TreeView const& tree, RegTree::FVec const& feats) {
+  auto const& cats = tree.GetCategoriesMatrix();
+  bst_node_t nidx = RegTree::kRoot;
+  while (!tree.IsLeaf(nidx)) {
+    auto split_index = tree.SplitIndex(nidx);
+    nidx = GetNextNode<has_missing, has_categorical>(
+        tree, nidx, feats.GetFvalue(split_index), has_missing && feats.IsMissing(split_index),
+        cats);
+  }
+  return nidx;
+}
+
+template <bool has_missing, bool has_categorical, typename Trees>
+void AccumulateTrees(Trees const& trees, common::Span<bst_target_t const> tree_groups,
+                     common::OptionalWeights tree_weights, RegTree::FVec const& feats,
+                     float* margin) {
+  for (std::size_t i = 0; i < trees.size(); ++i) {
+    auto weight = tree_weights[i];
+    if (auto const* sc_tree = std::get_if<tree::ScalarTreeView>(&trees[i])) {
+      auto leaf = GetLeafIndex<has_missing, has_categorical>(*sc_tree, feats);
+      margin[tree_groups[i]] += sc_tree->LeafValue(leaf) * weight;
+    } else {
+      auto const& mt_tree = std::get<tree::MultiTargetTreeView>(trees[i]);
+      auto leaf = GetLeafIndex<has_missing, has_categorical>(mt_tree, feats);
+      auto leaf_value = mt_tree.LeafValue(leaf);
+      for (std::size_t j = 0; j < leaf_value.Size(); ++j) {
+        margin[j] += leaf_value(j) * weight;
+      }
+    }
+  }
+}
+}  // namespace
+
+PredictionSession::PredictionSession(gbm::GBTreeModel const& model, float missing,
+                                     bst_tree_t tree_begin, bst_tree_t tree_end)
+    : model_{DeviceOrd::CPU(), model, false, tree_begin, tree_end, CopyViews{}},
+      tree_weights_{1.0f},
+      missing_{missing} {
+  this->ctx_.UpdateAllowUnknown(Args{{"nthread", "1"}});
+
+  auto const* weights = model.TreeWeights();
+  if (weights != nullptr) {
+    this->tree_weights_ = common::OptionalWeights{common::Span<float const>{
+        weights->data() + tree_begin, static_cast<std::size_t>(tree_end - tree_begin)}};
+  }
+  for (auto const& tree : model_.Trees()) {
+    std::visit([&](auto&& t) { has_categorical_ |= t.HasCategoricalSplit(); }, tree);
+  }
+
+  auto n_groups = model_.n_groups;
+  auto base_score = model.learner_model_state->BaseScore(DeviceOrd::CPU());
+  this->base_score_.resize(n_groups);
+  for (bst_target_t gidx = 0; gidx < n_groups; ++gidx) {
+    this->base_score_[gidx] = base_score.Size() == 1 ? base_score(0) : base_score(gidx);
+  }
+  this->margin_.resize(n_groups);
+  this->n_outputs_ = n_groups;
+  this->feats_.Init(model_.n_features);
+}
+
+void PredictionSession::SetTransform(std::unique_ptr<ObjFunction> obj) {
+  this->obj_ = std::move(obj);
+  // Run the transformation once to obtain the output size, and reserve the buffer.
+  auto& h_transformed = this->transformed_.HostVector();
+  h_transformed.assign(this->margin_.size(), 0.0f);
+  this->obj_->PredTransform(&this->transformed_);
+  this->n_outputs_ = this->transformed_.Size();
+}
+
+void PredictionSession::PredictRow(float const* row, float* out) {
+  auto n_features = model_.n_features;
+  auto data = feats_.Data();
+  bool has_missing = false;
+  for (bst_feature_t fidx = 0; fidx < n_features; ++fidx) {
+    auto fvalue = row[fidx];
+    if (fvalue == missing_ || std::isnan(fvalue)) {
+      data[fidx] = std::numeric_limits<float>::quiet_NaN();
+      has_missing = true;
+    } else {
+      data[fidx] = fvalue;
+    }
+  }
+  feats_.HasMissing(has_missing);
+
+  std::copy(base_score_.cbegin(), base_score_.cend(), margin_.begin());
+  auto trees = model_.Trees();
+  auto margin = margin_.data();
+  if (has_missing) {
+    if (has_categorical_) {
+      AccumulateTrees<true, true>(trees, model_.tree_groups, tree_weights_, feats_, margin);
+    } else {
+      AccumulateTrees<true, false>(trees, model_.tree_groups, tree_weights_, feats_, margin);
+    }
+  } else {
+    if (has_categorical_) {
+      AccumulateTrees<false, true>(trees, model_.tree_groups, tree_weights_, feats_, margin);
+    } else {
+      AccumulateTrees<false, false>(trees, model_.tree_groups, tree_weights_, feats_, margin);
+    }
+  }
+
+  if (!obj_) {
+    std::copy(margin_.cbegin(), margin_.cend(), out);
+    return;
+  }
+  // The capacity is reserved by the `SetTransform`, resizing doesn't allocate.
+  auto& h_transformed = transformed_.HostVector();
+  h_transformed.resize(margin_.size());
+  std::copy(margin_.cbegin(), margin_.cend(), h_transformed.begin());
+  obj_->PredTransform(&transformed_);
+  CHECK_EQ(transformed_.Size(), n_outputs_);
+  std::copy_n(h_transformed.cbegin(), n_outputs_, out);
+}
+}  // namespace xgboost::predictor
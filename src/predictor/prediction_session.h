@@ -0,0 +1,94 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Low latency prediction for a single dense row.
+ */
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <memory>   // for unique_ptr
+#include <utility>  // for swap
+#include <variant>  // for variant
+#include <vector>   // for vector
+
+#include "../common/optional_weight.h"   // for OptionalWeights
+#include "../tree/tree_view.h"           // for ScalarTreeView, MultiTargetTreeView
+#include "gbtree_view.h"                 // for GBTreeModelView
+#include "xgboost/base.h"                // for bst_feature_t, bst_tree_t
+#include "xgboost/context.h"             // for Context
+#include "xgboost/host_device_vector.h"  // for HostDeviceVector
+#include "xgboost/objective.h"           // for ObjFunction
+#include "xgboost/tree_model.h"          // for RegTree
+
+namespace xgboost::gbm {
+struct GBTreeModel;
+}  // namespace xgboost::gbm
+
+namespace xgboost::predictor {
+/**
+ * @brief Prediction session for serving one row at a time.
+ *
+ *   All the state required for prediction, including the tree views, the feature vector,
+ *   and the output buffers, is created with the session. Predicting a row doesn't allocate
+ *   memory, parse configuration, or launch threads. The trees are referenced instead of
+ *   being copied, the session must not outlive the booster, and the booster must not be
+ *   updated while the session is alive. A session is not thread-safe, create one for each
+ *   serving thread instead.
+ */
+class PredictionSession {
+ public:
+  using TreeViewVar = std::variant<tree::ScalarTreeView, tree::MultiTargetTreeView>;
+  struct CopyViews {
+    void operator()(std::vector<TreeViewVar>* p_dst, std::vector<TreeViewVar>&& src) const {
+      std::swap(src, *p_dst);
+    }
+  };
+  template <typename T>
+  using Vec = std::vector<T>;
+
+ private:
+  // Single-threaded context for the objective.
+  Context ctx_;
+  GBTreeModelView<Vec, TreeViewVar, CopyViews> model_;
+  common::OptionalWeights tree_weights_;
+  std::vector<float> base_score_;
+  float missing_;
+  bool has_categorical_{false};
+
+  RegTree::FVec feats_;
+  std::vector<float> margin_;
+  // Optional output transformation.
+  std::unique_ptr<ObjFunction> obj_;
+  HostDeviceVector<float> transformed_;
+  std::size_t n_outputs_;
+
+ public:
+  /**
+   * @param model      The tree model.
+   * @param missing    Value representing missing values in the input rows.
+   * @param tree_begin Beginning of the tree range.
+   * @param tree_end   End of the tree range.
+   */
+  PredictionSession(gbm::GBTreeModel const& model, float missing, bst_tree_t tree_begin,
+                    bst_tree_t tree_end);
+
+  /** @brief Context for creating the objective used by @ref SetTransform . */
+  [[nodiscard]] Context const* Ctx() const { return &ctx_; }
+  /**
+   * @brief Apply the prediction transformation of an objective to the output.
+   */
+  void SetTransform(std::unique_ptr<ObjFunction> obj);
+
+  [[nodiscard]] bst_feature_t NumFeatures() const { return model_.n_features; }
+  /** @brief Number of output values for each row. */
+  [[nodiscard]] std::size_t NumOutputs() const { return n_outputs_; }
+
+  /**
+   * @brief Predict a single dense row.
+   *
+   * @param row Feature values with size of @ref NumFeatures .
+   * @param out Output buffer with size of @ref NumOutputs .
+   */
+  void PredictRow(float const* row, float* out);
+};
+}  // namespace xgboost::predictor
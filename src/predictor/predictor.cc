@@ -51,6 +51,49 @@ void InitOutPredictions(Context const* ctx, linalg::VectorView<float const> base
                         linalg::MatrixView<float> predt);
 }
 
+void Predictor::PredictEarlyExit(DMatrix*, float, HostDeviceVector<float>*,
+                                 HostDeviceVector<bst_tree_t>*, gbm::GBTreeModel const&,
+                                 bst_tree_t, bst_tree_t) const {
+  LOG(FATAL) << "Early exit prediction is not supported by the current predictor.";
+}
+
+void Predictor::PredictStaged(DMatrix*, common::Span<bst_tree_t const>, HostDeviceVector<float>*,
+                              gbm::GBTreeModel const&) const {
+  LOG(FATAL) << "Staged prediction is not supported by the current predictor.";
+}
+
+void Predictor::PredictLeafCompact(DMatrix*, HostDeviceVector<std::uint8_t>*, std::int32_t*,
+                                   gbm::GBTreeModel const&, bst_tree_t) const {
+  LOG(FATAL) << "Compact leaf indices are not supported by the current predictor.";
+}
+
+void Predictor::PredictLeafOneHot(DMatrix*, HostDeviceVector<bst_idx_t>*,
+                                  HostDeviceVector<bst_feature_t>*, bst_feature_t*,
+                                  gbm::GBTreeModel const&, bst_tree_t) const {
+  LOG(FATAL) << "One-hot leaf indices are not supported by the current predictor.";
+}
+
+void Predictor::PredictContributionTopK(DMatrix*, bst_feature_t, HostDeviceVector<bst_idx_t>*,
+                                        HostDeviceVector<bst_feature_t>*,
+                                        HostDeviceVector<float>*, gbm::GBTreeModel const&,
+                                        bst_tree_t) const {
+  LOG(FATAL) << "Top-k feature contributions are not supported by the current predictor.";
+}
+
+void Predictor::PredictContributionStream(DMatrix*, bool, bst_idx_t, predictor::ContributionSink*,
+                                          gbm::GBTreeModel const&, bst_tree_t) const {
+  LOG(FATAL) << "Streaming feature contributions is not supported by the current predictor.";
+}
+
+void Predictor::PredictBatchMulti(DMatrix* dmat,
+                                  common::Span<gbm::GBTreeModel const* const> models,
+                                  common::Span<HostDeviceVector<float>* const> out_preds) const {
+  CHECK_EQ(models.size(), out_preds.size());
+  for (std::size_t i = 0; i < models.size(); ++i) {
+    this->PredictBatch(dmat, out_preds[i], *models[i], 0);
+  }
+}
+
 void Predictor::InitOutPredictions(const MetaInfo& info, HostDeviceVector<float>* out_preds,
                                    gbm::GBTreeModel const& model) const {
   CHECK_NE(model.learner_model_state->num_output_group, 0);
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "quantized_forest.h"
+
+#include <algorithm>  // for sort, unique, upper_bound, lower_bound, max
+#include <limits>     // for numeric_limits
+#include <queue>      // for queue
+#include <utility>    // for pair
+
+#include "xgboost/logging.h"  // for CHECK_EQ, CHECK_LT
+
+namespace xgboost::predictor {
+[[nodiscard]] bool QuantizedForest::IsSupported(tree::ScalarTreeView const& tree) {
+  if (tree.HasCategoricalSplit()) {
+    return false;
+  }
+  bool valid = true;
+  tree.WalkTree([&](bst_node_t nidx) {
+    if (!tree.IsLeaf(nidx) && tree.RightChild(nidx) == RegTree::kInvalidNodeId) {
+      valid = false;
+    }
+    return valid;
+  });
+  return valid;
+}
+
+[[nodiscard]] std::unique_ptr<QuantizedForest> QuantizedForest::Create(
+    common::Span<tree::ScalarTreeView const> trees, common::Span<bst_target_t const> tree_groups,
+    bst_feature_t n_features, common::OptionalWeights tree_weights) {
+  CHECK_EQ(trees.size(), tree_groups.size());
+  std::unique_ptr<QuantizedForest> forest{new QuantizedForest{}};
+  forest->n_features_ = n_features;
+  forest->tree_groups_.assign(tree_groups.cbegin(), tree_groups.cend());
+
+  // Collect the distinct thresholds of each feature.
+  std::vector<std::vector<float>> thresholds(n_features);
+  for (auto const& tree : trees) {
+    tree.WalkTree([&](bst_node_t nidx) {
+      if (!tree.IsLeaf(nidx)) {
+        CHECK_LT(tree.SplitIndex(nidx), n_features);
+        thresholds[tree.SplitIndex(nidx)].push_back(tree.SplitCond(nidx));
+      }
+      return true;
+    });
+  }
+  std::size_t max_cuts = 0;
+  forest->cut_ptr_.resize(n_features + 1, 0);
+  for (bst_feature_t fidx = 0; fidx < n_features; ++fidx) {
+    auto& cuts = thresholds[fidx];
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+    if (!cuts.empty()) {
+      forest->split_features_.push_back(fidx);
+    }
+    forest->cut_values_.insert(forest->cut_values_.end(), cuts.cbegin(), cuts.cend());
+    forest->cut_ptr_[fidx + 1] = forest->cut_values_.size();
+    max_cuts = std::max(max_cuts, cuts.size());
+  }
+  // The maximum value of the bin type is reserved for missing values.
+  if (max_cuts < std::numeric_limits<std::uint8_t>::max()) {
+    forest->bin_bytes_ = sizeof(std::uint8_t);
+  } else if (max_cuts < std::numeric_limits<std::uint16_t>::max()) {
+    forest->bin_bytes_ = sizeof(std::uint16_t);
+  } else {
+    return nullptr;
+  }
+
+  // Lay out each tree in breadth-first order with siblings next to each other.
+  forest->tree_ptr_.push_back(0);
+  for (std::size_t tree_idx = 0; tree_idx < trees.size(); ++tree_idx) {
+    auto const& tree = trees[tree_idx];
+    auto weight = tree_weights[tree_idx];
+    auto tree_beg = forest->nodes_.size();
+    // (node index in the tree, node index in the forest)
+    std::queue<std::pair<bst_node_t, std::size_t>> queue;
+    forest->nodes_.emplace_back();
+    queue.emplace(RegTree::kRoot, tree_beg);
+    while (!queue.empty()) {
+      auto [nidx, new_nidx] = queue.front();
+      queue.pop();
+      forest->leaf_values_.resize(forest->nodes_.size(), 0.0f);
+      auto& node = forest->nodes_[new_nidx];
+      if (tree.IsLeaf(nidx)) {
+        node = Node{RegTree::kInvalidNodeId, 0, 0};
+        forest->leaf_values_[new_nidx] = tree.LeafValue(nidx) * weight;
+        continue;
+      }
+      auto fidx = tree.SplitIndex(nidx);
+      auto cuts = forest->Cuts(fidx);
+      auto rank =
+          std::lower_bound(cuts.cbegin(), cuts.cend(), tree.SplitCond(nidx)) - cuts.cbegin();
+      auto left = forest->nodes_.size();
+      node = Node{static_cast<bst_node_t>(left - tree_beg),
+                  fidx | (static_cast<std::uint32_t>(tree.DefaultLeft(nidx)) << 31),
+                  static_cast<std::uint16_t>(rank)};
+      // The reference is invalidated after this.
+      forest->nodes_.resize(left + 2);
+      queue.emplace(tree.LeftChild(nidx), left);
+      queue.emplace(tree.RightChild(nidx), left + 1);
+    }
+    forest->leaf_values_.resize(forest->nodes_.size(), 0.0f);
+    forest->tree_ptr_.push_back(forest->nodes_.size());
+  }
+  return forest;
+}
+
+template <typename BinT>
+void QuantizedForest::BinRowsImpl(common::Span<RegTree::FVec const> feats, BinT* bins) const {
+  for (std::size_t i = 0; i < feats.size(); ++i) {
+    auto const& row = feats[i];
+    auto row_bins = bins + i * n_features_;
+    for (auto fidx : split_features_) {
+      if (row.IsMissing(fidx)) {
+        row_bins[fidx] = std::numeric_limits<BinT>::max();
+        continue;
+      }
+      auto cuts = this->Cuts(fidx);
+      // Number of thresholds less than or equal to the value.
+      auto bin = std::upper_bound(cuts.cbegin(), cuts.cend(), row.GetFvalue(fidx)) - cuts.cbegin();
+      row_bins[fidx] = static_cast<BinT>(bin);
+    }
+  }
+}
+
+template <typename BinT>
+void QuantizedForest::PredictImpl(BinT const* bins, linalg::MatrixView<float> out) const {
+  auto n_rows = out.Shape(0);
+  for (std::size_t tree_idx = 0; tree_idx < tree_groups_.size(); ++tree_idx) {
+    auto const* nodes = nodes_.data() + tree_ptr_[tree_idx];
+    auto const* leaf_values = leaf_values_.data() + tree_ptr_[tree_idx];
+    auto gidx = tree_groups_[tree_idx];
+    for (std::size_t i = 0; i < n_rows; ++i) {
+      auto row_bins = bins + i * n_features_;
+      bst_node_t nidx = 0;
+      while (!nodes[nidx].IsLeaf()) {
+        auto const& node = nodes[nidx];
+        auto bin = row_bins[node.SplitIndex()];
+        // Missing values have the largest bin and go right unless it's the default left.
+        bool go_left = bin <= node.split_bin ||
+                       (bin == std::numeric_limits<BinT>::max() && node.DefaultLeft());
+        nidx = node.left + !go_left;
+      }
+      out(i, gidx) += leaf_values[nidx];
+    }
+  }
+}
+
+void QuantizedForest::BinRows(common::Span<RegTree::FVec const> feats,
+                              common::Span<std::uint8_t> bins) const {
+  CHECK_EQ(bins.size(), feats.size() * this->RowBytes());
+  if (bin_bytes_ == sizeof(std::uint8_t)) {
+    this->BinRowsImpl(feats, bins.data());
+  } else {
+    this->BinRowsImpl(feats, reinterpret_cast<std::uint16_t*>(bins.data()));
+  }
+}
+
+void QuantizedForest::Predict(common::Span<std::uint8_t const> bins,
+                              linalg::MatrixView<float> out) const {
+  CHECK_EQ(bins.size(), out.Shape(0) * this->RowBytes());
+  if (bin_bytes_ == sizeof(std::uint8_t)) {
+    this->PredictImpl(bins.data(), out);
+  } else {
+    this->PredictImpl(reinterpret_cast<std::uint16_t const*>(bins.data()), out);
+  }
+}
+}  // namespace xgboost::predictor
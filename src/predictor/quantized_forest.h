@@ -0,0 +1,116 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Forest evaluation on feature bins derived from the split thresholds of the model.
+ */
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint16_t, int32_t
+#include <memory>   // for unique_ptr
+#include <vector>   // for vector
+
+#include "../common/optional_weight.h"  // for OptionalWeights
+#include "../tree/tree_view.h"          // for ScalarTreeView
+#include "xgboost/base.h"               // for bst_feature_t, bst_tree_t, bst_target_t
+#include "xgboost/linalg.h"             // for MatrixView
+#include "xgboost/span.h"               // for Span
+#include "xgboost/tree_model.h"         // for RegTree
+
+namespace xgboost::predictor {
+/**
+ * @brief A forest that compares feature bins instead of raw feature values.
+ *
+ *   The distinct split thresholds of each feature are collected from the model and used as
+ *   the bin boundaries, with the bin of a value being the number of thresholds less than or
+ *   equal to it. A sample goes left at a split if and only if its bin is less than or equal
+ *   to the rank of the split threshold, so the quantized traversal is exact. Input rows are
+ *   binned once with a binary search per feature, after which the trees are traversed with
+ *   1 or 2 byte comparisons on compact nodes.
+ *
+ *   Only numerical splits for scalar-leaf trees are supported.
+ */
+class QuantizedForest {
+ public:
+  struct Node {
+    // Index of the left child inside the tree, the right child is `left + 1`.
+    bst_node_t left;
+    // Feature index, the highest bit is set when missing values go left.
+    std::uint32_t sindex;
+    // The rank of the split threshold among the thresholds of the feature.
+    std::uint16_t split_bin;
+
+    [[nodiscard]] bool IsLeaf() const { return left == RegTree::kInvalidNodeId; }
+    [[nodiscard]] bst_feature_t SplitIndex() const { return sindex & ((1U << 31) - 1U); }
+    [[nodiscard]] bool DefaultLeft() const { return (sindex >> 31) != 0; }
+  };
+
+ private:
+  bst_feature_t n_features_{0};
+  // Size of each bin in bytes, either 1 or 2.
+  std::int32_t bin_bytes_{0};
+  // Features used by at least one split.
+  std::vector<bst_feature_t> split_features_;
+  // Sorted distinct thresholds for each feature in CSR format.
+  std::vector<std::size_t> cut_ptr_;
+  std::vector<float> cut_values_;
+  // Nodes of all trees in breadth-first order.
+  std::vector<Node> nodes_;
+  // Weighted leaf values, indexed by the node index.
+  std::vector<float> leaf_values_;
+  std::vector<std::size_t> tree_ptr_;
+  std::vector<bst_target_t> tree_groups_;
+
+  template <typename BinT>
+  void BinRowsImpl(common::Span<RegTree::FVec const> feats, BinT* bins) const;
+  template <typename BinT>
+  void PredictImpl(BinT const* bins, linalg::MatrixView<float> out) const;
+
+  QuantizedForest() = default;
+
+ public:
+  /**
+   * @brief Whether the tree can be quantized.
+   */
+  [[nodiscard]] static bool IsSupported(tree::ScalarTreeView const& tree);
+  /**
+   * @brief Quantize a forest, returns nullptr if a feature has too many distinct split
+   *        thresholds to be represented with 16-bit bins.
+   *
+   * @param trees        Scalar trees, all of them must pass the @ref IsSupported check.
+   * @param tree_groups  Output group for each tree.
+   * @param n_features   Number of features in the model.
+   * @param tree_weights Tree weights, folded into the leaf values.
+   */
+  [[nodiscard]] static std::unique_ptr<QuantizedForest> Create(
+      common::Span<tree::ScalarTreeView const> trees,
+      common::Span<bst_target_t const> tree_groups, bst_feature_t n_features,
+      common::OptionalWeights tree_weights);
+
+  /** @brief Size of the bins of a single row in bytes. */
+  [[nodiscard]] std::size_t RowBytes() const {
+    return static_cast<std::size_t>(n_features_) * bin_bytes_;
+  }
+  [[nodiscard]] std::int32_t BinBytes() const { return bin_bytes_; }
+  [[nodiscard]] bst_tree_t NumTrees() const { return tree_groups_.size(); }
+  [[nodiscard]] std::size_t NumNodes() const { return nodes_.size(); }
+  [[nodiscard]] common::Span<float const> Cuts(bst_feature_t fidx) const {
+    return common::Span{cut_values_}.subspan(cut_ptr_[fidx], cut_ptr_[fidx + 1] - cut_ptr_[fidx]);
+  }
+
+  /**
+   * @brief Quantize a block of rows.
+   *
+   * @param feats Feature vectors of the rows.
+   * @param bins  Output buffer with size of `feats.size() * RowBytes()`.
+   */
+  void BinRows(common::Span<RegTree::FVec const> feats, common::Span<std::uint8_t> bins) const;
+  /**
+   * @brief Accumulate the prediction of a block of quantized rows.
+   *
+   * @param bins Output of @ref BinRows .
+   * @param out  Output with shape (n_rows, n_groups), incremented by the leaf values.
+   */
+  void Predict(common::Span<std::uint8_t const> bins, linalg::MatrixView<float> out) const;
+};
+}  // namespace xgboost::predictor
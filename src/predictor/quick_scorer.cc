@@ -0,0 +1,178 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "quick_scorer.h"
+
+#include <algorithm>  // for fill, stable_sort
+#include <cstddef>    // for size_t
+#include <limits>     // for numeric_limits
+
+#include "../common/bitfield.h"  // for TrailingZeroBits
+#include "../common/common.h"    // for DivRoundUp
+#include "xgboost/logging.h"     // for CHECK_EQ, CHECK
+
+namespace xgboost::predictor {
+namespace {
+/**
+ * @brief Visit the tree in order, leaves are numbered from left to right.
+ *
+ * @param leaf_begin Index of the left most leaf in the sub-tree.
+ *
+ * @return The number of leaves in the sub-tree.
+ */
+template <typename LeafFn, typename SplitFn>
+bst_node_t VisitInOrder(tree::ScalarTreeView const& tree, bst_node_t nidx, bst_node_t leaf_begin,
+                        LeafFn&& leaf_fn, SplitFn&& split_fn) {
+  if (tree.IsLeaf(nidx)) {
+    leaf_fn(nidx, leaf_begin);
+    return 1;
+  }
+  auto n_left = VisitInOrder(tree, tree.LeftChild(nidx), leaf_begin, leaf_fn, split_fn);
+  auto n_right =
+      VisitInOrder(tree, tree.RightChild(nidx), leaf_begin + n_left, leaf_fn, split_fn);
+  split_fn(nidx, leaf_begin, leaf_begin + n_left);
+  return n_left + n_right;
+}
+
+bst_node_t CountLeaves(tree::ScalarTreeView const& tree) {
+  return VisitInOrder(
+      tree, RegTree::kRoot, 0, [](bst_node_t, bst_node_t) {},
+      [](bst_node_t, bst_node_t, bst_node_t) {});
+}
+
+struct SplitNode {
+  bst_feature_t fidx;
+  float cond;
+  bst_tree_t tree_idx;
+  std::uint8_t default_left;
+  // Range of leaves in the left sub-tree.
+  bst_node_t left_beg;
+  bst_node_t left_end;
+};
+}  // namespace
+
+[[nodiscard]] bool QuickScorerForest::IsSupported(tree::ScalarTreeView const& tree) {
+  if (tree.HasCategoricalSplit()) {
+    return false;
+  }
+  bst_node_t n_leaves = 0;
+  bool valid = true;
+  tree.WalkTree([&](bst_node_t nidx) {
+    if (tree.IsLeaf(nidx)) {
+      n_leaves++;
+    } else if (tree.RightChild(nidx) == RegTree::kInvalidNodeId) {
+      valid = false;
+    }
+    return valid && n_leaves <= kMaxWords * kBitsPerWord;
+  });
+  return valid && n_leaves <= kMaxWords * kBitsPerWord;
+}
+
+QuickScorerForest::QuickScorerForest(common::Span<tree::ScalarTreeView const> trees,
+                                     common::Span<bst_target_t const> tree_groups,
+                                     bst_feature_t n_features, common::OptionalWeights tree_weights)
+    : n_features_{n_features}, n_trees_{static_cast<bst_tree_t>(trees.size())} {
+  CHECK_EQ(trees.size(), tree_groups.size());
+  bst_node_t max_leaves = 1;
+  for (auto const& tree : trees) {
+    max_leaves = std::max(max_leaves, CountLeaves(tree));
+  }
+  n_words_ = static_cast<std::int32_t>(common::DivRoundUp(max_leaves, kBitsPerWord));
+  CHECK_LE(n_words_, kMaxWords);
+
+  auto leaf_stride = static_cast<std::size_t>(n_words_) * kBitsPerWord;
+  leaf_values_.resize(leaf_stride * trees.size(), 0.0f);
+  tree_groups_.assign(tree_groups.cbegin(), tree_groups.cend());
+
+  std::vector<SplitNode> splits;
+  for (bst_tree_t tree_idx = 0; tree_idx < n_trees_; ++tree_idx) {
+    auto const& tree = trees[tree_idx];
+    auto weight = tree_weights[tree_idx];
+    VisitInOrder(
+        tree, RegTree::kRoot, 0,
+        [&](bst_node_t nidx, bst_node_t leaf_idx) {
+          leaf_values_[tree_idx * leaf_stride + leaf_idx] = tree.LeafValue(nidx) * weight;
+        },
+        [&](bst_node_t nidx, bst_node_t left_beg, bst_node_t left_end) {
+          CHECK_LT(tree.SplitIndex(nidx), n_features_);
+          splits.push_back(SplitNode{tree.SplitIndex(nidx), tree.SplitCond(nidx), tree_idx,
+                                     static_cast<std::uint8_t>(tree.DefaultLeft(nidx)), left_beg,
+                                     left_end});
+        });
+  }
+
+  std::stable_sort(splits.begin(), splits.end(), [](SplitNode const& l, SplitNode const& r) {
+    return l.fidx == r.fidx ? l.cond < r.cond : l.fidx < r.fidx;
+  });
+
+  feature_ptr_.resize(n_features_ + 1, 0);
+  thresholds_.resize(splits.size());
+  tree_idx_.resize(splits.size());
+  default_left_.resize(splits.size());
+  masks_.resize(splits.size() * n_words_, std::numeric_limits<WordT>::max());
+  for (std::size_t i = 0; i < splits.size(); ++i) {
+    auto const& s = splits[i];
+    feature_ptr_[s.fidx + 1]++;
+    thresholds_[i] = s.cond;
+    tree_idx_[i] = s.tree_idx;
+    default_left_[i] = s.default_left;
+    // Clear the leaves in the left sub-tree, they are unreachable once the sample goes
+    // right.
+    auto mask = masks_.data() + i * n_words_;
+    for (bst_node_t leaf_idx = s.left_beg; leaf_idx < s.left_end; ++leaf_idx) {
+      mask[leaf_idx / kBitsPerWord] &= ~(WordT{1} << (leaf_idx % kBitsPerWord));
+    }
+  }
+  for (bst_feature_t fidx = 0; fidx < n_features_; ++fidx) {
+    if (feature_ptr_[fidx + 1] != 0) {
+      split_features_.push_back(fidx);
+    }
+    feature_ptr_[fidx + 1] += feature_ptr_[fidx];
+  }
+}
+
+void QuickScorerForest::PredictRow(RegTree::FVec const& feats, common::Span<WordT> workspace,
+                                   linalg::VectorView<float> out) const {
+  auto n_words = this->n_words_;
+  auto leaf_bits = workspace.data();
+  std::fill_n(leaf_bits, this->WorkspaceSize(), std::numeric_limits<WordT>::max());
+
+  auto apply = [&](std::size_t k) {
+    auto dst = leaf_bits + static_cast<std::size_t>(tree_idx_[k]) * n_words;
+    auto mask = masks_.data() + k * n_words;
+    for (std::int32_t w = 0; w < n_words; ++w) {
+      dst[w] &= mask[w];
+    }
+  };
+
+  for (auto fidx : split_features_) {
+    auto beg = feature_ptr_[fidx];
+    auto end = feature_ptr_[fidx + 1];
+    if (feats.IsMissing(fidx)) {
+      for (auto k = beg; k < end; ++k) {
+        if (!default_left_[k]) {
+          apply(k);
+        }
+      }
+    } else {
+      // The sample goes right when `fvalue < split_cond` is false.
+      auto fvalue = feats.GetFvalue(fidx);
+      for (auto k = beg; k < end && thresholds_[k] <= fvalue; ++k) {
+        apply(k);
+      }
+    }
+  }
+
+  auto leaf_stride = static_cast<std::size_t>(n_words) * kBitsPerWord;
+  for (bst_tree_t tree_idx = 0; tree_idx < n_trees_; ++tree_idx) {
+    auto bits = leaf_bits + static_cast<std::size_t>(tree_idx) * n_words;
+    // The exit leaf is never cleared.
+    std::int32_t w = 0;
+    while (bits[w] == 0) {
+      ++w;
+    }
+    auto leaf_idx = w * kBitsPerWord + TrailingZeroBits(bits[w]);
+    out(tree_groups_[tree_idx]) += leaf_values_[tree_idx * leaf_stride + leaf_idx];
+  }
+}
+}  // namespace xgboost::predictor
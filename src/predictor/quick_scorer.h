@@ -0,0 +1,94 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Bitvector-based forest evaluation.
+ *
+ * Reference: Lucchese et al., "QuickScorer: A Fast Algorithm to Rank Documents with
+ *            Additive Ensembles of Regression Trees", SIGIR 2015.
+ */
+#pragma once
+
+#include <cstdint>  // for uint32_t, uint8_t
+#include <vector>   // for vector
+
+#include "../common/optional_weight.h"  // for OptionalWeights
+#include "../tree/tree_view.h"          // for ScalarTreeView
+#include "xgboost/base.h"               // for bst_feature_t, bst_tree_t, bst_target_t
+#include "xgboost/linalg.h"             // for VectorView
+#include "xgboost/span.h"               // for Span
+#include "xgboost/tree_model.h"         // for RegTree
+
+namespace xgboost::predictor {
+/**
+ * @brief The QuickScorer representation of a forest.
+ *
+ *   Leaves of each tree are numbered from left to right, and each tree has a bitvector
+ *   with one bit per leaf. For every split node, we store a mask that clears the leaves
+ *   in its left sub-tree. A sample is scored by scanning the sorted thresholds of each
+ *   feature and applying the masks of nodes whose test is false (the sample goes right),
+ *   after which the left most remaining bit of each tree is the exit leaf.
+ *
+ *   Only numerical splits for scalar-leaf trees are supported. Callers should check @ref
+ *   IsSupported and fall back to the node-by-node traversal otherwise.
+ */
+class QuickScorerForest {
+ public:
+  using WordT = std::uint32_t;
+  constexpr static std::int32_t kBitsPerWord = sizeof(WordT) * 8;
+  /** @brief Maximum number of words for each tree, limits the number of leaves to 256. */
+  constexpr static std::int32_t kMaxWords = 8;
+
+ private:
+  bst_feature_t n_features_{0};
+  bst_tree_t n_trees_{0};
+  // Number of words for the bitvector of each tree.
+  std::int32_t n_words_{0};
+  // Features used by at least one split.
+  std::vector<bst_feature_t> split_features_;
+  // CSR pointer of split nodes grouped by feature, with size n_features + 1.
+  std::vector<std::size_t> feature_ptr_;
+  // Split nodes sorted by threshold inside each feature.
+  std::vector<float> thresholds_;
+  std::vector<bst_tree_t> tree_idx_;
+  std::vector<std::uint8_t> default_left_;
+  // Leaf masks, n_words_ for each split node.
+  std::vector<WordT> masks_;
+  // Weighted leaf values, n_words_ * kBitsPerWord for each tree.
+  std::vector<float> leaf_values_;
+  std::vector<bst_target_t> tree_groups_;
+
+ public:
+  /**
+   * @brief Whether the tree can be represented with bitvectors.
+   */
+  [[nodiscard]] static bool IsSupported(tree::ScalarTreeView const& tree);
+
+  /**
+   * @param trees        Scalar trees, all of them must pass the @ref IsSupported check.
+   * @param tree_groups  Output group for each tree.
+   * @param n_features   Number of features in the model.
+   * @param tree_weights Tree weights, folded into the leaf values.
+   */
+  QuickScorerForest(common::Span<tree::ScalarTreeView const> trees,
+                    common::Span<bst_target_t const> tree_groups, bst_feature_t n_features,
+                    common::OptionalWeights tree_weights);
+
+  /** @brief Size of the per-thread workspace required by @ref PredictRow */
+  [[nodiscard]] std::size_t WorkspaceSize() const {
+    return static_cast<std::size_t>(n_trees_) * n_words_;
+  }
+  [[nodiscard]] bst_tree_t NumTrees() const { return n_trees_; }
+  [[nodiscard]] std::int32_t NumWords() const { return n_words_; }
+  [[nodiscard]] std::size_t NumSplits() const { return thresholds_.size(); }
+
+  /**
+   * @brief Accumulate the prediction of a single sample.
+   *
+   * @param feats     Feature vector of the sample.
+   * @param workspace Buffer with size of @ref WorkspaceSize .
+   * @param out       Output for each group, incremented by the leaf values.
+   */
+  void PredictRow(RegTree::FVec const& feats, common::Span<WordT> workspace,
+                  linalg::VectorView<float> out) const;
+};
+}  // namespace xgboost::predictor
@@ -0,0 +1,306 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "simplify_forest.h"
+
+#include <algorithm>  // for max, min, max_element, count
+#include <cmath>      // for abs
+#include <cstring>    // for memcpy
+#include <limits>     // for numeric_limits
+#include <map>        // for map
+#include <tuple>      // for tuple
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "../common/json_utils.h"       // for OptionalArg
+#include "../common/threading_utils.h"  // for ParallelFor
+#include "../gbm/gbtree_model.h"        // for GBTreeModel
+#include "../tree/tree_view.h"          // for ScalarTreeView
+#include "xgboost/learner.h"            // for LearnerModelState
+#include "xgboost/logging.h"            // for CHECK, CHECK_LT
+
+namespace xgboost::predictor {
+namespace {
+/**
+ * @brief Values of a feature that can reach a node, [lo, hi) with an optional missing
+ *        value.
+ */
+struct FeatureBound {
+  float lo{-std::numeric_limits<float>::infinity()};
+  float hi{std::numeric_limits<float>::infinity()};
+  bool may_missing{true};
+};
+
+enum class Decision : std::int8_t { kLeft, kRight, kBoth };
+
+/** @brief Leaf values reachable from a node. */
+struct LeafRange {
+  float lo{std::numeric_limits<float>::infinity()};
+  float hi{-std::numeric_limits<float>::infinity()};
+  double sum_hess{0.0};
+  double weighted_sum{0.0};
+
+  [[nodiscard]] float Spread() const { return hi - lo; }
+  /** @brief Hessian-weighted mean, the mid-point is used if there's no statistic. */
+  [[nodiscard]] float Value() const {
+    if (sum_hess > 0.0) {
+      return std::min(std::max(static_cast<float>(weighted_sum / sum_hess), lo), hi);
+    }
+    return lo + (hi - lo) / 2.0f;
+  }
+};
+
+class TreeSimplifier {
+  tree::ScalarTreeView tree_;
+  float tolerance_;
+  // Bounds of each feature along the current path.
+  std::vector<FeatureBound> bounds_;
+  RegTree* out_;
+  SimplifyTreeStats stats_;
+
+  [[nodiscard]] Decision Decide(bst_node_t nidx) const {
+    auto const& bound = bounds_[tree_.SplitIndex(nidx)];
+    auto cond = tree_.SplitCond(nidx);
+    auto dft_left = tree_.DefaultLeft(nidx);
+    // All the values are less than the threshold.
+    if (bound.hi <= cond && (!bound.may_missing || dft_left)) {
+      return Decision::kLeft;
+    }
+    // None of the values is less than the threshold.
+    if (bound.lo >= cond && (!bound.may_missing || !dft_left)) {
+      return Decision::kRight;
+    }
+    return Decision::kBoth;
+  }
+  // Skip the splits with a known outcome.
+  [[nodiscard]] bst_node_t Reachable(bst_node_t nidx, bst_node_t* n_skipped) const {
+    while (!tree_.IsLeaf(nidx)) {
+      auto decision = this->Decide(nidx);
+      if (decision == Decision::kBoth) {
+        break;
+      }
+      nidx = decision == Decision::kLeft ? tree_.LeftChild(nidx) : tree_.RightChild(nidx);
+      ++(*n_skipped);
+    }
+    return nidx;
+  }
+  // Narrow the bound for the child, returns the previous bound for restoring it.
+  FeatureBound Narrow(bst_node_t nidx, bool left) {
+    auto& bound = bounds_[tree_.SplitIndex(nidx)];
+    auto prev = bound;
+    auto cond = tree_.SplitCond(nidx);
+    if (left) {
+      bound.hi = std::min(bound.hi, cond);
+      bound.may_missing = bound.may_missing && tree_.DefaultLeft(nidx);
+    } else {
+      bound.lo = std::max(bound.lo, cond);
+      bound.may_missing = bound.may_missing && !tree_.DefaultLeft(nidx);
+    }
+    return prev;
+  }
+  template <typename Fn>
+  void WithChild(bst_node_t nidx, bool left, Fn&& fn) {
+    auto prev = this->Narrow(nidx, left);
+    fn(left ? tree_.LeftChild(nidx) : tree_.RightChild(nidx));
+    bounds_[tree_.SplitIndex(nidx)] = prev;
+  }
+  /**
+   * @brief Accumulate the reachable leaves of a sub-tree, stops once the spread is greater
+   *        than the tolerance.
+   *
+   * @return Whether the spread is within the tolerance.
+   */
+  bool CollectLeaves(bst_node_t nidx, LeafRange* range) {
+    bst_node_t n_skipped = 0;
+    nidx = this->Reachable(nidx, &n_skipped);
+    if (tree_.IsLeaf(nidx)) {
+      auto value = tree_.LeafValue(nidx);
+      range->lo = std::min(range->lo, value);
+      range->hi = std::max(range->hi, value);
+      auto hess = static_cast<double>(tree_.SumHess(nidx));
+      range->sum_hess += hess;
+      range->weighted_sum += hess * value;
+      return range->Spread() <= tolerance_;
+    }
+    bool within = true;
+    this->WithChild(nidx, true, [&](bst_node_t child) { within = CollectLeaves(child, range); });
+    if (within) {
+      this->WithChild(nidx, false,
+                      [&](bst_node_t child) { within = CollectLeaves(child, range); });
+    }
+    return within;
+  }
+
+  void Build(bst_node_t nidx, bst_node_t new_nidx) {
+    nidx = this->Reachable(nidx, &stats_.n_redundant);
+    auto& node = (*out_)[new_nidx];
+    if (tree_.IsLeaf(nidx)) {
+      node.SetLeaf(tree_.LeafValue(nidx));
+      out_->Stat(new_nidx) = tree_.Stat(nidx);
+      return;
+    }
+    LeafRange range;
+    if (this->CollectLeaves(nidx, &range)) {
+      auto value = range.Value();
+      stats_.max_change =
+          std::max({stats_.max_change, static_cast<double>(value) - range.lo,
+                    static_cast<double>(range.hi) - value});
+      node.SetLeaf(value);
+      out_->Stat(new_nidx) = tree_.Stat(nidx);
+      ++stats_.n_collapsed;
+      return;
+    }
+
+    auto const& stat = tree_.Stat(nidx);
+    out_->ExpandNode(new_nidx, tree_.SplitIndex(nidx), tree_.SplitCond(nidx),
+                     tree_.DefaultLeft(nidx), stat.base_weight, 0.0f, 0.0f, stat.loss_chg,
+                     stat.sum_hess, 0.0f, 0.0f);
+    auto left = (*out_)[new_nidx].LeftChild();
+    auto right = (*out_)[new_nidx].RightChild();
+    this->WithChild(nidx, true, [&](bst_node_t child) { this->Build(child, left); });
+    this->WithChild(nidx, false, [&](bst_node_t child) { this->Build(child, right); });
+  }
+
+ public:
+  TreeSimplifier(RegTree const& tree, bst_feature_t n_features, float tolerance, RegTree* out)
+      : tree_{&tree}, tolerance_{tolerance}, bounds_(n_features), out_{out} {}
+
+  [[nodiscard]] SimplifyTreeStats Run() {
+    this->Build(RegTree::kRoot, RegTree::kRoot);
+    return stats_;
+  }
+};
+
+[[nodiscard]] std::uint32_t FloatBits(float v) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(v));
+  return bits;
+}
+
+/**
+ * @brief Fold stumps with the same root split and output group into the first of them,
+ *        the folded trees are replaced by a tree with a single zero leaf.
+ *
+ * @return The number of folded trees.
+ */
+[[nodiscard]] std::int64_t FoldStumps(gbm::GBTreeModel* model) {
+  auto& trees = model->trees;
+  auto groups = model->TreeGroups(DeviceOrd::CPU());
+  auto const* weights = model->TreeWeights();
+  auto weight = [&](std::size_t tree_idx) {
+    return weights == nullptr ? 1.0f : (*weights)[tree_idx];
+  };
+
+  // (group, feature, threshold, default left) -> first stump
+  std::map<std::tuple<bst_target_t, bst_feature_t, std::uint32_t, bool>, std::size_t> first;
+  std::int64_t n_folded = 0;
+  for (std::size_t tree_idx = 0; tree_idx < trees.size(); ++tree_idx) {
+    if (!CanSimplify(*trees[tree_idx])) {
+      continue;
+    }
+    auto tree = trees[tree_idx]->HostScView();
+    auto root = RegTree::kRoot;
+    if (tree.IsLeaf(root) || !tree.IsLeaf(tree.LeftChild(root)) ||
+        !tree.IsLeaf(tree.RightChild(root))) {
+      continue;
+    }
+    auto key = std::make_tuple(groups[tree_idx], tree.SplitIndex(root),
+                               FloatBits(tree.SplitCond(root)), tree.DefaultLeft(root));
+    auto it = first.find(key);
+    if (it == first.cend()) {
+      if (weight(tree_idx) != 0.0f) {
+        first.emplace(key, tree_idx);
+      }
+      continue;
+    }
+    // w_t * l_t + w_i * l_i = w_t * (l_t + w_i / w_t * l_i)
+    auto& target = *trees[it->second];
+    auto scale = weight(tree_idx) / weight(it->second);
+    for (bool left : {true, false}) {
+      auto nidx = left ? tree.LeftChild(root) : tree.RightChild(root);
+      auto t_nidx = left ? target[root].LeftChild() : target[root].RightChild();
+      target[t_nidx].SetLeaf(target[t_nidx].LeafValue() + scale * tree.LeafValue(nidx));
+    }
+    trees[tree_idx] = std::make_unique<RegTree>(1, trees[tree_idx]->NumFeatures());
+    ++n_folded;
+  }
+  return n_folded;
+}
+}  // namespace
+
+[[nodiscard]] bool CanSimplify(RegTree const& tree) {
+  return !tree.IsMultiTarget() && !tree.HasCategoricalSplit();
+}
+
+[[nodiscard]] std::unique_ptr<RegTree> SimplifyTree(RegTree const& tree, bst_feature_t n_features,
+                                                    float tolerance, SimplifyTreeStats* out_stats) {
+  CHECK(CanSimplify(tree)) << "Only scalar trees with numerical splits can be simplified.";
+  CHECK_GE(tolerance, 0.0f);
+  auto sc_tree = tree.HostScView();
+  sc_tree.WalkTree([&](bst_node_t nidx) {
+    if (!sc_tree.IsLeaf(nidx)) {
+      CHECK_LT(sc_tree.SplitIndex(nidx), n_features);
+    }
+    return true;
+  });
+  auto out = std::make_unique<RegTree>(1, tree.NumFeatures());
+  *out_stats = TreeSimplifier{tree, n_features, tolerance, out.get()}.Run();
+  return out;
+}
+
+[[nodiscard]] Json SimplifyModel(gbm::GBTreeModel* model, Json const& config) {
+  auto tolerance = OptionalArg<Number>(config, "tolerance", 0.0f);
+  auto fold_stumps = OptionalArg<Boolean>(config, "fold_stumps", false);
+  CHECK_GE(tolerance, 0.0f) << "`tolerance` must be non-negative.";
+
+  auto& trees = model->trees;
+  auto n_trees = trees.size();
+  auto n_features = model->learner_model_state->num_feature;
+  std::vector<SimplifyTreeStats> stats(n_trees);
+  std::vector<std::int8_t> skipped(n_trees, 0);
+  std::int64_t n_nodes_before = 0;
+  for (auto const& p_tree : trees) {
+    n_nodes_before += p_tree->NumValidNodes();
+  }
+
+  common::ParallelFor(n_trees, model->Ctx()->Threads(), [&](auto tree_idx) {
+    if (!CanSimplify(*trees[tree_idx])) {
+      skipped[tree_idx] = 1;
+      return;
+    }
+    trees[tree_idx] = SimplifyTree(*trees[tree_idx], n_features, tolerance, &stats[tree_idx]);
+  });
+  auto n_folded = fold_stumps ? FoldStumps(model) : 0;
+  model->InvalidateCache();
+
+  auto groups = model->TreeGroups(DeviceOrd::CPU());
+  auto const* weights = model->TreeWeights();
+  std::vector<double> margin_change(model->learner_model_state->OutputLength(), 0.0);
+  double max_leaf_change = 0.0;
+  std::int64_t n_redundant = 0, n_collapsed = 0, n_nodes = 0;
+  for (std::size_t tree_idx = 0; tree_idx < n_trees; ++tree_idx) {
+    auto weight = weights == nullptr ? 1.0 : std::abs(static_cast<double>((*weights)[tree_idx]));
+    auto change = stats[tree_idx].max_change * weight;
+    max_leaf_change = std::max(max_leaf_change, change);
+    margin_change[groups[tree_idx]] += change;
+    n_redundant += stats[tree_idx].n_redundant;
+    n_collapsed += stats[tree_idx].n_collapsed;
+    n_nodes += trees[tree_idx]->NumValidNodes();
+  }
+
+  Json report{Object{}};
+  report["n_nodes_before"] = Integer{n_nodes_before};
+  report["n_nodes"] = Integer{n_nodes};
+  report["n_redundant_splits"] = Integer{n_redundant};
+  report["n_collapsed_subtrees"] = Integer{n_collapsed};
+  report["n_folded_trees"] = Integer{n_folded};
+  report["n_skipped_trees"] =
+      Integer{static_cast<Integer::Int>(std::count(skipped.cbegin(), skipped.cend(), 1))};
+  report["max_leaf_change"] = Number{max_leaf_change};
+  report["max_margin_change"] =
+      Number{margin_change.empty()
+                 ? 0.0
+                 : *std::max_element(margin_change.cbegin(), margin_change.cend())};
+  return report;
+}
+}  // namespace xgboost::predictor
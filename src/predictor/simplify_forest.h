@@ -0,0 +1,67 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Inference-preparation pass that removes nodes from a tree model.
+ */
+#pragma once
+
+#include <cstdint>  // for int32_t
+#include <memory>   // for unique_ptr
+
+#include "xgboost/base.h"        // for bst_feature_t, bst_node_t
+#include "xgboost/json.h"        // for Json
+#include "xgboost/tree_model.h"  // for RegTree
+
+namespace xgboost::gbm {
+struct GBTreeModel;
+}  // namespace xgboost::gbm
+
+namespace xgboost::predictor {
+/** @brief Statistics of simplifying a single tree. */
+struct SimplifyTreeStats {
+  // Number of splits removed because an ancestor has already decided their outcome.
+  bst_node_t n_redundant{0};
+  // Number of sub-trees replaced by a single leaf.
+  bst_node_t n_collapsed{0};
+  // Maximum change of the tree output for any input.
+  double max_change{0.0};
+};
+
+/**
+ * @brief Whether the tree can be simplified. Only scalar trees with numerical splits are
+ *        supported.
+ */
+[[nodiscard]] bool CanSimplify(RegTree const& tree);
+
+/**
+ * @brief Create a simplified copy of a tree.
+ *
+ *   - A split is removed if the splits on the same feature along the path from the root
+ *     have already decided its outcome, including the outcome of missing values. The
+ *     split is replaced by the only reachable child.
+ *   - A sub-tree is replaced by a leaf if the difference between its largest and smallest
+ *     reachable leaf values is not greater than `tolerance`. The new leaf value is the
+ *     mean of the leaf values weighted by their hessian sum.
+ *
+ *   The node statistics of the remaining nodes are preserved.
+ *
+ * @param tree       A tree that passes the @ref CanSimplify check.
+ * @param n_features Number of features in the model.
+ * @param tolerance  Largest leaf value spread of a sub-tree that can be collapsed.
+ * @param out_stats  Statistics of the pass.
+ */
+[[nodiscard]] std::unique_ptr<RegTree> SimplifyTree(RegTree const& tree, bst_feature_t n_features,
+                                                    float tolerance, SimplifyTreeStats* out_stats);
+
+/**
+ * @brief Simplify all the trees in a model in place, see @ref SimplifyTree . Unsupported
+ *        trees are left unchanged.
+ *
+ * @param model  The tree model.
+ * @param config JSON encoded parameters, see @ref XGBoosterSimplify .
+ *
+ * @return A report with the number of nodes before and after the pass and the upper bound
+ *         of the change in the prediction.
+ */
+[[nodiscard]] Json SimplifyModel(gbm::GBTreeModel* model, Json const& config);
+}  // namespace xgboost::predictor
@@ -17,7 +17,7 @@
 #include "../common/numeric.h"            // for Iota
 #include "../common/partition_builder.h"  // for PartitionBuilder
 #include "../common/row_set.h"            // for RowSetCollection
-#include "../common/threading_utils.h"    // for ParallelFor2d
+#include "../common/threading_utils.h"    // for ParallelFor2dStealing
 #include "tree_view.h"                    // for ScalarTreeView
 #include "xgboost/base.h"                 // for bst_idx_t
 #include "xgboost/collective/result.h"    // for Success, SafeColl
@@ -168,8 +168,10 @@ class CommonRowPartitioner {
     CHECK_EQ(base_rowid, gmat.base_rowid);
 
     // 2.3 Split elements of row_set_collection_ to left and right child-nodes for each node
-    // Store results in intermediate buffers from partition_builder_
-    common::ParallelFor2d(space, ctx->Threads(), [&](size_t node_in_set, common::Range1d r) {
+    // Store results in intermediate buffers from partition_builder_. The buffers are indexed
+    // by task instead of thread, idle threads can steal blocks from the larger nodes.
+    common::ParallelFor2dStealing(space, ctx->Threads(), [&](size_t node_in_set,
+                                                            common::Range1d r) {
       size_t begin = r.begin();
       const int32_t nid = nodes[node_in_set].nid;
       const size_t task_id = partition_builder_.GetTaskIdx(node_in_set, begin);
@@ -186,7 +188,8 @@ class CommonRowPartitioner {
 
     // 4. Copy elements from partition_builder_ to row_set_collection_ back
     // with updated row-indexes for each tree-node
-    common::ParallelFor2d(space, ctx->Threads(), [&](size_t node_in_set, common::Range1d r) {
+    common::ParallelFor2dStealing(space, ctx->Threads(), [&](size_t node_in_set,
+                                                            common::Range1d r) {
       const int32_t nid = nodes[node_in_set].nid;
       partition_builder_.MergeToArray(node_in_set, r.begin(), row_set_collection_[nid].begin());
     });
@@ -8,7 +8,7 @@
 #include <cstddef>    // for size_t
 #include <limits>     // for numeric_limits
 #include <memory>     // for shared_ptr
-#include <numeric>    // for accumulate
+#include <numeric>    // for iota
 #include <utility>    // for move
 #include <vector>     // for vector
 
@@ -61,7 +61,8 @@ class HistEvaluator {
    *        pseudo-category for missing value but here we just do a complete scan to avoid
    *        making specialized histogram bin.
    */
-  void EnumerateOneHot(common::HistogramCuts const &cut, common::ConstGHistRow hist,
+  template <typename GradientSumT>
+  void EnumerateOneHot(common::HistogramCuts const &cut, common::Span<GradientSumT const> hist,
                        bst_feature_t fidx, bst_node_t nidx,
                        TreeEvaluator::SplitEvaluator<TrainParam> const &evaluator,
                        SplitEntry *p_best) const {
@@ -79,8 +80,10 @@ class HistEvaluator {
     best.is_cat = false;  // marker for whether it's updated or not.
 
     auto f_hist = hist.subspan(cut_ptr[fidx], n_bins);
-    auto feature_sum = GradStats{
-        std::accumulate(f_hist.data(), f_hist.data() + f_hist.size(), GradientPairPrecise{})};
+    GradStats feature_sum;
+    for (auto const &g : f_hist) {
+      feature_sum.Add(g.GetGrad(), g.GetHess());
+    }
     GradStats missing;
     auto const &parent = snode_[nidx];
     missing.SetSubstract(parent.stats, feature_sum);
@@ -131,9 +134,9 @@ class HistEvaluator {
    *   | [DE] ABC | CDE [AB] |
    *   | [E] ABCD | BCDE [A] |
    */
-  template <int d_step>
+  template <int d_step, typename GradientSumT>
   void EnumeratePart(common::HistogramCuts const &cut, common::Span<size_t const> sorted_idx,
-                     common::ConstGHistRow hist, bst_feature_t fidx, bst_node_t nidx,
+                     common::Span<GradientSumT const> hist, bst_feature_t fidx, bst_node_t nidx,
                      TreeEvaluator::SplitEvaluator<TrainParam> const &evaluator,
                      SplitEntry *p_best) {
     static_assert(d_step == +1 || d_step == -1, "Invalid step.");
@@ -201,9 +204,10 @@ class HistEvaluator {
   // Enumerate/Scan the split values of specific feature
   // Returns the sum of gradients corresponding to the data points that contains
   // a non-missing value for the particular feature fid.
-  template <int d_step>
-  GradStats EnumerateSplit(common::HistogramCuts const &cut, common::ConstGHistRow hist,
-                           bst_feature_t fidx, bst_node_t nidx,
+  template <int d_step, typename GradientSumT>
+  GradStats EnumerateSplit(common::HistogramCuts const &cut,
+                           common::Span<GradientSumT const> hist, bst_feature_t fidx,
+                           bst_node_t nidx,
                            TreeEvaluator::SplitEvaluator<TrainParam> const &evaluator,
                            SplitEntry *p_best) const {
     static_assert(d_step == +1 || d_step == -1, "Invalid step.");
@@ -264,7 +268,13 @@ class HistEvaluator {
   }
 
  public:
-  void EvaluateSplits(const BoundedHistCollection &hist, common::HistogramCuts const &cut,
+  /**
+   * @brief Evaluate splits for all entries. The histogram can be in either double or single
+   *        precision, the statistics of split candidates are always accumulated in double.
+   */
+  template <typename GradientSumT>
+  void EvaluateSplits(BoundedHistCollectionImpl<GradientSumT> const &hist,
+                      common::HistogramCuts const &cut,
                       common::Span<FeatureType const> feature_types,
                       std::vector<CPUExpandEntry> *p_entries) {
     auto n_threads = ctx_->Threads();
@@ -1,5 +1,5 @@
 /**
- * Copyright 2023-2024 by XGBoost Contributors
+ * Copyright 2023-2026, XGBoost Contributors
  */
 #ifndef XGBOOST_TREE_HIST_HIST_CACHE_H_
 #define XGBOOST_TREE_HIST_HIST_CACHE_H_
@@ -26,15 +26,18 @@ namespace xgboost::tree {
  *   The caller is responsible for clearing up the cache as it needs to rearrange the
  *   nodes before making overflowed allocations. The strcut only reports whether the size
  *   limit has benn reached.
+ *
+ * @tparam GradientSumT Type of the histogram bin, either floating point or quantised.
  */
-class BoundedHistCollection {
+template <typename GradientSumT>
+class BoundedHistCollectionImpl {
   // maps node index to offset in `data_`.
   std::map<bst_node_t, std::size_t> node_map_;
   // currently allocated bins, used for tracking consistentcy.
   std::size_t current_size_{0};
 
   // stores the histograms in a contiguous buffer
-  using Vec = common::ReallocVector<GradientPairPrecise>;
+  using Vec = common::ReallocVector<GradientSumT>;
   std::unique_ptr<Vec> data_{new Vec{}};  // nvcc 12.1 trips over std::make_unique
 
   // number of histogram bins across all features
@@ -45,13 +48,13 @@ class BoundedHistCollection {
   bool has_exceeded_{false};
 
  public:
-  BoundedHistCollection() = default;
-  common::GHistRow operator[](std::size_t idx) {
+  BoundedHistCollectionImpl() = default;
+  common::Span<GradientSumT> operator[](std::size_t idx) {
     auto offset = node_map_.at(idx);
     return common::Span{data_->data(), static_cast<size_t>(data_->size())}.subspan(
         offset, n_total_bins_);
   }
-  common::ConstGHistRow operator[](std::size_t idx) const {
+  common::Span<GradientSumT const> operator[](std::size_t idx) const {
     auto offset = node_map_.at(idx);
     return common::Span{data_->data(), static_cast<size_t>(data_->size())}.subspan(
         offset, n_total_bins_);
@@ -111,5 +114,7 @@ class BoundedHistCollection {
   }
   [[nodiscard]] std::size_t Size() const { return current_size_; }
 };
+
+using BoundedHistCollection = BoundedHistCollectionImpl<GradientPairPrecise>;
 }  // namespace xgboost::tree
 #endif  // XGBOOST_TREE_HIST_HIST_CACHE_H_
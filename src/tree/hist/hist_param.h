@@ -1,5 +1,5 @@
 /**
- * Copyright 2021-2025, XGBoost Contributors
+ * Copyright 2021-2026, XGBoost Contributors
  */
 #pragma once
 
@@ -23,6 +23,12 @@ struct HistMakerTrainParam : public XGBoostParameter<HistMakerTrainParam> {
   constexpr static std::size_t CudaDefaultNodes() { return static_cast<std::size_t>(1) << 12; }
 
   bool debug_synchronize{false};
+  // Build the histogram with quantised gradient.
+  bool quantised_hist{false};
+  // Store the histogram cache in single precision.
+  bool single_precision_histogram{false};
+  // Spread rows over multiple buffers for features with few bins in the column-wise kernel.
+  bool hist_spread_low_bins{false};
 
   void CheckTreesSynchronized(Context const* ctx, RegTree const* local_tree) const;
 
@@ -42,6 +48,15 @@ struct HistMakerTrainParam : public XGBoostParameter<HistMakerTrainParam> {
         .set_default(NotSet())
         .set_lower_bound(1)
         .describe("Maximum number of nodes in histogram cache.");
+    DMLC_DECLARE_FIELD(quantised_hist)
+        .set_default(false)
+        .describe("Build the CPU histogram with quantised gradient.");
+    DMLC_DECLARE_FIELD(single_precision_histogram)
+        .set_default(false)
+        .describe("Store the CPU histogram in single precision.");
+    DMLC_DECLARE_FIELD(hist_spread_low_bins)
+        .set_default(false)
+        .describe("Spread rows over multiple local buffers for features with few bins.");
   }
 };
 }  // namespace xgboost::tree
@@ -1,24 +1,29 @@
 /**
- * Copyright 2021-2025, XGBoost Contributors
+ * Copyright 2021-2026, XGBoost Contributors
  */
 #ifndef XGBOOST_TREE_HIST_HISTOGRAM_H_
 #define XGBOOST_TREE_HIST_HISTOGRAM_H_
 
-#include <algorithm>  // for max
-#include <cstddef>    // for size_t
-#include <cstdint>    // for int32_t
-#include <utility>    // for move
-#include <vector>     // for vector
+#include <algorithm>    // for max, min, copy_n, transform
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int32_t, int64_t, uint64_t
+#include <limits>       // for numeric_limits
+#include <tuple>        // for ignore
+#include <type_traits>  // for is_integral_v, is_same_v
+#include <utility>      // for move
+#include <vector>       // for vector
 
 #include "../../collective/allreduce.h"    // for Allreduce
 #include "../../common/cache_manager.h"    // for CacheManager
+#include "../../common/common.h"           // for DivRoundUp
 #include "../../common/hist_util.h"        // for GHistRow, ParallelGHi...
 #include "../../common/row_set.h"          // for RowSetCollection
-#include "../../common/threading_utils.h"  // for ParallelFor2d, Range1d, BlockedSpace2d
+#include "../../common/threading_utils.h"  // for ParallelFor2d, ParallelFor2dStealing, Range1d
 #include "../../data/gradient_index.h"     // for GHistIndexMatrix
 #include "expand_entry.h"                  // for MultiExpandEntry, CPUExpandEntry
 #include "hist_cache.h"                    // for BoundedHistCollection
 #include "hist_param.h"                    // for HistMakerTrainParam
+#include "quantiser.h"                     // for HistQuantiser
 #include "xgboost/base.h"                  // for bst_node_t, bst_target_t, bst_bin_t
 #include "xgboost/context.h"               // for Context
 #include "xgboost/data.h"                  // for BatchIterator, BatchSet
@@ -41,15 +46,121 @@ void AssignNodes(MultiTargetTreeView const &tree,
 void AssignNodes(ScalarTreeView const &tree, std::vector<CPUExpandEntry> const &candidates,
                  common::Span<bst_node_t> nodes_to_build, common::Span<bst_node_t> nodes_to_sub);
 
-class HistogramBuilder {
+/**
+ * @tparam GradientSumT Type of the cached histogram bin. With single precision, rows are
+ *         summed in float by blocks, see @ref BuildBlockedHistograms. The buffers of
+ *         different threads and different workers are summed in double precision.
+ */
+template <typename GradientSumT>
+class HistogramBuilderImpl {
+  static_assert(std::is_same_v<GradientSumT, GradientPairPrecise> ||
+                std::is_same_v<GradientSumT, GradientPair>);
+  static constexpr bool kSinglePrecision = std::is_same_v<GradientSumT, GradientPair>;
+
   /*! \brief culmulative histogram of gradients. */
   common::Monitor monitor_;
-  BoundedHistCollection hist_;
-  common::ParallelGHistBuilder buffer_;
+  BoundedHistCollectionImpl<GradientSumT> hist_;
+  common::ParallelGHistBuilderImpl<GradientSumT> buffer_;
+  // Block histogram of each thread and the rows summed into it, used with single precision.
+  struct RowBlock {
+    std::size_t nid_in_set{0};
+    std::size_t n_rows{0};
+  };
+  static constexpr std::size_t kMinBlockRows = 1024;
+  std::vector<std::vector<GradientPair>> block_hists_;
+  std::vector<RowBlock> row_blocks_;
   BatchParam param_;
   std::int32_t n_threads_{-1};
   // Whether XGBoost is running in distributed environment.
   bool is_distributed_{false};
+  // Whether the column-wise kernel spreads features with few bins over multiple buffers.
+  bool spread_low_bins_{false};
+
+  // Whether the histogram is built with quantised gradient.
+  bool quantised_{false};
+  // Whether the current node batch is built with 32-bit histogram bins.
+  bool narrow_{false};
+  HistQuantiser quantiser_;
+  // Quantised gradient, only one of them is used depending on the quantiser.
+  std::vector<common::GradientPairInt16> qgpair_;
+  std::vector<common::GradientPairInt32> qgpair32_;
+  // Number of trees built with quantised gradient, used to seed the rounding dither.
+  std::uint64_t n_quantised_{0};
+  // Integer histogram with the same layout as `hist_`, for exact allreduce and subtraction.
+  BoundedHistCollectionImpl<GradientPairInt64> qhist_;
+  common::ParallelGHistBuilderImpl<GradientPairInt64> qbuffer_;
+  // 32-bit histograms for nodes in the current batch, used when no bin can overflow.
+  std::vector<common::GradientPairInt32> qhist32_;
+  common::ParallelGHistBuilderImpl<common::GradientPairInt32> qbuffer32_;
+
+  // Sum the single precision histogram across workers in double precision. Values are
+  // converted in chunks to bound the size of the temporary buffer.
+  void AllreduceInDouble(Context const *ctx, common::Span<float> values) {
+    constexpr std::size_t kChunkSize = static_cast<std::size_t>(1) << 20;
+    std::vector<double> chunk(std::min(kChunkSize, values.size()));
+    for (std::size_t beg = 0; beg < values.size(); beg += kChunkSize) {
+      auto n = std::min(kChunkSize, values.size() - beg);
+      std::copy_n(values.data() + beg, n, chunk.begin());
+      auto rc = collective::Allreduce(ctx, linalg::MakeVec(chunk.data(), n),
+                                      collective::Op::kSum);
+      SafeColl(rc);
+      std::transform(chunk.cbegin(), chunk.cbegin() + n, values.data() + beg,
+                     [](double v) { return static_cast<float>(v); });
+    }
+  }
+
+  template <typename TreeView>
+  void SyncQuantisedHistogram(Context const *ctx, TreeView const &tree,
+                              std::vector<bst_node_t> const &nodes_to_build,
+                              std::vector<bst_node_t> const &nodes_to_trick) {
+    auto n_total_bins = buffer_.TotalBins();
+    common::BlockedSpace2d space(
+        nodes_to_build.size(), [&](std::size_t) { return n_total_bins; }, 1024);
+    common::ParallelFor2d(space, this->n_threads_, [&](size_t node, common::Range1d r) {
+      if (!narrow_) {
+        this->qbuffer_.ReduceHist(node, r.begin(), r.end());
+        return;
+      }
+      this->qbuffer32_.ReduceHist(node, r.begin(), r.end());
+      // Widen the histogram for allreduce and subtraction.
+      auto src = common::Span{qhist32_}.subspan(node * n_total_bins, n_total_bins);
+      auto dst = this->qhist_[nodes_to_build[node]];
+      for (auto i = r.begin(); i < r.end(); ++i) {
+        dst[i] = GradientPairInt64{src[i].GetGrad(), src[i].GetHess()};
+      }
+    });
+    if (is_distributed_) {
+      CHECK(!nodes_to_build.empty());
+      auto first_nidx = nodes_to_build.front();
+      std::size_t n = n_total_bins * nodes_to_build.size() * 2;
+      auto rc = collective::Allreduce(
+          ctx,
+          linalg::MakeVec(reinterpret_cast<std::int64_t *>(this->qhist_[first_nidx].data()), n),
+          collective::Op::kSum);
+      SafeColl(rc);
+    }
+
+    std::vector<bst_node_t> nodes{nodes_to_build};
+    nodes.insert(nodes.end(), nodes_to_trick.cbegin(), nodes_to_trick.cend());
+    common::BlockedSpace2d allspace(
+        nodes.size(), [&](std::size_t) { return n_total_bins; }, 1024);
+    common::ParallelFor2d(allspace, this->n_threads_, [&](std::size_t k, common::Range1d r) {
+      auto nidx = nodes[k];
+      if (k >= nodes_to_build.size()) {
+        auto parent_id = tree.Parent(nidx);
+        auto sibling_nidx =
+            tree.IsLeftChild(nidx) ? tree.RightChild(parent_id) : tree.LeftChild(parent_id);
+        common::SubtractionHist(this->qhist_[nidx], this->qhist_[parent_id],
+                                this->qhist_[sibling_nidx], r.begin(), r.end());
+      }
+      // Convert back to floating point for split evaluation.
+      auto src = this->qhist_[nidx];
+      auto dst = this->hist_[nidx];
+      for (auto i = r.begin(); i < r.end(); ++i) {
+        dst[i] = GradientSumT{quantiser_.ToFloatingPoint(src[i])};
+      }
+    });
+  }
 
  public:
   /**
@@ -66,15 +177,120 @@ class HistogramBuilder {
     hist_.Reset(total_bins, param->MaxCachedHistNodes(ctx->Device()));
     buffer_.Init(total_bins);
     is_distributed_ = is_distributed;
+    quantised_ = param->quantised_hist;
+    spread_low_bins_ = param->hist_spread_low_bins;
+    if (quantised_) {
+      qhist_.Reset(total_bins, param->MaxCachedHistNodes(ctx->Device()));
+      qbuffer_.Init(total_bins);
+      qbuffer32_.Init(total_bins);
+    }
   }
 
-  template <bool any_missing>
+  /**
+   * @brief Quantise the gradient for building histograms of the current tree. No-op if
+   *        the quantised histogram is not used.
+   */
+  void QuantiseGradient(Context const *ctx, linalg::VectorView<GradientPair const> gpair) {
+    if (!quantised_) {
+      return;
+    }
+    quantiser_ = HistQuantiser{ctx, gpair, is_distributed_};
+    auto seed = static_cast<std::uint64_t>(ctx->seed) + n_quantised_++;
+    if (quantiser_.IsWide()) {
+      qgpair_.clear();
+      qgpair32_.resize(gpair.Size());
+      quantiser_.Quantise(ctx, gpair, seed, common::Span{qgpair32_});
+    } else {
+      qgpair32_.clear();
+      qgpair_.resize(gpair.Size());
+      quantiser_.Quantise(ctx, gpair, seed, common::Span{qgpair_});
+    }
+  }
+
+  /**
+   * @brief Build the single precision histogram in blocks of rows.
+   *
+   *   Each thread sums its rows into a block histogram, which is added to the buffer of the
+   *   thread once the block is full, or when the thread moves to another node. The float
+   *   rounding error of a bin grows with the number of rows in a block and the number of
+   *   blocks, instead of the number of rows in the node. The buffers of the threads are
+   *   then summed in double precision by the reduction.
+   */
+  template <bool any_missing, typename Buffer>
+  void BuildBlockedHistograms(common::BlockedSpace2d const &space, GHistIndexMatrix const &gidx,
+                              std::vector<bst_node_t> const &nodes_to_build,
+                              common::RowSetCollection const &row_set_collection,
+                              common::Span<GradientPair const> gpair_h, Buffer *buffer,
+                              bool read_by_column) {
+    auto n_bins = static_cast<std::size_t>(buffer->TotalBins());
+    // Flushing a block costs a pass over all bins, the block should have at least as many
+    // entries as there are bins.
+    auto n_rows = gidx.Size();
+    auto row_size = n_rows == 0 ? std::size_t{1}
+                                : std::max<std::size_t>(gidx.row_ptr[n_rows] / n_rows, 1);
+    auto block_rows = std::max<std::size_t>(kMinBlockRows, common::DivRoundUp(n_bins, row_size));
+
+    block_hists_.resize(this->n_threads_);
+    for (auto &block_hist : block_hists_) {
+      if (block_hist.size() != n_bins) {
+        block_hist.assign(n_bins, GradientPair{});
+      }
+    }
+    row_blocks_.assign(this->n_threads_, RowBlock{});
+    auto flush = [&](std::size_t tid) {
+      auto &block = row_blocks_[tid];
+      if (block.n_rows == 0) {
+        return;
+      }
+      auto hist = buffer->GetInitializedHist(tid, block.nid_in_set);
+      auto &block_hist = block_hists_[tid];
+      for (std::size_t i = 0; i < n_bins; ++i) {
+        hist[i] += block_hist[i];
+      }
+      std::fill(block_hist.begin(), block_hist.end(), GradientPair{});
+      block.n_rows = 0;
+    };
+
+    common::ParallelFor2d(space, this->n_threads_, [&](size_t nid_in_set, common::Range1d r) {
+      const auto tid = static_cast<unsigned>(omp_get_thread_num());
+      bst_node_t const nidx = nodes_to_build[nid_in_set];
+      auto const &elem = row_set_collection[nidx];
+      auto start_of_row_set = std::min(r.begin(), elem.Size());
+      auto end_of_row_set = std::min(r.end(), elem.Size());
+      auto rid_set = common::Span<bst_idx_t const>{elem.begin() + start_of_row_set,
+                                                   elem.begin() + end_of_row_set};
+      std::ignore = buffer->GetInitializedHist(tid, nid_in_set);
+      if (rid_set.size() == 0) {
+        return;
+      }
+      auto &block = row_blocks_[tid];
+      if (block.nid_in_set != nid_in_set) {
+        flush(tid);
+        block.nid_in_set = nid_in_set;
+      }
+      common::BuildHist<any_missing>(gpair_h, rid_set, gidx, common::Span{block_hists_[tid]},
+                                     read_by_column, this->spread_low_bins_);
+      block.n_rows += rid_set.size();
+      if (block.n_rows >= block_rows) {
+        flush(tid);
+      }
+    });
+    common::ParallelFor(this->n_threads_, this->n_threads_, [&](std::size_t tid) { flush(tid); });
+  }
+
+  template <bool any_missing, typename GradientT, typename Buffer>
   void BuildLocalHistograms(common::BlockedSpace2d const &space, GHistIndexMatrix const &gidx,
                             std::vector<bst_node_t> const &nodes_to_build,
                             common::RowSetCollection const &row_set_collection,
-                            common::Span<GradientPair const> gpair_h, bool read_by_column) {
+                            common::Span<GradientT const> gpair_h, Buffer *buffer,
+                            bool read_by_column) {
+    if constexpr (kSinglePrecision && !std::is_integral_v<typename GradientT::ValueT>) {
+      this->BuildBlockedHistograms<any_missing>(space, gidx, nodes_to_build, row_set_collection,
+                                                gpair_h, buffer, read_by_column);
+      return;
+    }
     // Parallel processing by nodes and data in each node
-    common::ParallelFor2d(space, this->n_threads_, [&](size_t nid_in_set, common::Range1d r) {
+    auto fn = [&](size_t nid_in_set, common::Range1d r) {
       const auto tid = static_cast<unsigned>(omp_get_thread_num());
       bst_node_t const nidx = nodes_to_build[nid_in_set];
       auto const &elem = row_set_collection[nidx];
@@ -82,11 +298,26 @@ class HistogramBuilder {
       auto end_of_row_set = std::min(r.end(), elem.Size());
       auto rid_set = common::Span<bst_idx_t const>{elem.begin() + start_of_row_set,
                                                    elem.begin() + end_of_row_set};
-      auto hist = buffer_.GetInitializedHist(tid, nid_in_set);
-      if (rid_set.size() != 0) {
+      auto hist = buffer->GetInitializedHist(tid, nid_in_set);
+      if (rid_set.size() == 0) {
+        return;
+      }
+      if constexpr (std::is_integral_v<typename GradientT::ValueT>) {
         common::BuildHist<any_missing>(gpair_h, rid_set, gidx, hist, read_by_column);
+      } else {
+        common::BuildHist<any_missing>(gpair_h, rid_set, gidx, hist, read_by_column,
+                                       common::DetectSimdIsa(), this->spread_low_bins_);
       }
-    });
+    };
+    // Node sizes can be highly skewed, idle threads can steal blocks and accumulate them into
+    // their own buffers. Stealing changes the order of summation, it's only used for quantised
+    // gradient where the integer sum is exact. The floating point histogram keeps the static
+    // schedule for reproducible training.
+    if constexpr (std::is_integral_v<typename GradientT::ValueT>) {
+      common::ParallelFor2dStealing(space, this->n_threads_, fn);
+    } else {
+      common::ParallelFor2d(space, this->n_threads_, fn);
+    }
   }
 
   /**
@@ -115,12 +346,18 @@ class HistogramBuilder {
 
     if (!can_host) {
       this->hist_.Clear(true);
+      if (quantised_) {
+        this->qhist_.Clear(true);
+      }
     }
 
     if (!rearrange || cache_is_valid) {
       // If not rearrange, we allocate the histogram as usual, assuming the nodes have
       // been properly arranged by other builders.
       this->hist_.AllocateHistograms(nodes_to_build, nodes_to_sub);
+      if (quantised_) {
+        this->qhist_.AllocateHistograms(nodes_to_build, nodes_to_sub);
+      }
       if (rearrange) {
         CHECK(!this->hist_.HasExceeded());
       }
@@ -142,20 +379,73 @@ class HistogramBuilder {
 
     nodes_to_sub = std::move(can_subtract);
     this->hist_.AllocateHistograms(nodes_to_build, nodes_to_sub);
+    if (quantised_) {
+      this->qhist_.AllocateHistograms(nodes_to_build, nodes_to_sub);
+    }
   }
 
-  /** Main entry point of this class, build histogram for tree nodes. */
+  /**
+   * @brief Main entry point of this class, build histogram for tree nodes.
+   *
+   * @param max_node_rows The maximum number of rows in a node across all pages, used to
+   *                      choose the bin type for the quantised histogram.
+   */
   void BuildHist(std::size_t page_idx, common::BlockedSpace2d const &space,
                  GHistIndexMatrix const &gidx, common::RowSetCollection const &row_set_collection,
                  std::vector<bst_node_t> const &nodes_to_build,
-                 linalg::VectorView<GradientPair const> gpair, bool read_by_column) {
+                 linalg::VectorView<GradientPair const> gpair, bool read_by_column,
+                 bst_idx_t max_node_rows = std::numeric_limits<bst_idx_t>::max()) {
     monitor_.Start(__func__);
     CHECK(gpair.Contiguous());
 
+    auto build = [&](auto gpair_h, auto *buffer) {
+      if (gidx.IsDense()) {
+        this->BuildLocalHistograms<false>(space, gidx, nodes_to_build, row_set_collection,
+                                          gpair_h, buffer, read_by_column);
+      } else {
+        this->BuildLocalHistograms<true>(space, gidx, nodes_to_build, row_set_collection,
+                                         gpair_h, buffer, read_by_column);
+      }
+    };
+
+    if (quantised_) {
+      CHECK_EQ(quantiser_.IsWide() ? qgpair32_.size() : qgpair_.size(), gpair.Size())
+          << "The gradient is not quantised.";
+      auto n_nodes = nodes_to_build.size();
+      if (page_idx == 0) {
+        narrow_ = !quantiser_.IsWide() && max_node_rows <= HistQuantiser::kMaxNarrowRows;
+        if (narrow_) {
+          std::size_t n_bins = qbuffer32_.TotalBins();
+          qhist32_.resize(n_nodes * n_bins);
+          std::vector<common::Span<common::GradientPairInt32>> target_hists(n_nodes);
+          for (std::size_t i = 0; i < n_nodes; ++i) {
+            target_hists[i] = common::Span{qhist32_}.subspan(i * n_bins, n_bins);
+          }
+          qbuffer32_.Reset(this->n_threads_, n_nodes, space, target_hists);
+        } else {
+          std::vector<common::Span<GradientPairInt64>> target_hists(n_nodes);
+          for (std::size_t i = 0; i < n_nodes; ++i) {
+            target_hists[i] = qhist_[nodes_to_build[i]];
+          }
+          qbuffer_.Reset(this->n_threads_, n_nodes, space, target_hists);
+        }
+      }
+      auto qgpair = common::Span<common::GradientPairInt16 const>{qgpair_};
+      if (quantiser_.IsWide()) {
+        build(common::Span<common::GradientPairInt32 const>{qgpair32_}, &qbuffer_);
+      } else if (narrow_) {
+        build(qgpair, &qbuffer32_);
+      } else {
+        build(qgpair, &qbuffer_);
+      }
+      monitor_.Stop(__func__);
+      return;
+    }
+
     if (page_idx == 0) {
       // Add the local histogram cache to the parallel buffer before processing the first page.
       auto n_nodes = nodes_to_build.size();
-      std::vector<common::GHistRow> target_hists(n_nodes);
+      std::vector<common::Span<GradientSumT>> target_hists(n_nodes);
       for (size_t i = 0; i < n_nodes; ++i) {
         auto const nidx = nodes_to_build[i];
         target_hists[i] = hist_[nidx];
@@ -163,13 +453,7 @@ class HistogramBuilder {
       buffer_.Reset(this->n_threads_, n_nodes, space, target_hists);
     }
 
-    if (gidx.IsDense()) {
-      this->BuildLocalHistograms<false>(space, gidx, nodes_to_build, row_set_collection,
-                                        gpair.Values(), read_by_column);
-    } else {
-      this->BuildLocalHistograms<true>(space, gidx, nodes_to_build, row_set_collection,
-                                       gpair.Values(), read_by_column);
-    }
+    build(gpair.Values(), &buffer_);
     monitor_.Stop(__func__);
   }
 
@@ -177,6 +461,10 @@ class HistogramBuilder {
   void SyncHistogram(Context const *ctx, TreeView const &tree,
                      std::vector<bst_node_t> const &nodes_to_build,
                      std::vector<bst_node_t> const &nodes_to_trick) {
+    if (quantised_) {
+      this->SyncQuantisedHistogram(ctx, tree, nodes_to_build, nodes_to_trick);
+      return;
+    }
     auto n_total_bins = buffer_.TotalBins();
     common::BlockedSpace2d space(
         nodes_to_build.size(), [&](std::size_t) { return n_total_bins; }, 1024);
@@ -189,10 +477,15 @@ class HistogramBuilder {
       CHECK(!nodes_to_build.empty());
       auto first_nidx = nodes_to_build.front();
       std::size_t n = n_total_bins * nodes_to_build.size() * 2;
-      auto rc = collective::Allreduce(
-          ctx, linalg::MakeVec(reinterpret_cast<double *>(this->hist_[first_nidx].data()), n),
-          collective::Op::kSum);
-      SafeColl(rc);
+      using T = typename GradientSumT::ValueT;
+      auto values = common::Span<T>{reinterpret_cast<T *>(this->hist_[first_nidx].data()), n};
+      if constexpr (kSinglePrecision) {
+        this->AllreduceInDouble(ctx, values);
+      } else {
+        auto rc = collective::Allreduce(ctx, linalg::MakeVec(values.data(), values.size()),
+                                        collective::Op::kSum);
+        SafeColl(rc);
+      }
     }
 
     common::BlockedSpace2d const &subspace =
@@ -215,11 +508,15 @@ class HistogramBuilder {
 
  public:
   /* Getters for tests. */
-  [[nodiscard]] BoundedHistCollection const &Histogram() const { return hist_; }
-  [[nodiscard]] BoundedHistCollection &Histogram() { return hist_; }
+  [[nodiscard]] BoundedHistCollectionImpl<GradientSumT> const &Histogram() const {
+    return hist_;
+  }
+  [[nodiscard]] BoundedHistCollectionImpl<GradientSumT> &Histogram() { return hist_; }
   auto &Buffer() { return buffer_; }
 };
 
+using HistogramBuilder = HistogramBuilderImpl<GradientPairPrecise>;
+
 // Construct a work space for building histogram.  Eventually we should move this
 // function into histogram builder once hist tree method supports external memory.
 template <typename Partitioner>
@@ -312,8 +609,9 @@ common::BlockedSpace2d ConstructHistSpace(Partitioner const &partitioners,
 /**
  * @brief Histogram builder that can handle multiple targets.
  */
-class MultiHistogramBuilder {
-  std::vector<HistogramBuilder> target_builders_;
+template <typename GradientSumT>
+class MultiHistogramBuilderImpl {
+  std::vector<HistogramBuilderImpl<GradientSumT>> target_builders_;
   Context const *ctx_;
   common::CacheManager cache_manager_;
 
@@ -340,6 +638,21 @@ class MultiHistogramBuilder {
     return read_by_column;
   }
 
+  // The number of rows in the largest node across all pages.
+  template <typename Partitioner>
+  static bst_idx_t MaxNodeRows(std::vector<Partitioner> const &partitioners,
+                               std::vector<bst_node_t> const &nodes) {
+    bst_idx_t n_max = 0;
+    for (auto nidx : nodes) {
+      bst_idx_t n = 0;
+      for (auto const &partition : partitioners) {
+        n += partition.Partitions()[nidx].Size();
+      }
+      n_max = std::max(n_max, n);
+    }
+    return n_max;
+  }
+
  public:
   /**
    * @brief Build the histogram for root node.
@@ -356,10 +669,12 @@ class MultiHistogramBuilder {
     std::vector<bst_node_t> dummy_sub;
 
     for (bst_target_t t{0}; t < n_targets; ++t) {
+      this->target_builders_[t].QuantiseGradient(ctx_, gpair.Slice(linalg::All(), t));
       this->target_builders_[t].AddHistRows(tree, &nodes, &dummy_sub, false);
     }
     CHECK(dummy_sub.empty());
 
+    auto max_node_rows = MaxNodeRows(partitioners, nodes);
     std::size_t page_idx{0};
     for (auto const &gidx : p_fmat->GetBatches<GHistIndexMatrix>(ctx_, param)) {
       bool read_by_column = ReadByColumn(gidx, force_read_by_column);
@@ -370,7 +685,7 @@ class MultiHistogramBuilder {
         auto t_gpair = gpair.Slice(linalg::All(), t);
         this->target_builders_[t].BuildHist(page_idx, space, gidx,
                                             partitioners[page_idx].Partitions(), nodes, t_gpair,
-                                            read_by_column);
+                                            read_by_column, max_node_rows);
       }
       ++page_idx;
     }
@@ -402,6 +717,7 @@ class MultiHistogramBuilder {
       target_builders_[t].AddHistRows(tree, &nodes_to_build, &nodes_to_sub, false);
     }
 
+    auto max_node_rows = MaxNodeRows(partitioners, nodes_to_build);
     std::size_t page_idx{0};
     for (auto const &page : p_fmat->GetBatches<GHistIndexMatrix>(ctx_, param)) {
       bool read_by_column = ReadByColumn(page, force_read_by_column);
@@ -415,7 +731,7 @@ class MultiHistogramBuilder {
         CHECK_EQ(t_gpair.Shape(0), p_fmat->Info().num_row_);
         this->target_builders_[t].BuildHist(page_idx, space, page,
                                             partitioners[page_idx].Partitions(), nodes_to_build,
-                                            t_gpair, read_by_column);
+                                            t_gpair, read_by_column, max_node_rows);
       }
       page_idx++;
     }
@@ -443,5 +759,7 @@ class MultiHistogramBuilder {
     }
   }
 };
+
+using MultiHistogramBuilder = MultiHistogramBuilderImpl<GradientPairPrecise>;
 }  // namespace xgboost::tree
 #endif  // XGBOOST_TREE_HIST_HISTOGRAM_H_
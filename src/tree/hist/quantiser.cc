@@ -0,0 +1,144 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include "quantiser.h"
+
+#include <algorithm>  // for max, min, clamp
+#include <cmath>      // for abs, floor
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int64_t, uint64_t
+#include <limits>     // for numeric_limits
+#include <vector>     // for vector
+
+#include "../../collective/allreduce.h"    // for Allreduce
+#include "../../common/deterministic.cuh"  // for CreateRoundingFactor
+#include "../../common/threading_utils.h"  // for ParallelFor
+#include "xgboost/collective/result.h"     // for Success, SafeColl
+#include "xgboost/logging.h"               // for CHECK_EQ
+
+namespace xgboost::tree {
+namespace {
+// Sums of the positive and the negative values, and the largest absolute value.
+struct QuantiserStats {
+  double pos[2]{0.0, 0.0};
+  double neg[2]{0.0, 0.0};
+  double max_abs[2]{0.0, 0.0};
+
+  void Push(std::size_t k, double v) {
+    if (v > 0.0) {
+      pos[k] += v;
+    } else {
+      neg[k] -= v;
+    }
+    max_abs[k] = std::max(max_abs[k], std::abs(v));
+  }
+};
+
+double ToFixedPointScale(double pos, double neg, double max_abs, double n_samples,
+                         double max_value) {
+  // All values are zero, any scale works.
+  if (max_abs == 0.0) {
+    return 1.0;
+  }
+  // Same as the GPU quantiser, the sum of any subset of samples is bounded by the rounding
+  // factor. One bit is left for rounding up each sample, the bins can't overflow.
+  auto rounding = common::CreateRoundingFactor<double>(std::max(pos, neg),
+                                                      static_cast<bst_idx_t>(n_samples));
+  auto constexpr kMaxInt = static_cast<double>(static_cast<std::int64_t>(1) << 61);
+  return std::min(kMaxInt / rounding, max_value / max_abs);
+}
+
+// SplitMix64 finaliser.
+std::uint64_t Mix(std::uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Uniform value in [0, 1) for the i-th draw, independent of the thread schedule.
+double Dither(std::uint64_t key, std::uint64_t i) {
+  return static_cast<double>(Mix(key + i * 0x9e3779b97f4a7c15ULL) >> 11) * 0x1p-53;
+}
+
+// Stochastic rounding, the expected value of the result is `v`.
+template <typename T>
+T Round(double v, double u) {
+  auto constexpr kMax = static_cast<double>(std::numeric_limits<T>::max());
+  return static_cast<T>(std::clamp(std::floor(v + u), -kMax, kMax));
+}
+
+template <typename T>
+void QuantiseImpl(Context const *ctx, linalg::VectorView<GradientPair const> gpair,
+                  GradientPairPrecise to_fixed_point, std::uint64_t seed,
+                  common::Span<xgboost::detail::GradientPairInternal<T>> out) {
+  CHECK_EQ(gpair.Size(), out.size());
+  auto key = Mix(seed);
+  common::ParallelFor(gpair.Size(), ctx->Threads(), [&](std::size_t i) {
+    auto g = gpair(i);
+    auto grad = Round<T>(g.GetGrad() * to_fixed_point.GetGrad(), Dither(key, 2 * i));
+    auto hess = Round<T>(g.GetHess() * to_fixed_point.GetHess(), Dither(key, 2 * i + 1));
+    out[i] = xgboost::detail::GradientPairInternal<T>{grad, hess};
+  });
+}
+}  // anonymous namespace
+
+HistQuantiser::HistQuantiser(Context const *ctx, linalg::VectorView<GradientPair const> gpair,
+                             bool is_distributed) {
+  auto n_threads = ctx->Threads();
+  std::vector<QuantiserStats> stats_tloc(n_threads);
+  common::ParallelFor(gpair.Size(), n_threads, [&](std::size_t i) {
+    auto &stats = stats_tloc[omp_get_thread_num()];
+    auto g = gpair(i);
+    stats.Push(0, g.GetGrad());
+    stats.Push(1, g.GetHess());
+  });
+  // Sums of the positive and negative values, and the number of samples.
+  double sums[5] = {0.0, 0.0, 0.0, 0.0, static_cast<double>(gpair.Size())};
+  double max_abs[2] = {0.0, 0.0};
+  for (auto const &stats : stats_tloc) {
+    for (std::size_t k = 0; k < 2; ++k) {
+      sums[k * 2] += stats.pos[k];
+      sums[k * 2 + 1] += stats.neg[k];
+      max_abs[k] = std::max(max_abs[k], stats.max_abs[k]);
+    }
+  }
+  if (is_distributed) {
+    auto rc = collective::Success() << [&] {
+      return collective::Allreduce(ctx, linalg::MakeVec(sums, 5), collective::Op::kSum);
+    } << [&] {
+      return collective::Allreduce(ctx, linalg::MakeVec(max_abs, 2), collective::Op::kMax);
+    };
+    collective::SafeColl(rc);
+  }
+
+  auto n_samples = sums[4];
+  // Use 32 bits when outliers would leave too few bits for the typical sample.
+  for (std::size_t k = 0; k < 2; ++k) {
+    auto mean_abs = n_samples == 0.0 ? 0.0 : (sums[k * 2] + sums[k * 2 + 1]) / n_samples;
+    if (max_abs[k] > kMaxDynamicRange * mean_abs) {
+      wide_ = true;
+    }
+  }
+  auto max_value = static_cast<double>(wide_ ? kMaxWideValue : kMaxNarrowValue);
+  double scale[2];
+  for (std::size_t k = 0; k < 2; ++k) {
+    scale[k] =
+        ToFixedPointScale(sums[k * 2], sums[k * 2 + 1], max_abs[k], n_samples, max_value);
+  }
+  to_fixed_point_ = GradientPairPrecise{scale[0], scale[1]};
+  to_floating_point_ = GradientPairPrecise{1.0 / scale[0], 1.0 / scale[1]};
+}
+
+void HistQuantiser::Quantise(Context const *ctx, linalg::VectorView<GradientPair const> gpair,
+                             std::uint64_t seed,
+                             common::Span<common::GradientPairInt16> out) const {
+  CHECK(!wide_) << "The gradient must be stored in 32 bits.";
+  QuantiseImpl(ctx, gpair, to_fixed_point_, seed, out);
+}
+
+void HistQuantiser::Quantise(Context const *ctx, linalg::VectorView<GradientPair const> gpair,
+                             std::uint64_t seed,
+                             common::Span<common::GradientPairInt32> out) const {
+  QuantiseImpl(ctx, gpair, to_fixed_point_, seed, out);
+}
+}  // namespace xgboost::tree
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ *
+ * @brief Gradient quantisation for the CPU histogram builder.
+ */
+#ifndef XGBOOST_TREE_HIST_QUANTISER_H_
+#define XGBOOST_TREE_HIST_QUANTISER_H_
+
+#include <cstdint>  // for int16_t, int32_t, uint64_t
+#include <limits>   // for numeric_limits
+
+#include "../../common/hist_util.h"  // for GradientPairInt16, GradientPairInt32
+#include "xgboost/base.h"            // for GradientPair, GradientPairPrecise, GradientPairInt64
+#include "xgboost/context.h"         // for Context
+#include "xgboost/linalg.h"          // for VectorView
+#include "xgboost/span.h"            // for Span
+
+namespace xgboost::tree {
+/**
+ * @brief Convert the gradient of a single target into fixed point values.
+ *
+ *   Similar to the @ref GradientQuantiser used by the GPU implementation, the scale is
+ *   bounded by the rounding factor of the gradient sum and the number of rows, so that no
+ *   histogram bin can overflow. The scale is further limited by the largest absolute value
+ *   to fit each sample into the per-row storage. Samples are stored in 16 bits when the
+ *   largest absolute value is within @ref kMaxDynamicRange times the mean absolute value,
+ *   and in 32 bits otherwise. This way a few outliers don't round the rest of the samples
+ *   to zero.
+ *
+ *   Values are rounded stochastically with a counter-based dither, the rounding is
+ *   unbiased and doesn't depend on the thread schedule. The statistics for the scale are
+ *   shared by all workers in distributed training. Histograms built with the quantised
+ *   gradient are integer sums, which are exact and don't depend on the order of summation.
+ */
+class HistQuantiser {
+  /* Convert gradient to fixed point representation. */
+  GradientPairPrecise to_fixed_point_{1.0, 1.0};
+  /* Convert fixed point representation back to floating point. */
+  GradientPairPrecise to_floating_point_{1.0, 1.0};
+  // Whether each sample is stored in 32 bits.
+  bool wide_{false};
+
+ public:
+  /** @brief The largest absolute value of a sample stored in 16 bits. */
+  static constexpr std::int32_t kMaxNarrowValue = std::numeric_limits<std::int16_t>::max();
+  /** @brief The largest absolute value of a sample stored in 32 bits. */
+  static constexpr std::int32_t kMaxWideValue = std::numeric_limits<std::int32_t>::max();
+  /**
+   * @brief The largest ratio between the maximum and the mean absolute value for storing
+   *        samples in 16 bits. The mean is then represented with at least 7 bits.
+   */
+  static constexpr double kMaxDynamicRange = 256.0;
+  /**
+   * @brief The maximum number of 16-bit samples that can be summed into a 32-bit histogram
+   *        bin without overflow. 32-bit samples are always summed into 64-bit bins.
+   */
+  static constexpr bst_idx_t kMaxNarrowRows =
+      std::numeric_limits<std::int32_t>::max() / kMaxNarrowValue;
+
+  HistQuantiser() = default;
+  HistQuantiser(Context const *ctx, linalg::VectorView<GradientPair const> gpair,
+                bool is_distributed);
+
+  /** @brief Whether the samples must be stored in 32 bits. */
+  [[nodiscard]] bool IsWide() const { return wide_; }
+
+  /**
+   * @param seed Seed of the dither for stochastic rounding.
+   */
+  void Quantise(Context const *ctx, linalg::VectorView<GradientPair const> gpair,
+                std::uint64_t seed, common::Span<common::GradientPairInt16> out) const;
+  void Quantise(Context const *ctx, linalg::VectorView<GradientPair const> gpair,
+                std::uint64_t seed, common::Span<common::GradientPairInt32> out) const;
+
+  [[nodiscard]] GradientPairPrecise ToFloatingPoint(GradientPairInt64 const &gpair) const {
+    auto g = gpair.GetQuantisedGrad() * to_floating_point_.GetGrad();
+    auto h = gpair.GetQuantisedHess() * to_floating_point_.GetHess();
+    return {g, h};
+  }
+};
+}  // namespace xgboost::tree
+#endif  // XGBOOST_TREE_HIST_QUANTISER_H_
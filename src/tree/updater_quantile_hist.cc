@@ -404,7 +404,10 @@ class MultiTargetHistBuilder {
 
 /**
  * @brief Tree updater for single-target trees.
+ *
+ * @tparam GradientSumT Type of the cached histogram bin.
  */
+template <typename GradientSumT>
 class HistUpdater {
  private:
   common::Monitor *monitor_;
@@ -418,7 +421,7 @@ class HistUpdater {
   const RegTree *p_last_tree_{nullptr};
   DMatrix const *const p_last_fmat_{nullptr};
 
-  std::unique_ptr<MultiHistogramBuilder> histogram_builder_;
+  std::unique_ptr<MultiHistogramBuilderImpl<GradientSumT>> histogram_builder_;
   // Context for number of threads
   Context const *ctx_{nullptr};
 
@@ -431,7 +434,7 @@ class HistUpdater {
         hist_param_{hist_param},
         col_sampler_{std::move(column_sampler)},
         p_last_fmat_(fmat),
-        histogram_builder_{new MultiHistogramBuilder},
+        histogram_builder_{new MultiHistogramBuilderImpl<GradientSumT>},
         ctx_{ctx} {
     monitor_->Init(__func__);
   }
@@ -501,7 +504,7 @@ class HistUpdater {
         auto hist = this->histogram_builder_->Histogram(0)[RegTree::kRoot];
         auto begin = hist.data();
         for (std::uint32_t i = ibegin; i < iend; ++i) {
-          GradientPairPrecise const &et = begin[i];
+          auto const &et = begin[i];
           grad_stat.Add(et.GetGrad(), et.GetHess());
         }
       } else {
@@ -569,7 +572,8 @@ class HistUpdater {
 
 /*! \brief construct a tree using quantized feature values */
 class QuantileHistMaker : public TreeUpdater {
-  std::unique_ptr<HistUpdater> p_impl_{nullptr};
+  std::unique_ptr<HistUpdater<GradientPairPrecise>> p_impl_{nullptr};
+  std::unique_ptr<HistUpdater<GradientPair>> p_f32_impl_{nullptr};
   std::unique_ptr<MultiTargetHistBuilder> p_mtimpl_{nullptr};
   std::shared_ptr<common::ColumnSampler> column_sampler_;
 
@@ -603,11 +607,17 @@ class QuantileHistMaker : public TreeUpdater {
         this->p_mtimpl_ = std::make_unique<MultiTargetHistBuilder>(ctx_, param, &hist_param_,
                                                                    column_sampler_, &monitor_);
       }
+    } else if (hist_param_.single_precision_histogram) {
+      CHECK(hist_param_.GetInitialised());
+      if (!p_f32_impl_) {
+        p_f32_impl_ = std::make_unique<HistUpdater<GradientPair>>(
+            ctx_, column_sampler_, param, &hist_param_, p_fmat, &monitor_);
+      }
     } else {
       CHECK(hist_param_.GetInitialised());
       if (!p_impl_) {
-        p_impl_ = std::make_unique<HistUpdater>(ctx_, column_sampler_, param, &hist_param_, p_fmat,
-                                                &monitor_);
+        p_impl_ = std::make_unique<HistUpdater<GradientPairPrecise>>(
+            ctx_, column_sampler_, param, &hist_param_, p_fmat, &monitor_);
       }
     }
 
@@ -651,6 +661,9 @@ class QuantileHistMaker : public TreeUpdater {
         } else {
           (*tree_it)->GetMultiTargetTree()->SetLeaves();
         }
+      } else if (hist_param_.single_precision_histogram) {
+        UpdateTree<CPUExpandEntry>(&monitor_, h_sample_out, p_f32_impl_.get(), p_fmat, param,
+                                   h_out_position, *tree_it);
       } else {
         UpdateTree<CPUExpandEntry>(&monitor_, h_sample_out, p_impl_.get(), p_fmat, param,
                                    h_out_position, *tree_it);
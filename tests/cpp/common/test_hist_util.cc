@@ -1,5 +1,5 @@
 /**
- * Copyright 2019-2025, XGBoost Contributors
+ * Copyright 2019-2026, XGBoost Contributors
  */
 #include "test_hist_util.h"
 
@@ -7,11 +7,19 @@
 #include <xgboost/data.h>                // for ExtMemConfig
 #include <xgboost/host_device_vector.h>  // for HostDeviceVector
 
-#include <memory>  // for shared_ptr
+#include <algorithm>  // for fill_n, max
+#include <cmath>      // for abs
+#include <cstdint>    // for int32_t
+#include <memory>     // for shared_ptr
+#include <numeric>    // for iota
 #include <string>
+#include <tuple>    // for ignore
+#include <utility>  // for pair
 #include <vector>
 
 #include "../../../src/common/hist_util.h"
+#include "../../../src/common/simd.h"   // for SimdIsa, DetectSimdIsa
+#include "../../../src/common/timer.h"  // for Timer
 #include "../../../src/data/gradient_index.h"
 #include "../helpers.h"
 
@@ -117,6 +125,71 @@ TEST(ParallelGHistBuilder, ReduceHist) {
   }
 }
 
+TEST(ParallelGHistBuilder, Stealing) {
+  constexpr size_t kBins = 10;
+  constexpr size_t kNodes = 2;
+  constexpr size_t kThreads = 4;
+  constexpr double kValue = 1.0;
+
+  HistCollection collection;
+  collection.Init(kBins);
+  for (size_t inode = 0; inode < kNodes; inode++) {
+    collection.AddHistRow(inode);
+    collection.AllocateData(inode);
+  }
+  std::vector<GHistRow> target_hist(kNodes);
+  for (size_t i = 0; i < target_hist.size(); ++i) {
+    target_hist[i] = collection[i];
+    // Garbage from the last iteration.
+    std::fill_n(target_hist[i].data(), kBins, GradientPairPrecise{3.0, 3.0});
+  }
+
+  ParallelGHistBuilder hist_builder;
+  hist_builder.Init(kBins);
+  // Threads 0 and 1 are assigned to the first node, 2 and 3 to the second node.
+  common::BlockedSpace2d space(kNodes, [&](size_t /*node*/) { return 2; }, 1);
+  hist_builder.Reset(kThreads, kNodes, space, target_hist);
+
+  // Thread 3 steals all the blocks of the first node, the owner of the targeted hist for
+  // the second node is idle.
+  for (auto [tid, nid] : std::vector<std::pair<size_t, size_t>>{{3, 0}, {3, 0}, {3, 1}}) {
+    auto hist = hist_builder.GetInitializedHist(tid, nid);
+    for (size_t i = 0; i < kBins; ++i) {
+      hist[i].Add(kValue, kValue);
+    }
+  }
+  for (size_t inode = 0; inode < kNodes; inode++) {
+    hist_builder.ReduceHist(inode, 0, kBins);
+  }
+  for (size_t i = 0; i < kBins; ++i) {
+    ASSERT_EQ(collection[0][i].GetGrad(), kValue * 2);
+    ASSERT_EQ(collection[1][i].GetHess(), kValue);
+  }
+  // Thread 3 is assigned to the second node, only the first node needs a new buffer.
+  ASSERT_EQ(hist_builder.StolenBins(), kBins);
+
+  // Reduce the hists built by the stealing scheduler.
+  size_t constexpr kTasksPerNode = 64;
+  common::BlockedSpace2d skewed(
+      kNodes, [&](size_t node) { return node == 0 ? kTasksPerNode : 1; }, 1);
+  hist_builder.Reset(kThreads, kNodes, skewed, target_hist);
+  // Buffers of stolen blocks are released by the reset.
+  ASSERT_EQ(hist_builder.StolenBins(), std::size_t{0});
+  common::ParallelFor2dStealing(skewed, kThreads, [&](size_t inode, common::Range1d) {
+    GHistRow hist = hist_builder.GetInitializedHist(omp_get_thread_num(), inode);
+    for (size_t i = 0; i < kBins; ++i) {
+      hist[i].Add(kValue, kValue);
+    }
+  });
+  for (size_t inode = 0; inode < kNodes; inode++) {
+    hist_builder.ReduceHist(inode, 0, kBins);
+  }
+  for (size_t i = 0; i < kBins; ++i) {
+    ASSERT_EQ(collection[0][i].GetGrad(), kValue * kTasksPerNode);
+    ASSERT_EQ(collection[1][i].GetHess(), kValue);
+  }
+}
+
 TEST(HistUtil, IndexBinBound) {
   uint64_t bin_sizes[] = {static_cast<uint64_t>(std::numeric_limits<uint8_t>::max()) + 1,
                           static_cast<uint64_t>(std::numeric_limits<uint16_t>::max()) + 1,
@@ -265,4 +338,132 @@ TEST(HistUtil, GroupWeightsEquivalentToRowWeights) {
   ASSERT_EQ(sorted_grouped_cuts.Values(), sorted_per_row_cuts.Values());
 }
 
+
+namespace {
+// Every other row, for the prefetching kernels.
+std::vector<bst_idx_t> StridedRowsForTest(bst_idx_t n_samples) {
+  std::vector<bst_idx_t> rows(n_samples / 2);
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    rows[i] = i * 2;
+  }
+  return rows;
+}
+
+std::vector<GradientPairPrecise> BuildHistForTest(GHistIndexMatrix const &gmat,
+                                                  std::vector<GradientPair> const &gpair,
+                                                  std::vector<bst_idx_t> const &rows,
+                                                  bool read_by_column, SimdIsa isa,
+                                                  bool spread_low_bins = false) {
+  std::vector<GradientPairPrecise> hist(gmat.cut.TotalBins());
+  if (gmat.IsDense()) {
+    BuildHist<false>(gpair, rows, gmat, hist, read_by_column, isa, spread_low_bins);
+  } else {
+    BuildHist<true>(gpair, rows, gmat, hist, read_by_column, isa, spread_low_bins);
+  }
+  return hist;
+}
+}  // anonymous namespace
+
+TEST(HistUtil, BuildHistSimd) {
+  Context ctx;
+  bst_idx_t constexpr kRows = 512;
+  // Not a multiple of the vector width.
+  bst_feature_t constexpr kCols = 21;
+  auto p_fmat = RandomDataGenerator{kRows, kCols, 0.0}.GenerateDMatrix();
+  auto gpair = GenerateRandomGradients(kRows).HostVector();
+  std::vector<bst_idx_t> all_rows(kRows);
+  std::iota(all_rows.begin(), all_rows.end(), 0);
+
+  for (std::int32_t max_bin : {64, 1024}) {
+    for (auto const &gmat : p_fmat->GetBatches<GHistIndexMatrix>(&ctx, BatchParam{max_bin, 0.5})) {
+      ASSERT_TRUE(gmat.IsDense());
+      ASSERT_EQ(gmat.index.GetBinTypeSize(),
+                max_bin > 256 ? kUint16BinsTypeSize : kUint8BinsTypeSize);
+      for (auto const &rows : {StridedRowsForTest(kRows), all_rows}) {
+        auto expected = BuildHistForTest(gmat, gpair, rows, false, SimdIsa::kScalar);
+        for (auto isa : {SimdIsa::kAvx2, SimdIsa::kAvx512}) {
+          if (isa > DetectSimdIsa()) {
+            continue;
+          }
+          // Rows are accumulated in the same order, the result is identical.
+          ASSERT_EQ(BuildHistForTest(gmat, gpair, rows, false, isa), expected);
+        }
+      }
+    }
+  }
+}
+
+TEST(HistUtil, BuildHistColumnLowBins) {
+  Context ctx;
+  bst_idx_t constexpr kRows = 1024;
+  bst_feature_t constexpr kCols = 40;
+  auto gpair = GenerateRandomGradients(kRows).HostVector();
+  auto rows = StridedRowsForTest(kRows);
+  for (float sparsity : {0.0f, 0.3f}) {
+    auto p_fmat = RandomDataGenerator{kRows, kCols, sparsity}.GenerateDMatrix();
+    // Low bin count features use multiple copies of the local histogram.
+    for (std::int32_t max_bin : {4, 256}) {
+      for (auto const &gmat :
+           p_fmat->GetBatches<GHistIndexMatrix>(&ctx, BatchParam{max_bin, 0.5})) {
+        auto by_row = BuildHistForTest(gmat, gpair, rows, false, SimdIsa::kScalar);
+        // Without spreading, rows are summed in the same order as the row-wise kernel.
+        auto by_column = BuildHistForTest(gmat, gpair, rows, true, SimdIsa::kScalar);
+        ASSERT_EQ(by_row, by_column);
+        // Spreading changes the order of summation, the result is close but not identical.
+        auto spread = BuildHistForTest(gmat, gpair, rows, true, SimdIsa::kScalar, true);
+        ASSERT_EQ(by_row.size(), spread.size());
+        for (std::size_t i = 0; i < by_row.size(); ++i) {
+          auto eps = std::max(std::abs(by_row[i].GetHess()), 1.0) * kRtEps;
+          ASSERT_NEAR(by_row[i].GetGrad(), spread[i].GetGrad(), eps);
+          ASSERT_NEAR(by_row[i].GetHess(), spread[i].GetHess(), eps);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Microbenchmark for the histogram kernels, run with:
+ *
+ *   testxgboost --gtest_also_run_disabled_tests --gtest_filter='*BenchmarkBuildHist*'
+ */
+TEST(HistUtil, DISABLED_BenchmarkBuildHist) {
+  Context ctx;
+  bst_idx_t constexpr kRows = 1 << 18;
+  bst_feature_t constexpr kCols = 64;
+  std::int32_t constexpr kRepeats = 8;
+  auto gpair = GenerateRandomGradients(kRows).HostVector();
+  auto rows = StridedRowsForTest(kRows);
+
+  for (float sparsity : {0.0f, 0.5f}) {
+    auto p_fmat = RandomDataGenerator{kRows, kCols, sparsity}.GenerateDMatrix();
+    for (std::int32_t max_bin : {16, 256, 1024}) {
+      for (auto const &gmat :
+           p_fmat->GetBatches<GHistIndexMatrix>(&ctx, BatchParam{max_bin, 0.5})) {
+        auto run = [&](bool read_by_column, SimdIsa isa, std::string const &name,
+                       bool spread_low_bins = false) {
+          Timer timer;
+          for (std::int32_t i = 0; i < kRepeats; ++i) {
+            std::ignore =
+                BuildHistForTest(gmat, gpair, rows, read_by_column, isa, spread_low_bins);
+          }
+          timer.Stop();
+          timer.PrintElapsed("sparsity=" + std::to_string(sparsity) +
+                             " max_bin=" + std::to_string(max_bin) + " " + name);
+        };
+        run(false, SimdIsa::kScalar, "row-wise scalar");
+        if (DetectSimdIsa() >= SimdIsa::kAvx2) {
+          run(false, SimdIsa::kAvx2, "row-wise avx2");
+        }
+        if (DetectSimdIsa() >= SimdIsa::kAvx512) {
+          run(false, SimdIsa::kAvx512, "row-wise avx512");
+        }
+        if (gmat.IsDense()) {
+          run(true, SimdIsa::kScalar, "column-wise");
+          run(true, SimdIsa::kScalar, "column-wise spread", true);
+        }
+      }
+    }
+  }
+}
 }  // namespace xgboost::common
@@ -1,10 +1,15 @@
 /**
- * Copyright 2019-2024, XGBoost Contributors
+ * Copyright 2019-2026, XGBoost Contributors
  */
 #include <dmlc/omp.h>  // for omp_in_parallel
 #include <gtest/gtest.h>
 
+#include <atomic>   // for atomic
+#include <chrono>   // for microseconds
+#include <cstdint>  // for int32_t
 #include <cstddef>  // for std::size_t
+#include <thread>   // for sleep_for
+#include <vector>   // for vector
 
 #include "../../../src/common/threading_utils.h"  // BlockedSpace2d,ParallelFor2d,ParallelFor
 #include "xgboost/context.h"                      // Context
@@ -87,6 +92,41 @@ TEST(ParallelFor2d, NonUniform) {
   }
 }
 
+TEST(ParallelFor2d, Stealing) {
+  // A single large node followed by many small nodes, the first thread is assigned with
+  // the slow blocks.
+  std::vector<std::size_t> dim2{4096, 16, 16, 16, 16, 16, 16, 16};
+  constexpr std::size_t kGrainSize = 16;
+  BlockedSpace2d space{dim2.size(), [&](std::size_t i) { return dim2[i]; }, kGrainSize};
+
+  for (std::int32_t n_threads : {1, 4, 512}) {
+    std::vector<std::atomic<std::int32_t>> n_visits(space.Size());
+    ParallelFor2dStealing(space, n_threads, [&](std::size_t i, Range1d r) {
+      if (i == 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds{10});
+      }
+      std::size_t block = 0;
+      while (space.GetFirstDimension(block) != i || space.GetRange(block).begin() != r.begin()) {
+        ++block;
+      }
+      n_visits[block]++;
+    });
+    for (auto const& v : n_visits) {
+      ASSERT_EQ(v, 1);
+    }
+  }
+
+  ASSERT_THROW(
+      {
+        ParallelFor2dStealing(space, 4, [&](std::size_t i, Range1d) {
+          if (i == 3) {
+            LOG(FATAL) << "foo";
+          }
+        });
+      },
+      dmlc::Error);
+}
+
 TEST(ParallelFor, Basic) {
   Context ctx;
   std::size_t n{16};
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>  // for Learner
+
+#include <chrono>   // for milliseconds
+#include <cstdint>  // for int32_t
+#include <future>   // for promise
+#include <memory>   // for unique_ptr, shared_ptr
+#include <tuple>    // for ignore
+#include <vector>   // for vector
+
+#include "../../../src/predictor/async_prediction.h"  // for AsyncPredictor
+#include "../helpers.h"                               // for RandomDataGenerator
+
+namespace xgboost::predictor {
+TEST(AsyncPrediction, Learner) {
+  bst_idx_t constexpr kRows = 128;
+  bst_feature_t constexpr kCols = 8;
+  auto p_fmat = RandomDataGenerator{kRows, kCols, 0.2}.Classes(3).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_fmat})};
+  learner->Configure(Args{{"objective", "multi:softprob"}, {"num_class", "3"}});
+  for (std::int32_t iter = 0; iter < 4; ++iter) {
+    learner->UpdateOneIter(iter, p_fmat);
+  }
+
+  HostDeviceVector<float> expected;
+  learner->Predict(p_fmat, false, &expected, 0, 0);
+  HostDeviceVector<float> expected_contribs;
+  learner->Predict(p_fmat, false, &expected_contribs, 0, 0, false, false, true);
+
+  std::vector<std::shared_ptr<AsyncPrediction>> tasks;
+  for (std::int32_t i = 0; i < 4; ++i) {
+    tasks.emplace_back(learner->PredictAsync(p_fmat, false, 0, 0));
+  }
+  auto contribs = learner->PredictAsync(p_fmat, false, 0, 0, false, true);
+  for (auto const& task : tasks) {
+    ASSERT_EQ(task->Wait(), AsyncStatus::kDone);
+    ASSERT_EQ(task->Get().ConstHostVector(), expected.ConstHostVector());
+  }
+  ASSERT_EQ(contribs->Get().ConstHostVector(), expected_contribs.ConstHostVector());
+
+  // Destroying the learner waits for the queued predictions.
+  auto last = learner->PredictAsync(p_fmat, false, 0, 0);
+  learner.reset();
+  ASSERT_EQ(last->Status(), AsyncStatus::kDone);
+}
+
+TEST(AsyncPrediction, Cancel) {
+  AsyncPredictor worker;
+  std::promise<void> unblock;
+  auto blocker = worker.Submit([fut = unblock.get_future().share()](HostDeviceVector<float>*) {
+    fut.wait();
+  });
+  auto cancelled = worker.Submit([](HostDeviceVector<float>* out) { out->Resize(1); });
+  auto failed = worker.Submit([](HostDeviceVector<float>*) { LOG(FATAL) << "foo"; });
+
+  ASSERT_EQ(cancelled->WaitFor(std::chrono::milliseconds{1}), AsyncStatus::kPending);
+  ASSERT_TRUE(cancelled->Cancel());
+  ASSERT_EQ(cancelled->Status(), AsyncStatus::kCancelled);
+  ASSERT_THROW({ std::ignore = cancelled->Get(); }, dmlc::Error);
+
+  unblock.set_value();
+  ASSERT_EQ(blocker->Wait(), AsyncStatus::kDone);
+  // Finished predictions can't be cancelled.
+  ASSERT_FALSE(blocker->Cancel());
+  ASSERT_EQ(failed->Wait(), AsyncStatus::kFailed);
+  ASSERT_THROW({ std::ignore = failed->Get(); }, dmlc::Error);
+}
+}  // namespace xgboost::predictor
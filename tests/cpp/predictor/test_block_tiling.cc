@@ -0,0 +1,58 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+
+#include "../../../src/predictor/block_tiling.h"  // for ChooseBlockTiling
+
+namespace xgboost::predictor {
+TEST(BlockTiling, Choose) {
+  std::int64_t constexpr kL2 = 1024 * 1024;
+  std::size_t constexpr kBlock = 64;
+  bst_feature_t constexpr kFeatures = 200;
+  {
+    // Small model, stays in cache.
+    auto tiling = ChooseBlockTiling(kL2, 0, 1, 64 * 1024, 100, kFeatures, 1 << 20, kBlock);
+    ASSERT_EQ(tiling.tile_rows, kBlock);
+    ASSERT_EQ(tiling.chunk_trees, 100);
+  }
+  {
+    // Large model, both the tile and the chunk fit in the cache.
+    std::size_t model_bytes = 5000 * 20000;
+    auto tiling = ChooseBlockTiling(kL2, 0, 1, model_bytes, 5000, kFeatures, 1 << 20, kBlock);
+    ASSERT_GT(tiling.tile_rows, kBlock);
+    ASSERT_EQ(tiling.tile_rows % kBlock, 0);
+    ASSERT_GT(tiling.chunk_trees, 1);
+    ASSERT_LT(tiling.chunk_trees, 5000);
+    auto tile_bytes = tiling.tile_rows * kFeatures * sizeof(float);
+    auto chunk_bytes = tiling.chunk_trees * (model_bytes / 5000);
+    ASSERT_LE(tile_bytes + chunk_bytes, kL2);
+  }
+  {
+    // Shared L3 is split between threads.
+    std::size_t model_bytes = 5000 * 20000;
+    auto t1 = ChooseBlockTiling(kL2, 32 * kL2, 4, model_bytes, 5000, kFeatures, 1 << 20, kBlock);
+    auto t0 = ChooseBlockTiling(kL2, 0, 4, model_bytes, 5000, kFeatures, 1 << 20, kBlock);
+    ASSERT_GT(t1.chunk_trees, t0.chunk_trees);
+  }
+  {
+    // Small batch, don't starve the threads.
+    auto tiling = ChooseBlockTiling(kL2, 0, 4, 5000 * 20000, 5000, kFeatures, 256, kBlock);
+    ASSERT_EQ(tiling.tile_rows, kBlock);
+  }
+  {
+    // Huge trees, one tree for each chunk.
+    auto tiling = ChooseBlockTiling(kL2, 0, 1, 16 * kL2, 2, kFeatures, 1 << 20, kBlock);
+    ASSERT_EQ(tiling.chunk_trees, 1);
+  }
+  {
+    // No row block.
+    auto tiling = ChooseBlockTiling(kL2, 0, 1, 16 * kL2, 16, kFeatures, 1 << 20, 1);
+    ASSERT_EQ(tiling.tile_rows, 1);
+    ASSERT_EQ(tiling.chunk_trees, 16);
+  }
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>  // for Learner
+
+#include <algorithm>  // for copy
+#include <cmath>      // for abs
+#include <cstdint>    // for int32_t
+#include <limits>     // for numeric_limits
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include "../../../src/data/proxy_dmatrix.h"        // for DMatrixProxy
+#include "../../../src/predictor/compact_forest.h"  // for CompactForest
+#include "../../../src/tree/tree_view.h"            // for ScalarTreeView
+#include "../filesystem.h"                          // for TemporaryDirectory
+#include "../helpers.h"                             // for RandomDataGenerator
+
+namespace xgboost::predictor {
+namespace {
+std::vector<float> PredictRows(CompactForest const& forest,
+                               std::vector<std::vector<float>> const& rows) {
+  std::vector<RegTree::FVec> feats(rows.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    feats[i].Init(forest.NumFeatures());
+    std::copy(rows[i].cbegin(), rows[i].cend(), feats[i].Data().begin());
+  }
+  Context ctx;
+  auto out = linalg::Zeros<float>(&ctx, rows.size(), forest.NumGroups());
+  forest.Predict(common::Span<RegTree::FVec const>{feats}, 0, forest.NumTrees(), out.HostView());
+  auto const& h_out = out.Data()->ConstHostVector();
+  return {h_out.cbegin(), h_out.cend()};
+}
+}  // namespace
+
+TEST(CompactForest, Forest) {
+  auto constexpr kNaN = std::numeric_limits<float>::quiet_NaN();
+  RegTree tree{1, 2};
+  tree.ExpandNode(RegTree::kRoot, 0, 0.1f, false, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  tree.ExpandNode(2, 1, 1.0f, true, 0.0f, 0.1f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  RegTree other{1, 2};
+  other.ExpandNode(RegTree::kRoot, 0, 0.1f, true, 0.0f, 4.0f, 5.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+
+  std::vector<tree::ScalarTreeView> trees{tree::ScalarTreeView{&tree},
+                                          tree::ScalarTreeView{&other}};
+  ASSERT_TRUE(CompactForest::IsSupported(trees[0], 2));
+  std::vector<bst_target_t> groups{0, 0};
+  std::vector<float> weights{1.0f, 2.0f};
+
+  std::vector<std::vector<float>> rows{
+      {-1.0f, 0.0f}, {0.5f, 0.0f}, {1.0f, 2.0f}, {kNaN, kNaN}, {0.5f, kNaN}};
+  std::vector<float> expected{-1.0f + 8.0f, 0.1f + 10.0f, 3.0f + 10.0f, 0.1f + 8.0f,
+                              0.1f + 10.0f};
+  for (auto precision :
+       {CompactPrecision::kFp16, CompactPrecision::kBf16, CompactPrecision::kQuantized}) {
+    auto forest = CompactForest::Create(common::Span{trees}, common::Span{groups}, 2, 1,
+                                        common::OptionalWeights{common::Span{weights}}, precision);
+    ASSERT_TRUE(forest);
+    ASSERT_EQ(forest->NumTrees(), 2);
+    ASSERT_EQ(forest->NumNodes(), 8);
+
+    auto const& report = forest->Report();
+    // 0.1 is not representable in fp16.
+    auto leaf_error = get<Number const>(report["max_leaf_error"]);
+    ASSERT_GT(leaf_error, 0.0);
+    ASSERT_LT(leaf_error, 1e-3);
+    ASSERT_EQ(get<Number const>(report["max_margin_error"]), leaf_error);
+    ASSERT_EQ(get<Integer const>(report["n_nodes"]), 8);
+    if (precision == CompactPrecision::kQuantized) {
+      ASSERT_EQ(get<Integer const>(report["n_rounded_thresholds"]), 0);
+    } else {
+      ASSERT_EQ(get<Integer const>(report["n_rounded_thresholds"]), 2);
+    }
+
+    auto predt = PredictRows(*forest, rows);
+    ASSERT_EQ(predt.size(), expected.size());
+    for (std::size_t i = 0; i < predt.size(); ++i) {
+      ASSERT_NEAR(predt[i], expected[i], leaf_error + kRtEps);
+    }
+  }
+
+  // Leaf values out of the fp16 range.
+  RegTree large{1, 1};
+  large.ExpandNode(RegTree::kRoot, 0, 0.0f, false, 0.0f, 1e5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  std::vector<tree::ScalarTreeView> large_trees{tree::ScalarTreeView{&large}};
+  std::vector<bst_target_t> large_groups{0};
+  ASSERT_FALSE(CompactForest::Create(common::Span{large_trees}, common::Span{large_groups}, 1, 1,
+                                     common::OptionalWeights{1.0f}, CompactPrecision::kFp16));
+  ASSERT_THROW({ ParseCompactPrecision("fp8"); }, dmlc::Error);
+
+  // Split thresholds out of the fp16 range.
+  RegTree wide{1, 1};
+  wide.ExpandNode(RegTree::kRoot, 0, 7e4f, false, 0.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  std::vector<tree::ScalarTreeView> wide_trees{tree::ScalarTreeView{&wide}};
+  ASSERT_FALSE(CompactForest::Create(common::Span{wide_trees}, common::Span{large_groups}, 1, 1,
+                                     common::OptionalWeights{1.0f}, CompactPrecision::kFp16));
+  for (auto precision : {CompactPrecision::kBf16, CompactPrecision::kQuantized}) {
+    auto forest = CompactForest::Create(common::Span{wide_trees}, common::Span{large_groups}, 1,
+                                        1, common::OptionalWeights{1.0f}, precision);
+    ASSERT_TRUE(forest);
+    auto predt = PredictRows(*forest, {{6.9e4f}, {7.1e4f}});
+    ASSERT_EQ(predt, (std::vector<float>{-1.0f, 1.0f}));
+  }
+}
+
+namespace {
+void TestCompactPrediction(std::size_t n_classes, float sparsity) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 16;
+  auto p_train = RandomDataGenerator{kRows, kCols, sparsity}.Classes(n_classes).GenerateDMatrix(
+      true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  Args args{{"max_depth", "6"}};
+  if (n_classes > 1) {
+    args.emplace_back("objective", "multi:softprob");
+    args.emplace_back("num_class", std::to_string(n_classes));
+  }
+  learner->Configure(args);
+  for (std::int32_t i = 0; i < 8; ++i) {
+    learner->UpdateOneIter(i, p_train);
+  }
+
+  // Use new DMatrix objects to avoid the prediction cache.
+  auto predict = [&](Learner* booster, bst_layer_t layer_end) {
+    auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDMatrix();
+    HostDeviceVector<float> predt;
+    booster->Predict(p_test, true, &predt, 0, layer_end);
+    return predt.ConstHostVector();
+  };
+  auto expected = predict(learner.get(), 0);
+  auto expected_sliced = predict(learner.get(), 4);
+
+  // The quantized precision is exact for the thresholds, only the leaf values are rounded.
+  common::TemporaryDirectory tmpdir;
+  auto path = tmpdir.Str() + "/model.compact";
+  Json config{Object{}};
+  config["precision"] = String{"quantized"};
+  config["path"] = String{path};
+  Json report;
+  learner->Compact(config, &report);
+  auto margin_error = get<Number const>(report["max_margin_error"]);
+  ASSERT_EQ(get<Integer const>(report["n_rounded_thresholds"]), 0);
+  ASSERT_LT(get<Integer const>(report["bytes"]), get<Integer const>(report["full_bytes"]));
+
+  auto check = [&](std::vector<float> const& predt, std::vector<float> const& expected) {
+    ASSERT_EQ(predt.size(), expected.size());
+    for (std::size_t i = 0; i < predt.size(); ++i) {
+      ASSERT_NEAR(predt[i], expected[i], margin_error + kRtEps);
+    }
+  };
+  auto compacted = predict(learner.get(), 0);
+  check(compacted, expected);
+  check(predict(learner.get(), 4), expected_sliced);
+
+  // Inplace prediction.
+  HostDeviceVector<float> data;
+  RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDense(&data);
+  std::shared_ptr<data::DMatrixProxy> proxy{new data::DMatrixProxy{}};
+  auto array_interface = GetArrayInterface(&data, kRows, kCols);
+  std::string arr_str;
+  Json::Dump(array_interface, &arr_str);
+  proxy->SetArray(arr_str.data());
+  HostDeviceVector<float>* p_inplace{nullptr};
+  learner->InplacePredict(proxy, PredictionType::kMargin, std::numeric_limits<float>::quiet_NaN(),
+                          &p_inplace, 0, 0);
+  ASSERT_EQ(p_inplace->ConstHostVector(), compacted);
+
+  // Staged prediction is forwarded to the full model.
+  auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDMatrix();
+  std::vector<bst_layer_t> stages{4, 8};
+  HostDeviceVector<float> staged;
+  learner->PredictStaged(p_test, common::Span<bst_layer_t const>{stages}, &staged);
+  auto const& h_staged = staged.ConstHostVector();
+  ASSERT_EQ(h_staged.size(), expected.size() * 2);
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_NEAR(h_staged[i], expected_sliced[i], kRtEps);
+    ASSERT_NEAR(h_staged[expected.size() + i], expected[i], kRtEps);
+  }
+
+  // Load the compact model into a new booster.
+  Json model{Object{}};
+  learner->SaveModel(&model);
+  std::unique_ptr<Learner> loaded{Learner::Create({})};
+  loaded->LoadModel(model);
+  loaded->Configure({{"compact_model", path}});
+  ASSERT_EQ(predict(loaded.get(), 0), compacted);
+
+  // Half precision thresholds.
+  for (auto precision : {"fp16", "bf16"}) {
+    config = Json{Object{}};
+    config["precision"] = String{precision};
+    learner->Compact(config, &report);
+    ASSERT_GE(get<Number const>(report["max_threshold_error"]), 0.0);
+    ASSERT_EQ(predict(learner.get(), 0).size(), expected.size());
+  }
+}
+}  // namespace
+
+TEST(CompactForest, StaleModel) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 16;
+  auto train = [&](std::uint64_t seed) {
+    auto p_train = RandomDataGenerator{kRows, kCols, 0.0f}.Seed(seed).GenerateDMatrix(true);
+    std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+    learner->Configure({{"max_depth", "4"}});
+    for (std::int32_t i = 0; i < 4; ++i) {
+      learner->UpdateOneIter(i, p_train);
+    }
+    return learner;
+  };
+  auto predict = [&](Learner* booster) {
+    auto p_test = RandomDataGenerator{kRows, kCols, 0.0f}.Seed(3).GenerateDMatrix();
+    HostDeviceVector<float> predt;
+    booster->Predict(p_test, true, &predt, 0, 0);
+    return predt.ConstHostVector();
+  };
+
+  common::TemporaryDirectory tmpdir;
+  auto path = tmpdir.Str() + "/model.compact";
+  auto learner = train(0);
+  Json config{Object{}};
+  config["precision"] = String{"bf16"};
+  config["path"] = String{path};
+  Json report;
+  learner->Compact(config, &report);
+
+  // A model with the same shape doesn't use the compact copy of another model.
+  auto other = train(1);
+  auto expected = predict(other.get());
+  other->Configure({{"compact_model", path}});
+  ASSERT_EQ(predict(other.get()), expected);
+
+  // Loading a different model drops the compact copy.
+  Json model{Object{}};
+  other->SaveModel(&model);
+  learner->LoadModel(model);
+  ASSERT_EQ(predict(learner.get()), expected);
+}
+
+TEST(CompactForest, Prediction) {
+  TestCompactPrediction(1, 0.0f);
+  TestCompactPrediction(1, 0.5f);
+  TestCompactPrediction(3, 0.2f);
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,173 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>  // for Learner
+
+#include <cstdint>  // for uint64_t
+#include <cstdlib>  // for system
+#include <fstream>  // for ifstream
+#include <limits>   // for numeric_limits
+#include <memory>   // for unique_ptr
+#include <sstream>  // for stringstream
+#include <string>   // for string
+#include <tuple>    // for ignore
+#include <vector>   // for vector
+
+#include "../../../src/data/proxy_dmatrix.h"           // for DMatrixProxy
+#include "../../../src/predictor/compiled_predictor.h"  // for GenerateModelSource
+#include "../filesystem.h"                              // for TemporaryDirectory
+#include "../helpers.h"                                 // for RandomDataGenerator
+#include "test_predictor.h"                             // for CreateTestModel
+
+namespace xgboost::predictor {
+TEST(CompiledPredictor, Source) {
+  Context ctx;
+  bst_target_t constexpr kClasses = 3;
+  LearnerModelState mparam{MakeMP(4, 0.5, kClasses)};
+  auto p_model = CreateTestModel(&mparam, &ctx, kClasses);
+
+  std::stringstream ss;
+  GenerateModelSource(*p_model, &ss);
+  auto src = ss.str();
+  ASSERT_NE(src.find("static float tree_0(float const* x)"), std::string::npos);
+  ASSERT_NE(src.find("void predict(float const* data, size_t n_rows, float* out)"),
+            std::string::npos);
+  ASSERT_NE(src.find("y[2] += tree_2(x);"), std::string::npos);
+  // 1.5 in hexadecimal floating point.
+  ASSERT_NE(src.find("return 0x1.8p+0f;"), std::string::npos);
+  ASSERT_NE(src.find("xgboost_num_target(void) { return 3; }"), std::string::npos);
+}
+
+namespace {
+std::unique_ptr<Learner> TrainForCompile(bst_target_t n_classes, bst_feature_t n_features,
+                                         std::uint64_t seed) {
+  bst_idx_t constexpr kRows = 256;
+  auto p_train = RandomDataGenerator{kRows, n_features, 0.2}
+                     .Seed(seed)
+                     .Classes(n_classes)
+                     .GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  Args args{{"max_depth", "4"}};
+  if (n_classes > 1) {
+    args.emplace_back("objective", "multi:softprob");
+    args.emplace_back("num_class", std::to_string(n_classes));
+  }
+  learner->Configure(args);
+  for (std::int32_t i = 0; i < 8; ++i) {
+    learner->UpdateOneIter(i, p_train);
+  }
+  return learner;
+}
+
+void TestCompiledPrediction(bst_target_t n_classes) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 16;
+  float constexpr kSparsity = 0.2f;
+  auto learner = TrainForCompile(n_classes, kCols, 0);
+
+  HostDeviceVector<float> data;
+  RandomDataGenerator{kRows, kCols, kSparsity}.Seed(1).GenerateDense(&data);
+  std::shared_ptr<data::DMatrixProxy> proxy{new data::DMatrixProxy{}};
+  auto array_interface = GetArrayInterface(&data, kRows, kCols);
+  std::string arr_str;
+  Json::Dump(array_interface, &arr_str);
+  proxy->SetArray(arr_str.data());
+
+  auto constexpr kNaN = std::numeric_limits<float>::quiet_NaN();
+  auto predict = [&](Learner* booster, bst_layer_t end) {
+    HostDeviceVector<float>* p_out{nullptr};
+    booster->InplacePredict(proxy, PredictionType::kMargin, kNaN, &p_out, 0, end);
+    return p_out->ConstHostVector();
+  };
+  auto expected = predict(learner.get(), 0);
+  auto expected_sliced = predict(learner.get(), 4);
+
+  common::TemporaryDirectory tmpdir;
+  // The path is passed to the compiler as it is.
+  auto path = tmpdir.Str() + "/compiled model.so";
+  Json config{Object{}};
+  config["path"] = String{path};
+  learner->Compile(config);
+
+  auto check = [](std::vector<float> const& predt, std::vector<float> const& expected) {
+    ASSERT_EQ(predt.size(), expected.size());
+    for (std::size_t i = 0; i < predt.size(); ++i) {
+      ASSERT_NEAR(predt[i], expected[i], kRtEps);
+    }
+  };
+  check(predict(learner.get(), 0), expected);
+  // Falls back to the tree traversal.
+  check(predict(learner.get(), 4), expected_sliced);
+
+  // Load the library into a new booster.
+  Json model{Object{}};
+  learner->SaveModel(&model);
+  std::unique_ptr<Learner> loaded{Learner::Create({})};
+  loaded->LoadModel(model);
+  loaded->Configure({{"compiled_library", path}});
+  check(predict(loaded.get(), 0), expected);
+
+  // A different model with the same shape doesn't use the library.
+  auto other = TrainForCompile(n_classes, kCols, 1);
+  auto expected_other = predict(other.get(), 0);
+  ASSERT_NE(expected_other, expected);
+  other->SaveModel(&model);
+  loaded->LoadModel(model);
+  ASSERT_EQ(predict(loaded.get(), 0), expected_other);
+
+  // Neither does the model after training.
+  auto p_train = RandomDataGenerator{kRows, kCols, kSparsity}.Classes(n_classes).GenerateDMatrix(
+      true);
+  learner->UpdateOneIter(8, p_train);
+  learner->SaveModel(&model);
+  std::unique_ptr<Learner> trained{Learner::Create({})};
+  trained->LoadModel(model);
+  ASSERT_EQ(predict(learner.get(), 0), predict(trained.get(), 0));
+}
+}  // namespace
+
+TEST(CompiledPredictor, CompileError) {
+#if defined(_WIN32)
+  GTEST_SKIP() << "Compiling models is not supported on Windows.";
+#endif  // defined(_WIN32)
+  if (std::system("cc --version > /dev/null 2>&1") != 0) {
+    GTEST_SKIP() << "C compiler is not available.";
+  }
+  Context ctx;
+  LearnerModelState mparam{MakeMP(4, 0.5, 1)};
+  auto p_model = CreateTestModel(&mparam, &ctx);
+  common::TemporaryDirectory tmpdir;
+  Json config{Object{}};
+  config["path"] = String{tmpdir.Str() + "/model.so"};
+
+  // The flags are not interpreted by a shell.
+  config["flags"] = String{"-O2; touch " + tmpdir.Str() + "/injected"};
+  ASSERT_THROW({ std::ignore = CompileModel(*p_model, config); }, dmlc::Error);
+  ASSERT_FALSE(std::ifstream{tmpdir.Str() + "/injected"});
+
+  // The compiler output is in the error message.
+  config["flags"] = String{"-O2 -DBROKEN -include nonexistent_header.h"};
+  try {
+    std::ignore = CompileModel(*p_model, config);
+    FAIL() << "The compilation should fail.";
+  } catch (dmlc::Error const& e) {
+    ASSERT_NE(std::string{e.what()}.find("nonexistent_header.h"), std::string::npos);
+  }
+
+  config["compiler"] = String{"xgboost-nonexistent-compiler"};
+  config["flags"] = String{"-O2"};
+  ASSERT_THROW({ std::ignore = CompileModel(*p_model, config); }, dmlc::Error);
+}
+
+TEST(CompiledPredictor, InplacePredict) {
+#if defined(_WIN32)
+  GTEST_SKIP() << "Loading compiled models is not supported on Windows.";
+#endif  // defined(_WIN32)
+  if (std::system("cc --version > /dev/null 2>&1") != 0) {
+    GTEST_SKIP() << "C compiler is not available.";
+  }
+  TestCompiledPrediction(1);
+  TestCompiledPrediction(3);
+}
+}  // namespace xgboost::predictor
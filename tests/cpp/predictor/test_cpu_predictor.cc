@@ -2,14 +2,25 @@
  * Copyright 2017-2026, XGBoost contributors
  */
 #include <gtest/gtest.h>
+#include <xgboost/learner.h>  // for Learner
 #include <xgboost/predictor.h>
 
+#include <algorithm>  // for is_sorted
+#include <cstdint>    // for uint8_t, uint16_t, uint32_t
+#include <map>        // for map
+#include <memory>     // for shared_ptr, unique_ptr
+#include <numeric>    // for iota
+#include <string>     // for string
+
 #include "../../../src/collective/communicator-inl.h"
+#include "../../../src/common/simd.h"  // for SimdIsa, DetectSimdIsa
 #include "../../../src/data/adapter.h"
 #include "../../../src/data/proxy_dmatrix.h"
 #include "../../../src/gbm/gbtree.h"
 #include "../../../src/gbm/gbtree_model.h"
+#include "../../../src/predictor/array_forest.h"  // for ArrayForest
 #include "../../../src/predictor/array_tree_layout.h"
+#include "../../../src/predictor/block_tiling.h"  // for ChooseBlockTiling
 #include "../../../src/tree/tree_view.h"
 #include "../collective/test_worker.h"  // for TestDistributedGlobal
 #include "../helpers.h"
@@ -117,6 +128,196 @@ TEST(CpuPredictor, ArrayTreeLayout) {
   }
 }
 
+TEST(CpuPredictor, ArrayTreeLayoutSimd) {
+  Context ctx;
+  bst_feature_t constexpr kCols = 8;
+  std::size_t constexpr kBlockSize = 61;  // Not a multiple of the vector width.
+  constexpr bst_node_t kDepth = 5;
+
+  RegTree tree;
+  SimpleLCG lcg;
+  SimpleRealUniformDistribution<float> dist{-1.0f, 1.0f};
+  // A full tree with one extra level below the array layout.
+  for (bst_node_t nid = 0; nid < (1 << kDepth) - 1; ++nid) {
+    tree.ExpandNode(nid, nid % kCols, dist(&lcg), nid % 3 == 0, 0, 0, 0, 0, 0, 0, 0);
+  }
+  auto sc_tree = tree::ScalarTreeView{ctx.Device(), false, &tree};
+
+  std::vector<RegTree::FVec> fvecs(kBlockSize);
+  for (std::size_t i = 0; i < kBlockSize; ++i) {
+    fvecs[i].Init(kCols);
+    auto data = fvecs[i].Data();
+    for (bst_feature_t f = 0; f < kCols; ++f) {
+      // Leave some missing values.
+      if ((i + f) % 5 != 0) {
+        data[f] = dist(&lcg);
+      }
+    }
+  }
+
+  auto run = [&](common::SimdIsa isa) {
+    predictor::ArrayTreeLayout<false, true, kDepth - 1, tree::ScalarTreeView> layout{
+        sc_tree, sc_tree.GetCategoriesMatrix()};
+    std::vector<bst_node_t> nidx(kBlockSize, 0);
+    layout.Process(common::Span{fvecs}, kBlockSize, nidx.data(), isa);
+    return nidx;
+  };
+
+  auto expected = run(common::SimdIsa::kScalar);
+  for (auto isa : {common::SimdIsa::kAvx2, common::SimdIsa::kAvx512}) {
+    if (static_cast<std::int32_t>(isa) > static_cast<std::int32_t>(common::DetectSimdIsa())) {
+      continue;
+    }
+    ASSERT_EQ(run(isa), expected);
+  }
+}
+
+TEST(CpuPredictor, ArrayForest) {
+  bst_feature_t constexpr kCols = 8;
+  std::size_t constexpr kRows = 67;
+  SimpleLCG lcg;
+  SimpleRealUniformDistribution<float> dist{-1.0f, 1.0f};
+
+  // An unbalanced tree, grown by splitting random leaves.
+  RegTree tree;
+  std::vector<bst_node_t> leaves{RegTree::kRoot};
+  std::vector<std::int32_t> level{0};
+  while (!leaves.empty()) {
+    auto k = static_cast<std::size_t>((dist(&lcg) + 1.0f) / 2.0f * (leaves.size() - 1));
+    auto nid = leaves[k];
+    leaves.erase(leaves.begin() + k);
+    if (level[nid] == predictor::ArrayForest::kMaxDepth || tree.NumNodes() > 512) {
+      continue;
+    }
+    auto n = static_cast<float>(tree.NumNodes());
+    tree.ExpandNode(nid, nid % kCols, dist(&lcg), nid % 3 == 0, 0, n, n + 1, 0, 0, 0, 0);
+    for (auto child : {tree.LeftChild(nid), tree.RightChild(nid)}) {
+      level.resize(tree.NumNodes());
+      level[child] = level[nid] + 1;
+      leaves.push_back(child);
+    }
+  }
+  auto sc_tree = tree::ScalarTreeView{&tree};
+  std::int32_t depth = sc_tree.MaxDepth();
+  ASSERT_TRUE(predictor::ArrayForest::IsSupported(sc_tree, depth));
+  ASSERT_FALSE(predictor::ArrayForest::IsSupported(sc_tree, predictor::ArrayForest::kMaxDepth + 1));
+
+  std::vector<RegTree::FVec> fvecs(kRows);
+  for (std::size_t i = 0; i < kRows; ++i) {
+    fvecs[i].Init(kCols);
+    auto data = fvecs[i].Data();
+    for (bst_feature_t f = 0; f < kCols; ++f) {
+      if ((i + f) % 7 != 0) {
+        data[f] = dist(&lcg);
+      }
+    }
+  }
+
+  // The second tree is skipped.
+  std::vector<tree::ScalarTreeView const*> trees{&sc_tree, nullptr};
+  std::vector<std::int32_t> depths{depth, 0};
+  predictor::ArrayForest forest{common::Span{trees}, common::Span{depths}, 2};
+  ASSERT_TRUE(forest.IsFlat(0));
+  ASSERT_FALSE(forest.IsFlat(1));
+  ASSERT_EQ(forest.Depth(0), depth);
+
+  std::vector<bst_node_t> pos(kRows);
+  forest.Traverse(0, common::Span{fvecs}, true, pos.data());
+  for (std::size_t i = 0; i < kRows; ++i) {
+    bst_node_t nid = RegTree::kRoot;
+    while (!sc_tree.IsLeaf(nid)) {
+      auto fidx = sc_tree.SplitIndex(nid);
+      nid = fvecs[i].IsMissing(fidx) ? sc_tree.DefaultChild(nid)
+            : fvecs[i].GetFvalue(fidx) < sc_tree.SplitCond(nid) ? sc_tree.LeftChild(nid)
+                                                                 : sc_tree.RightChild(nid);
+    }
+    ASSERT_EQ(forest.LeafValue(0, pos[i]), sc_tree.LeafValue(nid));
+  }
+}
+
+TEST(CpuPredictor, ArrayForestPrediction) {
+  bst_idx_t constexpr kRows = 2048;
+  bst_feature_t constexpr kCols = 16;
+  for (float sparsity : {0.0f, 0.3f}) {
+    auto p_train = RandomDataGenerator{kRows, kCols, sparsity}.GenerateDMatrix(true);
+    std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+    learner->Configure(Args{{"max_depth", "9"}, {"min_child_weight", "0"}});
+    for (std::int32_t iter = 0; iter < 4; ++iter) {
+      learner->UpdateOneIter(iter, p_train);
+    }
+    // The whole batch is large enough for the flattened trees.
+    auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(3).GenerateDMatrix();
+    HostDeviceVector<float> predt;
+    learner->Predict(p_test, true, &predt, 0, 0);
+    auto const& h_predt = predt.ConstHostVector();
+    // Small slices use the array layout of the top levels.
+    std::int32_t constexpr kSlice = 32;
+    for (std::int32_t beg = 0; beg < static_cast<std::int32_t>(kRows); beg += kSlice) {
+      std::vector<std::int32_t> ridxs(kSlice);
+      std::iota(ridxs.begin(), ridxs.end(), beg);
+      std::shared_ptr<DMatrix> p_slice{p_test->Slice(common::Span{ridxs})};
+      HostDeviceVector<float> expected;
+      learner->Predict(p_slice, true, &expected, 0, 0);
+      auto const& h_expected = expected.ConstHostVector();
+      for (std::int32_t i = 0; i < kSlice; ++i) {
+        ASSERT_NEAR(h_predt[beg + i], h_expected[i], kRtEps);
+      }
+    }
+  }
+}
+
+TEST(CpuPredictor, BlockTiling) {
+  bst_idx_t constexpr kRows = 4096;
+  bst_feature_t constexpr kCols = 16;
+  std::int32_t constexpr kTrees = 64;
+  bst_node_t constexpr kDepth = 6;
+  // Holds a few row blocks and a few trees, far below the size of the model.
+  std::int64_t constexpr kCacheSize = 40 * 1024;
+
+  Context ctx;
+  ctx.UpdateAllowUnknown(Args{{"nthread", "2"}});
+  LearnerModelState mparam{MakeMP(kCols, .5, 1, ctx.Device())};
+  gbm::GBTreeModel model{&mparam, &ctx};
+  SimpleLCG lcg;
+  SimpleRealUniformDistribution<float> dist{-1.0f, 1.0f};
+  std::vector<std::unique_ptr<RegTree>> trees;
+  std::size_t model_bytes = 0;
+  for (std::int32_t i = 0; i < kTrees; ++i) {
+    auto tree = std::make_unique<RegTree>();
+    for (bst_node_t nid = 0; nid < (1 << kDepth) - 1; ++nid) {
+      tree->ExpandNode(nid, (nid + i) % kCols, dist(&lcg), nid % 3 == 0, 0, dist(&lcg),
+                       dist(&lcg), 0, 0, 0, 0);
+    }
+    model_bytes += tree->NumNodes() * sizeof(RegTree::Node);
+    trees.push_back(std::move(tree));
+  }
+  model.CommitModelGroup(std::move(trees), 0);
+
+  // Both the rows and the trees are tiled with this cache size.
+  std::size_t constexpr kBlock = 64;
+  auto tiling = predictor::ChooseBlockTiling(kCacheSize, 0, ctx.Threads(), model_bytes, kTrees,
+                                             kCols, kRows, kBlock);
+  ASSERT_GT(tiling.tile_rows, kBlock);
+  ASSERT_GT(tiling.chunk_trees, 1);
+  ASSERT_LT(tiling.chunk_trees, kTrees);
+
+  for (float sparsity : {0.0f, 0.3f}) {
+    auto p_fmat = RandomDataGenerator{kRows, kCols, sparsity}.Seed(3).GenerateDMatrix();
+    auto predict = [&](Args const& args) {
+      std::unique_ptr<Predictor> predictor{Predictor::Create("cpu_predictor", &ctx)};
+      predictor->Configure(args);
+      HostDeviceVector<float> predt;
+      predictor->InitOutPredictions(p_fmat->Info(), &predt, model);
+      predictor->PredictBatch(p_fmat.get(), &predt, model, 0);
+      return predt.HostVector();
+    };
+    auto expected = predict({});
+    auto tiled = predict({{"tiling_cache_size", std::to_string(kCacheSize)}});
+    // Tiling only changes the loop nest, not the accumulation order.
+    ASSERT_EQ(tiled, expected);
+  }
+}
+
 TEST(CpuPredictor, IterationRange) {
   Context ctx;
   TestIterationRange(&ctx);
@@ -246,4 +447,238 @@ TEST(CpuPredictor, Multi) {
 }
 
 TEST(CpuPredictor, Access) { TestPredictionDeviceAccess(); }
+
+TEST(CpuPredictor, EarlyExit) {
+  bst_idx_t constexpr kRows = 512;
+  bst_feature_t constexpr kCols = 16;
+  std::int32_t constexpr kRounds = 32;
+  auto p_train = RandomDataGenerator{kRows, kCols, 0.2}.Classes(2).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  learner->Configure(Args{{"objective", "binary:logistic"}, {"max_depth", "4"}});
+  for (std::int32_t i = 0; i < kRounds; ++i) {
+    learner->UpdateOneIter(i, p_train);
+  }
+
+  auto p_test = RandomDataGenerator{kRows, kCols, 0.2}.Seed(3).GenerateDMatrix();
+  HostDeviceVector<float> expected;
+  learner->Predict(p_test, true, &expected, 0, 0);
+  auto const& h_expected = expected.ConstHostVector();
+
+  for (float threshold : {-1.0f, 0.0f, 2.0f}) {
+    HostDeviceVector<float> predt;
+    HostDeviceVector<bst_tree_t> n_trees;
+    learner->PredictEarlyExit(p_test, threshold, &predt, &n_trees, 0, 0);
+    auto const& h_predt = predt.ConstHostVector();
+    auto const& h_n_trees = n_trees.ConstHostVector();
+    ASSERT_EQ(h_predt.size(), kRows);
+    ASSERT_EQ(h_n_trees.size(), kRows);
+    std::size_t n_exits = 0;
+    for (std::size_t i = 0; i < kRows; ++i) {
+      ASSERT_EQ(h_predt[i] > threshold, h_expected[i] > threshold);
+      ASSERT_LE(h_n_trees[i], kRounds);
+      if (h_n_trees[i] == kRounds) {
+        ASSERT_NEAR(h_predt[i], h_expected[i], kRtEps);
+      } else {
+        ++n_exits;
+      }
+    }
+    if (threshold == 2.0f) {
+      // Far from the margins of the training data.
+      ASSERT_GT(n_exits, 0);
+    }
+  }
+
+  // Multi-class models are not supported.
+  p_train = RandomDataGenerator{kRows, kCols, 0.2}.Classes(3).GenerateDMatrix(true);
+  learner.reset(Learner::Create({p_train}));
+  learner->Configure(Args{{"objective", "multi:softprob"}, {"num_class", "3"}});
+  learner->UpdateOneIter(0, p_train);
+  HostDeviceVector<float> predt;
+  HostDeviceVector<bst_tree_t> n_trees;
+  ASSERT_THROW({ learner->PredictEarlyExit(p_test, 0.0f, &predt, &n_trees, 0, 0); }, dmlc::Error);
+
+  // Neither are vector-leaf trees, even with a single target.
+  p_train = RandomDataGenerator{kRows, kCols, 0.2}.GenerateDMatrix(true);
+  learner.reset(Learner::Create({p_train}));
+  learner->Configure(Args{{"tree_method", "hist"}, {"multi_strategy", "multi_output_tree"}});
+  learner->UpdateOneIter(0, p_train);
+  ASSERT_THROW({ learner->PredictEarlyExit(p_test, 0.0f, &predt, &n_trees, 0, 0); }, dmlc::Error);
+}
+
+namespace {
+void TestStagedPrediction(std::size_t n_classes, float sparsity) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 16;
+  std::int32_t constexpr kRounds = 8;
+  auto p_train =
+      RandomDataGenerator{kRows, kCols, sparsity}.Classes(n_classes).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  Args args{{"max_depth", "4"}};
+  if (n_classes > 2) {
+    args.emplace_back("objective", "multi:softprob");
+    args.emplace_back("num_class", std::to_string(n_classes));
+  }
+  learner->Configure(args);
+  for (std::int32_t i = 0; i < kRounds; ++i) {
+    learner->UpdateOneIter(i, p_train);
+  }
+
+  auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(3).GenerateDMatrix();
+  std::vector<bst_layer_t> stages{1, 2, 5, kRounds};
+  HostDeviceVector<float> predt;
+  learner->PredictStaged(p_test, common::Span<bst_layer_t const>{stages}, &predt);
+  std::size_t n_groups = n_classes > 2 ? n_classes : 1;
+  auto const& h_predt = predt.ConstHostVector();
+  ASSERT_EQ(h_predt.size(), stages.size() * kRows * n_groups);
+
+  for (std::size_t s = 0; s < stages.size(); ++s) {
+    HostDeviceVector<float> expected;
+    learner->Predict(p_test, true, &expected, 0, stages[s]);
+    auto const& h_expected = expected.ConstHostVector();
+    ASSERT_EQ(h_expected.size(), kRows * n_groups);
+    for (std::size_t i = 0; i < h_expected.size(); ++i) {
+      ASSERT_NEAR(h_predt[s * h_expected.size() + i], h_expected[i], kRtEps);
+    }
+  }
+
+  // Stages must be strictly increasing and within the model.
+  for (auto const& invalid : std::vector<std::vector<bst_layer_t>>{
+           {}, {0}, {2, 2}, {3, 1}, {kRounds + 1}}) {
+    ASSERT_THROW(
+        { learner->PredictStaged(p_test, common::Span<bst_layer_t const>{invalid}, &predt); },
+        dmlc::Error);
+  }
+}
+}  // namespace
+
+TEST(CpuPredictor, Staged) {
+  TestStagedPrediction(2, 0.0f);
+  TestStagedPrediction(2, 0.5f);
+  TestStagedPrediction(3, 0.2f);
+}
+
+TEST(CpuPredictor, MultiModel) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 16;
+  std::vector<std::unique_ptr<Learner>> learners;
+  std::vector<Args> params{{{"objective", "reg:squarederror"}, {"max_depth", "4"}},
+                           {{"objective", "binary:logistic"}, {"max_depth", "6"}},
+                           {{"objective", "multi:softprob"}, {"num_class", "3"}},
+                           {{"booster", "dart"}, {"rate_drop", "0.5"}}};
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    std::size_t n_classes = i == 2 ? 3 : 2;
+    auto p_train =
+        RandomDataGenerator{kRows, kCols, 0.2}.Seed(i).Classes(n_classes).GenerateDMatrix(true);
+    learners.emplace_back(Learner::Create({p_train}));
+    learners.back()->Configure(params[i]);
+    for (std::int32_t iter = 0; iter < 4; ++iter) {
+      learners.back()->UpdateOneIter(iter, p_train);
+    }
+  }
+  std::vector<Learner*> h_learners;
+  for (auto const& learner : learners) {
+    h_learners.push_back(learner.get());
+  }
+
+  for (float sparsity : {0.0f, 0.4f}) {
+    auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(7).GenerateDMatrix();
+    for (bool output_margin : {true, false}) {
+      std::vector<HostDeviceVector<float>> predts(learners.size());
+      std::vector<HostDeviceVector<float>*> out_preds;
+      for (auto& predt : predts) {
+        out_preds.push_back(&predt);
+      }
+      learners.front()->PredictMulti(p_test, common::Span<Learner* const>{h_learners},
+                                     output_margin,
+                                     common::Span<HostDeviceVector<float>* const>{out_preds});
+      for (std::size_t i = 0; i < learners.size(); ++i) {
+        HostDeviceVector<float> expected;
+        learners[i]->Predict(p_test, output_margin, &expected, 0, 0);
+        auto const& h_expected = expected.ConstHostVector();
+        auto const& h_predt = predts[i].ConstHostVector();
+        ASSERT_EQ(h_predt.size(), h_expected.size());
+        for (std::size_t j = 0; j < h_expected.size(); ++j) {
+          ASSERT_NEAR(h_predt[j], h_expected[j], kRtEps);
+        }
+      }
+    }
+  }
+}
+TEST(CpuPredictor, LeafEncoding) {
+  bst_idx_t constexpr kRows = 512;
+  bst_feature_t constexpr kCols = 16;
+  for (auto max_depth : {"3", "10"}) {
+    auto p_train = RandomDataGenerator{kRows, kCols, 0.2}.Classes(3).GenerateDMatrix(true);
+    std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+    learner->Configure(Args{{"objective", "multi:softprob"},
+                            {"num_class", "3"},
+                            {"max_depth", max_depth},
+                            {"min_child_weight", "0"}});
+    for (std::int32_t iter = 0; iter < 4; ++iter) {
+      learner->UpdateOneIter(iter, p_train);
+    }
+
+    for (float sparsity : {0.0f, 0.4f}) {
+      auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(3).GenerateDMatrix();
+      HostDeviceVector<float> leaf;
+      learner->Predict(p_test, false, &leaf, 0, 0, false, true);
+      auto const& h_leaf = leaf.ConstHostVector();
+      std::size_t n_trees = h_leaf.size() / kRows;
+      ASSERT_EQ(n_trees, 12ul);
+
+      // Packed integers
+      HostDeviceVector<std::uint8_t> compact;
+      std::int32_t n_bytes{0};
+      learner->PredictLeafCompact(p_test, &compact, &n_bytes, 0, 0);
+      if (std::string{max_depth} == "3") {
+        ASSERT_EQ(n_bytes, 1);
+      }
+      auto const& h_compact = compact.ConstHostVector();
+      ASSERT_EQ(h_compact.size(), h_leaf.size() * n_bytes);
+      for (std::size_t i = 0; i < h_leaf.size(); ++i) {
+        std::uint32_t nidx{0};
+        switch (n_bytes) {
+          case 1:
+            nidx = h_compact[i];
+            break;
+          case 2:
+            nidx = reinterpret_cast<std::uint16_t const*>(h_compact.data())[i];
+            break;
+          default:
+            nidx = reinterpret_cast<std::uint32_t const*>(h_compact.data())[i];
+        }
+        ASSERT_EQ(static_cast<float>(nidx), h_leaf[i]);
+      }
+
+      // One-hot CSR
+      HostDeviceVector<bst_idx_t> indptr;
+      HostDeviceVector<bst_feature_t> indices;
+      bst_feature_t n_columns{0};
+      learner->PredictLeafOneHot(p_test, &indptr, &indices, &n_columns, 0, 0);
+      auto const& h_indptr = indptr.ConstHostVector();
+      auto const& h_indices = indices.ConstHostVector();
+      ASSERT_EQ(h_indptr.size(), kRows + 1);
+      ASSERT_EQ(h_indptr.back(), h_leaf.size());
+      // The same leaf maps to the same column, and columns follow the node order.
+      std::vector<std::map<bst_node_t, bst_feature_t>> columns(n_trees);
+      for (std::size_t i = 0; i < kRows; ++i) {
+        ASSERT_EQ(h_indptr[i + 1] - h_indptr[i], n_trees);
+        for (std::size_t j = 0; j < n_trees; ++j) {
+          auto k = h_indptr[i] + j;
+          ASSERT_LT(h_indices[k], n_columns);
+          if (j != 0) {
+            ASSERT_LT(h_indices[k - 1], h_indices[k]);
+          }
+          auto nidx = static_cast<bst_node_t>(h_leaf[i * n_trees + j]);
+          auto it = columns[j].emplace(nidx, h_indices[k]).first;
+          ASSERT_EQ(it->second, h_indices[k]);
+        }
+      }
+      for (auto const& tree_columns : columns) {
+        ASSERT_TRUE(std::is_sorted(tree_columns.cbegin(), tree_columns.cend(),
+                                   [](auto const& l, auto const& r) { return l.second < r.second; }));
+      }
+    }
+  }
+}
 }  // namespace xgboost
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>    // for Learner
+#include <xgboost/predictor.h>  // for Predictor
+
+#include <cstdint>  // for int32_t
+#include <memory>   // for unique_ptr
+#include <tuple>    // for ignore
+#include <vector>   // for vector
+
+#include "../../../src/common/numa_topo.h"      // for GetThreadAffinity
+#include "../../../src/gbm/gbtree_model.h"      // for GBTreeModel
+#include "../../../src/predictor/numa_model.h"  // for NumaReplicatedModel
+#include "../helpers.h"                         // for RandomDataGenerator, MakeMP
+#include "test_predictor.h"                     // for CreateTestModel
+
+namespace xgboost::predictor {
+TEST(NumaModel, Partition) {
+  std::vector<NumaNode> nodes{{0, {0, 1, 2, 3}}, {1, {4, 5}}};
+  auto partition = PartitionByNuma(common::Span{nodes}, 6, 600);
+  std::vector<std::int32_t> n_threads(nodes.size(), 0);
+  for (auto node : partition.thread_node) {
+    n_threads[node]++;
+  }
+  ASSERT_EQ(n_threads[0], 4);
+  ASSERT_EQ(n_threads[1], 2);
+  ASSERT_EQ(partition.row_ptr, (std::vector<bst_idx_t>{0, 400, 600}));
+
+  // Each node gets at least one thread.
+  partition = PartitionByNuma(common::Span{nodes}, 2, 10);
+  ASSERT_EQ(partition.thread_node, (std::vector<std::int32_t>{0, 1}));
+  ASSERT_EQ(partition.row_ptr.back(), 10);
+  ASSERT_THROW({ std::ignore = PartitionByNuma(common::Span{nodes}, 1, 10); }, dmlc::Error);
+}
+
+TEST(NumaModel, Replicas) {
+  Context ctx;
+  bst_feature_t constexpr kCols = 4;
+  auto mparam = MakeMP(kCols, .5, 3);
+  auto p_model = CreateTestModel(&mparam, &ctx, 3);
+  auto const& model = *p_model;
+
+  // Pretend that the current CPUs belong to two nodes.
+  std::vector<std::int32_t> cpus;
+  common::GetThreadAffinity(&cpus);
+  NumaReplicatedModel replicas{model, {{0, cpus}, {1, cpus}}};
+  ASSERT_EQ(replicas.NumNodes(), 2);
+
+  auto p_fmat = RandomDataGenerator{64, kCols, 0.0}.GenerateDMatrix();
+  std::unique_ptr<Predictor> predictor{Predictor::Create("cpu_predictor", &ctx)};
+  HostDeviceVector<float> expected;
+  predictor->InitOutPredictions(p_fmat->Info(), &expected, model);
+  predictor->PredictBatch(p_fmat.get(), &expected, model, 0);
+  for (std::size_t k = 0; k < replicas.NumNodes(); ++k) {
+    auto const& replica = replicas.Replica(k);
+    ASSERT_EQ(replica.trees.size(), model.trees.size());
+    ASSERT_NE(replica.trees.front().get(), model.trees.front().get());
+    ASSERT_EQ(replica.tree_info.ConstHostVector(), model.tree_info.ConstHostVector());
+
+    HostDeviceVector<float> predt;
+    predictor->InitOutPredictions(p_fmat->Info(), &predt, replica);
+    predictor->PredictBatch(p_fmat.get(), &predt, replica, 0);
+    ASSERT_EQ(predt.ConstHostVector(), expected.ConstHostVector());
+  }
+}
+
+TEST(NumaModel, Prediction) {
+  bst_idx_t constexpr kRows = 512;
+  bst_feature_t constexpr kCols = 16;
+  auto p_train = RandomDataGenerator{kRows, kCols, 0.2}.GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  for (std::int32_t iter = 0; iter < 4; ++iter) {
+    learner->UpdateOneIter(iter, p_train);
+  }
+  auto p_test = RandomDataGenerator{kRows, kCols, 0.2}.Seed(3).GenerateDMatrix();
+  HostDeviceVector<float> expected;
+  learner->Predict(p_test, true, &expected, 0, 0);
+
+  // Same as the default traversal, falls back to it on single node machines.
+  learner->Configure(Args{{"predictor", "numa"}});
+  p_test = RandomDataGenerator{kRows, kCols, 0.2}.Seed(3).GenerateDMatrix();
+  HostDeviceVector<float> predt;
+  learner->Predict(p_test, true, &predt, 0, 0);
+  ASSERT_EQ(predt.ConstHostVector(), expected.ConstHostVector());
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>  // for Learner
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t
+#include <limits>   // for numeric_limits
+#include <memory>   // for unique_ptr, shared_ptr
+#include <string>   // for string, to_string
+#include <vector>   // for vector
+
+#include "../../../src/data/proxy_dmatrix.h"           // for DMatrixProxy
+#include "../../../src/predictor/prediction_session.h"  // for PredictionSession
+#include "../helpers.h"                                 // for RandomDataGenerator
+
+namespace xgboost::predictor {
+namespace {
+void TestPredictionSession(std::string const& objective, std::size_t n_classes, float sparsity) {
+  bst_idx_t constexpr kRows = 128;
+  bst_feature_t constexpr kCols = 16;
+  auto p_train = RandomDataGenerator{kRows, kCols, sparsity}.Classes(n_classes).GenerateDMatrix(
+      true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  Args args{{"objective", objective}, {"max_depth", "4"}};
+  if (n_classes > 2) {
+    args.emplace_back("num_class", std::to_string(n_classes));
+  }
+  learner->Configure(args);
+  for (std::int32_t i = 0; i < 4; ++i) {
+    learner->UpdateOneIter(i, p_train);
+  }
+
+  HostDeviceVector<float> data;
+  RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDense(&data);
+  auto array_interface = GetArrayInterface(&data, kRows, kCols);
+  std::string arr_str;
+  Json::Dump(array_interface, &arr_str);
+  auto const& h_data = data.ConstHostVector();
+
+  auto constexpr kMissing = std::numeric_limits<float>::quiet_NaN();
+  for (auto type : {PredictionType::kMargin, PredictionType::kValue}) {
+    for (bst_layer_t layer_end : {0, 2}) {
+      std::shared_ptr<data::DMatrixProxy> proxy{new data::DMatrixProxy{}};
+      proxy->SetArray(arr_str.data());
+      HostDeviceVector<float>* p_expected{nullptr};
+      learner->InplacePredict(proxy, type, kMissing, &p_expected, 0, layer_end);
+      auto const& h_expected = p_expected->ConstHostVector();
+
+      std::unique_ptr<PredictionSession> session{
+          learner->CreatePredictionSession(type, kMissing, 0, layer_end)};
+      ASSERT_EQ(session->NumFeatures(), kCols);
+      ASSERT_EQ(session->NumOutputs() * kRows, h_expected.size());
+      std::vector<float> out(session->NumOutputs());
+      for (std::size_t i = 0; i < kRows; ++i) {
+        session->PredictRow(h_data.data() + i * kCols, out.data());
+        for (std::size_t j = 0; j < out.size(); ++j) {
+          ASSERT_NEAR(out[j], h_expected[i * out.size() + j], kRtEps);
+        }
+      }
+    }
+  }
+
+  // Prediction types other than margin and value are not supported.
+  ASSERT_THROW(
+      { learner->CreatePredictionSession(PredictionType::kContribution, kMissing, 0, 0); },
+      dmlc::Error);
+}
+}  // namespace
+
+TEST(PredictionSession, Regression) {
+  TestPredictionSession("reg:squarederror", 1, 0.0f);
+  TestPredictionSession("binary:logistic", 2, 0.4f);
+}
+
+TEST(PredictionSession, Multiclass) {
+  TestPredictionSession("multi:softprob", 3, 0.2f);
+  TestPredictionSession("multi:softmax", 3, 0.2f);
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,191 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>    // for Learner
+#include <xgboost/predictor.h>  // for Predictor
+
+#include <algorithm>  // for copy, clamp
+#include <cmath>      // for floor
+#include <cstdint>    // for uint8_t
+#include <limits>     // for numeric_limits
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include "../../../src/data/proxy_dmatrix.h"         // for DMatrixProxy
+#include "../../../src/gbm/gbtree_model.h"            // for GBTreeModel
+#include "../../../src/predictor/forest_cache.h"      // for ForestLayoutCache
+#include "../../../src/predictor/quantized_forest.h"  // for QuantizedForest
+#include "../../../src/tree/tree_view.h"              // for ScalarTreeView
+#include "../helpers.h"                               // for RandomDataGenerator, MakeMP
+#include "test_predictor.h"                           // for CreateTestModel
+
+namespace xgboost::predictor {
+namespace {
+std::vector<float> PredictRows(QuantizedForest const& forest, bst_feature_t n_features,
+                               std::vector<std::vector<float>> const& rows) {
+  std::vector<RegTree::FVec> feats(rows.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    feats[i].Init(n_features);
+    std::copy(rows[i].cbegin(), rows[i].cend(), feats[i].Data().begin());
+  }
+  std::vector<std::uint8_t> bins(forest.RowBytes() * rows.size());
+  forest.BinRows(common::Span<RegTree::FVec const>{feats}, common::Span{bins});
+  Context ctx;
+  auto out = linalg::Zeros<float>(&ctx, rows.size(), 1);
+  forest.Predict(common::Span<std::uint8_t const>{bins}, out.HostView());
+  auto const& h_out = out.Data()->ConstHostVector();
+  return {h_out.cbegin(), h_out.cend()};
+}
+}  // namespace
+
+TEST(QuantizedForest, Forest) {
+  auto constexpr kNaN = std::numeric_limits<float>::quiet_NaN();
+  RegTree tree{1, 2};
+  tree.ExpandNode(RegTree::kRoot, 0, 0.0f, false, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  tree.ExpandNode(2, 1, 1.0f, true, 0.0f, 2.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  RegTree other{1, 2};
+  other.ExpandNode(RegTree::kRoot, 0, 0.0f, true, 0.0f, 4.0f, 5.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+
+  std::vector<tree::ScalarTreeView> trees{tree::ScalarTreeView{&tree},
+                                          tree::ScalarTreeView{&other}};
+  ASSERT_TRUE(QuantizedForest::IsSupported(trees[0]));
+  std::vector<bst_target_t> groups{0, 0};
+  std::vector<float> weights{1.0f, 2.0f};
+  auto forest = QuantizedForest::Create(common::Span{trees}, common::Span{groups}, 2,
+                                        common::OptionalWeights{common::Span{weights}});
+  ASSERT_TRUE(forest);
+  ASSERT_EQ(forest->NumTrees(), 2);
+  ASSERT_EQ(forest->NumNodes(), 8);
+  ASSERT_EQ(forest->BinBytes(), 1);
+  // Duplicated thresholds are merged.
+  ASSERT_EQ(forest->Cuts(0).size(), 1);
+  ASSERT_EQ(forest->Cuts(1).size(), 1);
+
+  std::vector<std::vector<float>> rows{
+      {-1.0f, 0.0f}, {0.0f, 0.0f}, {1.0f, 1.0f}, {kNaN, kNaN}, {0.0f, kNaN}};
+  std::vector<float> expected{-1.0f + 8.0f, 2.0f + 10.0f, 3.0f + 10.0f, 2.0f + 8.0f,
+                              2.0f + 10.0f};
+  ASSERT_EQ(PredictRows(*forest, 2, rows), expected);
+}
+
+TEST(QuantizedForest, WideBins) {
+  // A chain with more thresholds than an 8-bit bin can hold.
+  bst_node_t constexpr kSplits = 300;
+  RegTree tree{1, 1};
+  bst_node_t nidx = RegTree::kRoot;
+  for (bst_node_t i = 0; i < kSplits; ++i) {
+    tree.ExpandNode(nidx, 0, static_cast<float>(i), true, 0.0f, static_cast<float>(i),
+                    static_cast<float>(kSplits), 0.0f, 0.0f, 0.0f, 0.0f);
+    nidx = tree.RightChild(nidx);
+  }
+  std::vector<tree::ScalarTreeView> trees{tree::ScalarTreeView{&tree}};
+  std::vector<bst_target_t> groups{0};
+  auto forest = QuantizedForest::Create(common::Span{trees}, common::Span{groups}, 1,
+                                        common::OptionalWeights{1.0f});
+  ASSERT_TRUE(forest);
+  ASSERT_EQ(forest->BinBytes(), 2);
+
+  std::vector<std::vector<float>> rows;
+  std::vector<float> expected;
+  for (float v : {-3.0f, 0.0f, 0.5f, 128.0f, 254.5f, 255.0f, 299.0f, 1000.0f}) {
+    rows.push_back({v});
+    expected.push_back(std::clamp(std::floor(v) + 1.0f, 0.0f, static_cast<float>(kSplits)));
+  }
+  rows.push_back({std::numeric_limits<float>::quiet_NaN()});
+  expected.push_back(0.0f);
+  ASSERT_EQ(PredictRows(*forest, 1, rows), expected);
+}
+
+namespace {
+void TestQuantizedPrediction(std::size_t n_classes, float sparsity) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 16;
+  auto p_train = RandomDataGenerator{kRows, kCols, sparsity}.Classes(n_classes).GenerateDMatrix(
+      true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  Args args{{"max_depth", "6"}};
+  if (n_classes > 1) {
+    args.emplace_back("objective", "multi:softprob");
+    args.emplace_back("num_class", std::to_string(n_classes));
+  }
+  learner->Configure(args);
+  for (std::int32_t i = 0; i < 8; ++i) {
+    learner->UpdateOneIter(i, p_train);
+  }
+
+  // Use new DMatrix objects to avoid the prediction cache.
+  auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDMatrix();
+  HostDeviceVector<float> expected;
+  learner->Predict(p_test, true, &expected, 0, 0);
+
+  learner->Configure({{"predictor", "quantized"}});
+  p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDMatrix();
+  HostDeviceVector<float> predt;
+  learner->Predict(p_test, true, &predt, 0, 0);
+  ASSERT_EQ(predt.ConstHostVector(), expected.ConstHostVector());
+
+  // Inplace prediction.
+  HostDeviceVector<float> data;
+  RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDense(&data);
+  std::shared_ptr<data::DMatrixProxy> proxy{new data::DMatrixProxy{}};
+  auto array_interface = GetArrayInterface(&data, kRows, kCols);
+  std::string arr_str;
+  Json::Dump(array_interface, &arr_str);
+  proxy->SetArray(arr_str.data());
+  HostDeviceVector<float>* p_inplace{nullptr};
+  learner->InplacePredict(proxy, PredictionType::kMargin, std::numeric_limits<float>::quiet_NaN(),
+                          &p_inplace, 0, 0);
+  ASSERT_EQ(p_inplace->ConstHostVector(), expected.ConstHostVector());
+}
+}  // namespace
+
+TEST(QuantizedForest, LayoutCache) {
+  Context ctx;
+  bst_feature_t constexpr kCols = 4;
+  auto mparam = MakeMP(kCols, .5, 1);
+  auto p_model = CreateTestModel(&mparam, &ctx);
+  auto& model = *p_model;
+  auto p_fmat = RandomDataGenerator{64, kCols, 0.0}.GenerateDMatrix();
+  std::unique_ptr<Predictor> predictor{Predictor::Create("cpu_quantized_predictor", &ctx)};
+
+  auto predict = [&](std::vector<float> const* weights) {
+    HostDeviceVector<float> predt;
+    predictor->InitOutPredictions(p_fmat->Info(), &predt, model);
+    predictor->PredictBatch(p_fmat.get(), &predt, model, 0, 0, weights);
+    return predt.ConstHostVector();
+  };
+  auto first = predict(nullptr);
+  auto const* forest = model.LayoutCache()->quantized.forest.get();
+  ASSERT_TRUE(forest);
+  ASSERT_EQ(predict(nullptr), first);
+  ASSERT_EQ(model.LayoutCache()->quantized.forest.get(), forest);
+
+  // Rebuilt for different tree weights.
+  std::vector<float> weights{2.0f};
+  auto weighted = predict(&weights);
+  ASSERT_NE(model.LayoutCache()->quantized.forest.get(), forest);
+  for (std::size_t i = 0; i < first.size(); ++i) {
+    // The leaf value of the test model is 1.5.
+    ASSERT_EQ(weighted[i] - first[i], 1.5f);
+  }
+
+  // Dropped when the model changes.
+  std::vector<std::unique_ptr<RegTree>> trees;
+  trees.emplace_back(std::make_unique<RegTree>());
+  (*trees.back())[RegTree::kRoot].SetLeaf(1.0f);
+  model.CommitModelGroup(std::move(trees), 0);
+  ASSERT_FALSE(model.LayoutCache());
+  auto second = predict(nullptr);
+  for (std::size_t i = 0; i < first.size(); ++i) {
+    ASSERT_EQ(second[i], first[i] + 1.0f);
+  }
+}
+
+TEST(QuantizedForest, Prediction) {
+  TestQuantizedPrediction(1, 0.0f);
+  TestQuantizedPrediction(1, 0.5f);
+  TestQuantizedPrediction(3, 0.2f);
+}
+}  // namespace xgboost::predictor
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>    // for Learner
+#include <xgboost/predictor.h>  // for Predictor
+
+#include <algorithm>  // for copy
+#include <limits>     // for numeric_limits
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include "../../../src/data/proxy_dmatrix.h"     // for DMatrixProxy
+#include "../../../src/gbm/gbtree_model.h"        // for GBTreeModel
+#include "../../../src/predictor/forest_cache.h"  // for ForestLayoutCache
+#include "../../../src/predictor/quick_scorer.h"  // for QuickScorerForest
+#include "../../../src/tree/tree_view.h"          // for ScalarTreeView
+#include "../helpers.h"                           // for RandomDataGenerator, MakeMP
+#include "test_predictor.h"                       // for CreateTestModel
+
+namespace xgboost::predictor {
+TEST(QuickScorer, Forest) {
+  auto constexpr kNaN = std::numeric_limits<float>::quiet_NaN();
+  RegTree tree{1, 2};
+  tree.ExpandNode(RegTree::kRoot, 0, 0.0f, false, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  tree.ExpandNode(2, 1, 1.0f, true, 0.0f, 2.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  RegTree stump{1, 2};
+  stump[RegTree::kRoot].SetLeaf(0.5f);
+
+  std::vector<tree::ScalarTreeView> trees{tree::ScalarTreeView{&tree},
+                                          tree::ScalarTreeView{&stump}};
+  ASSERT_TRUE(QuickScorerForest::IsSupported(trees[0]));
+  ASSERT_TRUE(QuickScorerForest::IsSupported(trees[1]));
+  std::vector<bst_target_t> groups{0, 0};
+  std::vector<float> weights{1.0f, 2.0f};
+  QuickScorerForest forest{common::Span{trees}, common::Span{groups}, 2,
+                           common::OptionalWeights{common::Span{weights}}};
+  ASSERT_EQ(forest.NumTrees(), 2);
+  ASSERT_EQ(forest.NumWords(), 1);
+  ASSERT_EQ(forest.NumSplits(), 2);
+
+  std::vector<std::vector<float>> rows{
+      {-1.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 5.0f}, {kNaN, kNaN}, {0.0f, 1.0f}};
+  std::vector<float> expected{-1.0f, 2.0f, 3.0f, 2.0f, 3.0f};
+  std::vector<QuickScorerForest::WordT> workspace(forest.WorkspaceSize());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    RegTree::FVec feats;
+    feats.Init(2);
+    std::copy(rows[i].cbegin(), rows[i].cend(), feats.Data().begin());
+    linalg::Vector<float> out{{0.0f}, {1}, DeviceOrd::CPU()};
+    forest.PredictRow(feats, common::Span{workspace}, out.HostView());
+    ASSERT_EQ(out.HostView()(0), expected[i] + 1.0f);
+  }
+}
+
+TEST(QuickScorer, TooManyLeaves) {
+  RegTree tree{1, 1};
+  // Grow a chain with more leaves than the bitvector can hold.
+  bst_node_t nidx = RegTree::kRoot;
+  for (std::int32_t i = 0; i < QuickScorerForest::kMaxWords * QuickScorerForest::kBitsPerWord;
+       ++i) {
+    tree.ExpandNode(nidx, 0, static_cast<float>(i), true, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                    0.0f);
+    nidx = tree.RightChild(nidx);
+  }
+  ASSERT_FALSE(QuickScorerForest::IsSupported(tree::ScalarTreeView{&tree}));
+}
+
+namespace {
+void TestQuickScorerPrediction(std::size_t n_classes, float sparsity) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 16;
+  auto p_train = RandomDataGenerator{kRows, kCols, sparsity}.Classes(n_classes).GenerateDMatrix(
+      true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_train})};
+  Args args{{"max_depth", "4"}};
+  if (n_classes > 1) {
+    args.emplace_back("objective", "multi:softprob");
+    args.emplace_back("num_class", std::to_string(n_classes));
+  }
+  learner->Configure(args);
+  for (std::int32_t i = 0; i < 8; ++i) {
+    learner->UpdateOneIter(i, p_train);
+  }
+
+  // Use new DMatrix objects to avoid the prediction cache.
+  auto p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDMatrix();
+  HostDeviceVector<float> expected;
+  learner->Predict(p_test, true, &expected, 0, 0);
+
+  learner->Configure({{"predictor", "quickscorer"}});
+  p_test = RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDMatrix();
+  HostDeviceVector<float> predt;
+  learner->Predict(p_test, true, &predt, 0, 0);
+  ASSERT_EQ(predt.ConstHostVector(), expected.ConstHostVector());
+
+  // Inplace prediction.
+  HostDeviceVector<float> data;
+  RandomDataGenerator{kRows, kCols, sparsity}.Seed(1).GenerateDense(&data);
+  std::shared_ptr<data::DMatrixProxy> proxy{new data::DMatrixProxy{}};
+  auto array_interface = GetArrayInterface(&data, kRows, kCols);
+  std::string arr_str;
+  Json::Dump(array_interface, &arr_str);
+  proxy->SetArray(arr_str.data());
+  HostDeviceVector<float>* p_inplace{nullptr};
+  learner->InplacePredict(proxy, PredictionType::kMargin, std::numeric_limits<float>::quiet_NaN(),
+                          &p_inplace, 0, 0);
+  ASSERT_EQ(p_inplace->ConstHostVector(), expected.ConstHostVector());
+}
+}  // namespace
+
+TEST(QuickScorer, LayoutCache) {
+  Context ctx;
+  bst_feature_t constexpr kCols = 4;
+  auto mparam = MakeMP(kCols, .5, 1);
+  auto p_model = CreateTestModel(&mparam, &ctx);
+  auto& model = *p_model;
+  auto p_fmat = RandomDataGenerator{64, kCols, 0.0}.GenerateDMatrix();
+  std::unique_ptr<Predictor> predictor{Predictor::Create("cpu_quickscorer_predictor", &ctx)};
+
+  auto predict = [&](bst_tree_t tree_end) {
+    HostDeviceVector<float> predt;
+    predictor->InitOutPredictions(p_fmat->Info(), &predt, model);
+    predictor->PredictBatch(p_fmat.get(), &predt, model, 0, tree_end);
+    return predt.ConstHostVector();
+  };
+  auto first = predict(0);
+  ASSERT_TRUE(model.LayoutCache());
+  auto const* forest = model.LayoutCache()->quick_scorer.forest.get();
+  ASSERT_TRUE(forest);
+  // Reused between calls.
+  ASSERT_EQ(predict(0), first);
+  ASSERT_EQ(model.LayoutCache()->quick_scorer.forest.get(), forest);
+
+  // Dropped when the model changes.
+  std::vector<std::unique_ptr<RegTree>> trees;
+  trees.emplace_back(std::make_unique<RegTree>());
+  trees.back()->ExpandNode(RegTree::kRoot, 0, 0.0f, false, 0.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f,
+                           0.0f);
+  model.CommitModelGroup(std::move(trees), 0);
+  ASSERT_FALSE(model.LayoutCache());
+  auto second = predict(0);
+  ASSERT_NE(second, first);
+  ASSERT_EQ(model.LayoutCache()->quick_scorer.forest->NumTrees(), 2);
+  // Rebuilt for a different range of trees.
+  ASSERT_EQ(predict(1), first);
+  ASSERT_EQ(model.LayoutCache()->quick_scorer.forest->NumTrees(), 1);
+}
+
+TEST(QuickScorer, Prediction) {
+  TestQuickScorerPrediction(1, 0.0f);
+  TestQuickScorerPrediction(1, 0.5f);
+  TestQuickScorerPrediction(3, 0.2f);
+}
+}  // namespace xgboost::predictor
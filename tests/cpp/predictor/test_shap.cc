@@ -3,6 +3,7 @@
  */
 #include "test_shap.h"
 
+#include <dmlc/io.h>  // for Stream
 #include <gtest/gtest.h>
 #include <xgboost/base.h>
 #include <xgboost/data.h>                // for DMatrix
@@ -14,6 +15,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>  // for int32_t
+#include <functional>  // for greater
 #include <memory>  // for unique_ptr
 #include <sstream>
 #include <string>   // for to_string
@@ -21,9 +24,12 @@
 #include <vector>
 
 #include "../../../src/common/param_array.h"
+#include "../../../src/common/simd.h"  // for SimdIsa, DetectSimdIsa
 #include "../../../src/gbm/gbtree_model.h"
+#include "../../../src/predictor/contribution_sink.h"  // for MemoryContributionSink
 #include "../../../src/predictor/interpretability/shap.h"
 #include "../../../src/tree/tree_view.h"
+#include "../filesystem.h"  // for TemporaryDirectory
 #include "../helpers.h"
 
 namespace xgboost {
@@ -381,6 +387,38 @@ TEST(Predictor, ShapHandlesDeepTree) {
   CheckShapHandlesDeepTree(&ctx);
 }
 
+TEST(Predictor, LinearTreeShap) {
+  bst_idx_t constexpr kRows = 53;
+  bst_feature_t constexpr kCols = 7;
+  bst_target_t constexpr kClasses = 3;
+  auto dmat = RandomDataGenerator(kRows, kCols, 0.3).Classes(kClasses).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({dmat})};
+  learner->Configure(Args{{"max_depth", "6"}, {"objective", "multi:softprob"},
+                          {"num_class", std::to_string(kClasses)}});
+  for (std::int32_t i = 0; i < 4; ++i) {
+    learner->UpdateOneIter(i, dmat);
+  }
+
+  HostDeviceVector<float> margin_predt;
+  learner->Predict(dmat, true, &margin_predt, 0, 0, false, false, false, false, false);
+  HostDeviceVector<float> expected;
+  learner->Predict(dmat, false, &expected, 0, 0, false, false, true, false, false);
+
+  learner->Configure(Args{{"shap_algorithm", "linear"}});
+  HostDeviceVector<float> contribs;
+  learner->Predict(dmat, false, &contribs, 0, 0, false, false, true, false, false);
+  CheckShapAdditivity(kRows, kCols, contribs, margin_predt);
+
+  auto const& h_expected = expected.ConstHostVector();
+  auto const& h_contribs = contribs.ConstHostVector();
+  ASSERT_EQ(h_contribs.size(), h_expected.size());
+  for (std::size_t i = 0; i < h_contribs.size(); ++i) {
+    ASSERT_NEAR(h_contribs[i], h_expected[i], 1e-4);
+  }
+
+  ASSERT_THROW({ learner->Configure(Args{{"shap_algorithm", "foo"}}); }, dmlc::Error);
+}
+
 void CheckShapHandlesZeroCover(Context const* ctx, bool zero_parent_cover) {
   std::size_t shape[1]{1};
   linalg::Vector<float> base_score{shape, ctx->Device()};
@@ -522,4 +560,237 @@ TEST(Predictor, ShapIterationRange) {
   }
 }
 
+TEST(Predictor, ShapModelCache) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 8;
+  auto dmat = RandomDataGenerator(kRows, kCols, 0).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({dmat})};
+  learner->Configure(Args{{"max_depth", "4"}});
+
+  auto check_sum = [&](std::vector<float>* out) {
+    HostDeviceVector<float> margin;
+    learner->Predict(dmat, true, &margin, 0, 0, false, false, false, false, false);
+    HostDeviceVector<float> contribs;
+    learner->Predict(dmat, false, &contribs, 0, 0, false, false, true, false, false);
+    auto const& h_margin = margin.ConstHostVector();
+    auto const& h_contribs = contribs.ConstHostVector();
+    ASSERT_EQ(h_contribs.size(), kRows * (kCols + 1));
+    for (bst_idx_t i = 0; i < kRows; ++i) {
+      double sum = 0.0;
+      for (bst_feature_t j = 0; j <= kCols; ++j) {
+        sum += h_contribs[i * (kCols + 1) + j];
+      }
+      ASSERT_NEAR(sum, h_margin[i], 1e-3);
+    }
+    *out = h_contribs;
+  };
+
+  for (std::int32_t i = 0; i < 2; ++i) {
+    learner->UpdateOneIter(i, dmat);
+  }
+  std::vector<float> first, cached;
+  check_sum(&first);
+  // Cached model data.
+  check_sum(&cached);
+  ASSERT_EQ(cached, first);
+  // The cache is dropped once new trees are committed.
+  for (std::int32_t i = 2; i < 4; ++i) {
+    learner->UpdateOneIter(i, dmat);
+  }
+  std::vector<float> second;
+  check_sum(&second);
+  ASSERT_NE(second, first);
+
+  // Different iteration ranges are cached separately.
+  bool bound = false;
+  std::unique_ptr<Learner> sliced{learner->Slice(0, 2, 1, &bound)};
+  HostDeviceVector<float> out_sliced;
+  HostDeviceVector<float> out_ranged;
+  sliced->Predict(dmat, false, &out_sliced, 0, 0, false, false, true, false, false);
+  for (std::int32_t i = 0; i < 2; ++i) {
+    learner->Predict(dmat, false, &out_ranged, 0, 2, false, false, true, false, false);
+    ASSERT_EQ(out_sliced.ConstHostVector(), out_ranged.ConstHostVector());
+  }
+  check_sum(&cached);
+  ASSERT_EQ(cached, second);
+}
+
+TEST(Predictor, ShapBlockKernel) {
+  // The row count is not a multiple of the row block.
+  bst_idx_t constexpr kRows = 67;
+  bst_feature_t constexpr kCols = 6;
+  bst_target_t constexpr kClasses = 3;
+  auto dmat = RandomDataGenerator(kRows, kCols, 0.3).Classes(kClasses).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({dmat})};
+  learner->Configure(Args{{"max_depth", "5"}, {"objective", "multi:softprob"},
+                          {"num_class", std::to_string(kClasses)}});
+  for (std::int32_t i = 0; i < 4; ++i) {
+    learner->UpdateOneIter(i, dmat);
+  }
+
+  HostDeviceVector<float> contribs;
+  learner->Predict(dmat, false, &contribs, 0, 0, false, false, true, false, false);
+  // The interaction values are computed one row at a time, their row sums are the SHAP values.
+  HostDeviceVector<float> interactions;
+  learner->Predict(dmat, false, &interactions, 0, 0, false, false, false, false, true);
+
+  auto const& h_contribs = contribs.ConstHostVector();
+  auto const& h_interactions = interactions.ConstHostVector();
+  std::size_t constexpr kColumns = kCols + 1;
+  ASSERT_EQ(h_contribs.size(), kRows * kClasses * kColumns);
+  ASSERT_EQ(h_interactions.size(), h_contribs.size() * kColumns);
+  for (std::size_t i = 0; i < h_contribs.size(); ++i) {
+    double sum = 0.0;
+    for (std::size_t j = 0; j < kColumns; ++j) {
+      sum += h_interactions[i * kColumns + j];
+    }
+    ASSERT_NEAR(sum, h_contribs[i], 1e-3);
+  }
+}
+
+class ShapIsaTest : public ::testing::TestWithParam<common::SimdIsa> {};
+
+TEST_P(ShapIsaTest, BlockKernel) {
+  auto isa = GetParam();
+  if (isa > common::DetectSimdIsa()) {
+    GTEST_SKIP() << "The instruction set is not supported by the CPU.";
+  }
+  // The row count is not a multiple of the row block.
+  bst_idx_t constexpr kRows = 67;
+  bst_feature_t constexpr kCols = 6;
+  auto dmat = RandomDataGenerator(kRows, kCols, 0.3).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({dmat})};
+  learner->Configure(Args{{"max_depth", "5"}});
+  for (std::int32_t i = 0; i < 4; ++i) {
+    learner->UpdateOneIter(i, dmat);
+  }
+  Json j_model{Object{}};
+  learner->SaveModel(&j_model);
+
+  Context ctx;
+  LearnerModelState mparam{MakeMP(kCols, .5, 1)};
+  gbm::GBTreeModel model{&mparam, &ctx};
+  model.LoadModel(j_model["learner"]["gradient_booster"]["model"]);
+
+  HostDeviceVector<float> expected;
+  interpretability::cpu_impl::ShapValues(&ctx, dmat.get(), &expected, model, 0, nullptr, 0, 0,
+                                         common::SimdIsa::kScalar);
+  HostDeviceVector<float> contribs;
+  interpretability::cpu_impl::ShapValues(&ctx, dmat.get(), &contribs, model, 0, nullptr, 0, 0,
+                                         isa);
+  ASSERT_EQ(contribs.Size(), kRows * (kCols + 1));
+  // Both kernels use the same operations in the same order, the result is identical.
+  ASSERT_EQ(contribs.ConstHostVector(), expected.ConstHostVector());
+}
+
+INSTANTIATE_TEST_SUITE_P(Predictor, ShapIsaTest,
+                         ::testing::Values(common::SimdIsa::kScalar, common::SimdIsa::kAvx2));
+
+TEST(Predictor, ShapTopK) {
+  bst_idx_t constexpr kRows = 37;
+  bst_feature_t constexpr kCols = 10;
+  bst_target_t constexpr kClasses = 3;
+  auto dmat = RandomDataGenerator(kRows, kCols, 0.2).Classes(kClasses).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({dmat})};
+  learner->Configure(Args{{"max_depth", "4"}, {"objective", "multi:softprob"},
+                          {"num_class", std::to_string(kClasses)}});
+  for (std::int32_t i = 0; i < 4; ++i) {
+    learner->UpdateOneIter(i, dmat);
+  }
+
+  HostDeviceVector<float> contribs;
+  learner->Predict(dmat, false, &contribs, 0, 0, false, false, true, false, false);
+  auto const& h_contribs = contribs.ConstHostVector();
+  std::size_t constexpr kColumns = kCols + 1;
+
+  for (bst_feature_t top_k : {1u, 3u, kCols, kCols * 2}) {
+    HostDeviceVector<bst_idx_t> indptr;
+    HostDeviceVector<bst_feature_t> indices;
+    HostDeviceVector<float> values;
+    learner->PredictContributionTopK(dmat, top_k, &indptr, &indices, &values, 0, 0);
+    auto const& h_indptr = indptr.ConstHostVector();
+    auto const& h_indices = indices.ConstHostVector();
+    auto const& h_values = values.ConstHostVector();
+    ASSERT_EQ(h_indptr.size(), kRows * kClasses + 1);
+    ASSERT_EQ(h_indices.size(), h_indptr.back());
+    ASSERT_EQ(h_values.size(), h_indptr.back());
+
+    for (std::size_t i = 0; i + 1 < h_indptr.size(); ++i) {
+      auto const* row = h_contribs.data() + i * kColumns;
+      std::vector<float> expected;
+      for (bst_feature_t j = 0; j < kCols; ++j) {
+        if (row[j] != 0.0f) {
+          expected.push_back(std::abs(row[j]));
+        }
+      }
+      std::sort(expected.begin(), expected.end(), std::greater<>{});
+      auto n = std::min<std::size_t>(top_k, expected.size());
+      ASSERT_EQ(h_indptr[i + 1] - h_indptr[i], n);
+      for (std::size_t j = 0; j < n; ++j) {
+        auto pos = h_indptr[i] + j;
+        ASSERT_EQ(h_values[pos], row[h_indices[pos]]);
+        ASSERT_EQ(std::abs(h_values[pos]), expected[j]);
+      }
+    }
+  }
+}
+
+TEST(Predictor, ShapStream) {
+  bst_idx_t constexpr kRows = 45;
+  bst_feature_t constexpr kCols = 5;
+  bst_target_t constexpr kClasses = 2;
+  auto dmat = RandomDataGenerator(kRows, kCols, 0.2).Classes(kClasses).GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({dmat})};
+  learner->Configure(Args{{"max_depth", "4"}, {"objective", "multi:softprob"},
+                          {"num_class", std::to_string(kClasses)}});
+  for (std::int32_t i = 0; i < 3; ++i) {
+    learner->UpdateOneIter(i, dmat);
+  }
+
+  common::TemporaryDirectory tmpdir;
+  for (auto interactions : {false, true}) {
+    HostDeviceVector<float> expected;
+    learner->Predict(dmat, false, &expected, 0, 0, false, false, !interactions, false,
+                     interactions);
+    auto const& h_expected = expected.ConstHostVector();
+
+    for (bst_idx_t block_rows : {0, 1, 5, 16}) {
+      std::vector<float> out(h_expected.size());
+      predictor::MemoryContributionSink sink{common::Span{out}};
+      std::vector<bst_idx_t> progress;
+      sink.SetProgress([&](bst_idx_t n_rows_done, bst_idx_t n_rows) {
+        ASSERT_EQ(n_rows, kRows);
+        progress.push_back(n_rows_done);
+      });
+      learner->PredictContributionStream(dmat, interactions, block_rows, &sink, 0, 0);
+      ASSERT_EQ(sink.Size(), h_expected.size());
+      ASSERT_EQ(out, h_expected);
+      ASSERT_FALSE(progress.empty());
+      ASSERT_EQ(progress.back(), kRows);
+      ASSERT_TRUE(std::is_sorted(progress.cbegin(), progress.cend()));
+      if (block_rows != 0) {
+        // Blocks have exactly `block_rows` rows, except for the last one.
+        ASSERT_EQ(progress.size(), common::DivRoundUp(kRows, block_rows));
+        for (std::size_t i = 0; i < progress.size(); ++i) {
+          ASSERT_EQ(progress[i], std::min<bst_idx_t>((i + 1) * block_rows, kRows));
+        }
+      }
+    }
+
+    auto path = tmpdir.Str() + "/contribs.bin";
+    {
+      predictor::FileContributionSink sink{path};
+      learner->PredictContributionStream(dmat, interactions, 8, &sink, 0, 0);
+    }
+    std::vector<float> out(h_expected.size());
+    std::unique_ptr<dmlc::Stream> fi{dmlc::Stream::Create(path.c_str(), "r")};
+    ASSERT_EQ(fi->Read(out.data(), out.size() * sizeof(float)), out.size() * sizeof(float));
+    ASSERT_EQ(out, h_expected);
+  }
+
+  // Smaller than the output.
+  std::vector<float> out(kRows);
+  predictor::MemoryContributionSink sink{common::Span{out}};
+  ASSERT_THROW({ learner->PredictContributionStream(dmat, false, 0, &sink, 0, 0); }, dmlc::Error);
+}
 }  // namespace xgboost
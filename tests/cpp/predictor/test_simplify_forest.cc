@@ -0,0 +1,110 @@
+/**
+ * Copyright 2026, XGBoost Contributors
+ */
+#include <gtest/gtest.h>
+#include <xgboost/learner.h>  // for Learner
+
+#include <cmath>    // for isnan, abs
+#include <cstdint>  // for int32_t
+#include <limits>   // for numeric_limits
+#include <memory>   // for unique_ptr
+#include <vector>   // for vector
+
+#include "../../../src/predictor/simplify_forest.h"  // for SimplifyTree
+#include "../../../src/tree/tree_view.h"             // for ScalarTreeView
+#include "../helpers.h"                              // for RandomDataGenerator
+
+namespace xgboost::predictor {
+namespace {
+float PredictRow(RegTree const& tree, std::vector<float> const& row) {
+  auto sc_tree = tree.HostScView();
+  bst_node_t nidx = RegTree::kRoot;
+  while (!sc_tree.IsLeaf(nidx)) {
+    auto fvalue = row[sc_tree.SplitIndex(nidx)];
+    if (std::isnan(fvalue)) {
+      nidx = sc_tree.DefaultChild(nidx);
+    } else {
+      nidx = fvalue < sc_tree.SplitCond(nidx) ? sc_tree.LeftChild(nidx)
+                                               : sc_tree.RightChild(nidx);
+    }
+  }
+  return sc_tree.LeafValue(nidx);
+}
+}  // namespace
+
+TEST(SimplifyForest, Tree) {
+  auto constexpr kNaN = std::numeric_limits<float>::quiet_NaN();
+  RegTree tree{1, 2};
+  tree.ExpandNode(RegTree::kRoot, 0, 1.0f, true, 0.0f, 0.0f, 0.0f, 0.0f, 3.0f, 1.0f, 2.0f);
+  // Redundant, all the values reaching the node are less than 1.0, including the missing.
+  tree.ExpandNode(1, 0, 2.0f, true, 0.0f, -1.0f, 5.0f, 0.0f, 1.0f, 1.0f, 0.0f);
+  tree.ExpandNode(2, 1, 0.0f, false, 0.0f, 3.0f, 3.5f, 0.0f, 2.0f, 1.0f, 1.0f);
+  ASSERT_TRUE(CanSimplify(tree));
+
+  std::vector<std::vector<float>> rows{
+      {0.5f, 0.0f}, {1.5f, -1.0f}, {1.5f, 1.0f}, {kNaN, kNaN}, {3.0f, kNaN}};
+
+  SimplifyTreeStats stats;
+  auto exact = SimplifyTree(tree, 2, 0.0f, &stats);
+  ASSERT_EQ(stats.n_redundant, 1);
+  ASSERT_EQ(stats.n_collapsed, 0);
+  ASSERT_EQ(stats.max_change, 0.0);
+  ASSERT_EQ(exact->NumValidNodes(), 5);
+  for (auto const& row : rows) {
+    ASSERT_EQ(PredictRow(*exact, row), PredictRow(tree, row));
+  }
+
+  auto collapsed = SimplifyTree(tree, 2, 0.5f, &stats);
+  ASSERT_EQ(stats.n_redundant, 1);
+  ASSERT_EQ(stats.n_collapsed, 1);
+  ASSERT_EQ(stats.max_change, 0.25);
+  ASSERT_EQ(collapsed->NumValidNodes(), 3);
+  ASSERT_EQ(PredictRow(*collapsed, rows[0]), -1.0f);
+  ASSERT_EQ(PredictRow(*collapsed, rows[1]), 3.25f);
+  ASSERT_EQ(PredictRow(*collapsed, rows[3]), -1.0f);
+
+  // The missing value goes right at the second split, it's not redundant.
+  RegTree missing{1, 2};
+  missing.ExpandNode(RegTree::kRoot, 0, 1.0f, true, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  missing.ExpandNode(1, 0, 2.0f, false, 0.0f, -1.0f, 5.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  auto kept = SimplifyTree(missing, 2, 0.0f, &stats);
+  ASSERT_EQ(stats.n_redundant, 0);
+  ASSERT_EQ(kept->NumValidNodes(), missing.NumValidNodes());
+  ASSERT_EQ(PredictRow(*kept, {kNaN, kNaN}), 5.0f);
+}
+
+TEST(SimplifyForest, Model) {
+  bst_idx_t constexpr kRows = 256;
+  bst_feature_t constexpr kCols = 8;
+  auto p_fmat = RandomDataGenerator{kRows, kCols, 0.2}.GenerateDMatrix(true);
+  std::unique_ptr<Learner> learner{Learner::Create({p_fmat})};
+  learner->Configure(Args{{"max_depth", "6"}});
+  for (std::int32_t iter = 0; iter < 8; ++iter) {
+    learner->UpdateOneIter(iter, p_fmat);
+  }
+  HostDeviceVector<float> expected;
+  learner->Predict(p_fmat, true, &expected, 0, 0);
+
+  // Exact.
+  Json report;
+  learner->Simplify(Json{Object{}}, &report);
+  ASSERT_LE(get<Integer const>(report["n_nodes"]), get<Integer const>(report["n_nodes_before"]));
+  ASSERT_EQ(get<Number const>(report["max_margin_change"]), 0.0f);
+  HostDeviceVector<float> predt;
+  learner->Predict(p_fmat, true, &predt, 0, 0);
+  ASSERT_EQ(predt.ConstHostVector(), expected.ConstHostVector());
+
+  // Bounded by the report.
+  Json config{Object{}};
+  config["tolerance"] = Number{0.05f};
+  config["fold_stumps"] = Boolean{true};
+  learner->Simplify(config, &report);
+  auto max_change = get<Number const>(report["max_margin_change"]);
+  learner->Predict(p_fmat, true, &predt, 0, 0);
+  auto const& h_predt = predt.ConstHostVector();
+  auto const& h_expected = expected.ConstHostVector();
+  for (std::size_t i = 0; i < h_predt.size(); ++i) {
+    ASSERT_LE(std::abs(h_predt[i] - h_expected[i]), max_change + 1e-5);
+  }
+}
+}  // namespace xgboost::predictor
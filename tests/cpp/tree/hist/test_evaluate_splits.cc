@@ -10,20 +10,26 @@
 #include <xgboost/logging.h>     // for CHECK_EQ
 #include <xgboost/tree_model.h>  // for RegTree, RTreeNodeStat
 
-#include <memory>   // for make_shared, shared_ptr, addressof
-#include <numeric>  // for iota
-#include <tuple>    // for make_tuple
-
-#include "../../../../src/common/hist_util.h"           // for HistCollection, HistogramCuts
-#include "../../../../src/common/random.h"              // for ColumnSampler
-#include "../../../../src/common/row_set.h"             // for RowSetCollection
-#include "../../../../src/data/gradient_index.h"        // for GHistIndexMatrix
-#include "../../../../src/tree/hist/evaluate_splits.h"  // for HistEvaluator, TreeEvaluator
-#include "../../../../src/tree/hist/expand_entry.h"     // for CPUExpandEntry
-#include "../../../../src/tree/hist/hist_cache.h"       // for BoundedHistCollection
-#include "../../../../src/tree/hist/hist_param.h"       // for HistMakerTrainParam
-#include "../../../../src/tree/param.h"                 // for GradStats, TrainParam
-#include "../../helpers.h"                              // for RandomDataGenerator, AllThreadsFo...
+#include <algorithm>    // for transform, copy
+#include <cmath>        // for abs
+#include <memory>       // for make_shared, shared_ptr, addressof
+#include <numeric>      // for iota
+#include <tuple>        // for make_tuple
+#include <type_traits>  // for remove_reference_t
+#include <vector>       // for vector
+
+#include "../../../../src/common/hist_util.h"             // for HistCollection, HistogramCuts
+#include "../../../../src/common/random.h"                // for ColumnSampler
+#include "../../../../src/common/row_set.h"               // for RowSetCollection
+#include "../../../../src/data/gradient_index.h"          // for GHistIndexMatrix
+#include "../../../../src/tree/common_row_partitioner.h"  // for CommonRowPartitioner
+#include "../../../../src/tree/hist/evaluate_splits.h"    // for HistEvaluator, TreeEvaluator
+#include "../../../../src/tree/hist/expand_entry.h"       // for CPUExpandEntry
+#include "../../../../src/tree/hist/hist_cache.h"         // for BoundedHistCollection
+#include "../../../../src/tree/hist/hist_param.h"         // for HistMakerTrainParam
+#include "../../../../src/tree/hist/histogram.h"          // for MultiHistogramBuilderImpl
+#include "../../../../src/tree/param.h"                   // for GradStats, TrainParam
+#include "../../helpers.h"                                // for RandomDataGenerator, AllThreadsF...
 
 namespace xgboost::tree {
 void TestPartitionBasedSplit::SetUp() {
@@ -163,6 +169,127 @@ TEST(HistEvaluator, Evaluate) {
   TestEvaluateSplits(true);
 }
 
+namespace {
+// Build the histograms of the root and its children with the histogram builder. The
+// right child is obtained by the subtraction trick.
+template <typename GradientSumT>
+std::vector<std::vector<GradientSumT>> BuildNodeHistForTest(
+    Context const *ctx, DMatrix *p_fmat, HostDeviceVector<GradientPair> const &gpair,
+    BatchParam const &batch, std::vector<std::vector<bst_idx_t>> *p_rows) {
+  bst_bin_t n_total_bins{0};
+  float split_cond{0};
+  for (auto const &page : p_fmat->GetBatches<GHistIndexMatrix>(ctx, batch)) {
+    n_total_bins = page.cut.TotalBins();
+    auto const &ptrs = page.cut.Ptrs();
+    split_cond = page.cut.Values()[(ptrs[1] + ptrs[2]) / 2];
+  }
+
+  HistMakerTrainParam hist_param;
+  RegTree tree;
+  MultiHistogramBuilderImpl<GradientSumT> hist_builder;
+  hist_builder.Reset(ctx, n_total_bins, tree.NumTargets(), batch, false, &hist_param);
+  std::vector<CommonRowPartitioner> partitioners;
+  partitioners.emplace_back(ctx, p_fmat->Info().num_row_, /*base_rowid=*/0);
+  auto h_gpair = linalg::MakeTensorView(ctx, gpair.ConstHostSpan(), gpair.Size(), 1);
+
+  CPUExpandEntry best;
+  hist_builder.BuildRootHist(p_fmat, tree.HostScView(), partitioners, h_gpair, best, batch);
+  // Split on the second feature.
+  best.split.Update(1.0f, 1, split_cond, false, false, GradStats{1.0, 1.0}, GradStats{1.0, 1.0});
+  tree.ExpandNode(best.nid, best.split.SplitIndex(), best.split.split_value, false,
+                  /*base_weight=*/2.0f,
+                  /*left_leaf_weight=*/1.0f, /*right_leaf_weight=*/1.0f, best.GetLossChange(),
+                  /*sum_hess=*/2.0f, best.split.left_sum.GetHess(),
+                  best.split.right_sum.GetHess());
+  std::vector<CPUExpandEntry> valid_candidates{best};
+  for (auto const &page : p_fmat->GetBatches<GHistIndexMatrix>(ctx, batch)) {
+    partitioners.front().UpdatePosition(ctx, page, valid_candidates, tree.HostScView());
+  }
+  hist_builder.BuildHistLeftRight(ctx, p_fmat, tree.HostScView(), partitioners, valid_candidates,
+                                  h_gpair, batch);
+
+  std::vector<std::vector<GradientSumT>> result;
+  p_rows->clear();
+  for (auto nidx : {RegTree::kRoot, tree.LeftChild(RegTree::kRoot),
+                    tree.RightChild(RegTree::kRoot)}) {
+    auto hist = hist_builder.Histogram(0)[nidx];
+    result.emplace_back(hist.cbegin(), hist.cend());
+    auto const &elem = partitioners.front().Partitions()[nidx];
+    p_rows->emplace_back(elem.begin(), elem.end());
+  }
+  return result;
+}
+}  // anonymous namespace
+
+TEST(HistEvaluator, SinglePrecision) {
+  Context ctx;
+  ctx.UpdateAllowUnknown(Args{{"nthread", "4"}});
+  static constexpr bst_idx_t kRows = 1 << 16, kCols = 16;
+  bst_bin_t constexpr kMaxBins = 64;
+
+  TrainParam param;
+  param.UpdateAllowUnknown(Args{});
+  auto dmat = RandomDataGenerator(kRows, kCols, 0.2).Seed(3).GenerateDMatrix();
+  // Large gradients of both signs that mostly cancel out in each bin. The sum is
+  // ill-conditioned for single precision.
+  auto gpair = GenerateRandomGradients(kRows);
+  auto &h_gpair = gpair.HostVector();
+  for (std::size_t i = 0; i < h_gpair.size(); ++i) {
+    auto offset = i % 2 == 0 ? 1e4f : -1e4f;
+    h_gpair[i] = GradientPair{h_gpair[i].GetGrad() + offset, h_gpair[i].GetHess()};
+  }
+
+  // Build both histograms with the histogram builder, including the float accumulation and
+  // the float subtraction.
+  auto batch = BatchParam{kMaxBins, TrainParam::DftSparseThreshold()};
+  std::vector<std::vector<bst_idx_t>> rows;
+  auto f64_hists = BuildNodeHistForTest<GradientPairPrecise>(&ctx, dmat.get(), gpair, batch,
+                                                               &rows);
+  auto f32_hists = BuildNodeHistForTest<GradientPair>(&ctx, dmat.get(), gpair, batch, &rows);
+  ASSERT_EQ(f64_hists.size(), std::size_t{3});
+  ASSERT_EQ(f32_hists.size(), std::size_t{3});
+
+  HistMakerTrainParam hist_param;
+  auto n_cached = hist_param.MaxCachedHistNodes(ctx.Device());
+  auto page = dmat->GetBatches<GHistIndexMatrix>(&ctx, batch).begin().Page();
+  auto const &cut = page->cut;
+  // Evaluate the histogram of a node as the root of a new tree.
+  auto evaluate = [&](auto const &node_hist, GradientPairPrecise node_sum) {
+    using GradientSumT = typename std::remove_reference_t<decltype(node_hist)>::value_type;
+    BoundedHistCollectionImpl<GradientSumT> hist;
+    hist.Reset(cut.TotalBins(), n_cached);
+    hist.AllocateHistograms({0});
+    std::copy(node_hist.cbegin(), node_hist.cend(), hist[0].begin());
+
+    HistEvaluator evaluator{&ctx, &param, dmat->Info(), std::make_shared<common::ColumnSampler>()};
+    evaluator.InitRoot(GradStats{node_sum});
+    std::vector<CPUExpandEntry> entries(1);
+    entries.front().nid = 0;
+    entries.front().depth = 0;
+    evaluator.EvaluateSplits(hist, cut, {}, &entries);
+    return entries.front().split;
+  };
+
+  // The split decision of the single precision histogram should be the same as the double
+  // precision histogram, for the root, the built child and the subtracted child.
+  for (std::size_t k = 0; k < f64_hists.size(); ++k) {
+    GradientPairPrecise node_sum;
+    for (auto ridx : rows[k]) {
+      node_sum += GradientPairPrecise{h_gpair[ridx]};
+    }
+    auto expected = evaluate(f64_hists[k], node_sum);
+    auto result = evaluate(f32_hists[k], node_sum);
+    ASSERT_GT(expected.loss_chg, 0.0f);
+    ASSERT_EQ(expected.SplitIndex(), result.SplitIndex()) << "node: " << k;
+    ASSERT_EQ(expected.split_value, result.split_value) << "node: " << k;
+    ASSERT_EQ(expected.DefaultLeft(), result.DefaultLeft()) << "node: " << k;
+    ASSERT_NEAR(expected.loss_chg, result.loss_chg, std::abs(expected.loss_chg) * 1e-4);
+    ASSERT_NEAR(expected.left_sum.GetHess(), result.left_sum.GetHess(), 1e-2);
+    ASSERT_NEAR(expected.right_sum.GetGrad(), result.right_sum.GetGrad(),
+                std::abs(expected.right_sum.GetGrad()) * 1e-4 + 1e-1);
+  }
+}
+
 TEST(HistMultiEvaluator, Evaluate) {
   Context ctx;
   ctx.nthread = 1;
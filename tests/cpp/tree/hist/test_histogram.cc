@@ -11,7 +11,7 @@
 #include <xgboost/span.h>                // for Span, operator!=
 #include <xgboost/tree_model.h>          // for RegTree
 
-#include <algorithm>  // for max
+#include <algorithm>  // for max, equal
 #include <cstddef>    // for size_t
 #include <cstdint>    // for int32_t, uint32_t
 #include <iterator>   // for back_inserter
@@ -31,6 +31,7 @@
 #include "../../../../src/tree/hist/hist_cache.h"         // for BoundedHistCollection
 #include "../../../../src/tree/hist/hist_param.h"         // for HistMakerTrainParam
 #include "../../../../src/tree/hist/histogram.h"          // for HistogramBuilder
+#include "../../../../src/tree/hist/quantiser.h"          // for HistQuantiser
 #include "../../../../src/tree/tree_view.h"               // for ScalarTreeView
 #include "../../categorical_helpers.h"                    // for OneHotEncodeFeature
 #include "../../collective/test_worker.h"                 // for TestDistributedGlobal
@@ -585,4 +586,211 @@ auto MakeParamsForTest() { return std::vector<bool>{true, false}; }
 TEST_P(OverflowTest, Overflow) { this->RunTest(); }
 
 INSTANTIATE_TEST_SUITE_P(CPUHistogram, OverflowTest, ::testing::ValuesIn(MakeParamsForTest()));
+
+namespace {
+// Build histograms for the root and its children, returned in the order of root, left
+// and right.
+template <typename GradientSumT = GradientPairPrecise>
+std::vector<GradientPairPrecise> BuildTreeHistForTest(Context const *ctx, DMatrix *p_fmat,
+                                                      HostDeviceVector<GradientPair> const &gpair,
+                                                      HistMakerTrainParam const &hist_param,
+                                                      bool is_distributed = false) {
+  bst_bin_t constexpr kBins = 256;
+  auto batch = BatchParam{kBins, TrainParam::DftSparseThreshold()};
+  bst_bin_t n_total_bins{0};
+  float split_cond{0};
+  for (auto const &page : p_fmat->GetBatches<GHistIndexMatrix>(ctx, batch)) {
+    n_total_bins = page.cut.TotalBins();
+    // use a cut point in the second column for split
+    split_cond = page.cut.Values()[kBins + kBins / 2];
+  }
+
+  RegTree tree;
+  MultiHistogramBuilderImpl<GradientSumT> hist_builder;
+  hist_builder.Reset(ctx, n_total_bins, tree.NumTargets(), batch, is_distributed, &hist_param);
+  std::vector<CommonRowPartitioner> partitioners;
+  partitioners.emplace_back(ctx, p_fmat->Info().num_row_, /*base_rowid=*/0);
+  auto h_gpair = linalg::MakeTensorView(ctx, gpair.ConstHostSpan(), gpair.Size(), 1);
+
+  CPUExpandEntry best;
+  hist_builder.BuildRootHist(p_fmat, tree.HostScView(), partitioners, h_gpair, best, batch);
+  std::vector<GradientPairPrecise> result;
+  auto append = [&](bst_node_t nidx) {
+    auto hist = hist_builder.Histogram(0)[nidx];
+    std::transform(hist.cbegin(), hist.cend(), std::back_inserter(result),
+                   [](GradientSumT const &g) { return GradientPairPrecise{g}; });
+  };
+  append(best.nid);
+
+  best.split.Update(1.0f, 1, split_cond, false, false, GradStats{1.0, 1.0}, GradStats{1.0, 1.0});
+  tree.ExpandNode(best.nid, best.split.SplitIndex(), best.split.split_value, false,
+                  /*base_weight=*/2.0f,
+                  /*left_leaf_weight=*/1.0f, /*right_leaf_weight=*/1.0f, best.GetLossChange(),
+                  /*sum_hess=*/2.0f, best.split.left_sum.GetHess(),
+                  best.split.right_sum.GetHess());
+  std::vector<CPUExpandEntry> valid_candidates{best};
+  for (auto const &page : p_fmat->GetBatches<GHistIndexMatrix>(ctx, batch)) {
+    partitioners.front().UpdatePosition(ctx, page, valid_candidates, tree.HostScView());
+  }
+  hist_builder.BuildHistLeftRight(ctx, p_fmat, tree.HostScView(), partitioners, valid_candidates,
+                                  h_gpair, batch);
+  for (auto nidx : {tree.LeftChild(best.nid), tree.RightChild(best.nid)}) {
+    append(nidx);
+  }
+  return result;
+}
+}  // anonymous namespace
+
+TEST(CPUHistogram, Quantised) {
+  bst_bin_t constexpr kBins = 256;
+  bst_idx_t constexpr kRows = 8192;
+  auto Xy = RandomDataGenerator{kRows, 16, 0.5}.Bins(kBins).GenerateQuantileDMatrix(true);
+  auto gpair = GenerateRandomGradients(kRows, -1.0f, 1.0f);
+
+  Context ctx;
+  ctx.UpdateAllowUnknown(Args{{"nthread", "4"}});
+  HistMakerTrainParam fp_param;
+  HistMakerTrainParam q_param;
+  q_param.Init(Args{{"quantised_hist", "true"}});
+
+  auto expected = BuildTreeHistForTest(&ctx, Xy.get(), gpair, fp_param);
+  auto result = BuildTreeHistForTest(&ctx, Xy.get(), gpair, q_param);
+  ASSERT_EQ(expected.size(), result.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_NEAR(expected[i].GetGrad(), result[i].GetGrad(), 1e-2);
+    ASSERT_NEAR(expected[i].GetHess(), result[i].GetHess(), 1e-2);
+  }
+
+  // The integer sum doesn't depend on the number of threads.
+  Context single;
+  single.UpdateAllowUnknown(Args{{"nthread", "1"}});
+  ASSERT_EQ(BuildTreeHistForTest(&single, Xy.get(), gpair, q_param), result);
+
+  // 64-bit bins produce the same histogram as 32-bit bins.
+  auto batch = BatchParam{kBins, TrainParam::DftSparseThreshold()};
+  auto n_total_bins = static_cast<bst_bin_t>(result.size() / 3);
+  auto build_root = [&](bst_idx_t max_node_rows) {
+    auto h_gpair = linalg::MakeTensorView(&ctx, gpair.ConstHostSpan(), gpair.Size());
+    RegTree tree;
+    std::vector<bst_node_t> nodes{RegTree::kRoot};
+    std::vector<bst_node_t> dummy_sub;
+    common::RowSetCollection row_set;
+    InitRowPartitionForTest(&row_set, kRows);
+    common::BlockedSpace2d space{1, [&](std::size_t) { return kRows; }, 256};
+
+    HistogramBuilder builder;
+    builder.Reset(&ctx, n_total_bins, batch, false, &q_param);
+    builder.QuantiseGradient(&ctx, h_gpair);
+    builder.AddHistRows(tree.HostScView(), &nodes, &dummy_sub, false);
+    for (auto const &page : Xy->GetBatches<GHistIndexMatrix>(&ctx, batch)) {
+      builder.BuildHist(0, space, page, row_set, nodes, h_gpair, false, max_node_rows);
+    }
+    builder.SyncHistogram(&ctx, tree.HostScView(), nodes, {});
+    auto hist = builder.Histogram()[RegTree::kRoot];
+    return std::vector<GradientPairPrecise>(hist.cbegin(), hist.cend());
+  };
+  auto narrow = build_root(kRows);
+  ASSERT_EQ(narrow, build_root(std::numeric_limits<bst_idx_t>::max()));
+  ASSERT_TRUE(std::equal(narrow.cbegin(), narrow.cend(), result.cbegin()));
+}
+
+TEST(CPUHistogram, QuantisedHeavyTail) {
+  bst_bin_t constexpr kBins = 256;
+  bst_idx_t constexpr kRows = 8192;
+  auto Xy = RandomDataGenerator{kRows, 16, 0.5}.Bins(kBins).GenerateQuantileDMatrix(true);
+
+  Context ctx;
+  ctx.UpdateAllowUnknown(Args{{"nthread", "4"}});
+  HistMakerTrainParam fp_param;
+  HistMakerTrainParam q_param;
+  q_param.Init(Args{{"quantised_hist", "true"}});
+
+  auto check = [&](HostDeviceVector<GradientPair> const &gpair, bool wide, double bin_eps,
+                   double total_eps) {
+    auto h_gpair = linalg::MakeTensorView(&ctx, gpair.ConstHostSpan(), gpair.Size());
+    ASSERT_EQ(HistQuantiser(&ctx, h_gpair, false).IsWide(), wide);
+    auto expected = BuildTreeHistForTest(&ctx, Xy.get(), gpair, fp_param);
+    auto result = BuildTreeHistForTest(&ctx, Xy.get(), gpair, q_param);
+    ASSERT_EQ(expected.size(), result.size());
+    GradientPairPrecise expected_total, total;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_NEAR(expected[i].GetGrad(), result[i].GetGrad(), bin_eps);
+      ASSERT_NEAR(expected[i].GetHess(), result[i].GetHess(), bin_eps);
+      expected_total += expected[i];
+      total += result[i];
+    }
+    ASSERT_NEAR(expected_total.GetGrad(), total.GetGrad(), total_eps);
+    ASSERT_NEAR(expected_total.GetHess(), total.GetHess(), total_eps);
+  };
+
+  // Small gradients with a few large outliers. With 16 bits scaled by the largest value,
+  // the small gradients would all be rounded to zero.
+  auto gpair = GenerateRandomGradients(kRows, -1e-3f, 1e-3f);
+  for (std::size_t i = 0; i < kRows; i += 1024) {
+    gpair.HostVector()[i] = GradientPair{1e3f, 1e3f};
+  }
+  check(gpair, true, 1e-4, 1e-3);
+
+  // Many samples that are rounded in the same direction. Rounding to the nearest would
+  // add a third of the resolution for each sample, more than 1 for the total of all bins.
+  // The stochastic rounding is unbiased.
+  HostDeviceVector<GradientPair> uniform(kRows, GradientPair{1e-2f, 1e-2f});
+  uniform.HostVector()[0] = GradientPair{1.0f, 1.0f};
+  check(uniform, false, 1e-3, 0.2);
+}
+
+TEST(CPUHistogram, SinglePrecision) {
+  bst_bin_t constexpr kBins = 256;
+  bst_idx_t constexpr kRows = 8192;
+  auto Xy = RandomDataGenerator{kRows, 16, 0.5}.Bins(kBins).GenerateQuantileDMatrix(true);
+  auto gpair = GenerateRandomGradients(kRows, -1.0f, 1.0f);
+
+  Context ctx;
+  ctx.UpdateAllowUnknown(Args{{"nthread", "4"}});
+  for (auto quantised : {false, true}) {
+    HistMakerTrainParam hist_param;
+    hist_param.Init(Args{{"quantised_hist", quantised ? "true" : "false"}});
+    auto expected = BuildTreeHistForTest(&ctx, Xy.get(), gpair, hist_param);
+    auto result = BuildTreeHistForTest<GradientPair>(&ctx, Xy.get(), gpair, hist_param);
+    ASSERT_EQ(expected.size(), result.size());
+    // Each thread sums its block of rows in float, the blocks are summed in double.
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_NEAR(expected[i].GetGrad(), result[i].GetGrad(), 1e-5);
+      ASSERT_NEAR(expected[i].GetHess(), result[i].GetHess(), 1e-5);
+    }
+    if (quantised) {
+      // The root is built directly, which is the rounded integer histogram.
+      auto n_total_bins = result.size() / 3;
+      for (std::size_t i = 0; i < n_total_bins; ++i) {
+        ASSERT_EQ(GradientPair{expected[i]}, GradientPair{result[i]});
+      }
+    }
+  }
+}
+
+TEST(CPUHistogram, SinglePrecisionDistributed) {
+  std::int32_t constexpr kWorkers = 3;
+  collective::TestDistributedGlobal(kWorkers, [] {
+    bst_bin_t constexpr kBins = 256;
+    bst_idx_t constexpr kRows = 8192;
+    // All workers have the same data, the result is the local histogram times the number
+    // of workers.
+    auto Xy = RandomDataGenerator{kRows, 16, 0.5}.Bins(kBins).GenerateQuantileDMatrix(true);
+    auto gpair = GenerateRandomGradients(kRows, -1.0f, 1.0f);
+
+    Context ctx;
+    ctx.UpdateAllowUnknown(Args{{"nthread", "2"}});
+    HistMakerTrainParam hist_param;
+    auto local = BuildTreeHistForTest(&ctx, Xy.get(), gpair, hist_param);
+    auto expected = BuildTreeHistForTest(&ctx, Xy.get(), gpair, hist_param, true);
+    auto result = BuildTreeHistForTest<GradientPair>(&ctx, Xy.get(), gpair, hist_param, true);
+    ASSERT_EQ(expected.size(), result.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_NEAR(expected[i].GetGrad(), local[i].GetGrad() * kWorkers, 1e-6);
+      ASSERT_NEAR(expected[i].GetHess(), local[i].GetHess() * kWorkers, 1e-6);
+      ASSERT_NEAR(expected[i].GetGrad(), result[i].GetGrad(), 1e-4);
+      ASSERT_NEAR(expected[i].GetHess(), result[i].GetHess(), 1e-4);
+    }
+  });
+}
 }  // namespace xgboost::tree
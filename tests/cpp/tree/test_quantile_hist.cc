@@ -4,11 +4,13 @@
 #include <gtest/gtest.h>
 #include <xgboost/gradient.h>  // for GradientContainer
 #include <xgboost/host_device_vector.h>
+#include <xgboost/learner.h>  // for Learner
 #include <xgboost/linalg.h>
 #include <xgboost/tree_updater.h>
 
 #include <cmath>
 #include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t
 #include <cstring>
 #include <limits>
 #include <memory>
@@ -199,4 +201,88 @@ void TestPartitionerOverrun(bst_target_t n_targets) {
 TEST(QuantileHist, HistUpdaterPartitionerOverrun) { TestPartitionerOverrun(1); }
 
 TEST(QuantileHist, MultiTargetHistBuilderPartitionerOverrun) { TestPartitionerOverrun(3); }
+
+TEST(QuantileHist, SinglePrecision) {
+  bst_idx_t constexpr kRows = 4096;
+  bst_feature_t constexpr kCols = 8;
+  Context ctx;
+  ctx.InitAllowUnknown(Args{{"nthread", "4"}});
+  ObjInfo task{ObjInfo::kRegression};
+  auto p_fmat = RandomDataGenerator{kRows, kCols, 0.2f}.Seed(3).GenerateDMatrix();
+
+  std::size_t shape[2]{kRows, 1};
+  GradientContainer gpair;
+  gpair.gpair = linalg::Matrix<GradientPair>{shape, ctx.Device()};
+  auto h_gpair = gpair.gpair.HostView();
+  auto random = GenerateRandomGradients(kRows, -1.0f, 1.0f);
+  for (bst_idx_t i = 0; i < kRows; ++i) {
+    auto g = random.ConstHostVector()[i];
+    h_gpair(i, 0) = GradientPair{g.GetGrad(), std::abs(g.GetHess())};
+  }
+
+  TrainParam param;
+  param.InitAllowUnknown(Args{{"max_depth", "4"}});
+  auto build = [&](std::string single_precision) {
+    auto updater =
+        std::unique_ptr<TreeUpdater>{TreeUpdater::Create("grow_quantile_histmaker", &ctx, &task)};
+    updater->Configure(Args{{"single_precision_histogram", single_precision}});
+    RegTree tree{1, kCols};
+    std::vector<RegTree*> trees{&tree};
+    std::vector<HostDeviceVector<bst_node_t>> position(1);
+    updater->Update(&param, &gpair, p_fmat.get(), common::Span{position}, trees);
+    return tree;
+  };
+
+  // The single precision histogram should produce the same tree structure.
+  auto expected = build("false");
+  auto result = build("true");
+  ASSERT_GT(expected.NumExtraNodes(), 0);
+  ASSERT_EQ(expected.NumNodes(), result.NumNodes());
+  for (bst_node_t nidx = 0; nidx < expected.NumNodes(); ++nidx) {
+    ASSERT_EQ(expected[nidx].IsLeaf(), result[nidx].IsLeaf());
+    if (expected[nidx].IsLeaf()) {
+      ASSERT_NEAR(expected[nidx].LeafValue(), result[nidx].LeafValue(), 1e-5);
+    } else {
+      ASSERT_EQ(expected[nidx].SplitIndex(), result[nidx].SplitIndex());
+      ASSERT_EQ(expected[nidx].SplitCond(), result[nidx].SplitCond());
+    }
+  }
+}
+
+TEST(QuantileHist, QuantisedTrainingQuality) {
+  bst_idx_t constexpr kRows = 4096;
+  bst_feature_t constexpr kCols = 8;
+  auto p_fmat = RandomDataGenerator{kRows, kCols, 0.2f}.Seed(3).GenerateDMatrix(true);
+  auto train_rmse = [&](std::string quantised) {
+    std::unique_ptr<Learner> learner{Learner::Create({p_fmat})};
+    learner->SetParams(
+        Args{{"tree_method", "hist"}, {"max_depth", "6"}, {"quantised_hist", quantised}});
+    for (std::int32_t iter = 0; iter < 16; ++iter) {
+      learner->UpdateOneIter(iter, p_fmat);
+    }
+    HostDeviceVector<float> predt;
+    learner->Predict(p_fmat, false, &predt, 0, 0);
+    auto const &h_predt = predt.ConstHostVector();
+    auto h_labels = p_fmat->Info().labels.HostView();
+    double sse{0.0};
+    for (bst_idx_t i = 0; i < kRows; ++i) {
+      sse += std::pow(h_predt[i] - h_labels(i, 0), 2);
+    }
+    return std::sqrt(sse / kRows);
+  };
+
+  // The quantised histogram should train a model as good as the floating point histogram,
+  // with ordinary labels and with heavy-tailed labels that produce outlier gradients.
+  for (auto heavy_tail : {false, true}) {
+    if (heavy_tail) {
+      auto &h_labels = p_fmat->Info().labels.Data()->HostVector();
+      for (bst_idx_t i = 0; i < kRows; i += 512) {
+        h_labels[i] *= 1e3f;
+      }
+    }
+    auto expected = train_rmse("false");
+    auto result = train_rmse("true");
+    ASSERT_LT(result, expected * 1.02 + 1e-3) << "heavy tail: " << heavy_tail;
+  }
+}
 }  // namespace xgboost::tree